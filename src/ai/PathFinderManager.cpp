@@ -262,7 +262,7 @@ void PathFinderThread::run() {
 			if(curpr.ioid && curpr.ioid->_npcdata) {
 				float heuristic(PATHFINDER_HEURISTIC_MAX);
 
-				pathfinder.setCylinder(curpr.ioid->physics.cyl.radius, curpr.ioid->physics.cyl.height);
+				pathfinder.setCylinder(curpr.ioid->physics().cyl.radius, curpr.ioid->physics().cyl.height);
 
 				bool stealth = (curpr.ioid->_npcdata->behavior & (BEHAVIOUR_SNEAK | BEHAVIOUR_HIDE))
 				                == (BEHAVIOUR_SNEAK | BEHAVIOUR_HIDE);
@@ -294,11 +294,11 @@ void PathFinderThread::run() {
 
 					pathfinder.setHeuristic(heuristic);
 					float safedist = curpr.ioid->_npcdata->behavior_param
-					                 + fdist(curpr.ioid->target, curpr.ioid->pos);
+					                 + fdist(curpr.ioid->target, curpr.ioid->pos());
 
 					pathfinder.flee(curpr.from, curpr.ioid->target, safedist, result, stealth);
 				} else if(curpr.ioid->_npcdata->behavior & BEHAVIOUR_LOOK_FOR) {
-					float distance = fdist(curpr.ioid->pos, curpr.ioid->target);
+					float distance = fdist(curpr.ioid->pos(), curpr.ioid->target);
 
 					if(distance < PATHFINDER_DISTANCE_MAX)
 						heuristic = PATHFINDER_HEURISTIC_MIN + PATHFINDER_HEURISTIC_RANGE * (distance / PATHFINDER_DISTANCE_MAX);
@@ -192,16 +192,16 @@ void ARX_PATH_UpdateAllZoneInOutInside() {
 			if(count < entities.size()
 			   && io
 			   && io->ioflags & (IO_NPC | IO_ITEM)
-			   && io->show != SHOW_FLAG_MEGAHIDE
+			   && io->show() != SHOW_FLAG_MEGAHIDE
 			) {
-				arx_assert(io->show != SHOW_FLAG_DESTROYED);
+				arx_assert(io->show() != SHOW_FLAG_DESTROYED);
 				ARX_PATH * current = ARX_PATH_CheckInZone(io);
 				ARX_PATH * last = io->inzone;
 
 				if(!last && !current) { // Not in a zone
 				} else if(last == current) { // Stayed inside last zone
-					if(io->show != io->inzone_show) {
-						io->inzone_show = io->show;
+					if(io->show() != io->inzone_show) {
+						io->inzone_show = io->show();
 						goto entering;
 					}
 				} else if(last && !current) { // Leaving last zone
@@ -216,7 +216,7 @@ void ARX_PATH_UpdateAllZoneInOutInside() {
 						}
 					}
 				} else if(!last && current) { // Entering current zone
-					io->inzone_show = io->show;
+					io->inzone_show = io->show();
 				entering:
 
 					if(JUST_RELOADED && (current->name == "ingot_maker" || current->name == "mauld_user")) {
@@ -245,7 +245,7 @@ void ARX_PATH_UpdateAllZoneInOutInside() {
 						}
 					}
 
-					io->inzone_show = io->show;
+					io->inzone_show = io->show();
 					SendIOScriptEvent(io, SM_ENTERZONE, current->name);
 
 					if(!current->controled.empty()) {
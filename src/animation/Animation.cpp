@@ -678,7 +678,7 @@ void PrepareAnim(AnimLayer & layer, unsigned long time, Entity *io) {
 			   && (anim->frames[fr].sample != -1)
 			   && (layer.lastframe != fr)) {
 
-				Vec3f * position = io ? &io->pos : NULL;
+				Vec3f * position = io ? &io->pos() : NULL;
 				
 				if(layer.lastframe < fr && layer.lastframe != -1) {
 					for(long n = layer.lastframe + 1; n <= fr; n++)
@@ -697,11 +697,11 @@ void PrepareAnim(AnimLayer & layer, unsigned long time, Entity *io) {
 					if(layer.lastframe < fr && layer.lastframe != -1) {
 						for(long n = layer.lastframe + 1; n <= fr; n++) {
 							if(anim->frames[n].stepSound)
-								ARX_NPC_NeedStepSound(io, io->pos);
+								ARX_NPC_NeedStepSound(io, io->pos());
 						}
 					}
 					else if(anim->frames[fr].stepSound)
-						ARX_NPC_NeedStepSound(io, io->pos);
+						ARX_NPC_NeedStepSound(io, io->pos());
 				}
 			}
 			
@@ -774,7 +774,7 @@ void FinishAnim(Entity * io, ANIM_HANDLE * eanim) {
 
 	// Only layer 0 controls movement...
 	if(eanim == io->animlayer[0].cur_anim && (io->ioflags & IO_NPC)) {
-		io->move = io->lastmove = Vec3f_ZERO;
+		io->move() = io->lastmove = Vec3f_ZERO;
 	}
 
 	return;
@@ -314,7 +314,7 @@ void Cedric_ApplyLightingFirstPartRefactor(Entity *io) {
 	}
 
 	if(io->sfx_flag & SFX_TYPE_YLSIDE_DEATH) {
-		if(io->show == SHOW_FLAG_TELEPORTING) {
+		if(io->show() == SHOW_FLAG_TELEPORTING) {
 			float fTime = io->sfx_time + g_framedelay;
 			io->sfx_time = checked_range_cast<unsigned long>(fTime);
 
@@ -341,7 +341,7 @@ void Cedric_ApplyLightingFirstPartRefactor(Entity *io) {
 						MakePlayerAppearsFX(io);
 						AddRandomSmoke(io, 50);
 						Color3f rgb = io->_npcdata->blood_color.to<float>();
-						Sphere sp = Sphere(io->pos, 200.f);
+						Sphere sp = Sphere(io->pos(), 200.f);
 						
 						long count = 6;
 						while(count--) {
@@ -351,7 +351,7 @@ void Cedric_ApplyLightingFirstPartRefactor(Entity *io) {
 
 							ARX_PARTICLES_Spawn_Splat(sp.origin, 200.f, io->_npcdata->blood_color);
 
-							sp.origin = io->pos + randomVec3f() * Vec3f(200.f, 20.f,200.f) - Vec3f(100.f, 10.f, 100.f);
+							sp.origin = io->pos() + randomVec3f() * Vec3f(200.f, 20.f,200.f) - Vec3f(100.f, 10.f, 100.f);
 							sp.radius = Random::getf(100.f, 200.f);
 						}
 
@@ -363,7 +363,7 @@ void Cedric_ApplyLightingFirstPartRefactor(Entity *io) {
 							light->fallend = 600.f;
 							light->fallstart = 400.f;
 							light->rgb = Color3f(1.0f, 0.8f, 0.f);
-							light->pos = io->pos + Vec3f(0.f, -80.f, 0.f);
+							light->pos = io->pos() + Vec3f(0.f, -80.f, 0.f);
 							light->duration = 600;
 						}
 
@@ -381,11 +381,11 @@ void Cedric_ApplyLightingFirstPartRefactor(Entity *io) {
 								damages = ARX_SPELLS_ApplyFireProtection(io, damages);
 
 								if (ValidIONum(spell->m_caster))
-									ARX_DAMAGES_DamageNPC(io, damages, spell->m_caster, true, &entities[spell->m_caster]->pos);
+									ARX_DAMAGES_DamageNPC(io, damages, spell->m_caster, true, &entities[spell->m_caster]->pos());
 								else
-									ARX_DAMAGES_DamageNPC(io, damages, spell->m_caster, true, &io->pos);
+									ARX_DAMAGES_DamageNPC(io, damages, spell->m_caster, true, &io->pos());
 
-								ARX_SOUND_PlaySFX(SND_SPELL_FIRE_HIT, &io->pos);
+								ARX_SOUND_PlaySFX(SND_SPELL_FIRE_HIT, &io->pos());
 							}
 						} else {
 							io->sfx_flag &= ~SFX_TYPE_YLSIDE_DEATH;
@@ -1107,7 +1107,7 @@ static void Cedric_RenderObject(EERIE_3DOBJ * eobj, Skeleton * obj, Entity * io,
 
 	bool glow = false;
 	ColorRGBA glowColor;
-	if(io && (io->sfx_flag & SFX_TYPE_YLSIDE_DEATH) && io->show != SHOW_FLAG_TELEPORTING) {
+	if(io && (io->sfx_flag & SFX_TYPE_YLSIDE_DEATH) && io->show() != SHOW_FLAG_TELEPORTING) {
 		const unsigned long elapsed = arxtime.now_ul() - io->sfx_time;
 		if(elapsed >= 3000 && elapsed < 6000) {
 			float ratio = (elapsed - 3000) * (1.0f / 3000);
@@ -1271,17 +1271,17 @@ static void StoreEntityMovement(Entity * io, Vec3f & ftr, float scale) {
 	ftr2 = VRotateY(ftr, temp);
 
 	// stores Translations for a later use
-	io->move = ftr2;
+	io->move() = ftr2;
 
 	if(io->animlayer[0].cur_anim) {
 
 		// Use calculated value to notify the Movement engine of the translation to do
 		if(io->ioflags & IO_NPC) {
 			ftr = Vec3f_ZERO;
-			io->move -= io->lastmove;
-		} else if (io->gameFlags & GFLAG_ELEVATOR) {
+			io->move() -= io->lastmove;
+		} else if (io->gameFlags() & GFLAG_ELEVATOR) {
 			// Must recover translations for NON-NPC IO
-			PushIO_ON_Top(io, io->move.y - io->lastmove.y);
+			PushIO_ON_Top(io, io->move().y - io->lastmove.y);
 		}
 
 		io->lastmove = ftr2;
@@ -1588,7 +1588,7 @@ void EERIEDrawAnimQuatUpdate(EERIE_3DOBJ * eobj,
 	if(update_movement)
 		StoreEntityMovement(io, ftr, scale);
 
-	if(io && io != entities.player() && !Cedric_IO_Visible(io->pos))
+	if(io && io != entities.player() && !Cedric_IO_Visible(io->pos()))
 		return;
 
 	glm::quat rotation;
@@ -1643,13 +1643,13 @@ void EERIEDrawAnimQuatRender(EERIE_3DOBJ *eobj, const Vec3f & pos, Entity *io, f
 
 	ARX_PROFILE_FUNC();
 	
-	if(io && io != entities.player() && !Cedric_IO_Visible(io->pos))
+	if(io && io != entities.player() && !Cedric_IO_Visible(io->pos()))
 		return;
 
 	bool isFightingNpc = io &&
 						 (io->ioflags & IO_NPC) &&
 						 (io->_npcdata->behavior & BEHAVIOUR_FIGHT) &&
-						 closerThan(io->pos, player.pos, 240.f);
+						 closerThan(io->pos(), player.pos, 240.f);
 
 	if(!isFightingNpc && ARX_SCENE_PORTAL_ClipIO(io, pos))
 		return;
@@ -1662,5 +1662,5 @@ void AnimatedEntityRender(Entity * entity, float invisibility) {
 	Cedric_ViewProjectTransform(entity->obj);
 	Cedric_UpdateBbox2d(*entity->obj, entity->bbox2D);
 
-	EERIEDrawAnimQuatRender(entity->obj, entity->pos, entity, invisibility);
+	EERIEDrawAnimQuatRender(entity->obj, entity->pos(), entity, invisibility);
 }
@@ -148,12 +148,14 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include "scene/ChangeLevel.h"
 #include "scene/Interactive.h"
 #include "scene/GameSound.h"
+#include "scene/LevelLoader.h"
 #include "scene/Light.h"
 #include "scene/LoadLevel.h"
 #include "scene/Object.h"
 #include "scene/Scene.h"
 
 #include "script/ScriptEvent.h"
+#include "script/ScriptProfiler.h"
 
 #include "Configure.h"
 
@@ -998,10 +1000,15 @@ bool ArxGame::addPaks() {
 	// Load required pak files
 	bool missing = false;
 	for(size_t i = 0; i < ARRAY_SIZE(default_paks); i++) {
-		if(resources->addArchive(fs::paths.find(default_paks[i][0]))) {
-			continue;
+		fs::path pak = fs::paths.find(default_paks[i][0]);
+		bool found = resources->addArchive(pak);
+		if(!found && default_paks[i][1]) {
+			pak = fs::paths.find(default_paks[i][1]);
+			found = resources->addArchive(pak);
 		}
-		if(default_paks[i][1] && resources->addArchive(fs::paths.find(default_paks[i][1]))) {
+		if(found) {
+			// Mount the faster repacked archive on top of the original if there is one
+			resources->addRepackedArchive(pak);
 			continue;
 		}
 		std::ostringstream oss;
@@ -1111,6 +1118,7 @@ void ArxGame::shutdownGame() {
 	
 	Menu2_Close();
 	DanaeClearLevel(2);
+	savegames.releaseThumbnail();
 	TextureContainer::DeleteAll();
 	
 	delete ControlCinematique, ControlCinematique = NULL;
@@ -1120,6 +1128,7 @@ void ArxGame::shutdownGame() {
 	RoomDrawRelease();
 	EXITING=1;
 	TREATZONE_Release();
+	ARX_PHYSICS_Release();
 	ClearTileLights();
 	
 	// texts and textures
@@ -1159,6 +1168,8 @@ void ArxGame::shutdownGame() {
 	//object loaders from beforerun
 	gui::ReleaseNecklace();
 	
+	LevelLoader::clearPrefetch();
+	
 	delete resources;
 	
 	// Current game
@@ -1274,6 +1285,8 @@ void ArxGame::doFrame() {
 	updateTime();
 
 	updateInput();
+	
+	savegames.pollSave();
 
 	if(m_wasResized) {
 		LogDebug("was resized");
@@ -1292,6 +1305,11 @@ void ArxGame::doFrame() {
 		DANAE_StartNewQuest();
 	}
 
+	// Start loading the target level while the player is in a level change zone
+	if(!TELEPORT_TO_LEVEL.empty() && CHANGE_LEVEL_ICON > -1) {
+		ARX_CHANGELEVEL_Prefetch(TELEPORT_TO_LEVEL);
+	}
+	
 	// Are we being teleported ?
 	if(!TELEPORT_TO_LEVEL.empty() && CHANGE_LEVEL_ICON == 200) {
 		benchmark::begin(benchmark::LoadLevel);
@@ -1704,6 +1722,7 @@ void ArxGame::updateInput() {
 		*/
 		
 		profiler::flush();
+		script::logHottestScripts();
 	}
 
 	if(GInput->isKeyPressedNowPressed(Keyboard::Key_F11)) {
@@ -1849,7 +1868,7 @@ void ArxGame::updateLevel() {
 			EERIEDrawAnimQuatUpdate(entity->obj,
 			                        entity->animlayer,
 			                        entity->angle,
-			                        entity->pos,
+			                        entity->pos(),
 			                        Original_framedelay,
 			                        entity,
 			                        true);
@@ -609,9 +609,9 @@ void levelInit() {
 	if(WILL_RESTORE_PLAYER_POSITION_FLAG) {
 		Entity * io = entities.player();
 		player.pos = WILL_RESTORE_PLAYER_POSITION;
-		io->pos = player.basePosition();
+		io->pos() = player.basePosition();
 		for(size_t i = 0; i < io->obj->vertexlist.size(); i++) {
-			io->obj->vertexlist3[i].v = io->obj->vertexlist[i].v + io->pos;
+			io->obj->vertexlist3[i].v = io->obj->vertexlist[i].v + io->pos();
 		}
 		WILL_RESTORE_PLAYER_POSITION_FLAG = false;
 	}
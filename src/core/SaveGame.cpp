@@ -23,11 +23,18 @@
 #include <iomanip>
 #include <algorithm>
 
+#include <boost/unordered_map.hpp>
+
 #include "core/Config.h"
+#include "graphics/Renderer.h"
+#include "graphics/data/TextureContainer.h"
+#include "graphics/texture/Texture.h"
+#include "io/fs/FileStream.h"
 #include "io/fs/Filesystem.h"
 #include "io/fs/SystemPaths.h"
 #include "io/log/Logger.h"
-#include "io/resource/PakReader.h"
+#include "platform/Lock.h"
+#include "platform/Thread.h"
 #include "scene/ChangeLevel.h"
 
 namespace {
@@ -35,8 +42,12 @@ namespace {
 static const fs::path SAVEGAME_NAME = "gsave.sav";
 static const fs::path SAVEGAME_DIR = "save";
 static const fs::path SAVEGAME_THUMBNAIL = "gsave.bmp";
+static const fs::path SAVEGAME_INDEX = "index.cache";
 static const std::string QUICKSAVE_ID = "ARX_QUICK_ARX";
 
+static const u32 SAVEGAME_INDEX_MAGIC = 0x58495341; // "ASIX"
+static const u32 SAVEGAME_INDEX_VERSION = 1;
+
 enum SaveGameChange {
 	SaveGameRemoved,
 	SaveGameUnchanged,
@@ -47,45 +58,123 @@ static int saveTimeCompare(const SaveGame & a, const SaveGame & b) {
 	return (a.stime > b.stime);
 }
 
+static bool isQuicksave(const std::string & name) {
+	return (name == QUICKSAVE_ID || name == "ARX_QUICK_ARX1");
+}
+
+static std::string formatTime(std::time_t stime) {
+	const struct tm & t = *localtime(&stime);
+	std::ostringstream oss;
+	oss << std::setfill('0') << (t.tm_year + 1900) << "-" << std::setw(2) << (t.tm_mon + 1)
+	    << "-" << std::setw(2) << t.tm_mday << "   " << std::setfill(' ') << std::setw(2)
+	    << t.tm_hour << ":" << std::setfill('0') << std::setw(2) << t.tm_min << ":"
+	    << std::setw(2) << t.tm_sec;
+	return oss.str();
+}
+	
 } // anonnymous namespace
 
+/*!
+ * Decodes a savegame thumbnail in the background.
+ * 
+ * The main thread must not access the image until the loader has finished.
+ */
+class SaveGameList::ThumbnailLoader : public Thread {
+	
+public:
+	
+	explicit ThumbnailLoader(const fs::path & file)
+		: m_file(file)
+		, m_finished(false)
+		, m_success(false)
+	{
+		setThreadName("Thumbnail Loader");
+	}
+	
+	const fs::path & getFile() const { return m_file; }
+	
+	bool isFinished() {
+		Autolock lock(m_lock);
+		return m_finished;
+	}
+	
+	bool succeeded() {
+		Autolock lock(m_lock);
+		return m_success;
+	}
+	
+	const Image & getImage() const { return m_image; }
+	
+private:
+	
+	void run() {
+		
+		std::string data = fs::read(m_file);
+		bool success = !data.empty()
+		               && m_image.LoadFromMemory(&data[0], data.size(), m_file.string().c_str());
+		
+		Autolock lock(m_lock);
+		m_success = success;
+		m_finished = true;
+	}
+	
+	fs::path m_file;
+	Image m_image;
+	
+	Lock m_lock;
+	bool m_finished;
+	bool m_success;
+	
+};
+
 SaveGameList savegames;
 
 void SaveGameList::update(bool verbose) {
 	
 	LogDebug("SaveGameList::update()");
 	
-	size_t old_count = savelist.size();
-	std::vector<SaveGameChange> found(old_count, SaveGameRemoved);
-	
-	bool new_saves = false;
-	
-	size_t max_name_length = 0;
-	
 	fs::path savedir = fs::paths.user / SAVEGAME_DIR;
 	
 	if(verbose) {
 		LogInfo << "Using save game dir " << savedir;
 	}
 	
+	if(!indexLoaded) {
+		loadIndex(savedir);
+		indexLoaded = true;
+	}
+	
+	size_t old_count = savelist.size();
+	std::vector<SaveGameChange> found(old_count, SaveGameRemoved);
+	
+	typedef boost::unordered_map<std::string, size_t> KnownSaves;
+	KnownSaves known;
+	for(size_t i = 0; i < old_count; i++) {
+		known[savelist[i].savefile.string()] = i;
+	}
+	
+	bool new_saves = false;
+	bool removed_saves = false;
+	
 	for(fs::directory_iterator it(savedir); !it.end(); ++it) {
 		
 		fs::path dirname = it.name();
 		fs::path path = savedir / dirname / SAVEGAME_NAME;
 		
+		// Savegames are only opened if their modification time or size changed
 		std::time_t stime = fs::last_write_time(path);
 		if(stime == 0) {
 			LogDebug("Ignoring directory without " << SAVEGAME_NAME << ": " << path);
 			continue;
 		}
+		u64 size = fs::file_size(path);
 		
 		size_t index = (size_t)-1;
-		for(size_t i = 0; i < old_count; i++) {
-			if(savelist[i].savefile == path) {
-				index = i;
-			}
+		KnownSaves::const_iterator i = known.find(path.string());
+		if(i != known.end()) {
+			index = i->second;
 		}
-		if(index != (size_t)-1 && savelist[index].stime == stime) {
+		if(index != (size_t)-1 && savelist[index].stime == stime && savelist[index].size == size) {
 			found[index] = SaveGameUnchanged;
 			continue;
 		}
@@ -114,45 +203,38 @@ void SaveGameList::update(bool verbose) {
 		save->name = name;
 		save->level = level;
 		save->stime = stime;
+		save->size = size;
 		save->savefile = path;
 		
-		save->quicksave = (name == QUICKSAVE_ID || name == "ARX_QUICK_ARX1");
+		save->quicksave = isQuicksave(name);
 		
+		// Thumbnails are only decoded once they are needed by getThumbnail()
 		fs::path thumbnail = path.parent() / SAVEGAME_THUMBNAIL;
 		if(fs::exists(thumbnail)) {
-			// Resource paths must be lowercase (for now), but filesystem paths can be
-			// mixed case and case sensitive, so we can't just convert the save dirname
-			// to lowercase and expect to not get collisions.
-			// Instead, choose a unique number.
-			res::path thumbnail_res;
-			size_t i = 0;
-			std::ostringstream oss;
-			do {
-				oss.clear();
-				oss << "thumbnail" << i << SAVEGAME_THUMBNAIL.ext();
-				thumbnail_res = res::path("save") / oss.str();
-				i++;
-			} while(resources->getFile(thumbnail_res));
-			resources->addFiles(thumbnail, thumbnail_res);
-			save->thumbnail = thumbnail_res.remove_ext();
+			save->thumbnail = thumbnail;
 		} else {
 			save->thumbnail.clear();
 		}
 		
-		max_name_length = std::max(save->quicksave ? 9 : name.length(), max_name_length);
-		
-		const struct tm & t = *localtime(&stime);
-		std::ostringstream oss;
-		oss << std::setfill('0') << (t.tm_year + 1900) << "-" << std::setw(2) << (t.tm_mon + 1)
-		    << "-" << std::setw(2) << t.tm_mday << "   " << std::setfill(' ') << std::setw(2)
-		    << t.tm_hour << ":" << std::setfill('0') << std::setw(2) << t.tm_min << ":"
-		    << std::setw(2) << t.tm_sec;
-		save->time = oss.str();
+		save->time = formatTime(stime);
+	}
+	
+	size_t max_name_length = 0;
+	for(size_t i = 0; i < savelist.size(); i++) {
+		if(verbose || i >= old_count || found[i] == SaveGameChanged) {
+			const SaveGame & save = savelist[i];
+			max_name_length = std::max(save.quicksave ? 9 : save.name.length(), max_name_length);
+		}
 	}
 	
 	size_t o = 0;
 	for(size_t i = 0; i < savelist.size(); i++) {
 		
+		if(i < old_count && found[i] == SaveGameRemoved) {
+			removed_saves = true;
+			continue;
+		}
+		
 		// print new savegames
 		if(verbose || i >= old_count || found[i] == SaveGameChanged) {
 			
@@ -176,16 +258,10 @@ void SaveGameList::update(bool verbose) {
 			LogInfo << lead << oss.str() << "  " << savelist[i].time;
 		}
 		
-		if(i >= old_count || found[i] != SaveGameRemoved) {
-			if(o != i) {
-				savelist[o] = savelist[i];
-			}
-			o++;
-		} else {
-			// Clean obsolete mounts
-			resources->removeFile(savelist[i].thumbnail);
-			resources->removeDirectory(savelist[i].thumbnail.parent());
+		if(o != i) {
+			savelist[o] = savelist[i];
 		}
+		o++;
 	}
 	savelist.resize(o);
 	
@@ -193,11 +269,185 @@ void SaveGameList::update(bool verbose) {
 		std::sort(savelist.begin(), savelist.end(), saveTimeCompare);
 	}
 	
+	if(new_saves || removed_saves) {
+		saveIndex(savedir);
+		// The current thumbnail may belong to an overwritten savegame
+		releaseThumbnail();
+	}
+	
 	LogDebug("Found " << savelist.size() << " savegames");
 }
 
+void SaveGameList::loadIndex(const fs::path & savedir) {
+	
+	fs::path file = savedir / SAVEGAME_INDEX;
+	if(!fs::is_regular_file(file)) {
+		return;
+	}
+	
+	// Read everything at once
+	std::istringstream is(fs::read(file));
+	
+	u32 magic, version, count;
+	fs::read(is, magic);
+	fs::read(is, version);
+	fs::read(is, count);
+	if(is.fail() || magic != SAVEGAME_INDEX_MAGIC || version != SAVEGAME_INDEX_VERSION) {
+		LogDebug("ignoring outdated savegame index " << file);
+		return;
+	}
+	
+	std::vector<SaveGame> saves;
+	for(u32 i = 0; i < count; i++) {
+		
+		SaveGame save;
+		std::string dirname;
+		s32 level;
+		s64 stime;
+		u8 thumbnail;
+		fs::read(is, dirname);
+		fs::read(is, save.name);
+		fs::read(is, level);
+		fs::read(is, stime);
+		fs::read(is, save.size);
+		fs::read(is, thumbnail);
+		if(is.fail()) {
+			LogWarning << "Ignoring invalid savegame index " << file;
+			return;
+		}
+		
+		save.savefile = savedir / dirname / SAVEGAME_NAME;
+		if(thumbnail) {
+			save.thumbnail = save.savefile.parent() / SAVEGAME_THUMBNAIL;
+		}
+		save.level = level;
+		save.stime = std::time_t(stime);
+		save.quicksave = isQuicksave(save.name);
+		save.time = formatTime(save.stime);
+		
+		saves.push_back(save);
+	}
+	
+	savelist.swap(saves);
+	
+	LogDebug("loaded savegame index " << file << " with " << savelist.size() << " savegames");
+}
+
+void SaveGameList::saveIndex(const fs::path & savedir) const {
+	
+	if(!fs::is_directory(savedir)) {
+		return;
+	}
+	
+	fs::path file = savedir / SAVEGAME_INDEX;
+	
+	std::ostringstream os;
+	fs::write(os, SAVEGAME_INDEX_MAGIC);
+	fs::write(os, SAVEGAME_INDEX_VERSION);
+	fs::write(os, u32(savelist.size()));
+	for(iterator save = begin(); save != end(); ++save) {
+		std::string dirname = save->savefile.parent().filename();
+		fs::write(os, dirname.c_str(), dirname.length() + 1);
+		fs::write(os, save->name.c_str(), save->name.length() + 1);
+		fs::write(os, s32(save->level));
+		fs::write(os, s64(save->stime));
+		fs::write(os, save->size);
+		fs::write(os, u8(save->thumbnail.empty() ? 0 : 1));
+	}
+	
+	// Write to a temporary file first so that a crash never leaves a partial index
+	fs::path tempFile = file;
+	tempFile.append(".tmp");
+	if(!fs::write(tempFile, os.str()) || !fs::rename(tempFile, file, true)) {
+		LogWarning << "Could not write savegame index " << file;
+		fs::remove(tempFile);
+	}
+}
+
+TextureContainer * SaveGameList::getThumbnail(SavegameHandle handle) {
+	
+	size_t index = size_t(handle.handleData());
+	arx_assert(index < savelist.size());
+	
+	const fs::path & file = savelist[index].thumbnail;
+	if(file.empty() || failedThumbnails.find(file) != failedThumbnails.end()) {
+		return NULL;
+	}
+	
+	if(file == thumbnailFile && (thumbnail || !thumbnailLoader)) {
+		// Already decoded or failed to decode
+		return thumbnail;
+	}
+	
+	if(thumbnailLoader) {
+		
+		if(!thumbnailLoader->isFinished()) {
+			// Let the current thumbnail finish before starting the next one
+			return NULL;
+		}
+		
+		thumbnailLoader->waitForCompletion();
+		
+		if(thumbnailLoader->getFile() == file) {
+			
+			delete thumbnail, thumbnail = NULL;
+			thumbnailFile = file;
+			
+			if(thumbnailLoader->succeeded()) {
+				
+				TextureContainer::TCFlags flags = TextureContainer::NoMipmap
+				                                  | TextureContainer::NoInsert
+				                                  | TextureContainer::NoColorKey;
+				thumbnail = new TextureContainer(res::path("save/thumbnail"), flags);
+				thumbnail->m_pTexture = GRenderer->CreateTexture2D();
+				if(thumbnail->m_pTexture && thumbnail->m_pTexture->Init(thumbnailLoader->getImage(), 0)) {
+					thumbnail->m_size = thumbnail->m_pTexture->getSize();
+					Vec2i storedSize = thumbnail->m_pTexture->getStoredSize();
+					thumbnail->uv = Vec2f(float(thumbnail->m_size.x) / storedSize.x,
+					                      float(thumbnail->m_size.y) / storedSize.y);
+					thumbnail->hd = Vec2f(.5f / storedSize.x, .5f / storedSize.y);
+				} else {
+					LogWarning << "Could not create thumbnail texture for " << file;
+					delete thumbnail, thumbnail = NULL;
+				}
+				
+			}
+			
+			if(!thumbnail) {
+				// Don't try to decode the same file again every frame
+				failedThumbnails.insert(file);
+			}
+			
+			delete thumbnailLoader, thumbnailLoader = NULL;
+			
+			return thumbnail;
+		}
+		
+		delete thumbnailLoader, thumbnailLoader = NULL;
+	}
+	
+	thumbnailLoader = new ThumbnailLoader(file);
+	thumbnailLoader->start();
+	
+	return NULL;
+}
+
+void SaveGameList::releaseThumbnail() {
+	
+	if(thumbnailLoader) {
+		thumbnailLoader->waitForCompletion();
+		delete thumbnailLoader, thumbnailLoader = NULL;
+	}
+	
+	delete thumbnail, thumbnail = NULL;
+	thumbnailFile.clear();
+	failedThumbnails.clear();
+}
+
 void SaveGameList::remove(SavegameHandle handle) {
 	
+	finishSave();
+	
 	iterator save = begin() + handle.handleData();
 	
 	arx_assert(save >= begin() && save < end());
@@ -242,11 +492,44 @@ bool SaveGameList::save(const std::string & name, iterator overwrite, const Imag
 		LogWarning << "Failed to save screenshot to " << (savefile.parent() / SAVEGAME_THUMBNAIL);
 	}
 	
-	update();
+	// The list is updated by pollSave() once the savegame has been written
+	saving = true;
+	saveProgress = 0.f;
 	
 	return true;
 }
 
+void SaveGameList::pollSave() {
+	
+	if(!saving) {
+		return;
+	}
+	
+	float progress = 0.f;
+	SaveWriteStatus status = ARX_CHANGELEVEL_PollSave(&progress);
+	if(status == SaveWriteInProgress) {
+		saveProgress = progress;
+		return;
+	}
+	
+	if(status == SaveWriteFailed) {
+		LogError << "Failed to write savegame";
+	}
+	
+	saving = false;
+	saveProgress = 1.f;
+	
+	update();
+}
+
+void SaveGameList::finishSave() {
+	
+	if(saving) {
+		ARX_CHANGELEVEL_FinishSave();
+		pollSave();
+	}
+}
+
 bool SaveGameList::quicksave(const Image & thumbnail) {
 	
 	iterator overwrite = end();
@@ -274,6 +557,9 @@ bool SaveGameList::quicksave(const Image & thumbnail) {
 
 SaveGameList::iterator SaveGameList::quickload() {
 	
+	// Make sure the newest savegame is complete and in the list
+	finishSave();
+	
 	if(savelist.empty()) {
 		return end();
 	}
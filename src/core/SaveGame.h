@@ -21,15 +21,18 @@
 #define ARX_CORE_SAVEGAME_H
 
 #include <stddef.h>
+#include <set>
 #include <vector>
 #include <string>
 #include <ctime>
 
 #include "graphics/image/Image.h"
 #include "io/fs/FilePath.h"
-#include "io/resource/ResourcePath.h"
+#include "platform/Platform.h"
 #include "util/HandleType.h"
 
+class TextureContainer;
+
 ARX_HANDLE_TYPEDEF(long, SavegameHandle, -1);
 
 struct SaveGame {
@@ -39,10 +42,11 @@ struct SaveGame {
 	std::string name;
 	
 	fs::path savefile;
-	res::path thumbnail;
+	fs::path thumbnail; //!< Thumbnail image file or empty if there is none
 	
 	long level;
 	std::time_t stime;
+	u64 size;
 	
 	std::string time;
 	
@@ -50,6 +54,7 @@ struct SaveGame {
 		: quicksave(false)
 		, level(0)
 		, stime(0)
+		, size(0)
 	{}
 };
 
@@ -60,13 +65,27 @@ public:
 	
 	typedef std::vector<SaveGame>::const_iterator iterator;
 	
-	//! Update the savegame list. This is automatically called by save() and remove()
+	SaveGameList()
+		: saving(false)
+		, saveProgress(0.f)
+		, indexLoaded(false)
+		, thumbnailLoader(NULL)
+		, thumbnail(NULL)
+	{ }
+	
+	/*!
+	 * Update the savegame list. This is automatically called by save() and remove()
+	 *
+	 * Savegame info is cached in an index file in the save directory - only new or
+	 * modified savegames need to be opened.
+	 */
 	void update(bool verbose = false);
 	
 	/*! Save the current game state
+	 * The savegame file is written in the background - the list is updated once it is complete.
 	 * \param name The name of the new savegame.
 	 * \param overwrite A savegame to overwrite with this save or end()
-	 * \return true if the game was successfully saved.
+	 * \return true if the game state was successfully captured.
 	 */
 	bool save(const std::string & name, iterator overwrite, const Image & thumbnail = Image());
 	
@@ -79,6 +98,15 @@ public:
 		return save(name, (overwrite == size_t(-1)) ? end() : begin() + overwrite, th);
 	}
 	
+	//! Check on the savegame being written in the background. Call this once per frame.
+	void pollSave();
+	
+	//! \return true while a savegame is being written in the background
+	bool isSaving() const { return saving; }
+	
+	//! \return the fraction [0, 1] of the current savegame that has been written
+	float getSaveProgress() const { return saveProgress; }
+	
 	//! Perform a quicksave: Maintain a number of quicksave slots and always overwrite the oldest one.
 	bool quicksave(const Image & thumbnail = Image());
 	
@@ -88,6 +116,22 @@ public:
 	//! Delete the given savegame. This removes the actual on-disk files.
 	void remove(SavegameHandle handle);
 	
+	/*!
+	 * Get the thumbnail for a savegame.
+	 *
+	 * Thumbnails are decoded in a background thread when first requested.
+	 *
+	 * \return the thumbnail texture or NULL if the savegame has no thumbnail or it is
+	 *         not decoded yet. The texture remains valid until a different thumbnail
+	 *         is returned or until releaseThumbnail() or update() are called.
+	 */
+	TextureContainer * getThumbnail(SavegameHandle handle);
+	
+	//! Free the current thumbnail texture and wait for any pending thumbnail decode.
+	//! Thumbnails that failed to decode will be tried again.
+	//! Must be called before the renderer is shut down.
+	void releaseThumbnail();
+	
 	iterator begin() const { return savelist.begin(); }
 	iterator end() const { return savelist.end(); }
 	
@@ -96,8 +140,29 @@ public:
 	
 private:
 	
+	class ThumbnailLoader;
+	
 	std::vector<SaveGame> savelist;
 	
+	bool saving;
+	float saveProgress;
+	
+	bool indexLoaded;
+	
+	ThumbnailLoader * thumbnailLoader;
+	fs::path thumbnailFile; //!< Thumbnail image file for the current texture
+	TextureContainer * thumbnail;
+	std::set<fs::path> failedThumbnails; //!< Thumbnail files that could not be decoded
+	
+	//! Wait for the savegame being written in the background and update the list
+	void finishSave();
+	
+	//! Fill the savegame list with the cached info from the index file.
+	void loadIndex(const fs::path & savedir);
+	
+	//! Write the savegame list to the index file.
+	void saveIndex(const fs::path & savedir) const;
+	
 };
 
 extern SaveGameList savegames;
@@ -62,9 +62,12 @@
 #include "platform/Environment.h"
 #include "platform/profiler/Profiler.h"
 #include "platform/ProgramOptions.h"
+#include "platform/ThreadPool.h"
 #include "platform/Time.h"
 #include "platform/WindowsMain.h"
 
+#include "script/ScriptProfiler.h"
+
 #include "util/String.h"
 #include "util/cmdline/Parser.h"
 
@@ -126,6 +129,16 @@ static ExitStatus parseCommandLine(int argc, char ** argv) {
 	return RunProgram;
 }
 
+static void registerPoolWorker() {
+	CrashHandler::registerThreadCrashHandlers();
+	profiler::registerThread("ThreadPool");
+}
+
+static void unregisterPoolWorker() {
+	profiler::unregisterThread();
+	CrashHandler::unregisterThreadCrashHandlers();
+}
+
 int utf8_main(int argc, char ** argv) {
 	
 	// Initialize Random now so that the crash handler can use it
@@ -197,6 +210,7 @@ int utf8_main(int argc, char ** argv) {
 		}
 		
 		profiler::initialize();
+		ThreadPool::setWorkerHooks(registerPoolWorker, unregisterPoolWorker);
 		
 		// 14: Start the game already!
 		LogInfo << "Starting " << arx_version;
@@ -205,6 +219,7 @@ int utf8_main(int argc, char ** argv) {
 	}
 	
 	benchmark::shutdown();
+	script::logHottestScripts();
 	
 	// Shutdown the logging system
 	// If there has been a critical error, a dialog will be shown now
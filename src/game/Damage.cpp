@@ -438,7 +438,7 @@ static float ARX_DAMAGES_DrainMana(Entity * io, float dmg) {
 void ARX_DAMAGES_DamageFIX(Entity * io, float dmg, EntityHandle source, bool isSpellHit)
 {
 	if(   !io
-	   || !io->show
+	   || !io->show()
 	   || !(io->ioflags & IO_FIX)
 	   || (io->ioflags & IO_INVULNERABILITY)
 	   || !io->script.data
@@ -552,7 +552,7 @@ void ARX_DAMAGES_ForceDeath(Entity * io_dead, Entity * io_killer) {
 
 	ARX_SCRIPT_SetMainEvent(io_dead, "dead");
 
-	if(fartherThan(io_dead->pos, ACTIVECAM->orgTrans.pos, 3200.f)) {
+	if(fartherThan(io_dead->pos(), ACTIVECAM->orgTrans.pos, 3200.f)) {
 		io_dead->animlayer[0].ctime = 9999999;
 		io_dead->animBlend.lastanimtime = 0;
 	}
@@ -607,9 +607,9 @@ void ARX_DAMAGES_ForceDeath(Entity * io_dead, Entity * io_killer) {
 		if(io_dead->_npcdata->weapon) {
 			Entity * ioo = io_dead->_npcdata->weapon;
 			if(ValidIOAddress(ioo)) {
-				ioo->show = SHOW_FLAG_IN_SCENE;
+				ioo->show() = SHOW_FLAG_IN_SCENE;
 				ioo->ioflags |= IO_NO_NPC_COLLIDE;
-				ioo->pos = ioo->obj->vertexlist3[ioo->obj->origin].v;
+				ioo->pos() = ioo->obj->vertexlist3[ioo->obj->origin].v;
 				ioo->velocity = Vec3f(0.f, 13.f, 0.f);
 				ioo->stopped = 0;
 			}
@@ -623,7 +623,7 @@ static void ARX_DAMAGES_PushIO(Entity * io_target, EntityHandle source, float po
 	if(power > 0.f && ValidIONum(source)) {
 		power *= ( 1.0f / 20 );
 		Entity * io = entities[source];
-		Vec3f vect = io_target->pos - io->pos;
+		Vec3f vect = io_target->pos() - io->pos();
 		vect = glm::normalize(vect);
 		vect *= power;
 		arx_assert(isallfinite(vect));
@@ -631,7 +631,7 @@ static void ARX_DAMAGES_PushIO(Entity * io_target, EntityHandle source, float po
 		if(io_target == entities.player()) {
 			PUSH_PLAYER_FORCE = vect; // TODO why not +=?
 		} else {
-			io_target->move += vect;
+			io_target->move() += vect;
 		}
 	}
 }
@@ -735,7 +735,7 @@ float ARX_DAMAGES_DealDamages(EntityHandle target, float dmg, EntityHandle sourc
 float ARX_DAMAGES_DamageNPC(Entity * io, float dmg, EntityHandle source, bool isSpellHit, const Vec3f * pos) {
 	
 	if(   !io
-	   || !io->show
+	   || !io->show()
 	   || !(io->ioflags & IO_NPC)
 	   || (io->ioflags & IO_INVULNERABILITY)
 	) {
@@ -969,7 +969,7 @@ static void ARX_DAMAGES_UpdateDamage(DamageHandle j, float now) {
 		if(damage.params.source == PlayerEntityHandle) {
 			damage.params.pos = player.pos;
 		} else if (ValidIONum(damage.params.source)) {
-			damage.params.pos = entities[damage.params.source]->pos;
+			damage.params.pos = entities[damage.params.source]->pos();
 		}
 	}
 	
@@ -997,8 +997,8 @@ static void ARX_DAMAGES_UpdateDamage(DamageHandle j, float now) {
 		Entity * io = entities[handle];
 		
 		if(io
-		   && (io->gameFlags & GFLAG_ISINTREATZONE)
-		   && (io->show == SHOW_FLAG_IN_SCENE)
+		   && (io->gameFlags() & GFLAG_ISINTREATZONE)
+		   && (io->show() == SHOW_FLAG_IN_SCENE)
 		   && (damage.params.source != handle
 		   || (damage.params.source == handle && !(damage.params.flags & DAMAGE_FLAG_DONT_HURT_SOURCE)))
 		){
@@ -1016,7 +1016,7 @@ static void ARX_DAMAGES_UpdateDamage(DamageHandle j, float now) {
 				sphere.radius = damage.params.radius - 10.f;
 				
 				if(CheckIOInSphere(sphere, *io, true)) {
-					Vec3f sub = io->pos + Vec3f(0.f, -60.f, 0.f);
+					Vec3f sub = io->pos() + Vec3f(0.f, -60.f, 0.f);
 					
 					float dist = fdist(damage.params.pos, sub);
 					
@@ -1218,8 +1218,8 @@ bool ARX_DAMAGES_TryToDoDamage(const Vec3f & pos, float dmg, float radius, Entit
 		Entity * io = entities[handle];
 
 		if(io != NULL
-		   && (entities[handle]->gameFlags & GFLAG_ISINTREATZONE)
-		   && io->show == SHOW_FLAG_IN_SCENE
+		   && (entities[handle]->gameFlags() & GFLAG_ISINTREATZONE)
+		   && io->show() == SHOW_FLAG_IN_SCENE
 		   && source != handle
 		) {
 			float threshold;
@@ -1234,7 +1234,7 @@ bool ARX_DAMAGES_TryToDoDamage(const Vec3f & pos, float dmg, float radius, Entit
 				threshold = 350;
 			}
 
-			if(closerThan(pos, io->pos, threshold) && SphereInIO(io, Sphere(pos, rad))) {
+			if(closerThan(pos, io->pos(), threshold) && SphereInIO(io, Sphere(pos, rad))) {
 				if(io->ioflags & IO_NPC) {
 					if(ValidIONum(source))
 						ARX_EQUIPMENT_ComputeDamages(entities[source], io, 1.f);
@@ -1284,7 +1284,7 @@ void CheckForIgnition(const Sphere & sphere, bool mode, long flag) {
 		Entity * io = entities[handle];
 
 		if(   io
-		   && io->show == SHOW_FLAG_IN_SCENE
+		   && io->show() == SHOW_FLAG_IN_SCENE
 		   && io->obj
 		   && !(io->ioflags & IO_UNDERWATER)
 		   && io->obj->fastaccess.fire != ActionPoint()
@@ -84,13 +84,13 @@ Entity::Entity(const res::path & classPath, EntityInstance instance)
 	
 	ioflags = 0;
 	lastpos = Vec3f_ZERO;
-	pos = Vec3f_ZERO;
-	move = Vec3f_ZERO;
+	pos() = Vec3f_ZERO;
+	move() = Vec3f_ZERO;
 	lastmove = Vec3f_ZERO;
 	forcedmove = Vec3f_ZERO;
 	
 	angle = Anglef::ZERO;
-	physics = IO_PHYSICS();
+	physics() = IO_PHYSICS();
 	room = -1;
 	requestRoomUpdate = 1;
 	original_height = 0.f;
@@ -121,13 +121,13 @@ Entity::Entity(const res::path & classPath, EntityInstance instance)
 	_itemdata = NULL, _fixdata = NULL, _npcdata = NULL, _camdata = NULL;
 	
 	inventory = NULL;
-	show = SHOW_FLAG_IN_SCENE;
+	show() = SHOW_FLAG_IN_SCENE;
 	collision = 0;
 	infracolor = Color3f::blue;
 	changeanim = -1;
 	
 	weight = 1.f;
-	gameFlags = GFLAG_NEEDINIT | GFLAG_INTERACTIVITY;
+	gameFlags() = GFLAG_NEEDINIT | GFLAG_INTERACTIVITY;
 	velocity = Vec3f_ZERO;
 	fall = 0.f;
 	
@@ -303,7 +303,7 @@ void Entity::cleanReferences() {
 	if(!FAST_RELEASE) {
 		TREATZONE_RemoveIO(this);
 	}
-	gameFlags &= ~GFLAG_ISINTREATZONE;
+	gameFlags() &= ~GFLAG_ISINTREATZONE;
 	
 	ARX_INTERACTIVE_DestroyDynamicInfo(this);
 	
@@ -55,6 +55,7 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include "audio/AudioTypes.h"
 #include "game/Damage.h" // TODO needed for DamageType
 #include "game/EntityId.h"
+#include "game/EntityManager.h"
 #include "game/Spells.h" // TODO needed for Spell, Rune, SpellcastFlags
 #include "graphics/Color.h"
 #include "graphics/BaseGraphicsTypes.h"
@@ -233,6 +234,15 @@ enum EntityVisilibity {
 	SHOW_FLAG_DESTROYED    = 255 // Only used in save files
 };
 
+//! Entity state that is read every frame by sweeps over all entities
+struct EntityHotData {
+	EntityVisilibity show; // Show status (in scene, in inventory...)
+	GameFlags gameFlags;
+	Vec3f pos; // IO position
+	Vec3f move;
+	IO_PHYSICS physics; // Movement Collision Data
+};
+
 struct AnimationBlendStatus {
 	bool m_active;
 	unsigned long lastanimtime;
@@ -247,13 +257,10 @@ public:
 	
 	EntityFlags ioflags; // IO type
 	Vec3f lastpos; // IO last position
-	Vec3f pos; // IO position
-	Vec3f move;
 	Vec3f lastmove;
 	Vec3f forcedmove;
 	
 	Anglef angle; // IO angle
-	IO_PHYSICS physics;	// Movement Collision Data
 	short room;
 	bool requestRoomUpdate;
 	float original_height;
@@ -285,7 +292,6 @@ public:
 	};
 	
 	INVENTORY_DATA * inventory; // Inventory Data
-	EntityVisilibity show; // Show status (in scene, in inventory...)
 	IOCollisionFlags collision; // collision type
 	std::string mainevent;
 	Color3f infracolor; // Improve Vision Color (Heat)
@@ -293,7 +299,6 @@ public:
 	
 	float weight;
 	std::string locname; //localisation
-	GameFlags gameFlags;
 	Vec3f velocity; // velocity
 	float fall;
 
@@ -409,6 +414,24 @@ public:
 	//! \return the index of this Entity in the EntityManager
 	EntityHandle index() const { return EntityHandle(m_index); }
 	
+	//! Show status (in scene, in inventory...)
+	EntityVisilibity & show() { return entities.hotData(index()).show; }
+	EntityVisilibity show() const { return entities.hotData(index()).show; }
+	
+	GameFlags & gameFlags() { return entities.hotData(index()).gameFlags; }
+	GameFlags gameFlags() const { return entities.hotData(index()).gameFlags; }
+	
+	//! IO position
+	Vec3f & pos() { return entities.hotData(index()).pos; }
+	const Vec3f & pos() const { return entities.hotData(index()).pos; }
+	
+	Vec3f & move() { return entities.hotData(index()).move; }
+	const Vec3f & move() const { return entities.hotData(index()).move; }
+	
+	//! Movement collision data, including the bounding cylinder
+	IO_PHYSICS & physics() { return entities.hotData(index()).physics; }
+	const IO_PHYSICS & physics() const { return entities.hotData(index()).physics; }
+	
 	/*!
 	 * Marks the entity as destroyed.
 	 * 
@@ -442,6 +465,11 @@ private:
 	
 };
 
+inline EntityHotData & EntityManager::hotData(EntityHandle index) const {
+	size_t i = size_t(index.handleData());
+	return m_hotData[i / HotDataBlockSize][i % HotDataBlockSize];
+}
+
 inline Vec3f actionPointPosition(const EERIE_3DOBJ * obj, ActionPoint ap) {
 	return obj->vertexlist3[ap.handleData()].v;
 }
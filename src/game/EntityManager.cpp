@@ -47,6 +47,7 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include <algorithm>
 
 #include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 
 #include "game/Entity.h"
 #include "platform/Platform.h"
@@ -58,6 +59,9 @@ struct EntityManager::Impl {
 	typedef boost::unordered_map<std::string, Entity *> Index;
 	Index m_index;
 	
+	typedef boost::unordered_set<const Entity *> Addresses;
+	Addresses m_addresses;
+	
 	Impl() : m_minfree(0) { }
 	
 	EntityHandle getById(const std::string & idString) const {
@@ -79,6 +83,10 @@ EntityManager::~EntityManager() {
 	}
 #endif
 	
+	for(size_t i = 0; i < m_hotData.size(); i++) {
+		delete[] m_hotData[i];
+	}
+	
 	delete m_impl;
 	
 }
@@ -87,6 +95,10 @@ void EntityManager::init() {
 	arx_assert(size() == 0);
 	entries.resize(1);
 	entries[0] = NULL;
+	if(generations.empty()) {
+		generations.resize(1, 0);
+	}
+	allocateHotData();
 	m_impl->m_minfree = 0;
 }
 
@@ -135,30 +147,75 @@ Entity * EntityManager::getById(const std::string & name, Entity * self) const {
 	return (index == -1) ? NULL : (index == -2) ? self : entries[index]; 
 }
 
+EntityRef EntityManager::ref(const Entity * entity) const {
+	
+	if(!entity) {
+		return EntityRef();
+	}
+	
+	size_t index = size_t(entity->index().handleData());
+	arx_assert(index < size() && entries[index] == entity);
+	
+	return EntityRef(long(index), generations[index]);
+}
+
+bool EntityManager::contains(const Entity * entity) const {
+	return entity && m_impl->m_addresses.find(entity) != m_impl->m_addresses.end();
+}
+
 size_t EntityManager::add(Entity * entity) {
 	
 	m_impl->m_index[entity->idString()] = entity;
+	m_impl->m_addresses.insert(entity);
 	
-	for(size_t i = m_impl->m_minfree; i < size(); i++) {
-		if(entries[i] == NULL) {
-			entries[i] = entity;
-			m_impl->m_minfree = i + 1;
-			return i;
+	size_t i = m_impl->m_minfree;
+	while(i < size() && entries[i] != NULL) {
+		i++;
+	}
+	
+	if(i == size()) {
+		entries.push_back(entity);
+		if(generations.size() < entries.size()) {
+			generations.resize(entries.size(), 0);
 		}
+	} else {
+		entries[i] = entity;
 	}
 	
-	size_t i = size();
-	entries.push_back(entity);
+	allocateHotData();
+	
 	m_impl->m_minfree = i + 1;
 	return i;
 }
 
+void EntityManager::allocateHotData() {
+	
+	while(m_hotData.size() * HotDataBlockSize < entries.size()) {
+		EntityHotData * block = new EntityHotData[HotDataBlockSize];
+		for(size_t i = 0; i < HotDataBlockSize; i++) {
+			block[i].show = SHOW_FLAG_NOT_DRAWN;
+			block[i].gameFlags = GameFlags();
+		}
+		m_hotData.push_back(block);
+	}
+	
+}
+
 void EntityManager::remove(size_t index) {
 	
 	arx_assert(index < size() && entries[index] != NULL,
 	           "double free or memory corruption detected: index=%lu", (unsigned long)index);
 	
 	m_impl->m_index.erase(entries[index]->idString());
+	m_impl->m_addresses.erase(entries[index]);
+	
+	// Invalidate all references to this entity
+	generations[index]++;
+	
+	// Let sweeps over the hot data skip this index
+	EntityHotData & hot = hotData(EntityHandle(long(index)));
+	hot.show = SHOW_FLAG_NOT_DRAWN;
+	hot.gameFlags = GameFlags();
 	
 	if(index < m_impl->m_minfree) {
 		m_impl->m_minfree = index;
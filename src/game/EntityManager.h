@@ -28,6 +28,7 @@
 #include "game/GameTypes.h"
 
 class Entity;
+struct EntityHotData;
 
 class EntityManager {
 	
@@ -50,10 +51,41 @@ public:
 	
 	Entity * getById(const std::string & idString, Entity * self) const;
 	
+	//! \return a weak reference to an existing entity or an invalid reference for NULL
+	EntityRef ref(const Entity * entity) const;
+	
+	//! \return the referenced entity or NULL if it has been destroyed
+	Entity * get(EntityRef ref) const {
+		size_t index = size_t(ref.index());
+		if(index >= entries.size() || generations[index] != ref.generation()) {
+			return NULL;
+		}
+		return entries[index];
+	}
+	
+	/*!
+	 * Check if an entity address refers to an existing entity.
+	 *
+	 * Prefer storing an \ref EntityRef as addresses can be reused.
+	 */
+	bool contains(const Entity * entity) const;
+	
 	Entity * operator[](EntityHandle index) const {
 		return entries[index.handleData()];
 	}
 	
+	/*!
+	 * Get the per-frame state of the entity at the given index.
+	 *
+	 * This is stored in contiguous blocks so that per-frame loops over all entities
+	 * can skip hidden or inactive ones without touching the Entity objects.
+	 * Unused indices read as \ref SHOW_FLAG_NOT_DRAWN.
+	 *
+	 * Blocks are never moved, so the returned reference stays valid while entities
+	 * are added.
+	 */
+	EntityHotData & hotData(EntityHandle index) const;
+	
 	//! Get the player entity
 	Entity * player() const {
 		return entries[0];
@@ -78,11 +110,23 @@ private:
 	
 	Entries entries;
 	
+	//! Incremented whenever an index is freed - may have more elements than entries
+	std::vector<unsigned long> generations;
+	
+	//! Number of entries in each block of hot entity state
+	static const size_t HotDataBlockSize = 256;
+	
+	//! Hot entity state, indexed like entries - may have more elements than entries
+	std::vector<EntityHotData *> m_hotData;
+	
 	struct Impl;
 	Impl * m_impl;
 	
 	size_t add(Entity * entity);
 	
+	//! Make sure that there is hot entity state for all entries
+	void allocateHotData();
+	
 	void remove(size_t index);
 	
 	friend class Entity;
@@ -592,7 +592,7 @@ float ARX_EQUIPMENT_ComputeDamages(Entity * io_source, Entity * io_target, float
 	float dmgs = damages * backstab;
 	dmgs -= dmgs * absorb * 0.01f;
 	
-	Vec3f pos = io_target->pos;
+	Vec3f pos = io_target->pos();
 	float power = std::min(1.f, dmgs * 0.05f) * 0.1f + 0.9f;
 	
 	ARX_SOUND_PlayCollision(*amat, *wmat, power, 1.f, pos, io_source);
@@ -613,7 +613,7 @@ float ARX_EQUIPMENT_ComputeDamages(Entity * io_source, Entity * io_target, float
 		if(io_target == entities.player()) {
 			
 			// TODO should this be player.pos - player.baseOffset() = player.basePosition()?
-			Vec3f ppos = io_source->pos - (player.pos + player.baseOffset());
+			Vec3f ppos = io_source->pos() - (player.pos + player.baseOffset());
 			ppos = glm::normalize(ppos);
 			
 			// Push the player
@@ -624,13 +624,13 @@ float ARX_EQUIPMENT_ComputeDamages(Entity * io_source, Entity * io_target, float
 			
 		} else {
 			
-			Vec3f ppos = io_source->pos - io_target->pos;
+			Vec3f ppos = io_source->pos() - io_target->pos();
 			ppos = glm::normalize(ppos);
 			
 			// Push the NPC
 			io_target->forcedmove += ppos * -dmgs;
 			
-			Vec3f * pos = position ? position : &io_target->pos;
+			Vec3f * pos = position ? position : &io_target->pos();
 			ARX_DAMAGES_DamageNPC(io_target, dmgs, io_source->index(), false, pos);
 		}
 	}
@@ -707,7 +707,7 @@ bool ARX_EQUIPMENT_Strike_Check(Entity * io_source, Entity * io_weapon, float ra
 					long hitpoint = -1;
 					float curdist = 999999.f;
 					
-					Vec3f vector = (sphere.origin - target->pos) * Vec3f(1.f, 0.5f, 1.f);
+					Vec3f vector = (sphere.origin - target->pos()) * Vec3f(1.f, 0.5f, 1.f);
 					vector = glm::normalize(vector);
 
 					for(size_t ii = 0; ii < target->obj->facelist.size(); ii++) {
@@ -777,9 +777,9 @@ bool ARX_EQUIPMENT_Strike_Check(Entity * io_source, Entity * io_weapon, float ra
 								float power;
 								power = (dmgs * ( 1.0f / 40 )) + 0.7f;
 								Vec3f vect;
-								vect.x = target->obj->vertexlist3[hitpoint].v.x - io_source->pos.x;
+								vect.x = target->obj->vertexlist3[hitpoint].v.x - io_source->pos().x;
 								vect.y = 0;
-								vect.z = target->obj->vertexlist3[hitpoint].v.z - io_source->pos.z;
+								vect.z = target->obj->vertexlist3[hitpoint].v.z - io_source->pos().z;
 								vect = glm::normalize(vect);
 								sp.origin.x = target->obj->vertexlist3[hitpoint].v.x + vect.x * 30.f;
 								sp.origin.y = target->obj->vertexlist3[hitpoint].v.y;
@@ -968,7 +968,7 @@ void ARX_EQUIPMENT_Equip(Entity * target, Entity * toequip)
 		return;
 
 	RemoveFromAllInventories(toequip);
-	toequip->show = SHOW_FLAG_ON_PLAYER; // on player
+	toequip->show() = SHOW_FLAG_ON_PLAYER; // on player
 
 	if(toequip == DRAGINTER)
 		Set_DragInter(NULL);
@@ -29,6 +29,33 @@ ARX_HANDLE_TYPEDEF(long, DamageHandle,  -1)
 
 static const EntityHandle PlayerEntityHandle = EntityHandle(0);
 
+/*!
+ * Weak reference to an entity.
+ *
+ * Unlike raw pointers and \ref EntityHandle, references to destroyed entities can be
+ * detected in constant time even if the memory or index has since been reused.
+ * Use EntityManager::ref() to create and EntityManager::get() to resolve references.
+ */
+class EntityRef {
+	
+	long m_index;
+	unsigned long m_generation;
+	
+public:
+	
+	EntityRef() : m_index(-1), m_generation(0) { }
+	EntityRef(long index, unsigned long generation) : m_index(index), m_generation(generation) { }
+	
+	long index() const { return m_index; }
+	unsigned long generation() const { return m_generation; }
+	
+	bool operator==(const EntityRef & other) const {
+		return m_index == other.m_index && m_generation == other.m_generation;
+	}
+	bool operator!=(const EntityRef & other) const { return !(*this == other); }
+	
+};
+
 struct ResourcePool {
 	float current;
 	float max;
@@ -112,7 +112,7 @@ void ARX_INVENTORY_Declare_InventoryIn(Entity * io) {
 	if(!io)
 		return;
 	
-	io->show = SHOW_FLAG_IN_INVENTORY;
+	io->show() = SHOW_FLAG_IN_INVENTORY;
 	
 	if(io->ignition > 0) {
 		
@@ -184,22 +184,22 @@ void PutInFrontOfPlayer(Entity * io)
 	if(!io)
 		return;
 	
-	io->pos = player.pos;
-	io->pos += angleToVectorXZ(player.angle.getPitch()) * 80.f;
-	io->pos += Vec3f(0.f, 20.f, 0.f);
+	io->pos() = player.pos;
+	io->pos() += angleToVectorXZ(player.angle.getPitch()) * 80.f;
+	io->pos() += Vec3f(0.f, 20.f, 0.f);
 	
 	io->velocity.y = 0.3f;
 	io->velocity.x = 0; 
 	io->velocity.z = 0; 
 	io->angle = Anglef::ZERO;
 	io->stopped = 0;
-	io->show = SHOW_FLAG_IN_SCENE;
+	io->show() = SHOW_FLAG_IN_SCENE;
 
 	if(io->obj && io->obj->pbox) {
 		Vec3f vector = Vec3f(0.f, 100.f, 0.f);
 		io->soundtime = 0;
 		io->soundcount = 0;
-		EERIE_PHYSICS_BOX_Launch(io->obj, io->pos, io->angle, vector);
+		EERIE_PHYSICS_BOX_Launch(io->obj, io->pos(), io->angle, vector);
 	}
 }
 
@@ -925,7 +925,7 @@ Vec3f GetItemWorldPosition(Entity * io) {
 	}
 
 	// Not in scene ?
-	if(io->show != SHOW_FLAG_IN_SCENE) {
+	if(io->show() != SHOW_FLAG_IN_SCENE) {
 		// Is it equiped ?
 		if(IsEquipedByPlayer(io)) {
 			// in player inventory
@@ -958,7 +958,7 @@ Vec3f GetItemWorldPosition(Entity * io) {
 			for(long j = 0; j < id->m_size.y; j++) {
 			for(long k = 0; k < id->m_size.x; k++) {
 				if(id->slot[k][j].io == io) {
-					return ioo->pos;
+					return ioo->pos();
 				}
 			}
 			}
@@ -966,7 +966,7 @@ Vec3f GetItemWorldPosition(Entity * io) {
 	}
 
 	// Default position.
-	return io->pos;
+	return io->pos();
 }
 
 /*!
@@ -980,7 +980,7 @@ Vec3f GetItemWorldPositionSound(const Entity * io) {
 		return ARX_PLAYER_FrontPos();
 	}
 	
-	if(io->show != SHOW_FLAG_IN_SCENE) {
+	if(io->show() != SHOW_FLAG_IN_SCENE) {
 		
 		if(IsEquipedByPlayer(io)) {
 			// in player inventory
@@ -1012,14 +1012,14 @@ Vec3f GetItemWorldPositionSound(const Entity * io) {
 			for(long j = 0; j < id->m_size.y; j++) {
 			for(long k = 0; k < id->m_size.x; k++) {
 				if(id->slot[k][j].io == io) {
-					return ioo->pos;
+					return ioo->pos();
 				}
 			}
 			}
 		}
 	}
 	
-	return io->pos;
+	return io->pos();
 }
 
 /*!
@@ -1155,7 +1155,7 @@ void SendInventoryObjectCommand(const std::string & _lpszText, ScriptMessage _lC
 			   && slot.io->obj->texturecontainer[lTex]
 			   && slot.io->obj->texturecontainer[lTex]->m_texName == _lpszText
 			) {
-				if(slot.io->gameFlags & GFLAG_INTERACTIVITY) {
+				if(slot.io->gameFlags() & GFLAG_INTERACTIVITY) {
 					SendIOScriptEvent(slot.io, _lCommand);
 				}
 				return;
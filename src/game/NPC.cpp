@@ -106,6 +106,7 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include "physics/Physics.h"
 
 #include "platform/Platform.h"
+#include "platform/ThreadPool.h"
 #include "platform/profiler/Profiler.h"
 
 #include "scene/Object.h"
@@ -116,7 +117,7 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 
 #include "script/Script.h"
 
-void CheckNPCEx(Entity * io);
+static void ARX_NPC_DetectPlayer(const std::vector<EntityRef> & npcs);
 
 static const float ARX_NPC_ON_HEAR_MAX_DISTANCE_STEP(600.0F);
 static const float ARX_NPC_ON_HEAR_MAX_DISTANCE_ITEM(800.0F);
@@ -156,7 +157,7 @@ static void CheckHit(Entity * source, float ratioaim) {
 	
 	Vec3f from(0.f, 0.f, -90.f);
 	Vec3f to = VRotateY(from, MAKEANGLE(180.f - source->angle.getPitch()));
-	Vec3f ppos = source->pos + Vec3f(0.f, -80.f, 0.f);
+	Vec3f ppos = source->pos() + Vec3f(0.f, -80.f, 0.f);
 	Vec3f pos = ppos + to;
 
 	float dmg;
@@ -179,13 +180,13 @@ static void CheckHit(Entity * source, float ratioaim) {
 	if(target->ioflags & (IO_MARKER | IO_CAMERA))
 		return;
 
-	if(target->gameFlags & GFLAG_ISINTREATZONE)
-	if(target->show == SHOW_FLAG_IN_SCENE)
+	if(target->gameFlags() & GFLAG_ISINTREATZONE)
+	if(target->show() == SHOW_FLAG_IN_SCENE)
 	if(target->obj)
-	if(target->pos.y > (source->pos.y + source->physics.cyl.height))
-	if(source->pos.y > (target->pos.y + target->physics.cyl.height))
+	if(target->pos().y > (source->pos().y + source->physics().cyl.height))
+	if(source->pos().y > (target->pos().y + target->physics().cyl.height))
 	{
-		float dist_limit = source->_npcdata->reach + source->physics.cyl.radius;
+		float dist_limit = source->_npcdata->reach + source->physics().cyl.radius;
 		long count = 0;
 		float mindist = std::numeric_limits<float>::max();
 
@@ -289,7 +290,7 @@ void ARX_NPC_Revive(Entity * io, bool init)
 
 	if(init) {
 		io->requestRoomUpdate = true;
-		io->pos = io->initpos;
+		io->pos() = io->initpos;
 	}
 	
 	long goretex = -1;
@@ -451,7 +452,7 @@ static long ARX_NPC_GetNextAttainableNodeIncrement(Entity * io) {
 	if(!(io->ioflags & IO_NPC) || (io->_npcdata->behavior & BEHAVIOUR_WANDER_AROUND))
 		return 0;
 
-	float dists = glm::distance2(io->pos, ACTIVECAM->orgTrans.pos);
+	float dists = glm::distance2(io->pos(), ACTIVECAM->orgTrans.pos);
 
 	if (dists > square(ACTIVECAM->cdepth) * square(1.0f / 2))
 		return 0;
@@ -482,19 +483,19 @@ static long ARX_NPC_GetNextAttainableNodeIncrement(Entity * io) {
 		if(tot <= 3.5f)
 			continue;
 
-		io->physics.startpos = io->pos;
+		io->physics().startpos = io->pos();
 		long pos = io->_npcdata->pathfind.list[io->_npcdata->pathfind.listpos+l_try];
-		io->physics.targetpos = ACTIVEBKG->anchors[pos].pos;
+		io->physics().targetpos = ACTIVEBKG->anchors[pos].pos;
 
-		if(glm::abs(io->physics.startpos.y - io->physics.targetpos.y) > 60.f)
+		if(glm::abs(io->physics().startpos.y - io->physics().targetpos.y) > 60.f)
 			continue;
 
-		io->physics.targetpos.y += 60.f; // FAKE Gravity !
-		IO_PHYSICS phys = io->physics;
+		io->physics().targetpos.y += 60.f; // FAKE Gravity !
+		IO_PHYSICS phys = io->physics();
 		phys.cyl = GetIOCyl(io);
 
 		// Now we try the physical move for real
-		if(io->physics.startpos == io->physics.targetpos
+		if(io->physics().startpos == io->physics().targetpos
 		        || ((ARX_COLLISION_Move_Cylinder(&phys, io, 40, CFLAG_JUST_TEST | CFLAG_NPC))))
 		{
 			if(closerThan(phys.cyl.origin, ACTIVEBKG->anchors[pos].pos, 30.f)) {
@@ -554,7 +555,7 @@ bool ARX_NPC_LaunchPathfind(Entity * io, EntityHandle target)
 		return false;
 
 	long MUST_SELECT_Start_Anchor = -1;
-	io->physics.cyl.origin = io->pos;
+	io->physics().cyl.origin = io->pos();
 	EntityHandle old_target = io->targetinfo;
 
 	if(!(io->ioflags & IO_PHYSICAL_OFF)) {
@@ -581,8 +582,8 @@ bool ARX_NPC_LaunchPathfind(Entity * io, EntityHandle target)
 	
 	Vec3f pos1, pos2;
 	if(io->_npcdata->behavior & BEHAVIOUR_WANDER_AROUND) {
-		pos1 = io->pos;
-		pos2 = io->pos + Vec3f(1000.f, 0.f, 1000.f);
+		pos1 = io->pos();
+		pos2 = io->pos() + Vec3f(1000.f, 0.f, 1000.f);
 		goto wander;
 	}
 	
@@ -593,7 +594,7 @@ bool ARX_NPC_LaunchPathfind(Entity * io, EntityHandle target)
 			goto failure;
 
 		io->_npcdata->pathfind.truetarget = target;
-		pos1 = io->pos;
+		pos1 = io->pos();
 		
 		if(io->_npcdata->behavior & BEHAVIOUR_GO_HOME) {
 			pos2 = io->initpos;
@@ -614,14 +615,14 @@ bool ARX_NPC_LaunchPathfind(Entity * io, EntityHandle target)
 
 	EVENT_SENDER = NULL;
 	
-	pos1 = io->pos;
+	pos1 = io->pos();
 	
 	if(io->_npcdata->behavior & BEHAVIOUR_GO_HOME) {
 		pos2 = io->initpos;
 	} else if(ValidIONum(target)) {
-		pos2 = entities[target]->pos;
+		pos2 = entities[target]->pos();
 	} else {
-		pos2 = io->pos;
+		pos2 = io->pos();
 	}
 	
 	io->_npcdata->pathfind.truetarget = target;
@@ -634,13 +635,13 @@ bool ARX_NPC_LaunchPathfind(Entity * io, EntityHandle target)
 	   )
 	{
 		// COLLISION Management START *********************************************************************
-		io->physics.startpos = pos1;
-		io->physics.targetpos = pos2;
-		IO_PHYSICS phys = io->physics;
+		io->physics().startpos = pos1;
+		io->physics().targetpos = pos2;
+		IO_PHYSICS phys = io->physics();
 		phys.cyl = GetIOCyl(io);
 
 		// Now we try the physical move for real
-		if(io->physics.startpos == io->physics.targetpos
+		if(io->physics().startpos == io->physics().targetpos
 		        || ((ARX_COLLISION_Move_Cylinder(&phys, io, 40, CFLAG_JUST_TEST | CFLAG_NPC | CFLAG_NO_HEIGHT_MOD)) ))
 		{
 			if(closerThan(phys.cyl.origin, pos2, 100.f)) {
@@ -663,20 +664,20 @@ wander:
 	{
 		if ((io->_npcdata->behavior & BEHAVIOUR_WANDER_AROUND)
 		        ||	(io->_npcdata->behavior & BEHAVIOUR_FLEE))
-			from = AnchorData_GetNearest(pos1, io->physics.cyl);
+			from = AnchorData_GetNearest(pos1, io->physics().cyl);
 		else
-			from = AnchorData_GetNearest_2(io->angle.getPitch(), pos1, io->physics.cyl);
+			from = AnchorData_GetNearest_2(io->angle.getPitch(), pos1, io->physics().cyl);
 	}
 	else from = MUST_SELECT_Start_Anchor;
 
 	long to;
 
 	if (io->_npcdata->behavior & BEHAVIOUR_FLEE)
-		to = AnchorData_GetNearest(pos2, io->physics.cyl, from);
+		to = AnchorData_GetNearest(pos2, io->physics().cyl, from);
 	else if (io->_npcdata->behavior & BEHAVIOUR_WANDER_AROUND)
 		to = from;
 	else
-		to = AnchorData_GetNearest(pos2, io->physics.cyl);
+		to = AnchorData_GetNearest(pos2, io->physics().cyl);
 
 	if(from != -1 && to != -1) {
 		if(from == to && !(io->_npcdata->behavior & BEHAVIOUR_WANDER_AROUND))
@@ -859,7 +860,7 @@ static void ARX_NPC_ManagePoison(Entity * io) {
  */
 static void CheckUnderWaterIO(Entity * io) {
 	
-	Vec3f ppos = io->pos;
+	Vec3f ppos = io->pos();
 	EERIEPOLY * ep = EEIsUnderWater(ppos);
 
 	if(io->ioflags & IO_UNDERWATER) {
@@ -892,17 +893,26 @@ static void ManageNPCMovement(Entity * io);
 
 extern float MAX_ALLOWED_PER_SECOND;
 
+//! Number of treat zone entries per player detection test in each frame
+static const long NPC_DETECT_SPREAD = 16;
+
 void ARX_PHYSICS_Apply() {
 	
 	ARX_PROFILE_FUNC();
 	
 	static long CURRENT_DETECT = 0;
 
-	CURRENT_DETECT++;
+	// Test more NPCs per frame in crowded areas so that the detection delay stays bounded
+	long detectCount = std::max(1l, TREATZONE_CUR / NPC_DETECT_SPREAD);
+
+	CURRENT_DETECT += detectCount;
 
 	if(CURRENT_DETECT > TREATZONE_CUR)
 		CURRENT_DETECT = 1;
 
+	static std::vector<EntityRef> detect;
+	detect.clear();
+
 	// We don't manage Player(0) this way
 	for(long i = 1; i < TREATZONE_CUR; i++) {
 		ARX_PROFILE(IO);
@@ -917,17 +927,20 @@ void ARX_PHYSICS_Apply() {
 
 		if(!io)
 			continue;
+		
+		// Blocks of hot data never move, so this stays valid while events create entities
+		EntityHotData & hot = entities.hotData(treatio[i].handle);
 
-		if((io->ioflags & IO_NPC) && io->_npcdata->poisonned > 0.f)
+		if((treatio[i].ioflags & IO_NPC) && io->_npcdata->poisonned > 0.f)
 			ARX_NPC_ManagePoison(io);
 
-		if(   (io->ioflags & IO_ITEM)
-		   && (io->gameFlags & GFLAG_GOREEXPLODE)
+		if(   (treatio[i].ioflags & IO_ITEM)
+		   && (hot.gameFlags & GFLAG_GOREEXPLODE)
 		   && arxtime.now_f() - io->animBlend.lastanimtime > 300
 		   && io->obj
 		   && !io->obj->vertexlist.empty()
 		) {
-			arx_assert(io->show != SHOW_FLAG_DESTROYED);
+			arx_assert(hot.show != SHOW_FLAG_DESTROYED);
 			long cnt = (io->obj->vertexlist.size() << 12) + 1;
 
 			cnt = glm::clamp(cnt, 2l, 10l);
@@ -943,13 +956,13 @@ void ARX_PHYSICS_Apply() {
 			continue;
 		}
 
-		EERIEPOLY * ep = CheckInPoly(io->pos);
+		EERIEPOLY * ep = CheckInPoly(hot.pos);
 
 		if(   ep
 		   && (ep->type & POLY_LAVA)
-		   && glm::abs(ep->center.y - io->pos.y) < 40
+		   && glm::abs(ep->center.y - hot.pos.y) < 40
 		) {
-			ARX_PARTICLES_Spawn_Lava_Burn(io->pos, io);
+			ARX_PARTICLES_Spawn_Lava_Burn(hot.pos, io);
 
 			if(io->ioflags & IO_NPC) {
 				const float LAVA_DAMAGE = 10.f;
@@ -961,7 +974,7 @@ void ARX_PHYSICS_Apply() {
 		CheckUnderWaterIO(io);
 		
 		if(io->obj && io->obj->pbox) {
-			io->gameFlags &= ~GFLAG_NOCOMPUTATION;
+			hot.gameFlags &= ~GFLAG_NOCOMPUTATION;
 			
 			PHYSICS_BOX_DATA * pbox = io->obj->pbox;
 			
@@ -979,7 +992,7 @@ void ARX_PHYSICS_Apply() {
 				}
 				
 				io->requestRoomUpdate = true;
-				io->pos = pbox->vert[0].pos;
+				hot.pos = pbox->vert[0].pos;
 				
 				continue;
 			}
@@ -1040,17 +1053,19 @@ void ARX_PHYSICS_Apply() {
 			ManageNPCMovement(io);
 			CheckNPC(io);
 
-			if(CURRENT_DETECT == i)
-				CheckNPCEx(io);
+			if(i >= CURRENT_DETECT && i < CURRENT_DETECT + detectCount)
+				detect.push_back(entities.ref(io));
 		}
 	}
+
+	ARX_NPC_DetectPlayer(detect);
 }
 
 void FaceTarget2(Entity * io)
 {
 	Vec3f tv;
 
-	if(!io->show)
+	if(!io->show())
 		return;
 
 	if(io->ioflags & IO_NPC) {
@@ -1066,7 +1081,7 @@ void FaceTarget2(Entity * io)
 	}
 	
 	GetTargetPos(io);
-	tv = io->pos;
+	tv = io->pos();
 	
 	if(!fartherThan(Vec2f(tv.x, tv.z), Vec2f(io->target.x, io->target.z), 5.f)) {
 		return;
@@ -1093,8 +1108,8 @@ void FaceTarget2(Entity * io)
 		rot = -rot;
 	
 	if(rot != 0) {
-		Vec3f temp = io->move;
-		io->move = VRotateY(temp, rot);
+		Vec3f temp = io->move();
+		io->move() = VRotateY(temp, rot);
 		temp = io->lastmove;
 		io->lastmove = VRotateY(temp, rot);
 	}
@@ -1109,7 +1124,7 @@ void StareAtTarget(Entity * io)
 		ARX_NPC_CreateExRotateData(io);
 	}
 
-	if(!io->show)
+	if(!io->show())
 		return;
 
 	if(io->ioflags & IO_NPC) {
@@ -1124,7 +1139,7 @@ void StareAtTarget(Entity * io)
 		return;
 
 	GetTargetPos(io);
-	Vec3f tv = io->pos;
+	Vec3f tv = io->pos();
 
 	if(glm::distance(tv, io->target) <= 20.f)
 		return; // To fix "stupid" rotation near target
@@ -1199,9 +1214,9 @@ static float GetTRUETargetDist(Entity * io) {
 	
 	if(ValidIONum(t)) {
 		if(io->_npcdata->behavior & BEHAVIOUR_GO_HOME) {
-			return glm::distance(io->pos, io->initpos);
+			return glm::distance(io->pos(), io->initpos);
 		}
-		return glm::distance(io->pos, entities[t]->pos);
+		return glm::distance(io->pos(), entities[t]->pos());
 	}
 	
 	return 99999999.f;
@@ -1460,14 +1475,14 @@ static bool TryIOAnimMove(Entity * io, long animnum) {
 	Vec3f trans = GetAnimTotalTranslate(io->anims[animnum], 0);
 	Vec3f trans2 = VRotateY(trans, MAKEANGLE(180.f - io->angle.getPitch()));
 	
-	IO_PHYSICS phys = io->physics;
+	IO_PHYSICS phys = io->physics();
 	phys.cyl = GetIOCyl(io);
 
-	phys.startpos = io->pos;
-	phys.targetpos = io->pos + trans2;
+	phys.startpos = io->pos();
+	phys.targetpos = io->pos() + trans2;
 	bool res = ARX_COLLISION_Move_Cylinder(&phys, io, 30, CFLAG_JUST_TEST | CFLAG_NPC);
 
-	if(res && glm::abs(phys.cyl.origin.y - io->pos.y) < 20.f)
+	if(res && glm::abs(phys.cyl.origin.y - io->pos().y) < 20.f)
 		return true;
 
 	return false;
@@ -1506,9 +1521,9 @@ static void ARX_NPC_Manage_Anims(Entity * io, float TOLERANCE) {
 	
 	float tdist = std::numeric_limits<float>::max();
 	if(io->_npcdata->pathfind.listnb && ValidIONum(io->_npcdata->pathfind.truetarget)) {
-		tdist = glm::distance2(io->pos, entities[io->_npcdata->pathfind.truetarget]->pos);
+		tdist = glm::distance2(io->pos(), entities[io->_npcdata->pathfind.truetarget]->pos());
 	} else if(ValidIONum(io->targetinfo)) {
-		tdist = glm::distance2(io->pos, entities[io->targetinfo]->pos);
+		tdist = glm::distance2(io->pos(), entities[io->targetinfo]->pos());
 	}
 	
 	if(ValidIOAddress(io->_npcdata->weapon)) {
@@ -1776,7 +1791,7 @@ float GetIOHeight(Entity * io) {
 	
 	if (io == entities.player())
 	{
-		return io->physics.cyl.height; 
+		return io->physics().cyl.height; 
 	}
 
 	float v = (io->original_height * io->scale);
@@ -1797,7 +1812,7 @@ float GetIORadius(Entity * io) {
 }
 
 Cylinder GetIOCyl(Entity * io) {
-	return Cylinder(io->pos, GetIORadius(io), GetIOHeight(io));
+	return Cylinder(io->pos(), GetIORadius(io), GetIOHeight(io));
 }
 
 /*!
@@ -1818,13 +1833,13 @@ static void ComputeTolerance(Entity * io, EntityHandle targ, float * dst) {
 		if(entities[targ]->ioflags & IO_NO_COLLISIONS)
 			targ_dist = 0.f;
 		else
-			targ_dist = std::max(entities[targ]->physics.cyl.radius, GetIORadius(entities[targ])); //entities[targ]->physics.cyl.radius;
+			targ_dist = std::max(entities[targ]->physics().cyl.radius, GetIORadius(entities[targ])); //entities[targ]->physics.cyl.radius;
 
 		// Compute min self close-dist
 		if(io->ioflags & IO_NO_COLLISIONS)
 			self_dist = 0.f;
 		else
-			self_dist = std::max(io->physics.cyl.radius, GetIORadius(io)); //io->physics.cyl.radius;
+			self_dist = std::max(io->physics().cyl.radius, GetIORadius(io)); //io->physics.cyl.radius;
 
 		// Base tolerance = radius added
 		TOLERANCE = targ_dist + self_dist + 5.f;
@@ -1875,7 +1890,7 @@ static void ManageNPCMovement(Entity * io)
 	float TOLERANCE2 = 0.f;
 
 	// Ignores invalid or dead IO
-	if(!io ||!io->show || !(io->ioflags & IO_NPC))
+	if(!io ||!io->show() || !(io->ioflags & IO_NPC))
 		return;
 
 	//	AnchorData_GetNearest_2(io->angle.b,&io->pos,&io->physics.cyl);
@@ -1890,12 +1905,12 @@ static void ManageNPCMovement(Entity * io)
 			aup->_curtime -= 500;
 			ARX_PATHS_Interpolate(aup, &tv);
 			aup->_curtime += 500;
-			io->angle.setPitch(MAKEANGLE(glm::degrees(getAngle(tv.x, tv.z, io->pos.x, io->pos.z))));
+			io->angle.setPitch(MAKEANGLE(glm::degrees(getAngle(tv.x, tv.z, io->pos().x, io->pos().z))));
 		} else {
 			aup->_curtime += 500;
 			ARX_PATHS_Interpolate(aup, &tv);
 			aup->_curtime -= 500;
-			io->angle.setPitch(MAKEANGLE(180.f + glm::degrees(getAngle(tv.x, tv.z, io->pos.x, io->pos.z))));
+			io->angle.setPitch(MAKEANGLE(180.f + glm::degrees(getAngle(tv.x, tv.z, io->pos().x, io->pos().z))));
 		}
 		return;
 	}
@@ -1926,7 +1941,7 @@ static void ManageNPCMovement(Entity * io)
 	   && !(layer0.flags & EA_ANIMEND)
 	) {
 		io->requestRoomUpdate = true;
-		io->lastpos = (io->pos += io->move);
+		io->lastpos = (io->pos() += io->move());
 		return;
 	}
 
@@ -2011,7 +2026,7 @@ static void ManageNPCMovement(Entity * io)
 
 
 	// look around if finished fleeing or being looking around !
-	if((io->_npcdata->behavior & BEHAVIOUR_LOOK_AROUND) && fartherThan(io->pos, io->target, 150.f)) {
+	if((io->_npcdata->behavior & BEHAVIOUR_LOOK_AROUND) && fartherThan(io->pos(), io->target, 150.f)) {
 		if(!io->_npcdata->ex_rotate) {
 			ARX_NPC_CreateExRotateData(io);
 		} else { // already created
@@ -2100,7 +2115,7 @@ static void ManageNPCMovement(Entity * io)
 	{
 
 	// XS : Moved to top of func
-	_dist = glm::distance(Vec2f(io->pos.x, io->pos.z), Vec2f(io->target.x, io->target.z));
+	_dist = glm::distance(Vec2f(io->pos().x, io->pos().z), Vec2f(io->target.x, io->target.z));
 	dis = _dist;
 
 	if(io->_npcdata->pathfind.listnb > 0)
@@ -2256,7 +2271,7 @@ static void ManageNPCMovement(Entity * io)
 	// Try physics from last valid pos to current desired pos...
 	// For this frame we want to try a move from startpos (valid pos)
 	// to targetpos (potentially invalid pos)
-	io->physics.startpos = io->physics.cyl.origin = io->pos;
+	io->physics().startpos = io->physics().cyl.origin = io->pos();
 	
 	if(io->forcedmove == Vec3f_ZERO) {
 		ForcedMove = Vec3f_ZERO;
@@ -2266,30 +2281,30 @@ static void ManageNPCMovement(Entity * io)
 	}
 
 	// Sets Target position to desired position...
-	io->physics.targetpos.x = io->pos.x + io->move.x + ForcedMove.x;
-	io->physics.targetpos.z = io->pos.z + io->move.z + ForcedMove.z;
+	io->physics().targetpos.x = io->pos().x + io->move().x + ForcedMove.x;
+	io->physics().targetpos.z = io->pos().z + io->move().z + ForcedMove.z;
 	// IO_PHYSICS phys;	// XS : Moved to func beginning
-	phys = io->physics;
+	phys = io->physics();
 	phys.cyl = GetIOCyl(io);
 
 	CollisionFlags levitate = 0;
 
 	if(spells.getSpellOnTarget(io->index(), SPELL_LEVITATE)) {
 		levitate = CFLAG_LEVITATE;
-		io->physics.targetpos.y = io->pos.y + io->move.y + ForcedMove.y;
+		io->physics().targetpos.y = io->pos().y + io->move().y + ForcedMove.y;
 	} else { // Gravity 'simulation'
 		phys.cyl.origin.y += 10.f;
 		float anything = CheckAnythingInCylinder(phys.cyl, io, CFLAG_JUST_TEST | CFLAG_NPC);
 
 		if(anything >= 0)
-			io->physics.targetpos.y = io->pos.y + g_framedelay * 1.5f + ForcedMove.y;
+			io->physics().targetpos.y = io->pos().y + g_framedelay * 1.5f + ForcedMove.y;
 		else
-			io->physics.targetpos.y = io->pos.y + ForcedMove.y;
+			io->physics().targetpos.y = io->pos().y + ForcedMove.y;
 
 		phys.cyl.origin.y -= 10.f;
 	}
 
-	phys = io->physics;
+	phys = io->physics();
 	phys.cyl = GetIOCyl(io);
 	
 	io->forcedmove -= ForcedMove;
@@ -2297,7 +2312,7 @@ static void ManageNPCMovement(Entity * io)
 	DIRECT_PATH = true;
 	
 	// Now we try the physical move for real
-	if(io->physics.startpos == io->physics.targetpos
+	if(io->physics().startpos == io->physics().targetpos
 	   || ARX_COLLISION_Move_Cylinder(&phys, io, 40, levitate | CFLAG_NPC)
 	) {
 		// Successfull move now validate it
@@ -2313,12 +2328,12 @@ static void ManageNPCMovement(Entity * io)
 	}
 
 	io->requestRoomUpdate = true;
-	io->physics.cyl.origin = io->pos = phys.cyl.origin;
-	io->physics.cyl.radius = GetIORadius(io);
-	io->physics.cyl.height = GetIOHeight(io);
+	io->physics().cyl.origin = io->pos() = phys.cyl.origin;
+	io->physics().cyl.radius = GetIORadius(io);
+	io->physics().cyl.height = GetIOHeight(io);
 	
 	// Compute distance 2D to target.
-	_dist = glm::distance(Vec2f(io->pos.x, io->pos.z), Vec2f(io->target.x, io->target.z));
+	_dist = glm::distance(Vec2f(io->pos().x, io->pos().z), Vec2f(io->target.x, io->target.z));
 	dis = _dist;
 
 	if(io->_npcdata->pathfind.listnb > 0)
@@ -2353,8 +2368,8 @@ static void ManageNPCMovement(Entity * io)
 	   && !(io->_npcdata->behavior & BEHAVIOUR_FLEE)
 	) {
 		if(ValidIONum(io->_npcdata->pathfind.truetarget)) {
-			Vec3f p = entities[io->_npcdata->pathfind.truetarget]->pos;
-			long t = AnchorData_GetNearest(p, io->physics.cyl);
+			Vec3f p = entities[io->_npcdata->pathfind.truetarget]->pos();
+			long t = AnchorData_GetNearest(p, io->physics().cyl);
 
 			if(t != -1 && t != io->_npcdata->pathfind.list[io->_npcdata->pathfind.listnb - 1]) {
 				float d = glm::distance(ACTIVEBKG->anchors[t].pos, ACTIVEBKG->anchors[io->_npcdata->pathfind.list[io->_npcdata->pathfind.listnb-1]].pos);
@@ -2492,7 +2507,7 @@ static void ManageNPCMovement(Entity * io)
 						io->targetinfo = io->_npcdata->pathfind.truetarget;
 						GetTargetPos(io);
 
-						if(glm::abs(io->pos.y - io->target.y) > 200.f) {
+						if(glm::abs(io->pos().y - io->target.y) > 200.f) {
 							io->_npcdata->pathfind.listnb = -2;
 						}
 					}
@@ -2543,7 +2558,7 @@ static void ManageNPCMovement(Entity * io)
 	}
 	
 	// Now update lastpos values for next call use...
-	io->lastpos = io->pos;
+	io->lastpos = io->pos();
 }
 
 static float AngularDifference(float a1, float a2) {
@@ -2579,7 +2594,7 @@ Entity * ARX_NPC_GetFirstNPCInSight(Entity * ioo)
 		return NULL;
 
 	// Basic Clipping to avoid performance loss
-	if(fartherThan(ACTIVECAM->orgTrans.pos, ioo->pos, 2500)) {
+	if(fartherThan(ACTIVECAM->orgTrans.pos, ioo->pos(), 2500)) {
 		return NULL;
 	}
 
@@ -2594,12 +2609,12 @@ Entity * ARX_NPC_GetFirstNPCInSight(Entity * ioo)
 		   || IsDeadNPC(io)
 		   || io == ioo
 		   || !(io->ioflags & IO_NPC)
-		   || io->show != SHOW_FLAG_IN_SCENE
+		   || io->show() != SHOW_FLAG_IN_SCENE
 		) {
 			continue;
 		}
 
-		float dist_io = glm::distance2(io->pos, ioo->pos);
+		float dist_io = glm::distance2(io->pos(), ioo->pos());
 
 		if(dist_io > found_dist || dist_io > square(1800))
 			continue; // too far
@@ -2621,7 +2636,7 @@ Entity * ARX_NPC_GetFirstNPCInSight(Entity * ioo)
 		long grp = ioo->obj->fastaccess.head_group_origin;
 
 		if(grp < 0) {
-			orgn = ioo->pos + Vec3f(0.f, -90.f, 0.f);
+			orgn = ioo->pos() + Vec3f(0.f, -90.f, 0.f);
 			
 			if(ioo == entities.player())
 				orgn.y = player.pos.y + 90.f;
@@ -2634,7 +2649,7 @@ Entity * ARX_NPC_GetFirstNPCInSight(Entity * ioo)
 		long grp = io->obj->fastaccess.head_group_origin;
 
 		if(grp < 0) {
-			dest = io->pos + Vec3f(0.f, -90.f, 0.f);
+			dest = io->pos() + Vec3f(0.f, -90.f, 0.f);
 			
 			if(io == entities.player())
 				dest.y = player.pos.y + 90.f;
@@ -2687,7 +2702,7 @@ Entity * ARX_NPC_GetFirstNPCInSight(Entity * ioo)
  */
 void CheckNPC(Entity * io)
 {
-	if(!io || (io->show != SHOW_FLAG_IN_SCENE))
+	if(!io || (io->show() != SHOW_FLAG_IN_SCENE))
 		return;
 
 	if(IsDeadNPC(io)) {
@@ -2702,82 +2717,185 @@ void CheckNPC(Entity * io)
 	}
 }
 
+namespace {
+
+//! Player state shared by all detection tests in one frame
+struct PlayerDetectionState {
+	Vec3f basePosition;
+	Vec3f position;
+	long room;
+	float radius;
+	bool exposed; //!< Player is not hidden by darkness or stealth
+};
+
+//! Result of the player detection test for one NPC
+struct NPCDetection {
+	EntityRef ref;
+	Entity * io;
+	bool test; //!< Player is in range and visibility needs to be tested
+	bool visible;
+};
+
 /*!
  * \brief Checks an NPC Visibility Field (Player Detect)
- * Sends appropriate Detectplayer/Undetectplayer events to the IO
- * \param io
+ *
+ * This only reads world state and may be called concurrently for different NPCs.
  *
  * \remarks Uses Invisibility/Confuse/Torch infos.
  * \warning io and io->obj must be valid (no check !)
  */
-void CheckNPCEx(Entity * io) {
+bool IsPlayerVisible(Entity * io, const PlayerDetectionState & state) {
 	
 	ARX_PROFILE_FUNC();
+	
+	float ds = glm::distance2(io->pos(), state.basePosition);
+	
+	float fdist = SP_GetRoomDist(io->pos(), state.position, io->room, state.room);
+	
+	// Use Portal Room Distance for Extra Visibility Clipping.
+	if(state.room > -1 && io->room > -1 && fdist > 2000.f) {
+		return false;
+	}
+	
+	// checks for near contact +/- 15 cm --> force visibility
+	if(ds < square(GetIORadius(io) + state.radius + 15.f)
+	   && glm::abs(state.position.y - io->pos().y) < 200.f) {
+		return true;
+	}
+	
+	// Make full visibility test
+	
+	// Retreives Head group position for "eye" pos.
+	long grp = io->obj->fastaccess.head_group_origin;
+	Vec3f orgn = io->pos() - Vec3f(0.f, (grp < 0) ? 90.f : 120.f, 0.f);
+	Vec3f dest = state.position + Vec3f(0.f, 90.f, 0.f);
+	
+	// Check for Field of vision angle
+	float aa = getAngle(orgn.x, orgn.z, dest.x, dest.z);
+	aa = MAKEANGLE(glm::degrees(aa));
+	float ab = MAKEANGLE(io->angle.getPitch());
+	if(glm::abs(AngularDifference(aa, ab)) >= 110.f) {
+		return false;
+	}
+	
+	// Check for Darkness/Stealth
+	if(!state.exposed && ds >= square(200.f)) {
+		return false;
+	}
+	
+	// Check for Geometrical Visibility
+	Vec3f ppos;
+	return IO_Visible(orgn, dest, &ppos) || closerThan(ppos, dest, 25.f);
+}
 
-	// Distance Between Player and IO
-	float ds = glm::distance2(io->pos, player.basePosition());
+class PlayerDetectionTask : public ThreadPool::Task {
+	
+	const PlayerDetectionState & m_state;
+	std::vector<NPCDetection> & m_npcs;
+	
+public:
+	
+	PlayerDetectionTask(const PlayerDetectionState & state, std::vector<NPCDetection> & npcs)
+		: m_state(state), m_npcs(npcs) { }
 	
-	// Start as not visible
-	long Visible = 0;
+	void run(size_t index) {
+		NPCDetection & npc = m_npcs[index];
+		if(npc.test) {
+			npc.visible = IsPlayerVisible(npc.io, m_state);
+		}
+	}
 	
-	// Check visibility only if player is visible, not too far and not dead
-	if(entities.player()->invisibility <= 0.f && ds < square(2000.f) && player.lifePool.current > 0.f) {
+};
+
+ThreadPool * g_detectionPool = NULL;
+
+} // anonymous namespace
+
+/*!
+ * \brief Checks the player visibility for a set of NPCs
+ *
+ * The visibility tests are independent and run in parallel. Detectplayer and
+ * Undetectplayer events are sent afterwards in the order of the npcs list.
+ */
+static void ARX_NPC_DetectPlayer(const std::vector<EntityRef> & npcs) {
+	
+	ARX_PROFILE_FUNC();
+	
+	static std::vector<NPCDetection> detections;
+	detections.clear();
+	
+	Entity * playerEntity = entities.player();
+	
+	// Check visibility only if player is visible and not dead
+	bool canBeSeen = playerEntity->invisibility <= 0.f && player.lifePool.current > 0.f;
+	
+	PlayerDetectionState state;
+	state.basePosition = player.basePosition();
+	state.position = player.pos;
+	state.room = canBeSeen ? ARX_PORTALS_GetRoomNumForPosition(player.pos, 1) : -1;
+	state.radius = GetIORadius(playerEntity);
+	state.exposed = CURRENT_PLAYER_COLOR > GetPlayerStealth() || player.torch;
+	
+	for(size_t i = 0; i < npcs.size(); i++) {
+		
+		Entity * io = entities.get(npcs[i]);
+		if(!io || !(io->ioflags & IO_NPC) || !io->obj) {
+			continue;
+		}
+		
+		NPCDetection npc;
+		npc.ref = npcs[i];
+		npc.io = io;
+		npc.visible = false;
+		
+		// Check visibility only if player is not too far
+		npc.test = canBeSeen && glm::distance2(io->pos(), state.basePosition) < square(2000.f);
 		
-		// checks for near contact +/- 15 cm --> force visibility
-		if(io->requestRoomUpdate) {
+		// Room updates modify the entity and must be done before the parallel phase
+		if(npc.test && io->requestRoomUpdate) {
 			UpdateIORoom(io);
 		}
 		
-		long playerRoom = ARX_PORTALS_GetRoomNumForPosition(player.pos, 1);
+		if(npc.test || io->_npcdata->detect) {
+			detections.push_back(npc);
+		}
+	}
+	
+	// Think: test visibility in parallel
+	if(detections.size() > 1 && !g_detectionPool) {
+		g_detectionPool = new ThreadPool;
+	}
+	PlayerDetectionTask task(state, detections);
+	ThreadPool::run(detections.size() > 1 ? g_detectionPool : NULL, task, detections.size());
+	
+	// Apply: send events in a deterministic order
+	for(size_t i = 0; i < detections.size(); i++) {
 		
-		float fdist = SP_GetRoomDist(io->pos, player.pos, io->room, playerRoom);
+		bool visible = detections[i].visible;
 		
-		// Use Portal Room Distance for Extra Visibility Clipping.
-		if(playerRoom > -1 && io->room > -1 && fdist > 2000.f) {
-			// nothing to do
-		} else if(ds < square(GetIORadius(io) + GetIORadius(entities.player()) + 15.f)
-		          && glm::abs(player.pos.y - io->pos.y) < 200.f) {
-			Visible = 1;
-		} else { // Make full visibility test
-			
-			// Retreives Head group position for "eye" pos.
-			long grp = io->obj->fastaccess.head_group_origin;
-			Vec3f orgn = io->pos - Vec3f(0.f, (grp < 0) ? 90.f : 120.f, 0.f);
-			Vec3f dest = player.pos + Vec3f(0.f, 90.f, 0.f);
-
-			// Check for Field of vision angle
-			float aa = getAngle(orgn.x, orgn.z, dest.x, dest.z);
-			aa = MAKEANGLE(glm::degrees(aa));
-			float ab = MAKEANGLE(io->angle.getPitch());
-			if(glm::abs(AngularDifference(aa, ab)) < 110.f) {
-				
-				// Check for Darkness/Stealth
-				if(CURRENT_PLAYER_COLOR > GetPlayerStealth() || player.torch
-				   || ds < square(200.f)) {
-					Vec3f ppos;
-					// Check for Geometrical Visibility
-					if(IO_Visible(orgn, dest, &ppos)
-					   || closerThan(ppos, dest, 25.f)) {
-						Visible = 1;
-					}
-				}
-			}
+		// Earlier events may have destroyed the entity
+		Entity * io = entities.get(detections[i].ref);
+		if(!io || !(io->ioflags & IO_NPC)) {
+			continue;
 		}
 		
-		if(Visible && !io->_npcdata->detect) {
+		if(visible && !io->_npcdata->detect) {
 			// if visible but was NOT visible, sends an Detectplayer Event
 			EVENT_SENDER = NULL;
 			SendIOScriptEvent(io, SM_DETECTPLAYER);
 			io->_npcdata->detect = 1;
+		} else if(!visible && io->_npcdata->detect) {
+			// if not visible but was visible, sends an Undetectplayer Event
+			EVENT_SENDER = NULL;
+			SendIOScriptEvent(io, SM_UNDETECTPLAYER);
+			io->_npcdata->detect = 0;
 		}
 	}
-	
-	// if not visible but was visible, sends an Undetectplayer Event
-	if(!Visible && io->_npcdata->detect) {
-		EVENT_SENDER = NULL;
-		SendIOScriptEvent(io, SM_UNDETECTPLAYER);
-		io->_npcdata->detect = 0;
-	}
+}
+
+void ARX_PHYSICS_Release() {
+	delete g_detectionPool;
+	g_detectionPool = NULL;
 }
 
 void ARX_NPC_NeedStepSound(Entity * io, const Vec3f & pos, const float volume, const float power) {
@@ -2840,19 +2958,19 @@ void ARX_NPC_SpawnAudibleSound(const Vec3f & pos, Entity * source, const float f
 		
 		if(   entity
 		   && (entity->ioflags & IO_NPC)
-		   && (entity->gameFlags & GFLAG_ISINTREATZONE)
+		   && (entity->gameFlags() & GFLAG_ISINTREATZONE)
 		   && (entity != source)
-		   && (entity->show == SHOW_FLAG_IN_SCENE || entity->show == SHOW_FLAG_HIDDEN)
+		   && (entity->show() == SHOW_FLAG_IN_SCENE || entity->show() == SHOW_FLAG_HIDDEN)
 		   && (entity->_npcdata->lifePool.current > 0.f)
 		) {
-			float distance = fdist(pos, entity->pos);
+			float distance = fdist(pos, entity->pos());
 
 			if(distance < max_distance) {
 				if(entity->requestRoomUpdate)
 					UpdateIORoom(entity);
 
 				if(Source_Room > -1 && entity->room > -1) {
-					float fdist = SP_GetRoomDist(pos, entity->pos, Source_Room, entity->room);
+					float fdist = SP_GetRoomDist(pos, entity->pos(), Source_Room, entity->room);
 
 					if(fdist < max_distance * 1.5f) {
 						long ldistance = fdist;
@@ -2900,7 +3018,7 @@ void ManageIgnition(Entity * io) {
 		plw = entities[player.equiped[EQUIP_SLOT_WEAPON]];
 	
 	if((io->ioflags & IO_FIERY) && (!(io->type_flags & OBJECT_TYPE_BOW))
-	   && (io->show == SHOW_FLAG_IN_SCENE || io == plw)) {
+	   && (io->show() == SHOW_FLAG_IN_SCENE || io == plw)) {
 		
 		io->ignition = 25.f;
 		
@@ -2913,7 +3031,7 @@ void ManageIgnition(Entity * io) {
 		io->durability -= g_framedelay * ( 1.0f / 10000 );
 		
 		if(io->durability <= 0.f) {
-			ARX_SOUND_PlaySFX(SND_TORCH_END, &io->pos);
+			ARX_SOUND_PlaySFX(SND_TORCH_END, &io->pos());
 			ARX_INTERACTIVE_DestroyIOdelayed(io);
 			return;
 		}
@@ -2953,7 +3071,7 @@ void ManageIgnition_2(Entity * io) {
 			else
 				position = actionPointPosition(io->obj, io->obj->fastaccess.fire);
 		else
-			position = io->pos;
+			position = io->pos();
 
 		if(!lightHandleIsValid(io->ignit_light))
 			io->ignit_light = GetFreeDynLight();
@@ -3002,7 +3120,7 @@ void GetTargetPos(Entity * io, unsigned long smoothing) {
 		arx_assert(npcData);
 		
 		if(npcData->behavior & BEHAVIOUR_NONE) {
-			io->target = io->pos;
+			io->target = io->pos();
 			return;
 		}
 		
@@ -3022,7 +3140,7 @@ void GetTargetPos(Entity * io, unsigned long smoothing) {
 				long pos = npcData->pathfind.list[npcData->pathfind.listpos];
 				io->target = ACTIVEBKG->anchors[pos].pos;
 			} else if(ValidIONum(npcData->pathfind.truetarget)) {
-				io->target = entities[npcData->pathfind.truetarget]->pos;
+				io->target = entities[npcData->pathfind.truetarget]->pos();
 			}
 			return;
 		}
@@ -3031,7 +3149,7 @@ void GetTargetPos(Entity * io, unsigned long smoothing) {
 	if(io->targetinfo == EntityHandle(TARGET_PATH)) {
 		
 		if(!io->usepath) {
-			io->target = io->pos;
+			io->target = io->pos();
 			return;
 		}
 		
@@ -3050,7 +3168,7 @@ void GetTargetPos(Entity * io, unsigned long smoothing) {
 	}
 	
 	if(io->targetinfo == EntityHandle(TARGET_NONE)) {
-		io->target = io->pos;
+		io->target = io->pos();
 		return;
 	}
 	
@@ -3062,5 +3180,5 @@ void GetTargetPos(Entity * io, unsigned long smoothing) {
 		return;
 	}
 	
-	io->target = io->pos;
+	io->target = io->pos();
 }
@@ -257,6 +257,8 @@ void ManageIgnition_2(Entity * io);
 void ARX_NPC_Kill_Spell_Launch(Entity * io);
 
 void ARX_PHYSICS_Apply();
+//! Stop the worker threads used by ARX_PHYSICS_Apply()
+void ARX_PHYSICS_Release();
 
 void GetTargetPos(Entity * io, unsigned long smoothing = 0);
 
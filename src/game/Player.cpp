@@ -298,7 +298,7 @@ void ARX_PLAYER_ClickedOnTorch(Entity * io)
 		ARX_SOUND_PlaySFX(SND_TORCH_LOOP, NULL, 1.0F, ARX_SOUND_PLAY_LOOPED);
 		RemoveFromAllInventories(io);
 		player.torch = io;
-		io->show = SHOW_FLAG_ON_PLAYER;
+		io->show() = SHOW_FLAG_ON_PLAYER;
 
 		if(DRAGINTER == io)
 			DRAGINTER = NULL;
@@ -1355,18 +1355,18 @@ void ARX_PLAYER_Manage_Visual() {
 		player.manaPool.current = std::min(player.manaPool.current, player.Full_maxmana);
 	}
 	
-	io->pos = player.basePosition();
+	io->pos() = player.basePosition();
 	
 	if(player.jumpphase == NotJumping && !LAST_ON_PLATFORM) {
 		float t;
 		EERIEPOLY * ep = CheckInPoly(player.pos, &t);
-		if(ep && io->pos.y > t - 30.f && io->pos.y < t) {
+		if(ep && io->pos().y > t - 30.f && io->pos().y < t) {
 			player.onfirmground = true;
 		}
 	}
 	
 	ComputeVVPos(io);
-	io->pos.y = io->_npcdata->vvpos;
+	io->pos().y = io->_npcdata->vvpos;
 	
 	if(!(player.m_currentMovement & PLAYER_CROUCH) && player.physics.cyl.height > -150.f) {
 		float old = player.physics.cyl.height;
@@ -1383,7 +1383,7 @@ void ARX_PLAYER_Manage_Visual() {
 		io->angle = Anglef(0.f, 180.f - player.angle.getPitch(), 0.f);
 	}
 	
-	io->gameFlags |= GFLAG_ISINTREATZONE;
+	io->gameFlags() |= GFLAG_ISINTREATZONE;
 	
 	AnimLayer & layer0 = io->animlayer[0];
 	AnimLayer & layer1 = io->animlayer[1];
@@ -1401,11 +1401,11 @@ void ARX_PLAYER_Manage_Visual() {
 		if(layer0.flags & EA_ANIMEND) {
 			layer0.flags &= ~EA_FORCEPLAY;
 			layer0.flags |= EA_STATICANIM;
-			io->move = io->lastmove = Vec3f_ZERO;
+			io->move() = io->lastmove = Vec3f_ZERO;
 		} else {
 			layer0.flags &= ~EA_STATICANIM;
-			player.pos = g_moveto = player.pos + io->move;
-			io->pos = player.basePosition();
+			player.pos = g_moveto = player.pos + io->move();
+			io->pos() = player.basePosition();
 			goto nochanges;
 		}
 	}
@@ -1747,7 +1747,7 @@ retry:
 		}
 	}
 	
-	io->physics = player.physics;
+	io->physics() = player.physics;
 	}
 	
 nochanges:
@@ -1797,12 +1797,12 @@ void ForcePlayerLookAtIO(Entity * io) {
 	if(id != ActionPoint()) {
 		target = actionPointPosition(io->obj, id);
 	} else {
-		target = io->pos;
+		target = io->pos();
 	}
 
 	// For the case of not already computed Vlist3... !
-	if(fartherThan(target, io->pos, 400.f)) {
-		target = io->pos;
+	if(fartherThan(target, io->pos(), 400.f)) {
+		target = io->pos();
 	}
 
 	tcam.setTargetCamera(target);
@@ -2551,7 +2551,7 @@ void ARX_PLAYER_AddGold(Entity * gold) {
 	
 	ARX_SOUND_PlayInterface(SND_GOLD);
 	
-	gold->gameFlags &= ~GFLAG_ISINTREATZONE;
+	gold->gameFlags() &= ~GFLAG_ISINTREATZONE;
 	
 	gold->destroy();
 }
@@ -2646,7 +2646,7 @@ void ARX_GAME_Reset(long type) {
 		entities.player()->halo.flags = 0;
 	}
 
-	entities.player()->gameFlags &= ~GFLAG_INVISIBILITY;
+	entities.player()->gameFlags() &= ~GFLAG_INVISIBILITY;
 	
 	ARX_PLAYER_Invulnerability(0);
 	player.m_paralysed = false;
@@ -677,7 +677,7 @@ static EntityHandle TemporaryGetSpellTarget(const Vec3f & from) {
 		Entity * e = entities[handle];
 		
 		if(e && e->ioflags & IO_NPC) {
-			float dist = glm::distance2(from, e->pos);
+			float dist = glm::distance2(from, e->pos());
 			if(dist < mindist) {
 				found = handle;
 				mindist = dist;
@@ -987,16 +987,16 @@ bool ARX_SPELLS_Launch(SpellType typ, EntityHandle source, SpellcastFlags flags,
 			if(!ValidIONum(source))
 				return false;
 
-			Vec3f cpos = entities[source]->pos;
+			Vec3f cpos = entities[source]->pos();
 
 			for(size_t ii = 1 ; ii < entities.size(); ii++) {
 				const EntityHandle handle = EntityHandle(ii);
 				Entity * ioo = entities[handle];
 				
 				if(ioo && (ioo->ioflags & IO_NPC) && ioo->_npcdata->lifePool.current > 0.f
-				   && ioo->show == SHOW_FLAG_IN_SCENE
+				   && ioo->show() == SHOW_FLAG_IN_SCENE
 				   && ioo->groups.find("demon") != ioo->groups.end()
-				   && closerThan(ioo->pos, cpos, 900.f)) {
+				   && closerThan(ioo->pos(), cpos, 900.f)) {
 					tcount++;
 				}
 			}
@@ -1033,14 +1033,14 @@ bool ARX_SPELLS_Launch(SpellType typ, EntityHandle source, SpellcastFlags flags,
 		return false;
 	
 	if(ValidIONum(source) && spellicons[typ].bAudibleAtStart) {
-		ARX_NPC_SpawnAudibleSound(entities[source]->pos, entities[source]);
+		ARX_NPC_SpawnAudibleSound(entities[source]->pos(), entities[source]);
 	}
 	
 	spell->m_caster = source; // Caster...
 	spell->m_target = target;
 	
 	if(target == EntityHandle())
-		spell->m_target = TemporaryGetSpellTarget(entities[spell->m_caster]->pos);
+		spell->m_target = TemporaryGetSpellTarget(entities[spell->m_caster]->pos());
 	
 	spell->updateCasterHand();
 	spell->updateCasterPosition();
@@ -1179,7 +1179,7 @@ void TryToCastSpell(Entity * io, SpellType spellType, long level, EntityHandle t
 	io->spellcast_data.duration = duration;
 	io->spellcast_data.target = target;
 	
-	io->gameFlags &=~GFLAG_INVISIBILITY;
+	io->gameFlags() &=~GFLAG_INVISIBILITY;
 	
 	if (	((io->spellcast_data.spell_flags & SPELLCAST_FLAG_NOANIM)
 		&&	(io->spellcast_data.spell_flags & SPELLCAST_FLAG_NODRAW) )
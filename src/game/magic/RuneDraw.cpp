@@ -124,9 +124,9 @@ void ARX_SPELLS_UpdateSymbolDraw() {
 					float speedFactor = std::max(io->speed_modif + io->basespeed, 0.01f);
 					float duration = (1000 - (io->spellcast_data.spell_level * 60)) * speedFactor;
 					ARX_SPELLS_RequestSymbolDraw2(io, symb, duration);
-					io->gameFlags &= ~GFLAG_INVISIBILITY;
+					io->gameFlags() &= ~GFLAG_INVISIBILITY;
 				} else if(tst) { // cast spell !!!
-					io->gameFlags &= ~GFLAG_INVISIBILITY;
+					io->gameFlags() &= ~GFLAG_INVISIBILITY;
 					
 					ARX_SPELLS_Launch(io->spellcast_data.castingspell,
 					                  handle,
@@ -150,7 +150,7 @@ void ARX_SPELLS_UpdateSymbolDraw() {
 			if(lightHandleIsValid(io->dynlight)) {
 				EERIE_LIGHT * light = lightHandleGet(io->dynlight);
 				
-				light->pos = io->pos;
+				light->pos = io->pos();
 				light->pos += angleToVectorXZ(io->angle.getPitch() - 45.f) * 60.f;
 				light->pos += Vec3f(0.f, -120.f, 0.f);
 				
@@ -310,14 +310,14 @@ static void ARX_SPELLS_RequestSymbolDrawCommon(Entity * io, float duration,
 	
 	float tmpAngle = io->angle.getPitch() - 45.0F + info.startOffset.x * 2;
 	
-	sd->lastpos = io->pos;
+	sd->lastpos = io->pos();
 	sd->lastpos += angleToVectorXZ(tmpAngle) * 60.f;
 	sd->lastpos += Vec3f(0.f, -120.0f, 0.f);
 	sd->lastpos += Vec3f(0.f, -info.startOffset.y * 5, 0.f);
 	
 	sd->cPosStart = info.startOffset;
 
-	io->gameFlags &= ~GFLAG_INVISIBILITY;
+	io->gameFlags() &= ~GFLAG_INVISIBILITY;
 }
 	
 
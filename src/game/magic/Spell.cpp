@@ -45,7 +45,7 @@ Vec3f SpellBase::getPosition() {
 
 Vec3f SpellBase::getCasterPosition() {
 	if(ValidIONum(m_caster)) {
-		return entities[m_caster]->pos;
+		return entities[m_caster]->pos();
 	} else {
 		// should not happen
 		return Vec3f_ZERO;
@@ -54,7 +54,7 @@ Vec3f SpellBase::getCasterPosition() {
 
 Vec3f SpellBase::getTargetPosition() {
 	if(ValidIONum(m_target)) {
-		return entities[m_target]->pos;
+		return entities[m_target]->pos();
 	} else {
 		// should not happen
 		return Vec3f_ZERO;
@@ -80,7 +80,7 @@ void SpellBase::updateCasterPosition() {
 	if(m_caster == PlayerEntityHandle) {
 		m_caster_pos = player.pos;
 	} else {
-		m_caster_pos = entities[m_caster]->pos;
+		m_caster_pos = entities[m_caster]->pos();
 	}
 }
 
@@ -96,7 +96,7 @@ Vec3f SpellBase::getTargetPos(EntityHandle source, EntityHandle target)
 			targetPos.y += std::sin(glm::radians(player.angle.getYaw())) * 60.f;
 		} else {
 			// TODO entities[target] with target < 0 ??? - uh oh!
-			targetPos = entities[target]->pos;
+			targetPos = entities[target]->pos();
 			targetPos += angleToVectorXZ(entities[target]->angle.getPitch()) * 60.f;
 			targetPos += Vec3f(0.f, -120.f, 0.f);
 		}
@@ -105,7 +105,7 @@ Vec3f SpellBase::getTargetPos(EntityHandle source, EntityHandle target)
 		targetPos = player.pos;
 	} else {
 		// IO target
-		targetPos = entities[target]->pos;
+		targetPos = entities[target]->pos();
 	}
 	
 	return targetPos;
@@ -65,7 +65,7 @@ void MagicSightSpell::End()
 		player.m_improve = false;
 		ARX_SOUND_Stop(m_snd_loop);
 	}
-	ARX_SOUND_PlaySFX(SND_SPELL_VISION_START, &entities[m_caster]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_VISION_START, &entities[m_caster]->pos());
 }
 
 void MagicSightSpell::Update() {
@@ -143,7 +143,8 @@ static void LaunchMagicMissileExplosion(const Vec3f & _ePos, bool mrCheat) {
 		cp = MagicMissileExplosionMrCheatParticle();
 	}
 	
-	ParticleSystem * pPS = new ParticleSystem();
+	arx_assert(pParticleManager);
+	ParticleSystem * pPS = pParticleManager->NewSystem();
 	pPS->SetParams(cp);
 	pPS->SetPos(_ePos);
 	pPS->Update(0);
@@ -167,7 +168,6 @@ static void LaunchMagicMissileExplosion(const Vec3f & _ePos, bool mrCheat) {
 		light->duration = 1500;
 	}
 
-	arx_assert(pParticleManager);
 	pParticleManager->AddSystem(pPS);
 
 	ARX_SOUND_PlaySFX(SND_SPELL_MM_HIT, &_ePos);
@@ -226,7 +226,7 @@ void MagicMissileSpell::Launch() {
 		if(m_hand_group != ActionPoint()) {
 			startPos = m_hand_pos;
 		} else {
-			startPos = entities[m_caster]->pos;
+			startPos = entities[m_caster]->pos();
 		}
 		
 		startPos += vector;
@@ -235,11 +235,11 @@ void MagicMissileSpell::Launch() {
 		
 		if(ValidIONum(io->targetinfo)) {
 			const Vec3f & p1 = m_caster_pos;
-			const Vec3f & p2 = entities[io->targetinfo]->pos;
+			const Vec3f & p2 = entities[io->targetinfo]->pos();
 			afAlpha = -(glm::degrees(getAngle(p1.y, p1.z, p2.y, p2.z + glm::distance(Vec2f(p2.x, p2.z), Vec2f(p1.x, p1.z))))); //alpha entre orgn et dest;
 		} else if (ValidIONum(m_target)) {
 			const Vec3f & p1 = m_caster_pos;
-			const Vec3f & p2 = entities[m_target]->pos;
+			const Vec3f & p2 = entities[m_target]->pos();
 			afAlpha = -(glm::degrees(getAngle(p1.y, p1.z, p2.y, p2.z + glm::distance(Vec2f(p2.x, p2.z), Vec2f(p1.x, p1.z))))); //alpha entre orgn et dest;
 		}
 	}
@@ -61,7 +61,7 @@ void HealSpell::Launch()
 	if(m_caster == PlayerEntityHandle) {
 		m_pos = player.pos;
 	} else {
-		m_pos = entities[m_caster]->pos;
+		m_pos = entities[m_caster]->pos();
 	}
 	
 	m_particles.SetPos(m_pos);
@@ -121,7 +121,7 @@ void HealSpell::Update() {
 	if(m_caster == PlayerEntityHandle) {
 		m_pos = player.pos;
 	} else if(ValidIONum(m_target)) {
-		m_pos = entities[m_target]->pos;
+		m_pos = entities[m_target]->pos();
 	}
 	
 	if(!lightHandleIsValid(m_light))
@@ -145,10 +145,8 @@ void HealSpell::Update() {
 		m_particles.m_parameters.m_spawnFlags = PARTICLE_CIRCULAR;
 		m_particles.m_parameters.m_gravity = Vec3f_ZERO;
 
-		std::list<Particle *>::iterator i;
-
-		for(i = m_particles.listParticle.begin(); i != m_particles.listParticle.end(); ++i) {
-			Particle * pP = *i;
+		for(size_t i = 0; i < m_particles.m_particles.size(); i++) {
+			Particle * pP = &m_particles.m_particles[i];
 
 			if(pP->isAlive()) {
 				pP->fColorEnd.a = 0;
@@ -169,8 +167,8 @@ void HealSpell::Update() {
 		Entity * e = entities[handle];
 		
 		if ((e)
-			&& (e->show==SHOW_FLAG_IN_SCENE) 
-			&& (e->gameFlags & GFLAG_ISINTREATZONE)
+			&& (e->show()==SHOW_FLAG_IN_SCENE) 
+			&& (e->gameFlags() & GFLAG_ISINTREATZONE)
 			&& (e->ioflags & IO_NPC)
 			&& (e->_npcdata->lifePool.current>0.f)
 			)
@@ -180,7 +178,7 @@ void HealSpell::Update() {
 			if(handle == m_caster)
 				dist=0;
 			else
-				dist=fdist(m_pos, e->pos);
+				dist=fdist(m_pos, e->pos());
 
 			if(dist<300.f) {
 				float gain = Random::getf(0.8f, 2.4f) * m_level * (300.f - dist) * (1.0f/300) * g_framedelay * (1.0f/1000);
@@ -245,10 +243,10 @@ void ArmorSpell::Launch()
 	}
 	
 	if(!(m_flags & SPELLCAST_FLAG_NOSOUND)) {
-		ARX_SOUND_PlaySFX(SND_SPELL_ARMOR_START, &entities[m_target]->pos);
+		ARX_SOUND_PlaySFX(SND_SPELL_ARMOR_START, &entities[m_target]->pos());
 	}
 	
-	m_snd_loop = ARX_SOUND_PlaySFX(SND_SPELL_ARMOR_LOOP, &entities[m_target]->pos, 1.f, ARX_SOUND_PLAY_LOOPED);
+	m_snd_loop = ARX_SOUND_PlaySFX(SND_SPELL_ARMOR_LOOP, &entities[m_target]->pos(), 1.f, ARX_SOUND_PLAY_LOOPED);
 	
 	m_duration = (m_launchDuration > -1) ? m_launchDuration : 20000;
 	
@@ -271,7 +269,7 @@ void ArmorSpell::Launch()
 void ArmorSpell::End()
 {
 	ARX_SOUND_Stop(m_snd_loop);
-	ARX_SOUND_PlaySFX(SND_SPELL_ARMOR_END, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_ARMOR_END, &entities[m_target]->pos());
 	
 	if(ValidIONum(m_target)) {
 		ARX_HALO_SetToNative(entities[m_target]);
@@ -289,7 +287,7 @@ void ArmorSpell::Update() {
 		io->halo.radius = 45.f;
 	}
 	
-	ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos);
+	ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos());
 }
 
 Vec3f ArmorSpell::getPosition() {
@@ -310,7 +308,7 @@ void LowerArmorSpell::Launch()
 	spells.endByCaster(m_caster, SPELL_COLD_PROTECTION);
 	
 	if(!(m_flags & SPELLCAST_FLAG_NOSOUND)) {
-		ARX_SOUND_PlaySFX(SND_SPELL_LOWER_ARMOR, &entities[m_target]->pos);
+		ARX_SOUND_PlaySFX(SND_SPELL_LOWER_ARMOR, &entities[m_target]->pos());
 	}
 	
 	m_duration = (m_launchDuration > -1) ? m_launchDuration : 20000;
@@ -365,7 +363,7 @@ void LowerArmorSpell::Update() {
 		}
 	}
 	
-	ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos);
+	ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos());
 }
 
 Vec3f LowerArmorSpell::getPosition() {
@@ -435,7 +433,7 @@ void HarmSpell::Update()
 	if(m_caster == PlayerEntityHandle)
 		scaley = 90.f;
 	else
-		scaley = glm::abs(entities[m_caster]->physics.cyl.height * (1.0f/2)) + 30.f;
+		scaley = glm::abs(entities[m_caster]->physics().cyl.height * (1.0f/2)) + 30.f;
 	
 	const float frametime = float(arxtime.get_frame_time());
 	
@@ -448,10 +446,10 @@ void HarmSpell::Update()
 		cabalpos.z = player.pos.z;
 		refpos = player.pos.y + 60.f;
 	} else {
-		cabalpos.x = entities[m_caster]->pos.x;
-		cabalpos.y = entities[m_caster]->pos.y - scaley - mov;
-		cabalpos.z = entities[m_caster]->pos.z;
-		refpos = entities[m_caster]->pos.y - scaley;
+		cabalpos.x = entities[m_caster]->pos().x;
+		cabalpos.y = entities[m_caster]->pos().y - scaley - mov;
+		cabalpos.z = entities[m_caster]->pos().z;
+		refpos = entities[m_caster]->pos().y - scaley;
 	}
 	
 	float Es = std::sin(frametime * (1.0f/800) + glm::radians(scaley));
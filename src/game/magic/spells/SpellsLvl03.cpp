@@ -53,10 +53,10 @@ void SpeedSpell::Launch()
 		m_target = m_caster;
 	}
 	
-	ARX_SOUND_PlaySFX(SND_SPELL_SPEED_START, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_SPEED_START, &entities[m_target]->pos());
 	
 	if(m_target == PlayerEntityHandle) {
-		m_snd_loop = ARX_SOUND_PlaySFX(SND_SPELL_SPEED_LOOP, &entities[m_target]->pos, 1.f, ARX_SOUND_PLAY_LOOPED);
+		m_snd_loop = ARX_SOUND_PlaySFX(SND_SPELL_SPEED_LOOP, &entities[m_target]->pos(), 1.f, ARX_SOUND_PLAY_LOOPED);
 	}
 	
 	m_duration = (m_launchDuration > -1) ? m_launchDuration : 20000;
@@ -96,7 +96,7 @@ void SpeedSpell::End() {
 	if(m_caster == PlayerEntityHandle)
 		ARX_SOUND_Stop(m_snd_loop);
 	
-	ARX_SOUND_PlaySFX(SND_SPELL_SPEED_END, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_SPEED_END, &entities[m_target]->pos());
 	
 	for(size_t i = 0; i < m_trails.size(); i++) {
 		delete m_trails[i].trail;
@@ -107,7 +107,7 @@ void SpeedSpell::End() {
 void SpeedSpell::Update() {
 	
 	if(m_caster == PlayerEntityHandle)
-		ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos);
+		ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos());
 	
 	for(size_t i = 0; i < m_trails.size(); i++) {
 		Vec3f pos = entities[m_target]->obj->vertexlist3[m_trails[i].vertexIndex].v;
@@ -145,8 +145,8 @@ void DispellIllusionSpell::Launch()
 		
 		if(spell->m_type == SPELL_INVISIBILITY) {
 			if(ValidIONum(spell->m_target) && ValidIONum(m_caster)) {
-				if(closerThan(entities[spell->m_target]->pos,
-				   entities[m_caster]->pos, 1000.f)) {
+				if(closerThan(entities[spell->m_target]->pos(),
+				   entities[m_caster]->pos(), 1000.f)) {
 					spells.endSpell(spell);
 				}
 			}
@@ -199,7 +199,7 @@ void FireballSpell::Launch() {
 		anglea = player.angle.getYaw(), angleb = player.angle.getPitch();
 	} else {
 		
-		Vec3f start = entities[m_caster]->pos;
+		Vec3f start = entities[m_caster]->pos();
 		if(ValidIONum(m_caster)
 		   && (entities[m_caster]->ioflags & IO_NPC)) {
 			start.y -= 80.f;
@@ -207,7 +207,7 @@ void FireballSpell::Launch() {
 		
 		Entity * _io = entities[m_caster];
 		if(ValidIONum(_io->targetinfo)) {
-			const Vec3f & end = entities[_io->targetinfo]->pos;
+			const Vec3f & end = entities[_io->targetinfo]->pos();
 			float d = glm::distance(Vec2f(end.x, end.z), Vec2f(start.x, start.z));
 			anglea = glm::degrees(getAngle(start.y, start.z, end.y, end.z + d));
 		}
@@ -255,7 +255,7 @@ void FireballSpell::Update() {
 		} else {
 			afBeta = entities[m_caster]->angle.getPitch();
 			
-			eCurPos = entities[m_caster]->pos;
+			eCurPos = entities[m_caster]->pos();
 			eCurPos += angleToVectorXZ(afBeta) * 60.f;
 			
 			if(ValidIONum(m_caster) && (entities[m_caster]->ioflags & IO_NPC)) {
@@ -268,7 +268,7 @@ void FireballSpell::Update() {
 
 			if(ValidIONum(io->targetinfo)) {
 				Vec3f * p1 = &eCurPos;
-				Vec3f p2 = entities[io->targetinfo]->pos;
+				Vec3f p2 = entities[io->targetinfo]->pos();
 				p2.y -= 60.f;
 				afAlpha = 360.f - (glm::degrees(getAngle(p1->y, p1->z, p2.y, p2.z + glm::distance(Vec2f(p2.x, p2.z), Vec2f(p1->x, p1->z))))); //alpha entre orgn et dest;
 			}
@@ -395,7 +395,7 @@ void CreateFoodSpell::Update() {
 	
 	m_currentTime += g_framedelay;
 	
-	m_pos = entities.player()->pos;
+	m_pos = entities.player()->pos();
 	
 	long ff = m_duration - m_currentTime;
 	
@@ -403,10 +403,8 @@ void CreateFoodSpell::Update() {
 		m_particles.m_parameters.m_spawnFlags = PARTICLE_CIRCULAR;
 		m_particles.m_parameters.m_gravity = Vec3f_ZERO;
 		
-		std::list<Particle *>::iterator i;
-		
-		for(i = m_particles.listParticle.begin(); i != m_particles.listParticle.end(); ++i) {
-			Particle * pP = *i;
+		for(size_t i = 0; i < m_particles.m_particles.size(); i++) {
+			Particle * pP = &m_particles.m_particles[i];
 			
 			if(pP->isAlive()) {
 				pP->fColorEnd.a = 0;
@@ -437,7 +435,7 @@ void IceProjectileSpell::Launch()
 		target = player.pos + Vec3f(0.f, 160.f, 0.f);
 		angleb = player.angle.getPitch();
 	} else {
-		target = entities[m_caster]->pos;
+		target = entities[m_caster]->pos();
 		angleb = entities[m_caster]->angle.getPitch();
 	}
 	target += angleToVectorXZ(angleb) * 150.0f;
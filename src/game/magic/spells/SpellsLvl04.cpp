@@ -58,7 +58,7 @@ void BlessSpell::Launch()
 	m_hasDuration = true;
 	m_fManaCostPerSecond = 0.3333f * m_level;
 	
-	m_pos = entities[m_caster]->pos;
+	m_pos = entities[m_caster]->pos();
 	
 	m_yaw = 0.f;
 	m_scale = 0.f;
@@ -80,7 +80,7 @@ void BlessSpell::Update() {
 	fRot += g_framedelay * 0.25f;
 	
 	if(ValidIONum(m_target)) {
-		m_pos = entities[m_target]->pos;
+		m_pos = entities[m_target]->pos();
 		
 		if(m_target == PlayerEntityHandle)
 			m_yaw = player.angle.getPitch();
@@ -197,7 +197,7 @@ void DispellFieldSpell::Launch()
 		}
 		
 		Entity * caster = entities[m_caster];
-		if(cancel && closerThan(pos, caster->pos, 400.f)) {
+		if(cancel && closerThan(pos, caster->pos(), 400.f)) {
 			valid++;
 			if(spell->m_level <= m_level) {
 				spells.endSpell(spell);
@@ -236,7 +236,7 @@ void FireProtectionSpell::Launch()
 		m_target = PlayerEntityHandle;
 	}
 	
-	ARX_SOUND_PlaySFX(SND_SPELL_FIRE_PROTECTION, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_FIRE_PROTECTION, &entities[m_target]->pos());
 	
 	m_hasDuration = true;
 	m_fManaCostPerSecond = 1.f;
@@ -250,13 +250,13 @@ void FireProtectionSpell::Launch()
 	
 	m_targets.push_back(m_target);
 	
-	m_snd_loop = ARX_SOUND_PlaySFX(SND_SPELL_FIRE_PROTECTION_LOOP, &entities[m_target]->pos, 1.f, ARX_SOUND_PLAY_LOOPED);
+	m_snd_loop = ARX_SOUND_PlaySFX(SND_SPELL_FIRE_PROTECTION_LOOP, &entities[m_target]->pos(), 1.f, ARX_SOUND_PLAY_LOOPED);
 }
 
 void FireProtectionSpell::End()
 {
 	ARX_SOUND_Stop(m_snd_loop);
-	ARX_SOUND_PlaySFX(SND_SPELL_FIRE_PROTECTION_END, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_FIRE_PROTECTION_END, &entities[m_target]->pos());
 	m_targets.clear();
 	
 	if(ValidIONum(m_target))
@@ -272,7 +272,7 @@ void FireProtectionSpell::Update() {
 		io->halo.radius = 45.f;
 	}
 	
-	ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos);
+	ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos());
 }
 
 Vec3f FireProtectionSpell::getPosition() {
@@ -290,7 +290,7 @@ void ColdProtectionSpell::Launch()
 		m_target = PlayerEntityHandle;
 	}
 	
-	ARX_SOUND_PlaySFX(SND_SPELL_COLD_PROTECTION_START, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_COLD_PROTECTION_START, &entities[m_target]->pos());
 	
 	m_duration = (m_launchDuration > -1) ? m_launchDuration : 20000;
 	
@@ -307,7 +307,7 @@ void ColdProtectionSpell::Launch()
 		io->halo.radius = 45.f;
 	}
 	
-	m_snd_loop = ARX_SOUND_PlaySFX(SND_SPELL_COLD_PROTECTION_LOOP, &entities[m_target]->pos, 1.f, ARX_SOUND_PLAY_LOOPED);
+	m_snd_loop = ARX_SOUND_PlaySFX(SND_SPELL_COLD_PROTECTION_LOOP, &entities[m_target]->pos(), 1.f, ARX_SOUND_PLAY_LOOPED);
 	
 	m_targets.push_back(m_target);
 }
@@ -315,7 +315,7 @@ void ColdProtectionSpell::Launch()
 void ColdProtectionSpell::End()
 {
 	ARX_SOUND_Stop(m_snd_loop);
-	ARX_SOUND_PlaySFX(SND_SPELL_COLD_PROTECTION_END, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_COLD_PROTECTION_END, &entities[m_target]->pos());
 	m_targets.clear();
 	
 	if(ValidIONum(m_target))
@@ -331,7 +331,7 @@ void ColdProtectionSpell::Update() {
 		io->halo.radius = 45.f;
 	}
 	
-	ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos);
+	ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos());
 }
 
 Vec3f ColdProtectionSpell::getPosition() {
@@ -361,7 +361,7 @@ void TelekinesisSpell::End()
 	if(m_caster == PlayerEntityHandle)
 		player.m_telekinesis = false;
 	
-	ARX_SOUND_PlaySFX(SND_SPELL_TELEKINESIS_END, &entities[m_caster]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_TELEKINESIS_END, &entities[m_caster]->pos());
 }
 
 
@@ -376,7 +376,7 @@ void CurseSpell::Launch()
 {
 	spells.endByCaster(m_target, SPELL_CURSE);
 	
-	ARX_SOUND_PlaySFX(SND_SPELL_CURSE, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_CURSE, &entities[m_target]->pos());
 	
 	m_duration = (m_launchDuration > -1) ? m_launchDuration : 2000000;
 	m_hasDuration = true;
@@ -386,7 +386,7 @@ void CurseSpell::Launch()
 	if(m_target == PlayerEntityHandle) {
 		target.y -= 200.f;
 	} else if(ValidIONum(m_target)) {
-		target.y += entities[m_target]->physics.cyl.height - 50.f;
+		target.y += entities[m_target]->physics().cyl.height - 50.f;
 	}
 	
 	m_pos = target;
@@ -407,12 +407,12 @@ void CurseSpell::Update() {
 	
 	Vec3f target = Vec3f_ZERO;
 	if(ValidIONum(m_target)) {
-		target = entities[m_target]->pos;
+		target = entities[m_target]->pos();
 
 		if(m_target == PlayerEntityHandle)
 			target.y -= 200.f;
 		else
-			target.y += entities[m_target]->physics.cyl.height - 30.f;
+			target.y += entities[m_target]->physics().cyl.height - 30.f;
 	}
 	m_pos = target;
 	
@@ -53,7 +53,7 @@ void RuneOfGuardingSpell::Launch()
 	
 	m_duration = (m_launchDuration > -1) ? m_launchDuration : 99999999;
 	
-	m_pos = entities[m_caster]->pos;
+	m_pos = entities[m_caster]->pos();
 	
 	tex_p2 = TextureContainer::Load("graph/obj3d/textures/(fx)_tsu_blueting");
 	
@@ -171,7 +171,7 @@ void LevitateSpell::Launch()
 		m_target = PlayerEntityHandle;
 	}
 	
-	ARX_SOUND_PlaySFX(SND_SPELL_LEVITATE_START, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_LEVITATE_START, &entities[m_target]->pos());
 	
 	m_duration = (m_launchDuration > -1) ? m_launchDuration : 2000000000;
 	m_hasDuration = true;
@@ -183,7 +183,7 @@ void LevitateSpell::Launch()
 		m_duration = 200000000;
 		player.levitate = true;
 	} else {
-		target = entities[m_target]->pos;
+		target = entities[m_target]->pos();
 	}
 	
 	m_pos = target;
@@ -195,7 +195,7 @@ void LevitateSpell::Launch()
 	cone2.Init(m_baseRadius, rhaut * 1.5f, hauteur * 0.5f);
 	m_stones.Init(m_baseRadius);
 	
-	m_snd_loop = ARX_SOUND_PlaySFX(SND_SPELL_LEVITATE_LOOP, &entities[m_target]->pos, 0.7f, ARX_SOUND_PLAY_LOOPED);
+	m_snd_loop = ARX_SOUND_PlaySFX(SND_SPELL_LEVITATE_LOOP, &entities[m_target]->pos(), 0.7f, ARX_SOUND_PLAY_LOOPED);
 	
 	m_targets.push_back(m_target);
 }
@@ -203,7 +203,7 @@ void LevitateSpell::Launch()
 void LevitateSpell::End()
 {
 	ARX_SOUND_Stop(m_snd_loop);
-	ARX_SOUND_PlaySFX(SND_SPELL_LEVITATE_END, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_LEVITATE_END, &entities[m_target]->pos());
 	m_targets.clear();
 	
 	if(m_target == PlayerEntityHandle)
@@ -220,7 +220,7 @@ void LevitateSpell::Update() {
 		target = player.pos + Vec3f(0.f, 150.f, 0.f);
 		player.levitate = true;
 	} else {
-		target = entities[m_caster]->pos;
+		target = entities[m_caster]->pos();
 	}
 	
 	m_pos = target;
@@ -249,7 +249,7 @@ void LevitateSpell::Update() {
 	cone2.Render();
 	m_stones.DrawStone();
 	
-	ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos);
+	ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos());
 }
 
 void LevitateSpell::createDustParticle() {
@@ -294,7 +294,7 @@ void CurePoisonSpell::Launch()
 		if(io->ioflags & IO_NPC) {
 			io->_npcdata->poisonned -= std::min(io->_npcdata->poisonned, cure);
 		}
-		ARX_SOUND_PlaySFX(SND_SPELL_CURE_POISON, &io->pos);
+		ARX_SOUND_PlaySFX(SND_SPELL_CURE_POISON, &io->pos());
 	}
 	
 	m_duration = 3500;
@@ -352,7 +352,7 @@ void CurePoisonSpell::Update() {
 	
 	m_currentTime += g_framedelay;
 	
-	m_pos = entities[m_target]->pos;
+	m_pos = entities[m_target]->pos();
 	
 	if(m_target == PlayerEntityHandle)
 		m_pos.y += 200;
@@ -363,10 +363,8 @@ void CurePoisonSpell::Update() {
 		m_particles.m_parameters.m_spawnFlags = PARTICLE_CIRCULAR;
 		m_particles.m_parameters.m_gravity = Vec3f_ZERO;
 
-		std::list<Particle *>::iterator i;
-
-		for(i = m_particles.listParticle.begin(); i != m_particles.listParticle.end(); ++i) {
-			Particle * pP = *i;
+		for(size_t i = 0; i < m_particles.m_particles.size(); i++) {
+			Particle * pP = &m_particles.m_particles[i];
 
 			if(pP->isAlive()) {
 				pP->fColorEnd.a = 0;
@@ -415,9 +413,9 @@ void RepelUndeadSpell::Launch()
 		m_target = PlayerEntityHandle;
 	}
 	
-	ARX_SOUND_PlaySFX(SND_SPELL_REPEL_UNDEAD, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_REPEL_UNDEAD, &entities[m_target]->pos());
 	if(m_target == PlayerEntityHandle) {
-		m_snd_loop = ARX_SOUND_PlaySFX(SND_SPELL_REPEL_UNDEAD_LOOP, &entities[m_target]->pos, 1.f, ARX_SOUND_PLAY_LOOPED);
+		m_snd_loop = ARX_SOUND_PlaySFX(SND_SPELL_REPEL_UNDEAD_LOOP, &entities[m_target]->pos(), 1.f, ARX_SOUND_PLAY_LOOPED);
 	}
 	
 	m_duration = (m_launchDuration > -1) ? m_launchDuration : 20000000;
@@ -437,7 +435,7 @@ void RepelUndeadSpell::End() {
 
 void RepelUndeadSpell::Update() {
 	
-	Vec3f pos = entities[m_target]->pos;
+	Vec3f pos = entities[m_target]->pos();
 	
 	float rot;
 	if(m_target == PlayerEntityHandle) {
@@ -504,7 +502,7 @@ void RepelUndeadSpell::Update() {
 	}
 	
 	if (m_target == PlayerEntityHandle)
-		ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos);
+		ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos());
 }
 
 
@@ -551,7 +549,7 @@ void PoisonProjectileSpell::Launch()
 		if(m_hand_group != ActionPoint()) {
 			srcPos = m_hand_pos;
 		} else {
-			srcPos = entities[m_caster]->pos;
+			srcPos = entities[m_caster]->pos();
 		}
 	}
 	
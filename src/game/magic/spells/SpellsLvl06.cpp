@@ -44,7 +44,7 @@ void RiseDeadSpell::GetTargetAndBeta(Vec3f & target, float & beta)
 		target = player.basePosition();
 		beta = player.angle.getPitch();
 	} else {
-		target = entities[m_caster]->pos;
+		target = entities[m_caster]->pos();
 		beta = entities[m_caster]->angle.getPitch();
 		displace = (entities[m_caster]->ioflags & IO_NPC) == IO_NPC;
 	}
@@ -123,11 +123,11 @@ void RiseDeadSpell::End()
 	if(ValidIONum(m_entity)) {
 		Entity *entity = entities[m_entity];
 		
-		ARX_SOUND_PlaySFX(SND_SPELL_ELECTRIC, &entity->pos);
+		ARX_SOUND_PlaySFX(SND_SPELL_ELECTRIC, &entity->pos());
 		
 		if(entity->scriptload && (entity->ioflags & IO_NOSAVE)) {
 			AddRandomSmoke(entity,100);
-			Vec3f posi = entity->pos;
+			Vec3f posi = entity->pos();
 			posi.y-=100.f;
 			MakeCoolFx(posi);
 			
@@ -231,7 +231,7 @@ void RiseDeadSpell::Update() {
 
 void ParalyseSpell::Launch()
 {
-	ARX_SOUND_PlaySFX(SND_SPELL_PARALYSE, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_PARALYSE, &entities[m_target]->pos());
 	
 	m_duration = (m_launchDuration > -1) ? m_launchDuration : 5000;
 	
@@ -286,13 +286,13 @@ void CreateFieldSpell::Launch()
 	float beta = 0.f;
 	bool displace = false;
 	if(m_caster == PlayerEntityHandle) {
-		target = entities.player()->pos;
+		target = entities.player()->pos();
 		beta = player.angle.getPitch();
 		displace = true;
 	} else {
 		if(ValidIONum(m_caster)) {
 			Entity * io = entities[m_caster];
-			target = io->pos;
+			target = io->pos();
 			beta = io->angle.getPitch();
 			displace = (io->ioflags & IO_NPC) == IO_NPC;
 		} else {
@@ -314,7 +314,7 @@ void CreateFieldSpell::Launch()
 		m_entity = io->index();
 		io->scriptload = 1;
 		io->ioflags |= IO_NOSAVE | IO_FIELD;
-		io->initpos = io->pos = target;
+		io->initpos = io->pos() = target;
 		SendInitScriptEvent(io);
 		
 		m_field.Create(target);
@@ -356,7 +356,7 @@ void CreateFieldSpell::Update() {
 		if(ValidIONum(m_entity)) {
 			Entity * io = entities[m_entity];
 			
-			io->pos = m_field.eSrc;
+			io->pos() = m_field.eSrc;
 
 			if (IsAnyNPCInPlatform(io))
 			{
@@ -416,7 +416,7 @@ bool SlowDownSpell::CanLaunch() {
 
 void SlowDownSpell::Launch()
 {
-	ARX_SOUND_PlaySFX(SND_SPELL_SLOW_DOWN, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_SLOW_DOWN, &entities[m_target]->pos());
 	
 	m_duration = (m_launchDuration > -1) ? m_launchDuration : 10000;
 	
@@ -116,7 +116,7 @@ void FlyingEyeSpell::Launch()
 
 void FlyingEyeSpell::End()
 {
-	ARX_SOUND_PlaySFX(SND_MAGIC_FIZZLE, &entities[m_caster]->pos);
+	ARX_SOUND_PlaySFX(SND_MAGIC_FIZZLE, &entities[m_caster]->pos());
 	
 	static TextureContainer * tc4=TextureContainer::Load("graph/particles/smoke");
 	
@@ -247,7 +247,7 @@ void FireFieldSpell::Launch() {
 	} else {
 		if(ValidIONum(m_caster)) {
 			Entity * io = entities[m_caster];
-			target = io->pos;
+			target = io->pos();
 			beta = io->angle.getPitch();
 			displace = (io->ioflags & IO_NPC) == IO_NPC;
 		} else {
@@ -452,7 +452,7 @@ void IceFieldSpell::Launch()
 	} else {
 		if(ValidIONum(m_caster)) {
 			Entity * io = entities[m_caster];
-			target = io->pos;
+			target = io->pos();
 			beta = io->angle.getPitch();
 			displace = (io->ioflags & IO_NPC) == IO_NPC;
 		} else {
@@ -637,10 +637,10 @@ void LightningStrikeSpell::Launch() {
 
 void LightningStrikeSpell::End()
 {
-	ARX_SOUND_PlaySFX(SND_SPELL_ELECTRIC, &entities[m_caster]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_ELECTRIC, &entities[m_caster]->pos());
 	
 	ARX_SOUND_Stop(m_snd_loop);
-	ARX_SOUND_PlaySFX(SND_SPELL_LIGHTNING_END, &entities[m_caster]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_LIGHTNING_END, &entities[m_caster]->pos());
 }
 
 static Vec3f GetChestPos(EntityHandle num) {
@@ -655,7 +655,7 @@ static Vec3f GetChestPos(EntityHandle num) {
 		if(idx >= 0) {
 			return entities[num]->obj->vertexlist3[idx].v;
 		} else {
-			return entities[num]->pos + Vec3f(0.f, -120.f, 0.f);
+			return entities[num]->pos() + Vec3f(0.f, -120.f, 0.f);
 		}
 	} else {
 		// should not happen
@@ -673,7 +673,7 @@ void LightningStrikeSpell::Update() {
 	if(idx >= 0) {
 		m_caster_pos = caster->obj->vertexlist3[idx].v;
 	} else {
-		m_caster_pos = caster->pos;
+		m_caster_pos = caster->pos();
 	}
 	
 	if(m_caster == PlayerEntityHandle) {
@@ -702,7 +702,7 @@ void LightningStrikeSpell::Update() {
 	m_lightning.Update(g_framedelay);
 	m_lightning.Render();
 	
-	ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_caster]->pos);
+	ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_caster]->pos());
 }
 
 
@@ -715,7 +715,7 @@ ConfuseSpell::ConfuseSpell()
 
 void ConfuseSpell::Launch() {
 	
-	ARX_SOUND_PlaySFX(SND_SPELL_CONFUSE, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_CONFUSE, &entities[m_target]->pos());
 	
 	m_hasDuration = true;
 	m_fManaCostPerSecond = 1.5f;
@@ -751,9 +751,9 @@ void ConfuseSpell::End() {
 
 void ConfuseSpell::Update() {
 	
-	Vec3f pos = entities[m_target]->pos;
+	Vec3f pos = entities[m_target]->pos();
 	if(m_target != PlayerEntityHandle) {
-		pos.y += entities[m_target]->physics.cyl.height - 30.f;
+		pos.y += entities[m_target]->physics().cyl.height - 30.f;
 	}
 	
 	long idx = entities[m_target]->obj->fastaccess.head_group_origin;
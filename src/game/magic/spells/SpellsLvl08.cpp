@@ -53,7 +53,7 @@ void InvisibilitySpell::Launch()
 		m_target = PlayerEntityHandle;
 	}
 
-	entities[m_target]->gameFlags |= GFLAG_INVISIBILITY;
+	entities[m_target]->gameFlags() |= GFLAG_INVISIBILITY;
 	entities[m_target]->invisibility = 0.f;
 	
 	ARX_SOUND_PlaySFX(SND_SPELL_INVISIBILITY_START, &m_caster_pos);
@@ -64,8 +64,8 @@ void InvisibilitySpell::Launch()
 void InvisibilitySpell::End()
 {
 	if(ValidIONum(m_target)) {
-		entities[m_target]->gameFlags &= ~GFLAG_INVISIBILITY;
-		ARX_SOUND_PlaySFX(SND_SPELL_INVISIBILITY_END, &entities[m_target]->pos);
+		entities[m_target]->gameFlags() &= ~GFLAG_INVISIBILITY;
+		ARX_SOUND_PlaySFX(SND_SPELL_INVISIBILITY_END, &entities[m_target]->pos());
 		m_targets.clear();
 	}
 }
@@ -73,7 +73,7 @@ void InvisibilitySpell::End()
 void InvisibilitySpell::Update() {
 	
 	if(m_target != PlayerEntityHandle) {
-		if(!(entities[m_target]->gameFlags & GFLAG_INVISIBILITY)) {
+		if(!(entities[m_target]->gameFlags() & GFLAG_INVISIBILITY)) {
 			m_targets.clear();
 			ARX_SPELLS_Fizzle(this);
 		}
@@ -150,7 +150,7 @@ void ManaDrainSpell::Update() {
 	if(m_caster == PlayerEntityHandle)
 		scaley = 90.f;
 	else
-		scaley = glm::abs(entities[m_caster]->physics.cyl.height * (1.0f/2)) + 30.f;
+		scaley = glm::abs(entities[m_caster]->physics().cyl.height * (1.0f/2)) + 30.f;
 	
 	const float frametime = float(arxtime.get_frame_time());
 	
@@ -163,10 +163,10 @@ void ManaDrainSpell::Update() {
 		cabalpos.z = player.pos.z;
 		refpos = player.pos.y + 60.f;
 	} else {
-		cabalpos.x = entities[m_caster]->pos.x;
-		cabalpos.y = entities[m_caster]->pos.y - scaley - mov;
-		cabalpos.z = entities[m_caster]->pos.z;
-		refpos = entities[m_caster]->pos.y - scaley;
+		cabalpos.x = entities[m_caster]->pos().x;
+		cabalpos.y = entities[m_caster]->pos().y - scaley - mov;
+		cabalpos.z = entities[m_caster]->pos().z;
+		refpos = entities[m_caster]->pos().y - scaley;
 	}
 	
 	float Es = std::sin(frametime * (1.0f/800) + glm::radians(scaley));
@@ -252,7 +252,7 @@ void ExplosionSpell::Launch()
 	
 	m_duration = 2000;
 	
-	Vec3f target = entities[m_caster]->pos;
+	Vec3f target = entities[m_caster]->pos();
 	if(m_caster == PlayerEntityHandle) {
 		target.y += 60.f;
 	} else {
@@ -408,7 +408,7 @@ void LifeDrainSpell::Update() {
 	if(m_caster == PlayerEntityHandle)
 		scaley = 90.f;
 	else
-		scaley = glm::abs(entities[m_caster]->physics.cyl.height * (1.0f/2)) + 30.f;
+		scaley = glm::abs(entities[m_caster]->physics().cyl.height * (1.0f/2)) + 30.f;
 	
 	const float frametime = float(arxtime.get_frame_time());
 	
@@ -421,10 +421,10 @@ void LifeDrainSpell::Update() {
 		cabalpos.z = player.pos.z;
 		refpos = player.pos.y + 60.f;
 	} else {
-		cabalpos.x = entities[m_caster]->pos.x;
-		cabalpos.y = entities[m_caster]->pos.y - scaley - mov;
-		cabalpos.z = entities[m_caster]->pos.z;
-		refpos = entities[m_caster]->pos.y - scaley;
+		cabalpos.x = entities[m_caster]->pos().x;
+		cabalpos.y = entities[m_caster]->pos().y - scaley - mov;
+		cabalpos.z = entities[m_caster]->pos().z;
+		refpos = entities[m_caster]->pos().y - scaley;
 	}
 	
 	float Es = std::sin(frametime * (1.0f/800) + glm::radians(scaley));
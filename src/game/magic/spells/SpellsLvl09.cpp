@@ -47,7 +47,7 @@ void SummonCreatureSpell::GetTargetAndBeta(Vec3f & target, float & beta)
 		beta = player.angle.getPitch();
 		displace = true;
 	} else {
-		target = entities[m_caster]->pos;
+		target = entities[m_caster]->pos();
 		beta = entities[m_caster]->angle.getPitch();
 		displace = (entities[m_caster]->ioflags & IO_NPC) == IO_NPC;
 	}
@@ -122,12 +122,12 @@ void SummonCreatureSpell::End() {
 	if(ValidIONum(m_summonedEntity)) {
 		Entity * io = entities[m_summonedEntity];
 		
-		ARX_SOUND_PlaySFX(SND_SPELL_ELECTRIC, &io->pos);
+		ARX_SOUND_PlaySFX(SND_SPELL_ELECTRIC, &io->pos());
 		
 		if(io->scriptload && (io->ioflags & IO_NOSAVE)) {
 			
 			AddRandomSmoke(io, 100);
-			Vec3f posi = io->pos;
+			Vec3f posi = io->pos();
 			posi.y -= 100.f;
 			MakeCoolFx(posi);
 		
@@ -228,13 +228,13 @@ void SummonCreatureSpell::Update() {
 					io->ioflags |= IO_NOSAVE;
 				}
 				
-				io->pos = phys.origin;
+				io->pos() = phys.origin;
 				SendInitScriptEvent(io);
 				
 				if(tokeep < 0) {
 					io->scale=1.65f;
-					io->physics.cyl.radius=25;
-					io->physics.cyl.height=-43;
+					io->physics().cyl.radius=25;
+					io->physics().cyl.height=-43;
 					io->speed_modif=1.f;
 				}
 				
@@ -280,7 +280,7 @@ void FakeSummonSpell::Launch()
 	m_fManaCostPerSecond = 1.9f;
 	m_duration = 4000;
 	
-	Vec3f target = entities[m_target]->pos;
+	Vec3f target = entities[m_target]->pos();
 	if(m_target != PlayerEntityHandle) {
 		target.y += player.baseHeight();
 	}
@@ -338,7 +338,7 @@ void NegateMagicSpell::Launch()
 		m_target = PlayerEntityHandle;
 	}
 	
-	ARX_SOUND_PlaySFX(SND_SPELL_NEGATE_MAGIC, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_NEGATE_MAGIC, &entities[m_target]->pos());
 	
 	m_hasDuration = true;
 	m_fManaCostPerSecond = 2.f;
@@ -363,7 +363,7 @@ void NegateMagicSpell::Update() {
 	if(m_target == PlayerEntityHandle) {
 		m_pos = player.basePosition();
 	} else {
-		m_pos = entities[m_target]->pos;
+		m_pos = entities[m_target]->pos();
 	}
 	
 	Vec3f stitepos = m_pos - Vec3f(0.f, 10.f, 0.f);
@@ -430,7 +430,7 @@ void NegateMagicSpell::LaunchAntiMagicField() {
 			continue;
 		
 		Vec3f pos = spell->getPosition();
-		if(closerThan(pos, entities[m_target]->pos, 600.f)) {
+		if(closerThan(pos, entities[m_target]->pos(), 600.f)) {
 			if(spell->m_type != SPELL_CREATE_FIELD) {
 				spells.endSpell(spell);
 			} else if(m_target == PlayerEntityHandle && spell->m_caster == PlayerEntityHandle) {
@@ -454,9 +454,9 @@ void IncinerateSpell::Launch()
 {
 	Entity * tio = entities[m_target];
 	
-	ARX_SOUND_PlaySFX(SND_SPELL_INCINERATE, &entities[m_target]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_INCINERATE, &entities[m_target]->pos());
 	
-	m_snd_loop = ARX_SOUND_PlaySFX(SND_SPELL_INCINERATE_LOOP, &entities[m_target]->pos, 1.f, ARX_SOUND_PLAY_LOOPED);
+	m_snd_loop = ARX_SOUND_PlaySFX(SND_SPELL_INCINERATE_LOOP, &entities[m_target]->pos(), 1.f, ARX_SOUND_PLAY_LOOPED);
 	
 	m_duration = 20000;
 	
@@ -476,7 +476,7 @@ void IncinerateSpell::End()
 void IncinerateSpell::Update() {
 	
 	if(ValidIONum(m_target)) {
-		ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos);
+		ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_target]->pos());
 	}	
 }
 
@@ -499,7 +499,7 @@ void MassParalyseSpell::Launch()
 			continue;
 		}
 		
-		if(tio->show != SHOW_FLAG_IN_SCENE) {
+		if(tio->show() != SHOW_FLAG_IN_SCENE) {
 			continue;
 		}
 		
@@ -507,7 +507,7 @@ void MassParalyseSpell::Launch()
 			continue;
 		}
 		
-		if(fartherThan(tio->pos, entities[m_caster]->pos, 500.f)) {
+		if(fartherThan(tio->pos(), entities[m_caster]->pos(), 500.f)) {
 			continue;
 		}
 		
@@ -70,7 +70,7 @@ void MassLightningStrikeSpell::Launch()
 		beta = player.angle.getPitch();
 	} else {
 		Entity * io = entities[m_caster];
-		m_pos = io->pos + Vec3f(0.f, -20.f, 0.f);
+		m_pos = io->pos() + Vec3f(0.f, -20.f, 0.f);
 		beta = io->angle.getPitch();
 	}
 	m_pos += angleToVectorXZ(beta) * 500.f;
@@ -195,7 +195,7 @@ bool ControlTargetSpell::CanLaunch()
 			continue;
 		}
 		
-		if(ioo->_npcdata->lifePool.current <= 0.f || ioo->show != SHOW_FLAG_IN_SCENE) {
+		if(ioo->_npcdata->lifePool.current <= 0.f || ioo->show() != SHOW_FLAG_IN_SCENE) {
 			continue;
 		}
 		
@@ -203,7 +203,7 @@ bool ControlTargetSpell::CanLaunch()
 			continue;
 		}
 		
-		if(closerThan(ioo->pos, m_caster_pos, 900.f)) {
+		if(closerThan(ioo->pos(), m_caster_pos, 900.f)) {
 			tcount++;
 		}
 	}
@@ -225,7 +225,7 @@ void ControlTargetSpell::Launch()
 			continue;
 		}
 		
-		if(ioo->_npcdata->lifePool.current <= 0.f || ioo->show != SHOW_FLAG_IN_SCENE) {
+		if(ioo->_npcdata->lifePool.current <= 0.f || ioo->show() != SHOW_FLAG_IN_SCENE) {
 			continue;
 		}
 		
@@ -233,7 +233,7 @@ void ControlTargetSpell::Launch()
 			continue;
 		}
 		
-		if(closerThan(ioo->pos, m_caster_pos, 900.f)) {
+		if(closerThan(ioo->pos(), m_caster_pos, 900.f)) {
 			std::ostringstream oss;
 			oss << entities[m_target]->idString();
 			oss << ' ' << long(m_level);
@@ -264,7 +264,7 @@ void ControlTargetSpell::Launch()
 		Entity * e = entities[handle];
 		
 		if(e) {
-			eTarget = e->pos;
+			eTarget = e->pos();
 		}
 	}
 	
@@ -396,7 +396,7 @@ void FreezeTimeSpell::Launch()
 void FreezeTimeSpell::End()
 {
 	GLOBAL_SLOWDOWN += m_slowdown;
-	ARX_SOUND_PlaySFX(SND_SPELL_TELEKINESIS_END, &entities[m_caster]->pos);
+	ARX_SOUND_PlaySFX(SND_SPELL_TELEKINESIS_END, &entities[m_caster]->pos());
 }
 
 void MassIncinerateSpell::Launch()
@@ -414,11 +414,11 @@ void MassIncinerateSpell::Launch()
 			continue;
 		}
 		
-		if(tio->_npcdata->lifePool.current <= 0.f || tio->show != SHOW_FLAG_IN_SCENE) {
+		if(tio->_npcdata->lifePool.current <= 0.f || tio->show() != SHOW_FLAG_IN_SCENE) {
 			continue;
 		}
 		
-		if(fartherThan(tio->pos, entities[m_caster]->pos, 500.f)) {
+		if(fartherThan(tio->pos(), entities[m_caster]->pos(), 500.f)) {
 			continue;
 		}
 		
@@ -445,7 +445,7 @@ void MassIncinerateSpell::End()
 void MassIncinerateSpell::Update() {
 	
 	if(ValidIONum(m_caster)) {
-		ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_caster]->pos);
+		ARX_SOUND_RefreshPosition(m_snd_loop, entities[m_caster]->pos());
 	}	
 }
 
@@ -118,7 +118,7 @@ static void ARX_NPC_SpawnMember(Entity * ioo, ObjSelection num) {
 		
 		nouvo->vertexlist[k] = from->vertexlist[cutSelection.selected[k]];
 		nouvo->vertexlist[k].v = from->vertexlist3[cutSelection.selected[k]].v;
-		nouvo->vertexlist[k].v -= ioo->pos;
+		nouvo->vertexlist[k].v -= ioo->pos();
 		nouvo->vertexlist[k].vert.p = nouvo->vertexlist[k].v;
 		
 		nouvo->vertexlist[k].vert.color = from->vertexlist[k].vert.color;
@@ -141,7 +141,7 @@ static void ARX_NPC_SpawnMember(Entity * ioo, ObjSelection num) {
 					if(count < nouvo->vertexlist.size()) {
 						nouvo->vertexlist[count] = from->vertexlist[from->facelist[k].vid[j]];
 						nouvo->vertexlist[count].v = from->vertexlist3[from->facelist[k].vid[j]].v;
-						nouvo->vertexlist[count].v -= ioo->pos;
+						nouvo->vertexlist[count].v -= ioo->pos();
 						nouvo->vertexlist[count].vert.p = nouvo->vertexlist[count].v;
 
 						nouvo->vertexlist3[count] = nouvo->vertexlist[count];
@@ -240,7 +240,7 @@ static void ARX_NPC_SpawnMember(Entity * ioo, ObjSelection num) {
 	io->ioflags = IO_ITEM | IO_NOSAVE | IO_MOVABLE;
 	io->script.size = 0;
 	io->script.data = NULL;
-	io->gameFlags |= GFLAG_NO_PHYS_IO_COL;
+	io->gameFlags() |= GFLAG_NO_PHYS_IO_COL;
 	
 	EERIE_COLLISION_Cylinder_Create(io);
 	EERIE_PHYSICS_BOX_Create(nouvo);
@@ -254,10 +254,10 @@ static void ARX_NPC_SpawnMember(Entity * ioo, ObjSelection num) {
 	io->m_icon = NULL;
 	io->scriptload = 1;
 	io->obj = nouvo;
-	io->lastpos = io->initpos = io->pos = ioo->obj->vertexlist3[inpos].v;
+	io->lastpos = io->initpos = io->pos() = ioo->obj->vertexlist3[inpos].v;
 	io->angle = ioo->angle;
 	
-	io->gameFlags = ioo->gameFlags;
+	io->gameFlags() = ioo->gameFlags();
 	io->halo = ioo->halo;
 	
 	io->angle.setYaw(Random::getf(340.f, 380.f));
@@ -278,12 +278,12 @@ static void ARX_NPC_SpawnMember(Entity * ioo, ObjSelection num) {
 	
 	io->no_collide = ioo->index();
 	
-	io->gameFlags |= GFLAG_GOREEXPLODE;
+	io->gameFlags() |= GFLAG_GOREEXPLODE;
 	io->animBlend.lastanimtime = arxtime.now_ul();
 	io->soundtime = 0;
 	io->soundcount = 0;
 
-	EERIE_PHYSICS_BOX_Launch(io->obj, io->pos, io->angle, vector);
+	EERIE_PHYSICS_BOX_Launch(io->obj, io->pos(), io->angle, vector);
 }
 
 
@@ -434,7 +434,7 @@ void ARX_NPC_TryToCutSomething(Entity * target, const Vec3f * pos)
 	if(!target || !(target->ioflags & IO_NPC))
 		return;
 
-	if(target->gameFlags & GFLAG_NOGORE)
+	if(target->gameFlags() & GFLAG_NOGORE)
 		return;
 
 	float mindistSqr = std::numeric_limits<float>::max();
@@ -71,10 +71,16 @@ static void SetTextureDrawPrim(TextureContainer * tex, TexturedVertex * v,
 	EERIEDRAWPRIM(prim, v, 4);
 }
 
-static bool EERIECreateSprite(TexturedQuad & sprite, const Vec3f & in, float siz,
-                              Color color, float Zpos, float rot = 0) {
+/*!
+ * Project a sprite center to screen space.
+ *
+ * \param out receives the projected center
+ * \param t   receives the half size of the sprite in pixels
+ * \return false if the sprite is off-screen
+ */
+static bool EERIEProjectSprite(TexturedVertex & out, float & t, const Vec3f & in, float siz,
+                               float Zpos) {
 	
-	TexturedVertex out;
 	EE_RTP(in, out);
 	out.rhw *= 3000.f;
 
@@ -85,8 +91,6 @@ static bool EERIECreateSprite(TexturedQuad & sprite, const Vec3f & in, float siz
 	   && out.p.y > -500.f
 	   && out.p.y < 1800.f
 	) {
-		float t;
-
 		if(siz < 0) {
 			t = -siz * g_sizeRatio.y;
 		} else {
@@ -103,37 +107,87 @@ static bool EERIECreateSprite(TexturedQuad & sprite, const Vec3f & in, float siz
 			out.rhw *= (1.f/3000.f);
 		}		
 		
-		ColorRGBA col = color.toRGBA();
-		
-		sprite.v[0] = TexturedVertex(Vec3f(), out.rhw, col, Vec2f_ZERO);
-		sprite.v[1] = TexturedVertex(Vec3f(), out.rhw, col, Vec2f_X_AXIS);
-		sprite.v[2] = TexturedVertex(Vec3f(), out.rhw, col, Vec2f(1.f, 1.f));
-		sprite.v[3] = TexturedVertex(Vec3f(), out.rhw, col, Vec2f_Y_AXIS);
-		
-		if(rot == 0) {
-			Vec3f maxs = out.p + t;
-			Vec3f mins = out.p - t;
-
-			sprite.v[0].p = Vec3f(mins.x, mins.y, out.p.z);
-			sprite.v[1].p = Vec3f(maxs.x, mins.y, out.p.z);
-			sprite.v[2].p = Vec3f(maxs.x, maxs.y, out.p.z);
-			sprite.v[3].p = Vec3f(mins.x, maxs.y, out.p.z);
-		} else {
-			for(long i=0;i<4;i++) {
-				float tt = glm::radians(MAKEANGLE(rot+90.f*i+45+90));
-				sprite.v[i].p.x = std::sin(tt) * t + out.p.x;
-				sprite.v[i].p.y = std::cos(tt) * t + out.p.y;
-				sprite.v[i].p.z = out.p.z;
-			}
-		}
-
 		return true;
 	}
 
 	return false;
 }
 
+static bool EERIECreateSprite(TexturedQuad & sprite, const Vec3f & in, float siz,
+                              Color color, float Zpos, float rot = 0) {
+	
+	TexturedVertex out;
+	float t;
+	if(!EERIEProjectSprite(out, t, in, siz, Zpos)) {
+		return false;
+	}
+	
+	ColorRGBA col = color.toRGBA();
+	
+	sprite.v[0] = TexturedVertex(Vec3f(), out.rhw, col, Vec2f_ZERO);
+	sprite.v[1] = TexturedVertex(Vec3f(), out.rhw, col, Vec2f_X_AXIS);
+	sprite.v[2] = TexturedVertex(Vec3f(), out.rhw, col, Vec2f(1.f, 1.f));
+	sprite.v[3] = TexturedVertex(Vec3f(), out.rhw, col, Vec2f_Y_AXIS);
+	
+	if(rot == 0) {
+		Vec3f maxs = out.p + t;
+		Vec3f mins = out.p - t;
+
+		sprite.v[0].p = Vec3f(mins.x, mins.y, out.p.z);
+		sprite.v[1].p = Vec3f(maxs.x, mins.y, out.p.z);
+		sprite.v[2].p = Vec3f(maxs.x, maxs.y, out.p.z);
+		sprite.v[3].p = Vec3f(mins.x, maxs.y, out.p.z);
+	} else {
+		for(long i=0;i<4;i++) {
+			float tt = glm::radians(MAKEANGLE(rot+90.f*i+45+90));
+			sprite.v[i].p.x = std::sin(tt) * t + out.p.x;
+			sprite.v[i].p.y = std::cos(tt) * t + out.p.y;
+			sprite.v[i].p.z = out.p.z;
+		}
+	}
+
+	return true;
+}
+
+//! Same as \ref EERIECreateSprite, but leaves expanding the quad to the renderer
+static bool EERIECreateSpriteInstance(SpriteInstance & sprite, const Vec3f & in, float siz,
+                                      Color color, float Zpos, float rot) {
+	
+	TexturedVertex out;
+	float t;
+	if(!EERIEProjectSprite(out, t, in, siz, Zpos)) {
+		return false;
+	}
+	
+	sprite.p = out.p;
+	sprite.rhw = out.rhw;
+	sprite.color = color.toRGBA();
+	
+	if(rot == 0) {
+		sprite.a = Vec2f(t, 0.f);
+		sprite.b = Vec2f(0.f, t);
+	} else {
+		// Corners i = 0 and i = 1 of EERIECreateSprite are p - a - b and p + a - b
+		float tt = glm::radians(MAKEANGLE(rot + 45 + 90));
+		Vec2f c0 = Vec2f(std::sin(tt), std::cos(tt)) * t;
+		Vec2f c1 = Vec2f(std::cos(tt), -std::sin(tt)) * t;
+		sprite.a = (c1 - c0) * 0.5f;
+		sprite.b = (c1 + c0) * -0.5f;
+	}
+	
+	return true;
+}
+
 void EERIEAddSprite(const RenderMaterial & mat, const Vec3f & in, float siz, Color color, float Zpos, float rot) {
+	
+	if(GRenderer->hasSpriteInstancing()) {
+		SpriteInstance s;
+		if(EERIECreateSpriteInstance(s, in, siz, color, Zpos, rot)) {
+			RenderBatcher::getInstance().add(mat, s);
+		}
+		return;
+	}
+	
 	TexturedQuad s;
 
 	if(EERIECreateSprite(s, in, siz, color, Zpos, rot)) {
@@ -420,7 +420,7 @@ static void drawDebugEntityPhysicsCylinder(Entity * io) {
 		levitate = CFLAG_LEVITATE;
 	}
 	
-	Cylinder cyll = Cylinder(io->physics.startpos, GetIORadius(io), GetIOHeight(io));
+	Cylinder cyll = Cylinder(io->physics().startpos, GetIORadius(io), GetIOHeight(io));
 	
 	drawLineCylinder(cyll, Color::green);
 	
@@ -430,7 +430,7 @@ static void drawDebugEntityPhysicsCylinder(Entity * io) {
 		cyll.height = GetIOHeight(io);
 	}
 	
-	cyll.origin = io->physics.targetpos;
+	cyll.origin = io->physics().targetpos;
 	drawLineCylinder(cyll, Color::red);
 	
 }
@@ -440,7 +440,7 @@ static void drawDebugEntityPhysicsCylinders() {
 		const EntityHandle handle = EntityHandle(i);
 		Entity * entity = entities[handle];
 		
-		if(!entity || !closerThan(entity->pos, player.pos, DebugPhysicsMaxDistance))
+		if(!entity || !closerThan(entity->pos(), player.pos, DebugPhysicsMaxDistance))
 			continue;
 		
 		drawDebugCollisionShape(entity->obj);
@@ -460,7 +460,7 @@ static void drawDebugEntities() {
 		
 		Color color = Color::white;
 		bool visible = true;
-		switch(entity->show) {
+		switch(entity->show()) {
 			case SHOW_FLAG_DESTROYED:    continue; // Don't even display the name
 			case SHOW_FLAG_IN_INVENTORY: continue;
 			case SHOW_FLAG_ON_PLAYER:    continue;
@@ -483,14 +483,14 @@ static void drawDebugEntities() {
 			drawDebugBoundingBox(entity->bbox2D.toRect(), Color::blue);
 		}
 		
-		if(closerThan(entity->pos, player.pos, DebugTextMaxDistance)) {
+		if(closerThan(entity->pos(), player.pos, DebugTextMaxDistance)) {
 			
 			if(visible && entity->bbox2D.valid()) {
 				int x = (entity->bbox2D.min.x + entity->bbox2D.max.x) / 2;
 				int y = entity->bbox2D.min.y - hFontDebug->getLineHeight() - 2;
 				UNICODE_ARXDrawTextCenter(hFontDebug, Vec2f(x, y), entity->idString(), color);
 			} else {
-				drawTextAt(hFontDebug, entity->pos, entity->idString(), color);
+				drawTextAt(hFontDebug, entity->pos(), entity->idString(), color);
 			}
 			
 			if(entity->obj) {
@@ -611,14 +611,14 @@ static void drawDebugMaterials() {
 		if((entity->ioflags & IO_CAMERA) || (entity->ioflags & IO_MARKER))
 			continue;
 		
-		if(!(entity->gameFlags & GFLAG_ISINTREATZONE))
+		if(!(entity->gameFlags() & GFLAG_ISINTREATZONE))
 			continue;
-		if((entity->gameFlags & GFLAG_INVISIBILITY))
+		if((entity->gameFlags() & GFLAG_INVISIBILITY))
 			continue;
-		if((entity->gameFlags & GFLAG_MEGAHIDE))
+		if((entity->gameFlags() & GFLAG_MEGAHIDE))
 			continue;
 		
-		switch(entity->show) {
+		switch(entity->show()) {
 			case SHOW_FLAG_DESTROYED:    continue;
 			case SHOW_FLAG_IN_INVENTORY: continue;
 			case SHOW_FLAG_ON_PLAYER:    continue;
@@ -33,7 +33,7 @@ RenderBatcher::~RenderBatcher() {
 
 void RenderBatcher::add(const RenderMaterial& mat, const TexturedVertex (&tri)[3]) {
 	
-	VertexBatch & batch = m_BatchedSprites[mat];
+	VertexBatch & batch = m_BatchedSprites[mat].vertices;
 	
 	batch.push_back(tri[0]);
 	batch.push_back(tri[1]);
@@ -42,7 +42,7 @@ void RenderBatcher::add(const RenderMaterial& mat, const TexturedVertex (&tri)[3
 
 void RenderBatcher::add(const RenderMaterial& mat, const TexturedQuad& sprite) {
 	
-	VertexBatch & batch = m_BatchedSprites[mat];
+	VertexBatch & batch = m_BatchedSprites[mat].vertices;
 	
 	batch.push_back(sprite.v[0]);
 	batch.push_back(sprite.v[1]);
@@ -53,14 +53,24 @@ void RenderBatcher::add(const RenderMaterial& mat, const TexturedQuad& sprite) {
 	batch.push_back(sprite.v[3]);
 }
 
+void RenderBatcher::add(const RenderMaterial& mat, const SpriteInstance& sprite) {
+	m_BatchedSprites[mat].sprites.push_back(sprite);
+}
+
 void RenderBatcher::render() {
 	
 	ARX_PROFILE_FUNC();
 	
 	for(Batches::const_iterator it = m_BatchedSprites.begin(); it != m_BatchedSprites.end(); ++it) {
-		if(!it->second.empty()) {
+		const Batch & batch = it->second;
+		if(!batch.vertices.empty() || !batch.sprites.empty()) {
 			it->first.apply();
-			EERIEDRAWPRIM(Renderer::TriangleList, &it->second.front(), it->second.size(), true);
+			if(!batch.vertices.empty()) {
+				EERIEDRAWPRIM(Renderer::TriangleList, &batch.vertices.front(), batch.vertices.size(), true);
+			}
+			if(!batch.sprites.empty()) {
+				GRenderer->drawSprites(&batch.sprites.front(), batch.sprites.size());
+			}
 			GRenderer->GetTextureStage(0)->setAlphaOp(TextureStage::OpSelectArg1);
 		}
 	}
@@ -77,8 +87,10 @@ void RenderBatcher::clear() {
 	
 	ARX_PROFILE_FUNC();
 	
-	for(Batches::iterator itBatch = m_BatchedSprites.begin(); itBatch != m_BatchedSprites.end(); ++itBatch)
-		itBatch->second.clear();
+	for(Batches::iterator itBatch = m_BatchedSprites.begin(); itBatch != m_BatchedSprites.end(); ++itBatch) {
+		itBatch->second.vertices.clear();
+		itBatch->second.sprites.clear();
+	}
 }
 
 void RenderBatcher::reset() {
@@ -93,7 +105,8 @@ u32 RenderBatcher::getMemoryUsed() const {
 	u32 memoryUsed = 0;
 
 	for(Batches::const_iterator it = m_BatchedSprites.begin(); it != m_BatchedSprites.end(); ++it) {
-		memoryUsed += it->second.capacity() * sizeof(TexturedVertex);
+		memoryUsed += it->second.vertices.capacity() * sizeof(TexturedVertex);
+		memoryUsed += it->second.sprites.capacity() * sizeof(SpriteInstance);
 	}
 
 	return memoryUsed;
@@ -21,6 +21,7 @@
 #define ARX_GRAPHICS_RENDERBATCHER_H
 
 #include "graphics/Renderer.h"
+#include "graphics/Vertex.h"
 #include "graphics/data/TextureContainer.h"
 #include "graphics/texture/TextureStage.h"
 
@@ -99,6 +100,8 @@ public:
 
 	void add(const RenderMaterial& mat, const TexturedVertex(&vertices)[3]);
 	void add(const RenderMaterial& mat, const TexturedQuad& sprite);
+	//! Add a sprite to be expanded by the renderer - requires \ref Renderer::hasSpriteInstancing()
+	void add(const RenderMaterial& mat, const SpriteInstance& sprite);
 
 	//! Render all batches
 	void render();
@@ -116,7 +119,14 @@ public:
 private:
 	
 	typedef std::vector<TexturedVertex> VertexBatch;
-	typedef std::map<RenderMaterial, VertexBatch> Batches;
+	typedef std::vector<SpriteInstance> SpriteBatch;
+	
+	struct Batch {
+		VertexBatch vertices;
+		SpriteBatch sprites;
+	};
+	
+	typedef std::map<RenderMaterial, Batch> Batches;
 	
 	Batches m_BatchedSprites;
 	
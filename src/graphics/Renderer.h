@@ -31,6 +31,7 @@
 struct TexturedVertex;
 struct SMY_VERTEX;
 struct SMY_VERTEX3;
+struct SpriteInstance;
 class TextureContainer;
 class TextureStage;
 class Image;
@@ -372,6 +373,16 @@ public:
 	
 	virtual void drawIndexed(Primitive primitive, const TexturedVertex * vertices, size_t nvertices, unsigned short * indices, size_t nindices) = 0;
 	
+	//! \return true if \ref drawSprites() can be used
+	virtual bool hasSpriteInstancing() = 0;
+	
+	/*!
+	 * Draw pre-transformed sprites with the current render state and texture.
+	 * Each sprite is expanded to a quad on the GPU.
+	 * Only available if \ref hasSpriteInstancing() returns true.
+	 */
+	virtual void drawSprites(const SpriteInstance * sprites, size_t count) = 0;
+	
 	virtual bool getSnapshot(Image & image) = 0;
 	virtual bool getSnapshot(Image & image, size_t width, size_t height) = 0;
 	
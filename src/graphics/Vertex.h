@@ -94,6 +94,20 @@ struct SMY_VERTEX3 {
 	Vec2f uv[3];
 };
 
+/*!
+ * Screen-space sprite expanded to a quad by the renderer.
+ *
+ * The corners are p + cx * a + cy * b for (cx, cy) in (-1, -1), (1, -1), (1, 1), (-1, 1),
+ * with texture coordinates (0, 0), (1, 0), (1, 1) and (0, 1) respectively.
+ */
+struct SpriteInstance {
+	Vec3f p;
+	float rhw;
+	ColorRGBA color;
+	Vec2f a;
+	Vec2f b;
+};
+
 struct EERIE_VERTEX {
 	TexturedVertex vert;
 	Vec3f v;
@@ -48,11 +48,14 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 
 #include <cstdlib>
 #include <cstdio>
+#include <iomanip>
 #include <map>
+#include <sstream>
 
-#include <boost/scoped_array.hpp>
 #include <boost/unordered_map.hpp>
 
+#include <zlib.h>
+
 #include <glm/gtx/intersect.hpp>
 
 #include "ai/PathFinder.h"
@@ -83,6 +86,7 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include "io/fs/FileStream.h"
 #include "io/resource/PakReader.h"
 #include "io/fs/Filesystem.h"
+#include "io/fs/SystemPaths.h"
 #include "io/Blast.h"
 #include "io/Implode.h"
 #include "io/IO.h"
@@ -160,14 +164,14 @@ long MakeTopObjString(Entity * io, std::string & dest) {
 		Entity * e = entities[handle];
 		
 		if(e && e != io) {
-			if(e->show == SHOW_FLAG_IN_SCENE) {
+			if(e->show() == SHOW_FLAG_IN_SCENE) {
 				if((e->ioflags & IO_NPC) || (e->ioflags & IO_ITEM)) {
-					if(e->pos.x > box.min.x
-							&& e->pos.x < box.max.x
-							&& e->pos.z > box.min.z
-							&& e->pos.z < box.max.z)
+					if(e->pos().x > box.min.x
+							&& e->pos().x < box.max.x
+							&& e->pos().z > box.min.z
+							&& e->pos().z < box.max.z)
 					{
-						if(glm::abs(e->pos.y - box.min.y) < 40.f) {
+						if(glm::abs(e->pos().y - box.min.y) < 40.f) {
 							dest += ' ' + e->idString();
 						}
 					}
@@ -823,7 +827,7 @@ static void ReleaseBKG_INFO(EERIE_BKG_INFO * eg) {
 
 void UpdateIORoom(Entity * io)
 {
-	Vec3f pos = io->pos;
+	Vec3f pos = io->pos();
 	pos.y -= 60.f;
 
 	long roo = ARX_PORTALS_GetRoomNumForPosition(pos, 2);
@@ -941,18 +945,6 @@ int InitBkg(EERIE_BACKGROUND * eb, short sx, short sz, short Xdiv, short Zdiv) {
 //*************************************************************************************
 //*************************************************************************************
 
-static void EERIEPOLY_Add_PolyIn(EERIE_BKG_INFO * eg, EERIEPOLY * ep) {
-	
-	for(long i = 0; i < eg->nbpolyin; i++)
-		if(eg->polyin[i] == ep)
-			return;
-
-	eg->polyin = (EERIEPOLY **)realloc(eg->polyin, sizeof(EERIEPOLY *) * (eg->nbpolyin + 1));
-
-	eg->polyin[eg->nbpolyin] = ep;
-	eg->nbpolyin++;
-}
-
 static bool PointInBBox(const Vec3f & point, const EERIE_2D_BBOX & bb) {
 	
 	if(   point.x > bb.max.x
@@ -967,6 +959,8 @@ static bool PointInBBox(const Vec3f & point, const EERIE_2D_BBOX & bb) {
 
 void EERIEPOLY_Compute_PolyIn() {
 	
+	std::vector<EERIEPOLY *> polyin;
+	
 	for(long z = 0; z < ACTIVEBKG->Zsize; z++)
 	for(long x = 0; x < ACTIVEBKG->Xsize; x++) {
 		EERIE_BKG_INFO *eg = &ACTIVEBKG->fastdata[x][z];
@@ -989,6 +983,9 @@ void EERIEPOLY_Compute_PolyIn() {
 		bbcenter.x = (bb.min.x + bb.max.x) * .5f;
 		bbcenter.z = (bb.min.y + bb.max.y) * .5f;
 		
+		// Each polygon is visited at most once per cell so there are no duplicates
+		polyin.clear();
+		
 		for(long z2 = minz; z2 < maxz; z2++)
 		for(long x2 = minx; x2 < maxx; x2++) {
 			EERIE_BKG_INFO *eg2 = &ACTIVEBKG->fastdata[x2][z2];
@@ -1001,24 +998,23 @@ void EERIEPOLY_Compute_PolyIn() {
 				
 				long nbvert = (ep2->type & POLY_QUAD) ? 4 : 3;
 				
-				if(PointInBBox(ep2->center, bb)) {
-					EERIEPOLY_Add_PolyIn(eg, ep2);
-				} else {
-					for(long k = 0; k < nbvert; k++) {
-						if(PointInBBox(ep2->v[k].p, bb)) {
-							EERIEPOLY_Add_PolyIn(eg, ep2);
-							break;
-						} else {
-							Vec3f pt = (ep2->v[k].p + ep2->center) * .5f;
-							if(PointInBBox(pt, bb)) {
-								EERIEPOLY_Add_PolyIn(eg, ep2);
-								break;
-							}
-						}
-					}
+				bool inside = PointInBBox(ep2->center, bb);
+				for(long k = 0; k < nbvert && !inside; k++) {
+					Vec3f pt = (ep2->v[k].p + ep2->center) * .5f;
+					inside = PointInBBox(ep2->v[k].p, bb) || PointInBBox(pt, bb);
+				}
+				
+				if(inside) {
+					polyin.push_back(ep2);
 				}
 			}
 		}
+		
+		if(!polyin.empty()) {
+			eg->polyin = (EERIEPOLY **)malloc(sizeof(EERIEPOLY *) * polyin.size());
+			std::copy(polyin.begin(), polyin.end(), eg->polyin);
+			eg->nbpolyin = short(polyin.size());
+		}
 	}
 }
 
@@ -1254,20 +1250,17 @@ public:
 	
 };
 
-bool FastSceneLoad(const res::path & partial_path) {
+bool FastSceneRead(const res::path & partial_path, std::vector<char> & buffer) {
 	
 	res::path file = "game" / partial_path / "fast.fts";
 	
-	const char * data = NULL, * end = NULL;
-	boost::scoped_array<char> bytes;
-	
 	try {
 		
 		// Load the whole file
 		LogDebug("Loading " << file);
 		size_t size;
 		scoped_malloc<char> dat(resources->readAlloc(file, size));
-		data = dat.get(), end = dat.get() + size;
+		const char * data = dat.get(), * end = dat.get() + size;
 		// TODO use new[] instead of malloc so we can use (boost::)unique_ptr
 		LogDebug("FTS: read " << size << " bytes");
 		if(!data) {
@@ -1283,55 +1276,299 @@ bool FastSceneLoad(const res::path & partial_path) {
 			         << FTS_VERSION << " in " << file;
 			return false;
 		}
-		progressBarAdvance();
-		LoadLevelScreen();
 		
 		
-		// Skip .scn file list and initialize the scene data
+		// Skip .scn file list
 		(void)fts_read<UNIQUE_HEADER3>(data, end, uh->count);
-		InitBkg(ACTIVEBKG, MAX_BKGX, MAX_BKGZ, BKG_SIZX, BKG_SIZZ);
-		progressBarAdvance();
-		LoadLevelScreen();
 		
 		
 		// Decompress the actual scene data
 		size_t input_size = end - data;
 		LogDebug("FTS: decompressing " << input_size << " -> "
 		                               << uh->uncompressedsize);
-		bytes.reset(new char[uh->uncompressedsize]);
-		if(!bytes) {
-			LogError << "FTS: can't allocate buffer for uncompressed data";
+		if(uh->uncompressedsize <= 0) {
+			LogError << "FTS: invalid scene data size in " << file;
 			return false;
 		}
-		size = blastMem(data, input_size, bytes.get(), uh->uncompressedsize);
-		data = bytes.get(), end = bytes.get() + size;
+		buffer.resize(size_t(uh->uncompressedsize));
+		size = blastMem(data, input_size, &buffer[0], buffer.size());
 		if(!size) {
 			LogError << "FTS: error decompressing scene data in " << file;
+			buffer.clear();
 			return false;
-		} else if(size != size_t(uh->uncompressedsize)) {
+		} else if(size != buffer.size()) {
 			LogWarning << "FTS: unexpected decompressed size: " << size << " < "
 			           << uh->uncompressedsize << " in " << file;
+			buffer.resize(size);
 		}
-		progressBarAdvance(3.f);
-		LoadLevelScreen();
 		
 		
 	} catch(file_truncated_exception) {
 		LogError << "FTS: truncated file " << file;
+		buffer.clear();
 		return false;
 	}
 	
+	return true;
+}
+
+bool FastSceneLoad(const res::path & partial_path, const std::vector<char> & buffer) {
+	
+	res::path file = "game" / partial_path / "fast.fts";
+	
+	arx_assert(!buffer.empty());
+	
+	// Initialize the scene data
+	InitBkg(ACTIVEBKG, MAX_BKGX, MAX_BKGZ, BKG_SIZX, BKG_SIZZ);
+	progressBarAdvance();
+	LoadLevelScreen();
+	
 	try {
-		return loadFastScene(file, data, end);
+		return loadFastScene(file, &buffer[0], &buffer[0] + buffer.size());
 	} catch(file_truncated_exception) {
 		LogError << "FTS: truncated compressed data in " << file;
 		return false;
 	}
 }
 
+bool FastSceneLoad(const res::path & partial_path) {
+	
+	std::vector<char> buffer;
+	if(!FastSceneRead(partial_path, buffer)) {
+		return false;
+	}
+	progressBarAdvance(4.f);
+	LoadLevelScreen();
+	
+	return FastSceneLoad(partial_path, buffer);
+}
+
+
+typedef std::map<s32, TextureContainer *> TextureContainerMap;
+
+/*
+ * Baked scenes cache the background cells in their final in-memory layout.
+ * Converting the FTS polygons and computing the per-cell polygon lists takes most of
+ * the scene load time - baked cells only need to be copied and relocated.
+ */
+
+static const u32 BAKED_SCENE_MAGIC = 0x53424641; // "AFBS"
+static const u32 BAKED_SCENE_VERSION = 1;
+
+static fs::path getBakedSceneFile(u32 checksum, size_t size) {
+	
+	if(fs::paths.user.empty()) {
+		return fs::path();
+	}
+	
+	std::ostringstream oss;
+	oss << std::hex << std::setfill('0') << std::setw(8) << checksum
+	    << std::dec << '-' << size << ".scene";
+	
+	return fs::paths.user / "cache" / "scenes" / oss.str();
+}
+
+static void releaseBakedCells() {
+	for(long z = 0; z < ACTIVEBKG->Zsize; z++)
+	for(long x = 0; x < ACTIVEBKG->Xsize; x++) {
+		EERIE_BKG_INFO & bkg = ACTIVEBKG->fastdata[x][z];
+		free(bkg.polydata), bkg.polydata = NULL, bkg.nbpoly = 0;
+		free(bkg.polyin), bkg.polyin = NULL, bkg.nbpolyin = 0;
+	}
+}
+
+static bool loadBakedCells(const fs::path & file, u32 checksum,
+                           const TextureContainerMap & textures) {
+	
+	if(file.empty() || !fs::is_regular_file(file)) {
+		return false;
+	}
+	
+	// Read everything at once
+	std::istringstream is(fs::read(file));
+	
+	u32 magic, version, fileChecksum, polySize, sizex, sizez;
+	fs::read(is, magic);
+	fs::read(is, version);
+	fs::read(is, fileChecksum);
+	fs::read(is, polySize);
+	fs::read(is, sizex);
+	fs::read(is, sizez);
+	if(is.fail() || magic != BAKED_SCENE_MAGIC || version != BAKED_SCENE_VERSION
+	   || fileChecksum != checksum || polySize != sizeof(EERIEPOLY)
+	   || sizex != u32(ACTIVEBKG->Xsize) || sizez != u32(ACTIVEBKG->Zsize)) {
+		LogDebug("ignoring outdated baked scene " << file);
+		return false;
+	}
+	
+	// Polygons are stored as is - only the texture pointers need to be relocated
+	std::vector<s32> textureIds;
+	for(long z = 0; z < ACTIVEBKG->Zsize && !is.fail(); z++)
+	for(long x = 0; x < ACTIVEBKG->Xsize && !is.fail(); x++) {
+		
+		EERIE_BKG_INFO & bkg = ACTIVEBKG->fastdata[x][z];
+		
+		u32 nbpoly = 0;
+		if(fs::read(is, nbpoly).fail() || nbpoly == 0 || nbpoly > 0x7fff) {
+			if(nbpoly != 0) {
+				is.setstate(std::ios::failbit);
+			}
+			continue;
+		}
+		
+		bkg.polydata = (EERIEPOLY *)malloc(sizeof(EERIEPOLY) * nbpoly);
+		bkg.nbpoly = short(nbpoly);
+		textureIds.resize(nbpoly);
+		fs::read(is, bkg.polydata, sizeof(EERIEPOLY) * nbpoly);
+		fs::read(is, &textureIds[0], sizeof(s32) * nbpoly);
+		
+		for(size_t k = 0; k < nbpoly; k++) {
+			EERIEPOLY & ep = bkg.polydata[k];
+			ep.tex = NULL;
+			if(textureIds[k] != 0) {
+				TextureContainerMap::const_iterator cit = textures.find(textureIds[k]);
+				ep.tex = (cit != textures.end()) ? cit->second : NULL;
+			}
+		}
+	}
+	
+	// Polygons in each cell are referenced by cell and polygon index
+	std::vector<u32> polyin;
+	for(long z = 0; z < ACTIVEBKG->Zsize && !is.fail(); z++)
+	for(long x = 0; x < ACTIVEBKG->Xsize && !is.fail(); x++) {
+		
+		EERIE_BKG_INFO & bkg = ACTIVEBKG->fastdata[x][z];
+		
+		u32 nbpolyin = 0;
+		if(fs::read(is, nbpolyin).fail() || nbpolyin == 0 || nbpolyin > 0x7fff) {
+			if(nbpolyin != 0) {
+				is.setstate(std::ios::failbit);
+			}
+			continue;
+		}
+		
+		polyin.resize(nbpolyin);
+		if(fs::read(is, &polyin[0], sizeof(u32) * nbpolyin).fail()) {
+			continue;
+		}
+		
+		bkg.polyin = (EERIEPOLY **)malloc(sizeof(EERIEPOLY *) * nbpolyin);
+		bkg.nbpolyin = short(nbpolyin);
+		
+		for(size_t k = 0; k < nbpolyin; k++) {
+			size_t cell = polyin[k] >> 16, index = polyin[k] & 0xffff;
+			size_t x2 = cell % ACTIVEBKG->Xsize, z2 = cell / ACTIVEBKG->Xsize;
+			if(z2 >= size_t(ACTIVEBKG->Zsize)
+			   || index >= size_t(ACTIVEBKG->fastdata[x2][z2].nbpoly)) {
+				is.setstate(std::ios::failbit);
+				break;
+			}
+			bkg.polyin[k] = &ACTIVEBKG->fastdata[x2][z2].polydata[index];
+		}
+	}
+	
+	if(is.fail()) {
+		LogWarning << "Ignoring invalid baked scene " << file;
+		releaseBakedCells();
+		return false;
+	}
+	
+	return true;
+}
+
+static void saveBakedCells(const fs::path & file, u32 checksum,
+                           const TextureContainerMap & textures) {
+	
+	if(file.empty()) {
+		return;
+	}
+	
+	typedef std::map<TextureContainer *, s32> TextureIdMap;
+	TextureIdMap textureIds;
+	for(TextureContainerMap::const_iterator i = textures.begin(); i != textures.end(); ++i) {
+		textureIds.insert(std::make_pair(i->second, i->first));
+	}
+	
+	std::ostringstream os;
+	fs::write(os, BAKED_SCENE_MAGIC);
+	fs::write(os, BAKED_SCENE_VERSION);
+	fs::write(os, checksum);
+	fs::write(os, u32(sizeof(EERIEPOLY)));
+	fs::write(os, u32(ACTIVEBKG->Xsize));
+	fs::write(os, u32(ACTIVEBKG->Zsize));
+	
+	std::vector<s32> ids;
+	for(long z = 0; z < ACTIVEBKG->Zsize; z++)
+	for(long x = 0; x < ACTIVEBKG->Xsize; x++) {
+		
+		const EERIE_BKG_INFO & bkg = ACTIVEBKG->fastdata[x][z];
+		
+		fs::write(os, u32(bkg.nbpoly));
+		if(bkg.nbpoly <= 0) {
+			continue;
+		}
+		
+		ids.resize(bkg.nbpoly);
+		for(long k = 0; k < bkg.nbpoly; k++) {
+			TextureIdMap::const_iterator id = textureIds.find(bkg.polydata[k].tex);
+			ids[k] = (id != textureIds.end()) ? id->second : 0;
+		}
+		
+		fs::write(os, bkg.polydata, sizeof(EERIEPOLY) * bkg.nbpoly);
+		fs::write(os, &ids[0], sizeof(s32) * bkg.nbpoly);
+	}
+	
+	std::vector<u32> polyin;
+	for(long z = 0; z < ACTIVEBKG->Zsize; z++)
+	for(long x = 0; x < ACTIVEBKG->Xsize; x++) {
+		
+		const EERIE_BKG_INFO & bkg = ACTIVEBKG->fastdata[x][z];
+		
+		polyin.clear();
+		for(long k = 0; k < bkg.nbpolyin; k++) {
+			
+			// Polygons are only ever added to nearby cells
+			const EERIEPOLY * ep = bkg.polyin[k];
+			bool found = false;
+			for(long z2 = std::max(z - 2, 0L); z2 <= std::min(z + 2, ACTIVEBKG->Zsize - 1L) && !found; z2++)
+			for(long x2 = std::max(x - 2, 0L); x2 <= std::min(x + 2, ACTIVEBKG->Xsize - 1L) && !found; x2++) {
+				const EERIE_BKG_INFO & bkg2 = ACTIVEBKG->fastdata[x2][z2];
+				if(ep >= bkg2.polydata && ep < bkg2.polydata + bkg2.nbpoly) {
+					polyin.push_back(u32(z2 * ACTIVEBKG->Xsize + x2) << 16 | u32(ep - bkg2.polydata));
+					found = true;
+				}
+			}
+			
+			if(!found) {
+				LogWarning << "Cannot bake scene: unexpected polygon in cell " << x << " " << z;
+				return;
+			}
+		}
+		
+		fs::write(os, u32(polyin.size()));
+		if(!polyin.empty()) {
+			fs::write(os, &polyin[0], sizeof(u32) * polyin.size());
+		}
+	}
+	
+	if(!fs::create_directories(file.parent())) {
+		LogWarning << "Could not create scene cache directory " << file.parent();
+		return;
+	}
+	
+	// Write to a temporary file first so that other instances never see a partial cache
+	fs::path tempFile = file;
+	tempFile.append(".tmp");
+	if(!fs::write(tempFile, os.str()) || !fs::rename(tempFile, file, true)) {
+		LogWarning << "Could not write baked scene " << file;
+		fs::remove(tempFile);
+	}
+}
 
 static bool loadFastScene(const res::path & file, const char * data, const char * end) {
 	
+	const char * begin = data;
+	
 	// Read the scene header
 	const FAST_SCENE_HEADER * fsh = fts_read<FAST_SCENE_HEADER>(data, end);
 	if(fsh->version != FTS_VERSION) {
@@ -1348,7 +1585,6 @@ static bool loadFastScene(const res::path & file, const char * data, const char
 	
 	
 	// Load textures
-	typedef std::map<s32, TextureContainer *> TextureContainerMap;
 	TextureContainerMap textures;
 	const FAST_TEXTURE_CONTAINER * ftc;
 	ftc = fts_read<FAST_TEXTURE_CONTAINER>(data, end, fsh->nb_textures);
@@ -1364,6 +1600,16 @@ static bool loadFastScene(const res::path & file, const char * data, const char
 	LoadLevelScreen();
 	
 	
+	// Use the baked cells if this scene has already been loaded before
+	u32 checksum = u32(crc32(crc32(0, Z_NULL, 0), reinterpret_cast<const Bytef *>(begin),
+	                         uInt(end - begin)));
+	fs::path bakedFile = getBakedSceneFile(checksum, end - begin);
+	bool baked = loadBakedCells(bakedFile, checksum, textures);
+	if(baked) {
+		LogDebug("FTS: using baked scene " << bakedFile);
+	}
+	
+	
 	// Load cells with polygons and anchors
 	LogDebug("FTS: loading " << fsh->sizex << " x " << fsh->sizez
 	         << " cells ...");
@@ -1375,19 +1621,24 @@ static bool loadFastScene(const res::path & file, const char * data, const char
 			EERIE_BKG_INFO & bkg = ACTIVEBKG->fastdata[i][j];
 			
 			bkg.nbianchors = (short)fsi->nbianchors;
-			bkg.nbpoly = (short)fsi->nbpoly;
-			
-			if(fsi->nbpoly > 0) {
-				bkg.polydata = (EERIEPOLY *)malloc(sizeof(EERIEPOLY) * fsi->nbpoly);
-			} else {
-				bkg.polydata = NULL;
-			}
 			
 			bkg.treat = false;
 			
 			const FAST_EERIEPOLY * eps;
 			eps = fts_read<FAST_EERIEPOLY>(data, end, fsi->nbpoly);
-			for(long k = 0; k < fsi->nbpoly; k++) {
+			
+			if(baked) {
+				arx_assert(bkg.nbpoly == std::max(fsi->nbpoly, 0));
+			} else {
+				bkg.nbpoly = (short)fsi->nbpoly;
+				if(fsi->nbpoly > 0) {
+					bkg.polydata = (EERIEPOLY *)malloc(sizeof(EERIEPOLY) * fsi->nbpoly);
+				} else {
+					bkg.polydata = NULL;
+				}
+			}
+			
+			for(long k = 0; !baked && k < fsi->nbpoly; k++) {
 				
 				const FAST_EERIEPOLY * ep = &eps[k];
 				EERIEPOLY * ep2 = &bkg.polydata[k];
@@ -1601,7 +1852,11 @@ static bool loadFastScene(const res::path & file, const char * data, const char
 	
 	LogDebug("FTS: preparing scene data ...");
 	
-	EERIEPOLY_Compute_PolyIn();
+	if(!baked) {
+		EERIEPOLY_Compute_PolyIn();
+		// Bake the cells before the polygons are modified for rendering
+		saveBakedCells(bakedFile, checksum, textures);
+	}
 	progressBarAdvance(3.f);
 	LoadLevelScreen();
 	
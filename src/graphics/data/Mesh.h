@@ -48,6 +48,7 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #define ARX_GRAPHICS_DATA_MESH_H
 
 #include <set>
+#include <vector>
 
 #include "graphics/GraphicsTypes.h"
 #include "math/Rectangle.h"
@@ -146,6 +147,18 @@ void EE_RTP(const Vec3f & in, TexturedVertex & out);
 
 
 // FAST SAVE LOAD
+
+/*!
+ * Read and decompress the scene data of a fast scene file.
+ * This does not modify the current scene and can be called from any thread.
+ * \param path the scene directory
+ * \param buffer receives the decompressed scene data
+ */
+bool FastSceneRead(const res::path & path, std::vector<char> & buffer);
+
+//! Load the current scene from the data returned by \ref FastSceneRead
+bool FastSceneLoad(const res::path & path, const std::vector<char> & buffer);
+
 bool FastSceneLoad(const res::path & path);
 
 struct RenderMaterial;
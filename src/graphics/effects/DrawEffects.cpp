@@ -115,13 +115,13 @@ void ARXDRAW_DrawInterShadows() {
 		   || (io->ioflags & IO_JUST_COLLIDE)
 		   || (io->ioflags & IO_NOSHADOW)
 		   || (io->ioflags & IO_GOLD)
-		   || !(io->show == SHOW_FLAG_IN_SCENE)
+		   || !(io->show() == SHOW_FLAG_IN_SCENE)
 		) {
 			continue;
 		}
 		
 		
-		EERIE_BKG_INFO * bkgData = getFastBackgroundData(io->pos.x, io->pos.z);
+		EERIE_BKG_INFO * bkgData = getFastBackgroundData(io->pos().x, io->pos().z);
 		if(bkgData && !bkgData->treat) { //TODO is that correct ?
 			continue;
 		}
@@ -23,6 +23,10 @@
 #include <iomanip>
 #include <iterator>
 #include <cmath>
+#include <algorithm>
+#include <map>
+
+#include <boost/functional/hash.hpp>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -35,6 +39,9 @@
 #include "graphics/Vertex.h"
 
 #include "io/fs/FilePath.h"
+#include "io/fs/FileStream.h"
+#include "io/fs/Filesystem.h"
+#include "io/fs/SystemPaths.h"
 #include "io/resource/ResourcePath.h"
 #include "io/log/Logger.h"
 
@@ -43,7 +50,141 @@
 //! Pre-load all visible characters below this one when creating a font object
 static const Font::Char FONT_PRELOAD_LIMIT = 127;
 
-Font::Font(const res::path & fontFile, unsigned int fontSize, FT_Face face) 
+//! Maximum number of text runs cached per font before the cache is flushed
+static const size_t FONT_MAX_CACHED_RUNS = 512;
+
+//! FreeType flags used to load glyphs - changing these invalidates the glyph cache
+static const FT_Int32 FONT_LOAD_FLAGS = FT_LOAD_FORCE_AUTOHINT;
+
+static const u32 FONT_CACHE_MAGIC = 0x43474641; // "AFGC"
+static const u32 FONT_CACHE_VERSION = 1;
+static const u32 FONT_CACHE_FREETYPE_VERSION = FREETYPE_MAJOR * 10000 + FREETYPE_MINOR * 100
+                                               + FREETYPE_PATCH;
+
+static Font::CacheStats g_cacheStats = { 0, 0, 0, 0 };
+
+const Font::CacheStats & Font::getCacheStats() {
+	return g_cacheStats;
+}
+
+Font::GlyphTable::GlyphTable()
+	: m_count(0)
+{
+	Slot empty;
+	empty.character = util::INVALID_CHAR;
+	m_slots.resize(256, empty);
+}
+
+size_t Font::GlyphTable::findSlot(Char character) const {
+	
+	arx_assert(character != util::INVALID_CHAR);
+	
+	// The multiplier is odd, so the hash is a bijection modulo the power-of-two table size
+	// that spreads consecutive characters apart - linear probing resolves collisions
+	size_t mask = m_slots.size() - 1;
+	size_t i = size_t(character * 2654435761u) & mask;
+	while(m_slots[i].character != character && m_slots[i].character != util::INVALID_CHAR) {
+		i = (i + 1) & mask;
+	}
+	
+	return i;
+}
+
+const Font::Glyph * Font::GlyphTable::find(Char character) const {
+	const Slot & slot = m_slots[findSlot(character)];
+	return (slot.character == character) ? &slot.glyph : NULL;
+}
+
+Font::Glyph & Font::GlyphTable::operator[](Char character) {
+	
+	size_t i = findSlot(character);
+	if(m_slots[i].character == character) {
+		return m_slots[i].glyph;
+	}
+	
+	// Keep the load factor below 1/2
+	if((m_count + 1) * 2 > m_slots.size()) {
+		grow();
+		i = findSlot(character);
+	}
+	
+	m_count++;
+	m_slots[i].character = character;
+	m_slots[i].glyph = Glyph();
+	
+	return m_slots[i].glyph;
+}
+
+void Font::GlyphTable::grow() {
+	
+	std::vector<Slot> old(m_slots.size() * 2);
+	old.swap(m_slots);
+	
+	for(size_t i = 0; i < m_slots.size(); i++) {
+		m_slots[i].character = util::INVALID_CHAR;
+	}
+	
+	for(size_t i = 0; i < old.size(); i++) {
+		if(old[i].character != util::INVALID_CHAR) {
+			m_slots[findSlot(old[i].character)] = old[i];
+		}
+	}
+}
+
+void Font::GlyphTable::write(std::ostream & os) const {
+	
+	fs::write(os, u32(m_count));
+	
+	for(size_t i = 0; i < m_slots.size(); i++) {
+		if(m_slots[i].character != util::INVALID_CHAR) {
+			fs::write(os, u32(m_slots[i].character));
+			fs::write(os, m_slots[i].glyph);
+		}
+	}
+}
+
+bool Font::GlyphTable::read(std::istream & is) {
+	
+	u32 count;
+	fs::read(is, count);
+	if(is.fail() || count > 0x10ffff) {
+		return false;
+	}
+	
+	for(u32 i = 0; i < count; i++) {
+		
+		u32 character;
+		Glyph glyph;
+		fs::read(is, character);
+		fs::read(is, glyph);
+		if(is.fail() || character == util::INVALID_CHAR) {
+			return false;
+		}
+		
+		(*this)[character] = glyph;
+	}
+	
+	return true;
+}
+
+size_t Font::TextHash::operator()(const std::string & text) const {
+	return boost::hash_range(text.begin(), text.end());
+}
+
+size_t Font::TextHash::operator()(const TextRange & text) const {
+	return boost::hash_range(text.first, text.second);
+}
+
+bool Font::TextEqual::operator()(const std::string & a, const std::string & b) const {
+	return a == b;
+}
+
+bool Font::TextEqual::operator()(const TextRange & a, const std::string & b) const {
+	return size_t(a.second - a.first) == b.length() && std::equal(a.first, a.second, b.begin());
+}
+
+Font::Font(const res::path & fontFile, unsigned int fontSize, FT_Face face,
+           u32 fileChecksum)
 	: info(fontFile, fontSize)
 	, referenceCount(0)
 	, face(face)
@@ -55,15 +196,20 @@ Font::Font(const res::path & fontFile, unsigned int fontSize, FT_Face face)
 	// Insert all the glyphs into texture pages
 	textures = new PackedTexture(TEXTURE_SIZE, Image::Format_A8);
 	
-	// Insert the replacement characters first as they may be needed if others are missing
-	insertGlyph('?');
-	insertGlyph(util::REPLACEMENT_CHAR);
-	
-	// Pre-load glyphs for displayable ASCII characters
-	for(Char chr = 32; chr < FONT_PRELOAD_LIMIT; ++chr) {
-		if(chr != '?') {
-			insertGlyph(chr);
+	if(!loadGlyphCache(fileChecksum)) {
+		
+		// Insert the replacement characters first as they may be needed if others are missing
+		insertGlyph('?');
+		insertGlyph(util::REPLACEMENT_CHAR);
+		
+		// Pre-load glyphs for displayable ASCII characters
+		for(Char chr = 32; chr < FONT_PRELOAD_LIMIT; ++chr) {
+			if(chr != '?') {
+				insertGlyph(chr);
+			}
 		}
+		
+		saveGlyphCache(fileChecksum);
 	}
 	
 	textures->upload();
@@ -83,8 +229,9 @@ void Font::insertPlaceholderGlyph(Char character) {
 	if(character == util::REPLACEMENT_CHAR) {
 		
 		// Use '?' as a fallback replacement character
-		arx_assert(glyphs.find('?') != glyphs.end());
-		glyphs[character] = glyphs['?'];
+		arx_assert(glyphs.find('?') != NULL);
+		Glyph replacement = *glyphs.find('?');
+		glyphs[character] = replacement;
 		
 	} else if(character < 32 || character == '?') {
 		
@@ -104,8 +251,9 @@ void Font::insertPlaceholderGlyph(Char character) {
 		           << " (" << util::encode<util::UTF8>(character) << ") in font "
 		           << info.name;
 		
-		arx_assert(glyphs.find(util::REPLACEMENT_CHAR) != glyphs.end());
-		glyphs[character] = glyphs[util::REPLACEMENT_CHAR];
+		arx_assert(glyphs.find(util::REPLACEMENT_CHAR) != NULL);
+		Glyph replacement = *glyphs.find(util::REPLACEMENT_CHAR);
+		glyphs[character] = replacement;
 		
 	}
 }
@@ -119,7 +267,7 @@ bool Font::insertGlyph(Char character) {
 		return false;
 	}
 	
-	error = FT_Load_Glyph(face, glyphIndex, FT_LOAD_FORCE_AUTOHINT);
+	error = FT_Load_Glyph(face, glyphIndex, FONT_LOAD_FLAGS);
 	if(error) {
 		insertPlaceholderGlyph(character);
 		return false;
@@ -204,13 +352,95 @@ bool Font::writeToDisk() {
 	return ok;
 }
 
+fs::path Font::getGlyphCacheFile(u32 fileChecksum) const {
+	
+	if(fs::paths.user.empty()) {
+		return fs::path();
+	}
+	
+	std::ostringstream oss;
+	oss << std::hex << std::setfill('0') << std::setw(8) << fileChecksum
+	    << std::dec << '-' << info.size << ".glyphs";
+	
+	return fs::paths.user / "cache" / "fonts" / oss.str();
+}
+
+bool Font::loadGlyphCache(u32 fileChecksum) {
+	
+	fs::path file = getGlyphCacheFile(fileChecksum);
+	if(file.empty() || !fs::is_regular_file(file)) {
+		return false;
+	}
+	
+	// Read everything at once
+	std::istringstream is(fs::read(file));
+	
+	u32 magic, version, freetypeVersion, checksum, size, flags, glyphSize;
+	fs::read(is, magic);
+	fs::read(is, version);
+	fs::read(is, freetypeVersion);
+	fs::read(is, checksum);
+	fs::read(is, size);
+	fs::read(is, flags);
+	fs::read(is, glyphSize);
+	if(is.fail() || magic != FONT_CACHE_MAGIC || version != FONT_CACHE_VERSION
+	   || freetypeVersion != FONT_CACHE_FREETYPE_VERSION || checksum != fileChecksum
+	   || size != info.size || flags != u32(FONT_LOAD_FLAGS) || glyphSize != sizeof(Glyph)) {
+		LogDebug("ignoring outdated glyph cache " << file);
+		return false;
+	}
+	
+	if(!glyphs.read(is) || !textures->read(is)) {
+		LogWarning << "Ignoring invalid glyph cache " << file;
+		glyphs = GlyphTable();
+		textures->clear();
+		return false;
+	}
+	
+	LogDebug("loaded glyph cache " << file);
+	
+	return true;
+}
+
+void Font::saveGlyphCache(u32 fileChecksum) {
+	
+	fs::path file = getGlyphCacheFile(fileChecksum);
+	if(file.empty()) {
+		return;
+	}
+	
+	if(!fs::create_directories(file.parent())) {
+		LogWarning << "Could not create glyph cache directory " << file.parent();
+		return;
+	}
+	
+	std::ostringstream os;
+	fs::write(os, FONT_CACHE_MAGIC);
+	fs::write(os, FONT_CACHE_VERSION);
+	fs::write(os, FONT_CACHE_FREETYPE_VERSION);
+	fs::write(os, fileChecksum);
+	fs::write(os, u32(info.size));
+	fs::write(os, u32(FONT_LOAD_FLAGS));
+	fs::write(os, u32(sizeof(Glyph)));
+	glyphs.write(os);
+	textures->write(os);
+	
+	// Write to a temporary file first so that other instances never see a partial cache
+	fs::path tempFile = file;
+	tempFile.append(".tmp");
+	if(!fs::write(tempFile, os.str()) || !fs::rename(tempFile, file, true)) {
+		LogWarning << "Could not write glyph cache " << file;
+		fs::remove(tempFile);
+	}
+}
+
 bool Font::insertMissingGlyphs(text_iterator begin, text_iterator end) {
 	
 	Char chr;
 	bool changed = false;
 	
 	for(text_iterator it = begin; (chr = util::UTF8::read(it, end)) != util::INVALID_CHAR; ) {
-		if(glyphs.find(chr) == glyphs.end()) {
+		if(!glyphs.find(chr)) {
 			if(chr >= FONT_PRELOAD_LIMIT && insertGlyph(chr)) {
 				changed = true;
 			}
@@ -220,29 +450,32 @@ bool Font::insertMissingGlyphs(text_iterator begin, text_iterator end) {
 	return changed;
 }
 
-Font::glyph_iterator Font::getNextGlyph(text_iterator & it, text_iterator end) {
+const Font::Glyph * Font::getNextGlyph(text_iterator & it, text_iterator end) {
 	
 	Char chr = util::UTF8::read(it, end);
 	if(chr == util::INVALID_CHAR) {
-		return glyphs.end();
+		return NULL;
 	}
 	
-	glyph_iterator glyph = glyphs.find(chr);
-	if(glyph != glyphs.end()) {
+	const Glyph * glyph = glyphs.find(chr);
+	if(glyph) {
+		g_cacheStats.glyphHits++;
 		return glyph; // an existing glyph
 	}
 	
 	if(chr < FONT_PRELOAD_LIMIT) {
 		// We pre-load all glyphs for ASCII characters, so there is no point in checking again
-		return glyphs.end();
+		return NULL;
 	}
 	
+	g_cacheStats.glyphMisses++;
+	
 	if(!insertGlyph(chr)) {
 		// No new glyph was inserted but the character was mapped to an existing one
 		return glyphs.find(chr);
 	}
 	
-	arx_assert(glyphs.find(chr) != glyphs.end());
+	arx_assert(glyphs.find(chr) != NULL);
 	
 	// As we need to re-upload the textures now, first check for more missing glyphs
 	insertMissingGlyphs(it, end);
@@ -297,19 +530,14 @@ static void addGlyphVertices(std::vector<TexturedVertex> & vertices,
 	vertices.push_back(quad[3]);
 }
 
-template <bool DoDraw>
-Vec2i Font::process(int x, int y, text_iterator start, text_iterator end, Color color) {
+void Font::layout(TextRun & run, text_iterator start, text_iterator end) {
+	
+	// Subtract one line height (since we flipped the Y origin to be like GDI)
+	Vec2f pen(0.f, float(face->size->metrics.ascender >> 6));
 	
-	Vec2f pen(x, y);
-		
 	int startX = 0;
 	int endX = 0;
 	
-	if(DoDraw) {
-		// Subtract one line height (since we flipped the Y origin to be like GDI)
-		pen.y += face->size->metrics.ascender >> 6;
-	}
-	
 	FT_UInt prevGlyphIndex = 0;
 	FT_Pos prevRsbDelta = 0;
 
@@ -319,11 +547,11 @@ Vec2i Font::process(int x, int y, text_iterator start, text_iterator end, Color
 	for(text_iterator it = start; it != end; ) {
 		
 		// Get glyph in glyph map
-		glyph_iterator itGlyph = getNextGlyph(it, end);
-		if(itGlyph == glyphs.end()) {
+		const Glyph * nextGlyph = getNextGlyph(it, end);
+		if(!nextGlyph) {
 			continue;
 		}
-		const Glyph & glyph = itGlyph->second;
+		const Glyph & glyph = *nextGlyph;
 		
 		// Kerning
 		if(FT_HAS_KERNING(face)) {
@@ -343,11 +571,9 @@ Vec2i Font::process(int x, int y, text_iterator start, text_iterator end, Color
 		}
 		prevRsbDelta = glyph.rsb_delta;
 		
-		// Draw
-		if(DoDraw && glyph.size.x != 0 && glyph.size.y != 0) {
-			addGlyphVertices(mapTextureVertices[glyph.texture], glyph, pen, color);
-		} else {
-			ARX_UNUSED(pen), ARX_UNUSED(color);
+		// Draw - the color is applied when drawing the cached run
+		if(glyph.size.x != 0 && glyph.size.y != 0) {
+			addGlyphVertices(mapTextureVertices[glyph.texture], glyph, pen, Color::white);
 		}
 		
 		// If this is the first drawn char, note the start position
@@ -360,49 +586,90 @@ Vec2i Font::process(int x, int y, text_iterator start, text_iterator end, Color
 		pen.x += glyph.advance.x;
 	}
 	
-	if(DoDraw && !mapTextureVertices.empty()) {
-		
-		UseRenderState state(render2D());
-		
-		// Fixed pipeline texture stage operation
-		GRenderer->GetTextureStage(0)->setColorOp(TextureStage::ArgDiffuse);
-		GRenderer->GetTextureStage(0)->setAlphaOp(TextureStage::ArgTexture);
-
-		GRenderer->GetTextureStage(0)->setWrapMode(TextureStage::WrapClamp);
-		GRenderer->GetTextureStage(0)->setMinFilter(TextureStage::FilterNearest);
-		GRenderer->GetTextureStage(0)->setMagFilter(TextureStage::FilterNearest);
-
-		for(MapTextureVertices::const_iterator it = mapTextureVertices.begin(); it != mapTextureVertices.end(); ++it) {
-			
-			if(!it->second.empty()) {
-				GRenderer->SetTexture(0, &textures->getTexture(it->first));
-				EERIEDRAWPRIM(Renderer::TriangleList, &it->second[0], it->second.size());
-			}
-		}
-					
-		GRenderer->ResetTexture(0);
-		TextureStage * stage = GRenderer->GetTextureStage(0);
-		stage->setColorOp(TextureStage::OpModulate,
-		                  TextureStage::ArgTexture, TextureStage::ArgCurrent);
-		stage->setAlphaOp(TextureStage::ArgTexture);
-		stage->setWrapMode(TextureStage::WrapRepeat);
-		stage->setMinFilter(TextureStage::FilterLinear);
-		stage->setMagFilter(TextureStage::FilterLinear);
-		
+	run.pages.resize(mapTextureVertices.size());
+	std::vector<TextRunPage>::iterator page = run.pages.begin();
+	for(MapTextureVertices::iterator it = mapTextureVertices.begin(); it != mapTextureVertices.end(); ++it, ++page) {
+		page->texture = it->first;
+		page->vertices.swap(it->second);
 	}
 	
 	int sizeX = endX - startX;
 	int sizeY = face->size->metrics.height >> 6;
 	
-	return Vec2i(sizeX, sizeY);
+	run.size = Vec2i(sizeX, sizeY);
+}
+
+const Font::TextRun & Font::getTextRun(text_iterator start, text_iterator end) {
+	
+	TextRange text(start, end);
+	TextRuns::iterator it = runs.find(text, TextHash(), TextEqual());
+	if(it != runs.end()) {
+		g_cacheStats.runHits++;
+		return it->second;
+	}
+	
+	g_cacheStats.runMisses++;
+	
+	if(runs.size() >= FONT_MAX_CACHED_RUNS) {
+		// Dynamic text (timers, counters, ...) would otherwise grow the cache forever
+		runs.clear();
+	}
+	
+	TextRun & run = runs[std::string(start, end)];
+	layout(run, start, end);
+	
+	return run;
 }
 
 void Font::draw(int x, int y, text_iterator start, text_iterator end, Color color) {
-	process<true>(x, y, start, end, color);
+	
+	const TextRun & run = getTextRun(start, end);
+	if(run.pages.empty()) {
+		return;
+	}
+	
+	UseRenderState state(render2D());
+	
+	// Fixed pipeline texture stage operation
+	GRenderer->GetTextureStage(0)->setColorOp(TextureStage::ArgDiffuse);
+	GRenderer->GetTextureStage(0)->setAlphaOp(TextureStage::ArgTexture);
+
+	GRenderer->GetTextureStage(0)->setWrapMode(TextureStage::WrapClamp);
+	GRenderer->GetTextureStage(0)->setMinFilter(TextureStage::FilterNearest);
+	GRenderer->GetTextureStage(0)->setMagFilter(TextureStage::FilterNearest);
+	
+	// Runs are laid out at the origin - glyph positions are snapped to whole
+	// pixels, so moving them by a whole number of pixels gives the same result
+	Vec3f offset(float(x), float(y), 0.f);
+	ColorRGBA rgba = color.toRGBA();
+	
+	for(std::vector<TextRunPage>::const_iterator page = run.pages.begin();
+	    page != run.pages.end(); ++page) {
+		
+		drawVertices.resize(page->vertices.size());
+		for(size_t i = 0; i < page->vertices.size(); i++) {
+			drawVertices[i] = page->vertices[i];
+			drawVertices[i].p += offset;
+			drawVertices[i].color = rgba;
+		}
+		
+		GRenderer->SetTexture(0, &textures->getTexture(page->texture));
+		EERIEDRAWPRIM(Renderer::TriangleList, &drawVertices[0], drawVertices.size());
+	}
+	
+	GRenderer->ResetTexture(0);
+	TextureStage * stage = GRenderer->GetTextureStage(0);
+	stage->setColorOp(TextureStage::OpModulate,
+	                  TextureStage::ArgTexture, TextureStage::ArgCurrent);
+	stage->setAlphaOp(TextureStage::ArgTexture);
+	stage->setWrapMode(TextureStage::WrapRepeat);
+	stage->setMinFilter(TextureStage::FilterLinear);
+	stage->setMagFilter(TextureStage::FilterLinear);
+	
 }
 
 Vec2i Font::getTextSize(text_iterator start, text_iterator end) {
-	return process<false>(0, 0, start, end, Color::none);
+	return getTextRun(start, end).size;
 }
 
 int Font::getLineHeight() const {
@@ -20,14 +20,19 @@
 #ifndef ARX_GRAPHICS_FONT_FONT_H
 #define ARX_GRAPHICS_FONT_FONT_H
 
+#include <iosfwd>
 #include <string>
-#include <map>
+#include <utility>
+#include <vector>
 
 #include <boost/noncopyable.hpp>
+#include <boost/unordered_map.hpp>
 
 #include "graphics/Color.h"
+#include "graphics/Vertex.h"
 #include "math/Vector.h"
 
+#include "io/fs/FilePath.h"
 #include "io/resource/ResourcePath.h"
 
 class Font : private boost::noncopyable {
@@ -98,6 +103,25 @@ public:
 	
 	typedef std::string::const_iterator text_iterator;
 	
+	//! Glyph table and text run cache statistics, summed over all fonts
+	struct CacheStats {
+		
+		//! Glyph table lookups that found an existing glyph
+		size_t glyphHits;
+		
+		//! Glyph table lookups that had to load the glyph from the font
+		size_t glyphMisses;
+		
+		//! Text draw or size requests that used a cached run
+		size_t runHits;
+		
+		//! Text draw or size requests that had to lay out the text
+		size_t runMisses;
+		
+	};
+	
+	static const CacheStats & getCacheStats();
+	
 	const Info & getInfo() const { return info; }
 	const res::path & getName() const { return info.name; }
 	unsigned int getSize() const { return info.size; }
@@ -129,9 +153,22 @@ public:
 private:
 	
 	// Construction/destruction handled by FontCache only
-	Font(const res::path & fontFile, unsigned int fontSize, struct FT_FaceRec_ * face);
+	Font(const res::path & fontFile, unsigned int fontSize, struct FT_FaceRec_ * face,
+	     u32 fileChecksum);
 	~Font();
 	
+	//! \return the file used to cache the pre-loaded glyphs, or an empty path
+	fs::path getGlyphCacheFile(u32 fileChecksum) const;
+	
+	/*!
+	 * Load pre-rendered glyphs and textures stored by \ref saveGlyphCache()
+	 * \return false if there is no valid cache for this font file, size and hinting mode
+	 */
+	bool loadGlyphCache(u32 fileChecksum);
+	
+	//! Store the current glyphs and textures so that the next launch can skip rendering them
+	void saveGlyphCache(u32 fileChecksum);
+	
 	//! Maps the given character to a placeholder glyph
 	void insertPlaceholderGlyph(Char character);
 	
@@ -151,22 +188,92 @@ private:
 	
 private:
 	
-	template <bool Draw>
-	Vec2i process(int pX, int pY, text_iterator start, text_iterator end, Color color);
+	/*!
+	 * Flat open-addressed map from characters to glyphs
+	 * Glyphs are never removed, and references are invalidated by insertions.
+	 */
+	class GlyphTable {
+		
+	public:
+		
+		GlyphTable();
+		
+		//! \return the glyph for the given character or NULL if there is none
+		const Glyph * find(Char character) const;
+		
+		//! \return the glyph for the given character, inserting it if needed
+		Glyph & operator[](Char character);
+		
+		void write(std::ostream & os) const;
+		bool read(std::istream & is);
+		
+	private:
+		
+		struct Slot {
+			Char character; //!< util::INVALID_CHAR for empty slots
+			Glyph glyph;
+		};
+		
+		size_t findSlot(Char character) const;
+		void grow();
+		
+		std::vector<Slot> m_slots;
+		size_t m_count;
+		
+	};
+	
+	//! Vertices for one texture page of a laid out text run
+	struct TextRunPage {
+		unsigned int texture;
+		std::vector<TexturedVertex> vertices;
+	};
+	
+	//! A laid out text string, positioned at the origin
+	struct TextRun {
+		Vec2i size;
+		std::vector<TextRunPage> pages;
+	};
+	
+	typedef std::pair<text_iterator, text_iterator> TextRange;
+	
+	struct TextHash {
+		size_t operator()(const std::string & text) const;
+		size_t operator()(const TextRange & text) const;
+	};
+	
+	struct TextEqual {
+		bool operator()(const std::string & a, const std::string & b) const;
+		bool operator()(const TextRange & a, const std::string & b) const;
+	};
+	
+	typedef boost::unordered_map<std::string, TextRun, TextHash, TextEqual> TextRuns;
+	
+	/*!
+	 * Get the cached layout for a UTF-8 string, laying it out if needed
+	 * The returned reference is only valid until the next call.
+	 */
+	const TextRun & getTextRun(text_iterator start, text_iterator end);
+	
+	//! Lay out the UTF-8 string [start, end) at the origin
+	void layout(TextRun & run, text_iterator start, text_iterator end);
 	
 	Info info;
 	unsigned int referenceCount;
 	
 	struct FT_FaceRec_ * face;
-	std::map<Char, Glyph> glyphs;
-	typedef std::map<Char, Glyph>::const_iterator glyph_iterator;
+	GlyphTable glyphs;
+	
+	TextRuns runs;
+	
+	//! Buffer for positioned and colored copies of cached run vertices
+	std::vector<TexturedVertex> drawVertices;
 	
 	/*!
 	 * Parses UTF-8 input and returns the glyph for the first character
 	 * Inserts missing glyphs if possible.
-	 * \return a glyph iterator or m_Glyphs.end()
+	 * \return the glyph or NULL
 	 */
-	glyph_iterator getNextGlyph(text_iterator & it, text_iterator end);
+	const Glyph * getNextGlyph(text_iterator & it, text_iterator end);
 	
 	class PackedTexture * textures;
 	
@@ -25,6 +25,8 @@
 #include <map>
 #include <utility>
 
+#include <zlib.h>
+
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
@@ -49,8 +51,9 @@ private:
 		
 		size_t m_size;
 		char * m_data;
+		u32 m_checksum; //!< CRC-32 of the file contents, used to key the glyph cache
 		
-		FontFile() : m_size(0), m_data(NULL) { }
+		FontFile() : m_size(0), m_data(NULL), m_checksum(0) { }
 		
 		FontMap m_sizes;
 		
@@ -124,6 +127,8 @@ Font * FontCache::Impl::create(const res::path & font, FontFile & file, unsigned
 		if(!file.m_data) {
 			return NULL;
 		}
+		const Bytef * bytes = reinterpret_cast<const Bytef *>(file.m_data);
+		file.m_checksum = u32(crc32(crc32(0, Z_NULL, 0), bytes, uInt(file.m_size)));
 	}
 	
 	LogDebug("creating font " << font << " @ " << size);
@@ -149,7 +154,7 @@ Font * FontCache::Impl::create(const res::path & font, FontFile & file, unsigned
 		return NULL;
 	}
 	
-	return new Font(font, size, face);
+	return new Font(font, size, face, file.m_checksum);
 }
 
 void FontCache::Impl::releaseFont(Font * font) {
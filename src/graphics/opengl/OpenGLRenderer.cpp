@@ -47,6 +47,35 @@ static const char vertexShaderSource[] = "void main() {\n"
 	"	gl_FogFragCoord = vertex.z;\n"
 	"}\n";
 
+static const char spriteShaderSource[] = "attribute vec4 corner;\n"
+	"attribute vec4 center;\n"
+	"attribute vec4 color;\n"
+	"attribute vec4 axes;\n"
+	"void main() {\n"
+	"	// Expand the sprite quad in screen space.\n"
+	"	vec2 position = center.xy + corner.x * axes.xy + corner.y * axes.zw;\n"
+	"	// Convert pre-transformed D3D vertices to OpenGL vertices.\n"
+	"	float w = 1.0 / center.w;\n"
+	"	vec4 vertex = vec4(vec3(position, center.z) * w, w);\n"
+	"	gl_Position = gl_ProjectionMatrix * vertex;\n"
+	"	gl_FrontColor = gl_BackColor = color;\n"
+	"	gl_TexCoord[0] = vec4(corner.zw, 0.0, 1.0);\n"
+	"	gl_FogFragCoord = vertex.z;\n"
+	"}\n";
+
+// Attribute locations for spriteShaderSource, in the order of spriteShaderAttributes
+enum SpriteAttribute {
+	SpriteCorner,
+	SpriteCenter,
+	SpriteColor,
+	SpriteAxes,
+	SpriteAttributeCount
+};
+
+static const char * const spriteShaderAttributes[] = {
+	"corner", "center", "color", "axes", NULL
+};
+
 
 
 OpenGLRenderer::OpenGLRenderer()
@@ -54,6 +83,9 @@ OpenGLRenderer::OpenGLRenderer()
 	, useVBOs(false)
 	, maxTextureStage(0)
 	, shader(0)
+	, m_spriteShader(0)
+	, m_spriteCorners(GL_NONE)
+	, m_spriteBuffer(GL_NONE)
 	, m_maximumAnisotropy(1.f)
 	, m_maximumSupportedAnisotropy(1.f)
 	, m_glcull(GL_NONE)
@@ -99,7 +131,13 @@ static bool checkShader(GLuint object, const char * op, GLuint check) {
 	return true;
 }
 
-static GLuint loadVertexShader(const char * source) {
+/*!
+ * Compile and link a vertex shader program.
+ *
+ * \param attributes NULL-terminated list of vertex attribute names to bind to the
+ *                   locations matching their index, or NULL.
+ */
+static GLuint loadVertexShader(const char * source, const char * const * attributes = NULL) {
 	
 	GLuint shader = glCreateProgramObjectARB();
 	if(!shader) {
@@ -125,6 +163,10 @@ static GLuint loadVertexShader(const char * source) {
 	glAttachObjectARB(shader, obj);
 	glDeleteObjectARB(obj);
 	
+	for(GLuint i = 0; attributes && attributes[i]; i++) {
+		glBindAttribLocationARB(shader, i, attributes[i]);
+	}
+	
 	glLinkProgramARB(shader);
 	if(!checkShader(shader, "link", GL_OBJECT_LINK_STATUS_ARB)) {
 		glDeleteObjectARB(shader);
@@ -335,6 +377,8 @@ void OpenGLRenderer::reinit() {
 		}
 		if(!shader) {
 			LogWarning << "Missing vertex shader, cannot use vertex arrays for pre-transformed vertices.";
+		} else {
+			initSpriteInstancing();
 		}
 	}
 	
@@ -355,8 +399,11 @@ void OpenGLRenderer::shutdown() {
 	
 	onRendererShutdown();
 	
+	shutdownSpriteInstancing();
+	
 	if(shader) {
 		glDeleteObjectARB(shader);
+		shader = 0;
 	}
 	
 	for(size_t i = 0; i < m_TextureStages.size(); ++i) {
@@ -369,6 +416,65 @@ void OpenGLRenderer::shutdown() {
 	
 }
 
+void OpenGLRenderer::initSpriteInstancing() {
+	
+	#if defined(GL_ARB_instanced_arrays) && defined(GL_ARB_draw_instanced)
+	
+	if(!GLEW_ARB_instanced_arrays) {
+		LogInfo << "Missing OpenGL extension ARB_instanced_arrays, sprites will be expanded on the CPU.";
+		return;
+	}
+	
+	if(!GLEW_ARB_draw_instanced) {
+		LogInfo << "Missing OpenGL extension ARB_draw_instanced, sprites will be expanded on the CPU.";
+		return;
+	}
+	
+	m_spriteShader = loadVertexShader(spriteShaderSource, spriteShaderAttributes);
+	if(!m_spriteShader) {
+		LogWarning << "Missing sprite shader, sprites will be expanded on the CPU.";
+		return;
+	}
+	
+	// corner weights (x, y) and texture coordinates (z, w) - see SpriteInstance
+	static const GLfloat corners[] = {
+		-1.f, -1.f, 0.f, 0.f,
+		 1.f, -1.f, 1.f, 0.f,
+		 1.f,  1.f, 1.f, 1.f,
+		-1.f,  1.f, 0.f, 1.f
+	};
+	
+	glGenBuffers(1, &m_spriteCorners);
+	bindBuffer(m_spriteCorners);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+	
+	glGenBuffers(1, &m_spriteBuffer);
+	
+	#endif
+	
+}
+
+void OpenGLRenderer::shutdownSpriteInstancing() {
+	
+	if(m_spriteBuffer != GL_NONE) {
+		unbindBuffer(m_spriteBuffer);
+		glDeleteBuffers(1, &m_spriteBuffer);
+		m_spriteBuffer = GL_NONE;
+	}
+	
+	if(m_spriteCorners != GL_NONE) {
+		unbindBuffer(m_spriteCorners);
+		glDeleteBuffers(1, &m_spriteCorners);
+		m_spriteCorners = GL_NONE;
+	}
+	
+	if(m_spriteShader) {
+		glDeleteObjectARB(m_spriteShader);
+		m_spriteShader = 0;
+	}
+	
+}
+
 static glm::mat4x4 projection;
 static glm::mat4x4 view;
 
@@ -741,6 +847,60 @@ void OpenGLRenderer::drawIndexed(Primitive primitive, const TexturedVertex * ver
 	}
 }
 
+void OpenGLRenderer::drawSprites(const SpriteInstance * sprites, size_t count) {
+	
+	arx_assert(m_spriteShader);
+	
+	#if defined(GL_ARB_instanced_arrays) && defined(GL_ARB_draw_instanced)
+	
+	if(count == 0) {
+		return;
+	}
+	
+	beforeDraw<TexturedVertex>();
+	
+	// The fixed-function vertex array aliases generic attribute 0
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glDisableClientState(GL_COLOR_ARRAY);
+	switchVertexArray(GL_NoArray, NULL, 0);
+	
+	glUseProgram(m_spriteShader);
+	
+	bindBuffer(m_spriteCorners);
+	glEnableVertexAttribArrayARB(SpriteCorner);
+	glVertexAttribPointerARB(SpriteCorner, 4, GL_FLOAT, GL_FALSE, 0, NULL);
+	
+	bindBuffer(m_spriteBuffer);
+	// Orphan the old contents to avoid waiting for the GL
+	glBufferData(GL_ARRAY_BUFFER, count * sizeof(SpriteInstance), sprites, GL_STREAM_DRAW);
+	
+	const SpriteInstance * instances = NULL;
+	const GLsizei stride = sizeof(SpriteInstance);
+	glVertexAttribPointerARB(SpriteCenter, 4, GL_FLOAT, GL_FALSE, stride, &instances->p);
+	glVertexAttribPointerARB(SpriteColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, &instances->color);
+	glVertexAttribPointerARB(SpriteAxes, 4, GL_FLOAT, GL_FALSE, stride, &instances->a);
+	for(GLuint i = SpriteCenter; i < SpriteAttributeCount; i++) {
+		glEnableVertexAttribArrayARB(i);
+		glVertexAttribDivisorARB(i, 1);
+	}
+	
+	glDrawArraysInstancedARB(GL_TRIANGLE_FAN, 0, 4, count);
+	
+	for(GLuint i = SpriteCenter; i < SpriteAttributeCount; i++) {
+		glVertexAttribDivisorARB(i, 0);
+	}
+	for(GLuint i = 0; i < SpriteAttributeCount; i++) {
+		glDisableVertexAttribArrayARB(i);
+	}
+	
+	glUseProgram(shader);
+	
+	#else
+	ARX_UNUSED(sprites), ARX_UNUSED(count);
+	#endif
+	
+}
+
 bool OpenGLRenderer::getSnapshot(Image & image) {
 	
 	Vec2i size = mainApp->getWindow()->getSize();
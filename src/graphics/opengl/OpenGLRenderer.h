@@ -86,6 +86,9 @@ public:
 	
 	void drawIndexed(Primitive primitive, const TexturedVertex * vertices, size_t nvertices, unsigned short * indices, size_t nindices);
 	
+	bool hasSpriteInstancing() { return m_spriteShader != 0; }
+	void drawSprites(const SpriteInstance * sprites, size_t count);
+	
 	bool getSnapshot(Image & image);
 	bool getSnapshot(Image & image, size_t width, size_t height);
 	
@@ -124,6 +127,13 @@ private:
 	
 	GLuint shader;
 	
+	void initSpriteInstancing();
+	void shutdownSpriteInstancing();
+	
+	GLuint m_spriteShader; //!< Vertex shader to expand \ref SpriteInstance quads
+	GLuint m_spriteCorners; //!< Static buffer with the per-vertex quad corners
+	GLuint m_spriteBuffer; //!< Stream buffer for per-instance sprite data
+	
 	float m_maximumAnisotropy;
 	float m_maximumSupportedAnisotropy;
 	
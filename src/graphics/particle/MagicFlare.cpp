@@ -205,7 +205,7 @@ void AddFlare(const Vec2s & pos, float sm, short typ, Entity * io, bool bookDraw
 		float vx = -(flare.pos.x - subj.center.x) * 0.2173913f;
 		float vy = (flare.pos.y - subj.center.y) * 0.1515151515151515f;
 		if(io) {
-			flare.v.p = io->pos;
+			flare.v.p = io->pos();
 			flare.v.p += angleToVectorXZ(io->angle.getPitch() + vx) * 100.f;
 			flare.v.p.y += std::sin(glm::radians(MAKEANGLE(io->angle.getYaw() + vy))) * 100.f - 150.f;
 		} else {
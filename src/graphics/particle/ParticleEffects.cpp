@@ -75,6 +75,7 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 
 #include "math/Random.h"
 
+#include "platform/Time.h"
 #include "platform/profiler/Profiler.h"
 
 #include "physics/Collisions.h"
@@ -86,9 +87,17 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 //TODO(lubosz): extern globals :(
 extern Color ulBKGColor;
 
-static const size_t MAX_PARTICLES = 2200;
-static long ParticleCount = 0;
+static const size_t MAX_PARTICLES = 4096;
+
+/*!
+ * Active particles are kept packed at the start of the array: slots
+ * [0, ParticleCount) are in use and everything after that is free.
+ * Dead particles are replaced by the last active one so that allocation
+ * and update never need to look at unused slots.
+ */
+static size_t ParticleCount = 0;
 static PARTICLE_DEF particle[MAX_PARTICLES];
+static u64 ParticleUpdateTime = 0;
 
 static TextureContainer * blood_splat = NULL;
 static TextureContainer * bloodsplat[6];
@@ -105,7 +114,19 @@ static TextureContainer * explo[MAX_EXPLO]; // TextureContainer for animated exp
 long			NewSpell=0;
 
 long getParticleCount() {
-	return ParticleCount;
+	return long(ParticleCount);
+}
+
+u64 getParticleUpdateTime() {
+	return ParticleUpdateTime;
+}
+
+static void removeParticle(size_t i) {
+	arx_assert(i < ParticleCount);
+	ParticleCount--;
+	if(i != ParticleCount) {
+		particle[i] = particle[ParticleCount];
+	}
 }
 
 void createFireParticles(Vec3f & pos, int perPos, int delay) {
@@ -590,10 +611,10 @@ void MakeCoolFx(const Vec3f & pos) {
 }
 
 void MakePlayerAppearsFX(Entity * io) {
-	MakeCoolFx(io->pos);
-	MakeCoolFx(io->pos);
+	MakeCoolFx(io->pos());
+	MakeCoolFx(io->pos());
 	AddRandomSmoke(io, 30);
-	ARX_PARTICLES_Add_Smoke(io->pos, 1 | 2, 20); // flag 1 = randomize pos
+	ARX_PARTICLES_Add_Smoke(io->pos(), 1 | 2, 20); // flag 1 = randomize pos
 }
 
 void AddRandomSmoke(Entity * io, long amount) {
@@ -825,7 +846,7 @@ void Add3DBoom(const Vec3f & position) {
 		const EntityHandle handle = EntityHandle(i);
 		Entity * entity = entities[handle];
 		
-		if(!entity || entity->show != 1 || !(entity->ioflags & IO_ITEM)) {
+		if(!entity || entity->show() != 1 || !(entity->ioflags & IO_ITEM)) {
 			continue;
 		}
 		
@@ -883,7 +904,7 @@ void ARX_PARTICLES_FirstInit() {
 
 void ARX_PARTICLES_ClearAll() {
 	
-	std::fill(particle, particle + MAX_PARTICLES, PARTICLE_DEF());
+	std::fill(particle, particle + ParticleCount, PARTICLE_DEF());
 	ParticleCount = 0;
 }
 
@@ -893,32 +914,25 @@ PARTICLE_DEF * createParticle(bool allocateWhilePaused) {
 		return NULL;
 	}
 	
-	for(size_t i = 0; i < MAX_PARTICLES; i++) {
-		
-		PARTICLE_DEF * pd = &particle[i];
-		
-		if(pd->exist) {
-			continue;
-		}
-		
-		ParticleCount++;
-		pd->exist = true;
-		pd->timcreation = arxtime.now_ul();
-		
-		pd->is2D = false;
-		pd->rgb = Color3f::white;
-		pd->tc = NULL;
-		pd->special = 0;
-		pd->source = NULL;
-		pd->delay = 0;
-		pd->zdec = false;
-		pd->move = Vec3f_ZERO;
-		pd->scale = Vec3f_ONE;
-		
-		return pd;
+	if(ParticleCount == MAX_PARTICLES) {
+		return NULL;
 	}
 	
-	return NULL;
+	PARTICLE_DEF * pd = &particle[ParticleCount++];
+	
+	pd->timcreation = arxtime.now_ul();
+	
+	pd->is2D = false;
+	pd->rgb = Color3f::white;
+	pd->tc = NULL;
+	pd->special = 0;
+	pd->source = NULL;
+	pd->delay = 0;
+	pd->zdec = false;
+	pd->move = Vec3f_ZERO;
+	pd->scale = Vec3f_ONE;
+	
+	return pd;
 }
 
 void MagFX(const Vec3f & pos, float size) {
@@ -1068,20 +1082,19 @@ void ARX_PARTICLES_Update(EERIE_CAMERA * cam)  {
 	}
 	
 	if(ParticleCount == 0) {
+		ParticleUpdateTime = 0;
 		return;
 	}
 	
-	const unsigned long now = arxtime.now_ul();
+	const u64 startTime = platform::getTimeUs();
 	
-	long pcc = ParticleCount;
+	const unsigned long now = arxtime.now_ul();
 	
-	for(size_t i = 0; i < MAX_PARTICLES && pcc > 0; i++) {
-
+	// Removing a particle moves the last one into its slot, so re-visit index i
+	for(size_t i = 0; i < ParticleCount; i++) {
+		
 		PARTICLE_DEF * part = &particle[i];
-		if(!part->exist) {
-			continue;
-		}
-
+		
 		long framediff = part->timcreation + part->tolive - now;
 		long framediff2 = now - part->timcreation;
 		
@@ -1096,7 +1109,7 @@ void ARX_PARTICLES_Update(EERIE_CAMERA * cam)  {
 					&& entities[part->sourceionum]) {
 				part->ov = *part->source;
 				Entity * target = entities[part->sourceionum];
-				Vec3f vector = (part->ov - target->pos) * Vec3f(1.f, 0.5f, 1.f);
+				Vec3f vector = (part->ov - target->pos()) * Vec3f(1.f, 0.5f, 1.f);
 				vector = glm::normalize(vector);
 				part->move = vector * Vec3f(18.f, 5.f, 18.f) + randomVec(-0.5f, 0.5f);
 				
@@ -1109,8 +1122,7 @@ void ARX_PARTICLES_Update(EERIE_CAMERA * cam)  {
 			EERIE_BKG_INFO * bkgData = getFastBackgroundData(part->ov.x, part->ov.z);
 
 			if(!bkgData || !bkgData->treat) {
-				part->exist = false;
-				ParticleCount--;
+				removeParticle(i--);
 				continue;
 			}
 		}
@@ -1131,8 +1143,7 @@ void ARX_PARTICLES_Update(EERIE_CAMERA * cam)  {
 				framediff = part->tolive;
 				
 			} else {
-				part->exist = false;
-				ParticleCount--;
+				removeParticle(i--);
 				continue;
 			}
 		}
@@ -1205,8 +1216,7 @@ void ARX_PARTICLES_Update(EERIE_CAMERA * cam)  {
 						Color3f rgb = part->rgb;
 						SpawnGroundSplat(sp, rgb, 0);
 					}
-					part->exist = false;
-					ParticleCount--;
+					removeParticle(i--);
 					continue;
 				}
 			}
@@ -1219,8 +1229,7 @@ void ARX_PARTICLES_Update(EERIE_CAMERA * cam)  {
 						Color3f rgb = part->rgb * 0.5f;
 						SpawnGroundSplat(sp, rgb, 2);
 					}
-					part->exist = false;
-					ParticleCount--;
+					removeParticle(i--);
 					continue;
 				}
 			}
@@ -1232,7 +1241,6 @@ void ARX_PARTICLES_Update(EERIE_CAMERA * cam)  {
 		}
 		
 		if(r <= 0.f) {
-			pcc--;
 			continue;
 		}
 		
@@ -1306,8 +1314,9 @@ void ARX_PARTICLES_Update(EERIE_CAMERA * cam)  {
 			
 		}
 		
-		pcc--;
 	}
+	
+	ParticleUpdateTime = platform::getElapsedUs(startTime);
 }
 
 void RestoreAllLightsInitialStatus() {
@@ -106,7 +106,6 @@ struct POLYBOOM {
 };
 
 struct PARTICLE_DEF {
-	bool exist;
 	bool is2D;
 	Vec3f ov;
 	Vec3f move;
@@ -129,8 +128,7 @@ struct PARTICLE_DEF {
 	char cval2;
 	
 	PARTICLE_DEF()
-		: exist(false)
-		, is2D(false)
+		: is2D(false)
 		, ov(Vec3f_ZERO)
 		, move(Vec3f_ZERO)
 		, scale(Vec3f_ZERO)
@@ -178,8 +176,18 @@ void MakePlayerAppearsFX(Entity * io);
 void MakeCoolFx(const Vec3f & pos);
 void SpawnGroundSplat(const Sphere & sp, const Color3f & col, long flags);
 
+/*!
+ * Allocate a new particle
+ *
+ * The returned pointer is only valid until the next call to
+ * \ref ARX_PARTICLES_Update() or \ref ARX_PARTICLES_ClearAll().
+ *
+ * \return the new particle or NULL if the pool is full or the game is paused.
+ */
 PARTICLE_DEF * createParticle(bool allocateWhilePaused = false);
 long getParticleCount();
+//! Time spent in the last \ref ARX_PARTICLES_Update() call, in microseconds
+u64 getParticleUpdateTime();
 
 void ARX_PARTICLES_FirstInit();
 void ARX_PARTICLES_ClearAll();
@@ -49,59 +49,75 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 
 #include "platform/profiler/Profiler.h"
 
-ParticleManager::ParticleManager() {
-	listParticleSystem.clear();
-}
+ParticleManager::ParticleManager() { }
 
 ParticleManager::~ParticleManager() {
+	
 	Clear();
+	
+	BOOST_FOREACH(ParticleSystem * p, m_freeSystems) {
+		delete p;
+	}
+	
+	m_freeSystems.clear();
 }
 
 void ParticleManager::Clear() {
 	
-	BOOST_FOREACH(ParticleSystem * p, listParticleSystem) {
-		delete p;
+	BOOST_FOREACH(ParticleSystem * p, m_systems) {
+		RecycleSystem(p);
 	}
 	
-	listParticleSystem.clear();
+	m_systems.clear();
+}
+
+void ParticleManager::RecycleSystem(ParticleSystem * ps) {
+	ps->Reset();
+	m_freeSystems.push_back(ps);
+}
+
+ParticleSystem * ParticleManager::NewSystem() {
+	
+	if(m_freeSystems.empty()) {
+		return new ParticleSystem();
+	}
+	
+	ParticleSystem * ps = m_freeSystems.back();
+	m_freeSystems.pop_back();
+	return ps;
 }
 
 void ParticleManager::AddSystem(ParticleSystem * _pPS) {
-	listParticleSystem.insert(listParticleSystem.end(), _pPS);
+	m_systems.push_back(_pPS);
 }
 
 void ParticleManager::Update(long _lTime) {
 	
 	ARX_PROFILE_FUNC();
 	
-	if(listParticleSystem.empty())
+	if(m_systems.empty())
 		return;
-
-	std::list<ParticleSystem *>::iterator i;
-	i = listParticleSystem.begin();
-
-	while(i != listParticleSystem.end()) {
-		ParticleSystem * p = *i;
-		++i;
-
+	
+	size_t alive = 0;
+	for(size_t i = 0; i < m_systems.size(); i++) {
+		ParticleSystem * p = m_systems[i];
+		
 		if(!p->IsAlive()) {
-			delete p;
-			listParticleSystem.remove(p);
+			RecycleSystem(p);
 		} else {
 			p->Update(_lTime);
+			m_systems[alive++] = p;
 		}
 	}
+	
+	m_systems.resize(alive);
 }
 
 void ParticleManager::Render() {
 	
 	ARX_PROFILE_FUNC();
 	
-	std::list<ParticleSystem *>::iterator i;
-
-	for(i = listParticleSystem.begin(); i != listParticleSystem.end(); ++i) {
-		ParticleSystem * p = *i;
+	BOOST_FOREACH(ParticleSystem * p, m_systems) {
 		p->Render();
 	}
 }
-
@@ -44,7 +44,7 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #ifndef ARX_GRAPHICS_PARTICLE_PARTICLEMANAGER_H
 #define ARX_GRAPHICS_PARTICLE_PARTICLEMANAGER_H
 
-#include <list>
+#include <vector>
 
 class ParticleSystem;
 
@@ -52,7 +52,12 @@ class ParticleManager {
 	
 private:
 	
-	std::list<ParticleSystem *> listParticleSystem;
+	std::vector<ParticleSystem *> m_systems;
+	
+	//! Finished systems that are kept so their particle storage can be reused
+	std::vector<ParticleSystem *> m_freeSystems;
+	
+	void RecycleSystem(ParticleSystem * ps);
 	
 public:
 	
@@ -61,6 +66,14 @@ public:
 	
 	void Clear();
 	
+	/*!
+	 * Get an unused particle system, reusing a finished one if possible
+	 *
+	 * The system is in its default state and should be handed back using
+	 * \ref AddSystem() once it has been set up.
+	 */
+	ParticleSystem * NewSystem();
+	
 	void AddSystem(ParticleSystem * ps);
 	
 	void Update(long alTime);
@@ -46,7 +46,6 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include <cstdio>
 #include <cstring>
 
-#include <boost/foreach.hpp>
 #include <glm/gtc/random.hpp>
 
 #include "core/GameTime.h"
@@ -63,14 +62,25 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 
 
 ParticleSystem::ParticleSystem() {
+	Reset();
+}
+
+ParticleSystem::~ParticleSystem() { }
+
+void ParticleSystem::Reset() {
 	
-	int i;
-	for(i = 0; i < 20; i++) {
+	m_particles.clear();
+	
+	for(size_t i = 0; i < ARRAY_SIZE(tex_tab); i++) {
 		tex_tab[i] = NULL;
 	}
 	
+	m_parameters = ParticleParams();
 	m_parameters.m_nbMax = 50;
 	
+	m_nextPosition = Vec3f_ZERO;
+	m_storedTime.reset();
+	
 	iParticleNbAlive = 0;
 	iNbTex = 0;
 	iTexTime = 500;
@@ -110,15 +120,6 @@ ParticleSystem::ParticleSystem() {
 	m_parameters.m_blendMode = RenderMaterial::Additive;
 }
 
-ParticleSystem::~ParticleSystem() {
-	
-	BOOST_FOREACH(Particle * p, listParticle) {
-		delete p;
-	}
-	
-	listParticle.clear();
-}
-
 void ParticleSystem::SetPos(const Vec3f & pos) {
 	
 	m_nextPosition = pos;
@@ -128,6 +129,8 @@ void ParticleSystem::SetParams(const ParticleParams & _pp) {
 	
 	m_parameters = _pp;
 	
+	m_particles.reserve(std::max(m_parameters.m_nbMax, 0));
+	
 	m_parameters.m_direction = glm::normalize(m_parameters.m_direction);
 	Vec3f eVect(m_parameters.m_direction.x, -m_parameters.m_direction.y, m_parameters.m_direction.z);
 	GenerateMatrixUsingVector(eMat, eVect, 0);
@@ -255,24 +258,24 @@ void ParticleSystem::Update(long _lTime) {
 	
 	iParticleNbAlive = 0;
 	
-	std::list<Particle *>::iterator i;
-	for(i = listParticle.begin(); i != listParticle.end(); ) {
-		Particle * pP = *i;
+	for(size_t i = 0; i < m_particles.size(); ) {
+		Particle & pP = m_particles[i];
 		
-		if(pP->isAlive()) {
-			pP->Update(_lTime);
-			pP->p3Velocity += m_parameters.m_gravity * fTimeSec;
+		if(pP.isAlive()) {
+			pP.Update(_lTime);
+			pP.p3Velocity += m_parameters.m_gravity * fTimeSec;
 			iParticleNbAlive ++;
 			++i;
 		} else {
 			if(iParticleNbAlive >= m_parameters.m_nbMax) {
-				delete pP;
-				i = listParticle.erase(i);
+				// Move the last particle into this slot, it will be updated next
+				pP = m_particles.back();
+				m_particles.pop_back();
 			} else {
-				pP->Regen();
-				SetParticleParams(pP);
-				pP->Validate();
-				pP->Update(0);
+				pP.Regen();
+				SetParticleParams(&pP);
+				pP.Validate();
+				pP.Update(0);
 				iParticleNbAlive++;
 				++i;
 			}
@@ -288,11 +291,11 @@ void ParticleSystem::Update(long _lTime) {
 		}
 		
 		for(size_t iNb = 0; iNb < t; iNb++) {
-			Particle * pP  = new Particle();
-			SetParticleParams(pP);
-			pP->Validate();
-			pP->Update(0);
-			listParticle.insert(listParticle.end(), pP);
+			m_particles.push_back(Particle());
+			Particle & pP = m_particles.back();
+			SetParticleParams(&pP);
+			pP.Validate();
+			pP.Update(0);
 			iParticleNbAlive++;
 		}
 	}
@@ -310,10 +313,8 @@ void ParticleSystem::Render() {
 
 	int inumtex = 0;
 
-	std::list<Particle *>::iterator i;
-
-	for(i = listParticle.begin(); i != listParticle.end(); ++i) {
-		Particle * p = *i;
+	for(size_t i = 0; i < m_particles.size(); i++) {
+		Particle * p = &m_particles[i];
 
 		if(p->isAlive()) {
 			if(m_parameters.m_flash > 0) {
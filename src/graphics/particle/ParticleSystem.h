@@ -44,11 +44,12 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #ifndef ARX_GRAPHICS_PARTICLE_PARTICLESYSTEM_H
 #define ARX_GRAPHICS_PARTICLE_PARTICLESYSTEM_H
 
-#include <list>
+#include <vector>
 
 #include "graphics/BaseGraphicsTypes.h"
 #include "graphics/Renderer.h"
 #include "graphics/Draw.h"
+#include "graphics/particle/Particle.h"
 #include "graphics/particle/ParticleParams.h"
 #include "math/Types.h"
 #include "math/Vector.h"
@@ -56,7 +57,6 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include "platform/Alignment.h"
 #include "util/Flags.h"
  
-class Particle;
 class ParticleParams;
 class TextureContainer;
 
@@ -64,7 +64,8 @@ class ParticleSystem {
 	
 public:
 	
-	std::list<Particle *> listParticle;
+	//! Particles are stored by value and recycled in place once they die
+	std::vector<Particle> m_particles;
 	
 	// these are used for the particles it creates
 	ParticleParams m_parameters;
@@ -72,6 +73,14 @@ public:
 	ParticleSystem();
 	~ParticleSystem();
 	
+	/*!
+	 * Restore the default state of a newly created system
+	 *
+	 * Storage allocated for the particles is kept so that the system can be
+	 * reused without allocating.
+	 */
+	void Reset();
+	
 	void SetParams(const ParticleParams & app);
 	
 	void SetPos(const Vec3f & pos);
@@ -78,8 +78,10 @@ extern ParticleManager * pParticleManager;
 
 static void LaunchPoisonExplosion(const Vec3f & aePos) {
 	
+	arx_assert(pParticleManager);
+	
 	// système de partoches pour l'explosion
-	ParticleSystem * pPS = new ParticleSystem();
+	ParticleSystem * pPS = pParticleManager->NewSystem();
 	ParticleParams cp = ParticleParams();
 	cp.m_nbMax = 80; 
 	cp.m_life = 1500;
@@ -115,17 +117,14 @@ static void LaunchPoisonExplosion(const Vec3f & aePos) {
 	pPS->SetPos(aePos);
 	pPS->Update(0);
 
-	std::list<Particle *>::iterator i;
-
-	for(i = pPS->listParticle.begin(); i != pPS->listParticle.end(); ++i) {
-		Particle * pP = *i;
+	for(size_t i = 0; i < pPS->m_particles.size(); i++) {
+		Particle * pP = &pPS->m_particles[i];
 
 		if(pP->isAlive()) {
 			pP->p3Velocity = glm::clamp(pP->p3Velocity, Vec3f(0, -100, 0), Vec3f(0, 100, 0));
 		}
 	}
 
-	arx_assert(pParticleManager);
 	pParticleManager->AddSystem(pPS);
 }
 
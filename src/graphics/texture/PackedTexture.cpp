@@ -19,8 +19,12 @@
 
 #include "graphics/texture/PackedTexture.h"
 
+#include <istream>
+#include <ostream>
+
 #include "graphics/Renderer.h"
 #include "graphics/texture/Texture.h"
+#include "io/fs/FileStream.h"
 #include "io/log/Logger.h"
 
 PackedTexture::PackedTexture(unsigned int pSize, Image::Format pFormat)
@@ -92,7 +96,7 @@ bool PackedTexture::insertImage(const Image & image, unsigned int & textureIndex
 	TextureTree::Node * node = NULL;
 	unsigned int nodeTree = 0;
 	
-	for(size_t i = 0; i < textures.size(); i++) {
+	for(size_t i = 0; i < textures.size() && !node; i++) {
 		node = textures[i]->insertImage(image);
 		nodeTree = i;
 	}
@@ -122,6 +126,69 @@ bool PackedTexture::insertImage(const Image & image, unsigned int & textureIndex
 	return node != NULL;
 }
 
+void PackedTexture::write(std::ostream & os) const {
+	
+	fs::write(os, u32(textureSize));
+	fs::write(os, u32(textureFormat));
+	fs::write(os, u32(textures.size()));
+	
+	for(size_t i = 0; i < textures.size(); i++) {
+		textures[i]->write(os);
+	}
+}
+
+bool PackedTexture::read(std::istream & is) {
+	
+	clear();
+	
+	u32 size, format, count;
+	fs::read(is, size);
+	fs::read(is, format);
+	fs::read(is, count);
+	if(is.fail() || size != textureSize || format != u32(textureFormat)) {
+		return false;
+	}
+	
+	for(u32 i = 0; i < count; i++) {
+		
+		TextureTree * tree = new TextureTree(textureSize, textureFormat);
+		if(!tree->texture) {
+			delete tree;
+			clear();
+			return false;
+		}
+		textures.push_back(tree);
+		
+		if(!tree->read(is)) {
+			clear();
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+void PackedTexture::TextureTree::write(std::ostream & os) const {
+	
+	root.write(os);
+	
+	const Image & image = texture->GetImage();
+	fs::write(os, image.GetData(), image.GetDataSize());
+}
+
+bool PackedTexture::TextureTree::read(std::istream & is) {
+	
+	if(!root.read(is)) {
+		return false;
+	}
+	
+	Image & image = texture->GetImage();
+	fs::read(is, image.GetData(), image.GetDataSize());
+	dirty = true;
+	
+	return !is.fail();
+}
+
 Texture2D& PackedTexture::getTexture(unsigned int index) {
 	arx_assert(index < textures.size());
 	arx_assert(textures[index]->texture);
@@ -139,6 +206,56 @@ PackedTexture::TextureTree::Node::~Node() {
 	delete children[1];
 }
 
+void PackedTexture::TextureTree::Node::write(std::ostream & os) const {
+	
+	fs::write(os, s32(rect.left));
+	fs::write(os, s32(rect.top));
+	fs::write(os, s32(rect.right));
+	fs::write(os, s32(rect.bottom));
+	fs::write(os, u8(used ? 1 : 0));
+	fs::write(os, u8(children[0] ? 1 : 0));
+	
+	if(children[0]) {
+		children[0]->write(os);
+		children[1]->write(os);
+	}
+}
+
+bool PackedTexture::TextureTree::Node::read(std::istream & is, size_t depth) {
+	
+	// Each level splits off at least one pixel row or column
+	const size_t maxDepth = 2 * 4096;
+	if(depth > maxDepth) {
+		return false;
+	}
+	
+	s32 left, top, right, bottom;
+	u8 isUsed, hasChildren;
+	fs::read(is, left);
+	fs::read(is, top);
+	fs::read(is, right);
+	fs::read(is, bottom);
+	fs::read(is, isUsed);
+	fs::read(is, hasChildren);
+	if(is.fail()) {
+		return false;
+	}
+	
+	rect = Rect(left, top, right, bottom);
+	used = (isUsed != 0);
+	
+	delete children[0], children[0] = NULL;
+	delete children[1], children[1] = NULL;
+	
+	if(hasChildren) {
+		children[0] = new Node();
+		children[1] = new Node();
+		return children[0]->read(is, depth + 1) && children[1]->read(is, depth + 1);
+	}
+	
+	return true;
+}
+
 PackedTexture::TextureTree::Node * PackedTexture::TextureTree::Node::insertImage(const Image & image) {
 	
 	// We're in a full node/leaf, return immediately.
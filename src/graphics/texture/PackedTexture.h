@@ -21,6 +21,7 @@
 #define ARX_GRAPHICS_TEXTURE_PACKEDTEXTURE_H
 
 #include <vector>
+#include <iosfwd>
 #include <stddef.h>
 
 #include "graphics/image/Image.h"
@@ -49,6 +50,19 @@ public:
 	unsigned int getTextureSize() const { return textureSize; }
 	size_t getTextureCount() const { return textures.size(); }
 	
+	/*!
+	 * Write the packing state and contents of all textures
+	 * The data is only meant to be read back by the same build.
+	 */
+	void write(std::ostream & os) const;
+	
+	/*!
+	 * Replace all textures with ones previously stored using \ref write()
+	 * Textures still need to be uploaded using \ref upload().
+	 * \return false if the data is invalid - the packed texture will be empty in that case
+	 */
+	bool read(std::istream & is);
+	
 protected:
 	
 	class TextureTree {
@@ -62,6 +76,9 @@ protected:
 			
 			Node * insertImage(const Image & pImg);
 			
+			void write(std::ostream & os) const;
+			bool read(std::istream & is, size_t depth = 0);
+			
 			Node * children[2];
 			Rect rect;
 			bool used;
@@ -72,6 +89,9 @@ protected:
 		
 		Node * insertImage(const Image & pImg);
 		
+		void write(std::ostream & os) const;
+		bool read(std::istream & is);
+		
 	private:
 		
 		Node root;
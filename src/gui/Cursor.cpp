@@ -247,7 +247,7 @@ bool Manage3DCursor(Entity * io, bool simulate) {
 		if(simulate) {
 			ARX_INTERACTIVE_Teleport(io, pos, true);
 
-			io->gameFlags &= ~GFLAG_NOCOMPUTATION;
+			io->gameFlags() &= ~GFLAG_NOCOMPUTATION;
 			
 			glm::quat rotation = glm::toQuat(toRotationMatrix(temp));
 			
@@ -272,7 +272,7 @@ bool Manage3DCursor(Entity * io, bool simulate) {
 				ARX_PLAYER_Remove_Invisibility();
 				io->obj->pbox->active = 1;
 				io->obj->pbox->stopcount = 0;
-				io->pos = collidpos;
+				io->pos() = collidpos;
 				io->velocity = Vec3f_ZERO;
 
 				io->stopped = 1;
@@ -285,9 +285,9 @@ bool Manage3DCursor(Entity * io, bool simulate) {
 				Anglef angle = temp;
 				io->soundtime = 0;
 				io->soundcount = 0;
-				EERIE_PHYSICS_BOX_Launch(io->obj, io->pos, angle, viewvector);
+				EERIE_PHYSICS_BOX_Launch(io->obj, io->pos(), angle, viewvector);
 				ARX_SOUND_PlaySFX(SND_WHOOSH, &pos);
-				io->show = SHOW_FLAG_IN_SCENE;
+				io->show() = SHOW_FLAG_IN_SCENE;
 				Set_DragInter(NULL);
 			} else {
 				ARX_PLAYER_Remove_Invisibility();
@@ -299,7 +299,7 @@ bool Manage3DCursor(Entity * io, bool simulate) {
 				io->angle.setRoll(temp.getRoll());
 
 				io->stopped = 0;
-				io->show = SHOW_FLAG_IN_SCENE;
+				io->show() = SHOW_FLAG_IN_SCENE;
 				io->obj->pbox->active = 0;
 				Set_DragInter(NULL);
 			}
@@ -469,7 +469,7 @@ static void ARX_INTERFACE_RenderCursorInternal(bool flag) {
 		 && !g_cursorOverBook
 		 && (eMouseState != MOUSE_IN_NOTE)
 		 && (FlyingOverIO->ioflags & IO_ITEM)
-		 && (FlyingOverIO->gameFlags & GFLAG_INTERACTIVITY)
+		 && (FlyingOverIO->gameFlags() & GFLAG_INTERACTIVITY)
 		 && (config.input.autoReadyWeapon == false))
 	   || (MAGICMODE && PLAYER_MOUSELOOK_ON)
 	) {
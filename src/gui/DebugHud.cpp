@@ -20,9 +20,13 @@
 #include "gui/DebugHud.h"
 
 #include <cstdio>
+#include <algorithm>
+#include <functional>
 #include <string>
 #include <iomanip>
 #include <deque>
+#include <utility>
+#include <vector>
 
 #include <boost/format.hpp>
 
@@ -124,6 +128,11 @@ static const char * entityVisilibityToString(EntityVisilibity value) {
 }
 
 
+static float hitRate(size_t hits, size_t misses) {
+	size_t total = hits + misses;
+	return total ? float(hits) * 100.f / float(total) : 0.f;
+}
+
 std::string LAST_FAILED_SEQUENCE = "none";
 EntityHandle LastSelectedIONum = EntityHandle();
 
@@ -132,7 +141,11 @@ void ShowInfoText() {
 	DebugBox frameInfo = DebugBox(Vec2i(10, 10), "FrameInfo");
 	frameInfo.add("Prims", EERIEDrawnPolys);
 	frameInfo.add("Particles", getParticleCount());
+	frameInfo.add("Particle update us", long(getParticleUpdateTime()));
 	frameInfo.add("Polybooms", long(polyboom.size()));
+	const Font::CacheStats & fontStats = Font::getCacheStats();
+	frameInfo.add("Text run hit %", hitRate(fontStats.runHits, fontStats.runMisses));
+	frameInfo.add("Glyph hit %", hitRate(fontStats.glyphHits, fontStats.glyphMisses));
 	frameInfo.add("TIME", static_cast<long>(arxtime.now_ul() / 1000));
 	frameInfo.print();
 	
@@ -215,6 +228,26 @@ void ShowInfoText() {
 	DebugBox scriptBox = DebugBox(Vec2i(10, miscBox.size().y + 5), "Script");
 	scriptBox.add("Events", ScriptEvent::totalCount);
 	scriptBox.add("Timers", ARX_SCRIPT_CountTimers());
+	const ScriptEventQueueStats & queueStats = ARX_SCRIPT_EventStackGetStats();
+	scriptBox.add("Queued events", long(queueStats.depth));
+	scriptBox.add("Max queued", long(queueStats.maxDepth));
+	scriptBox.add("Dropped events", long(queueStats.dropped));
+	
+	// Show which messages make up most of the queued event throughput
+	std::vector<std::pair<size_t, ScriptMessage> > executed;
+	for(size_t msg = 0; msg < size_t(SM_MAXCMD); msg++) {
+		if(queueStats.executed[msg]) {
+			executed.push_back(std::make_pair(queueStats.executed[msg], ScriptMessage(msg)));
+		}
+	}
+	size_t topCount = std::min(executed.size(), size_t(3));
+	std::partial_sort(executed.begin(), executed.begin() + topCount, executed.end(),
+	                  std::greater<std::pair<size_t, ScriptMessage> >());
+	for(size_t i = 0; i < topCount; i++) {
+		scriptBox.add("Queued " + ScriptEvent::getName(executed[i].second, std::string()),
+		              long(executed[i].first));
+	}
+	
 	scriptBox.add("Max events", maxEvents.entityName);
 	scriptBox.add("Max events#", maxEvents.events);
 	scriptBox.add("Max sender", maxSender.entityName);
@@ -227,12 +260,12 @@ void ShowInfoText() {
 
 		if(io) {
 			DebugBox entityBox = DebugBox(Vec2i(500, 10), "Entity " + io->idString());
-			entityBox.add("Pos", io->pos);
+			entityBox.add("Pos", io->pos());
 			entityBox.add("Angle", io->angle);
 			entityBox.add("Room", static_cast<long>(io->room));
-			entityBox.add("Move", io->move);
+			entityBox.add("Move", io->move());
 			entityBox.add("Flags", flagNames(EntityFlagNames, io->ioflags));
-			entityBox.add("Show", entityVisilibityToString(io->show));
+			entityBox.add("Show", entityVisilibityToString(io->show()));
 			entityBox.print();
 			
 			if(io->ioflags & IO_NPC) {
@@ -566,7 +566,7 @@ void CurrentTorchIconGui::updateInput() {
 			
 			if(!DRAGINTER && !PLAYER_MOUSELOOK_ON && DRAGGING) {
 				Entity * io = player.torch;
-				player.torch->show = SHOW_FLAG_IN_SCENE;
+				player.torch->show() = SHOW_FLAG_IN_SCENE;
 				ARX_SOUND_PlaySFX(SND_TORCH_END);
 				ARX_SOUND_Stop(SND_TORCH_LOOP);
 				player.torch = NULL;
@@ -1215,7 +1215,7 @@ void ArxGame::managePlayerControls() {
 				
 				if(io->_itemdata->count > 1) {
 					ioo = CloneIOItem(io);
-					ioo->show = SHOW_FLAG_NOT_DRAWN;
+					ioo->show() = SHOW_FLAG_NOT_DRAWN;
 					ioo->scriptload = 1;
 					ioo->_itemdata->count = 1;
 					io->_itemdata->count--;
@@ -1557,7 +1557,7 @@ void ArxGame::manageKeyMouse() {
 		}
 
 		if(pIO
-		   && (pIO->gameFlags & GFLAG_INTERACTIVITY)
+		   && (pIO->gameFlags() & GFLAG_INTERACTIVITY)
 		   && !g_cursorOverBook
 		   && eMouseState != MOUSE_IN_NOTE
 		) {
@@ -2087,7 +2087,7 @@ void ArxGame::manageEditorControls() {
 			}
 			
 			RemoveFromAllInventories( FlyingOverIO );
-			FlyingOverIO->show = SHOW_FLAG_IN_INVENTORY;
+			FlyingOverIO->show() = SHOW_FLAG_IN_INVENTORY;
 			
 			if(FlyingOverIO->ioflags & IO_GOLD)
 				ARX_SOUND_PlayInterface(SND_GOLD);
@@ -2106,7 +2106,7 @@ void ArxGame::manageEditorControls() {
 				}
 				
 				if(!bSecondary)
-					FlyingOverIO->show = SHOW_FLAG_IN_SCENE;
+					FlyingOverIO->show() = SHOW_FLAG_IN_SCENE;
 			}
 			
 			if(DRAGINTER == FlyingOverIO)
@@ -2147,7 +2147,7 @@ void ArxGame::manageEditorControls() {
 						ARX_PLAYER_Remove_Invisibility();
 						io->obj->pbox->active=1;
 						io->obj->pbox->stopcount=0;
-						io->pos = player.pos + Vec3f(0.f, 80.f, 0.f);
+						io->pos() = player.pos + Vec3f(0.f, 80.f, 0.f);
 						io->velocity = Vec3f_ZERO;
 						io->stopped = 1;
 						
@@ -2162,10 +2162,10 @@ void ArxGame::manageEditorControls() {
 						io->soundtime=0;
 						io->soundcount=0;
 						
-						EERIE_PHYSICS_BOX_Launch(io->obj, io->pos, io->angle, viewvector);
-						ARX_SOUND_PlaySFX(SND_WHOOSH, &io->pos);
+						EERIE_PHYSICS_BOX_Launch(io->obj, io->pos(), io->angle, viewvector);
+						ARX_SOUND_PlaySFX(SND_WHOOSH, &io->pos());
 						
-						io->show=SHOW_FLAG_IN_SCENE;
+						io->show()=SHOW_FLAG_IN_SCENE;
 						Set_DragInter(NULL);
 					}
 				}
@@ -2294,7 +2294,7 @@ void ArxGame::manageEditorControls() {
 				
 				if(io && !BLOCK_PLAYER_CONTROLS) {
 					if(g_cursorOverBook) {
-						if(io->show == SHOW_FLAG_ON_PLAYER)
+						if(io->show() == SHOW_FLAG_ON_PLAYER)
 							bOk = true;
 					} else {
 						bOk = true;
@@ -2307,7 +2307,7 @@ void ArxGame::manageEditorControls() {
 					if(io) {
 						ARX_PLAYER_Remove_Invisibility();
 						
-						if(DRAGINTER->show == SHOW_FLAG_ON_PLAYER) {
+						if(DRAGINTER->show() == SHOW_FLAG_ON_PLAYER) {
 							ARX_EQUIPMENT_UnEquip(entities.player(),DRAGINTER);
 							RemoveFromAllInventories(DRAGINTER);
 							DRAGINTER->bbox2D.max.x = -1;
@@ -2322,7 +2322,7 @@ void ArxGame::manageEditorControls() {
 								ARX_SOUND_PlayInterface(SND_PLOUF, Random::getf(0.8f, 1.2f));
 							}
 							
-							DRAGINTER->show = SHOW_FLAG_NOT_DRAWN;
+							DRAGINTER->show() = SHOW_FLAG_NOT_DRAWN;
 							ARX_SOUND_PlayInterface(SND_INVSTD);
 						}
 					}
@@ -60,6 +60,7 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include "core/Core.h"
 #include "core/GameTime.h"
 #include "core/Localisation.h"
+#include "core/SaveGame.h"
 
 #include "game/Player.h"
 
@@ -102,8 +103,6 @@ extern float ARXTimeMenu;
 
 extern bool REQUEST_SPEECH_SKIP;
 
-extern TextureContainer * pTextureLoad;
-
 //-----------------------------------------------------------------------------
 // Exported global variables
 
@@ -177,7 +176,7 @@ void ARX_Menu_Resources_Release(bool _bNoSound) {
 		ARXMenu_Options_Audio_ApplyGameVolumes();
 	}
 	
-	delete pTextureLoad, pTextureLoad = NULL;
+	savegames.releaseThumbnail();
 }
 
 extern bool TIME_INIT;
@@ -122,7 +122,6 @@ bool bFadeInOut=false;
 int iFadeAction=-1;
 float fFadeInOut=0.f;
 
-TextureContainer *pTextureLoad=NULL;
 TextureContainer *pTextureLoadRender=NULL;
 
 void ARX_QuickSave() {
@@ -423,7 +422,7 @@ bool Menu2_Render() {
 		
 		Rectf rect = Rectf(pos, config.interface.thumbnailSize.x, config.interface.thumbnailSize.y);
 		
-		EERIEDrawBitmap(rect, 0.001f, pTextureLoad, Color::white);
+		EERIEDrawBitmap(rect, 0.001f, pTextureLoadRender, Color::white);
 		drawLineRectangle(rect, 0.01f, Color::white);
 
 		pTextureLoadRender=NULL;
@@ -767,7 +767,7 @@ void MiniMap::drawDetectedEntities(int showLevel, Vec2f start, float zoom) {
 			continue; // don't show dead NPCs
 		}
 		
-		if((npc->gameFlags & GFLAG_MEGAHIDE) || npc->show != SHOW_FLAG_IN_SCENE) {
+		if((npc->gameFlags() & GFLAG_MEGAHIDE) || npc->show() != SHOW_FLAG_IN_SCENE) {
 			continue; // don't show hidden NPCs
 		}
 		
@@ -781,13 +781,13 @@ void MiniMap::drawDetectedEntities(int showLevel, Vec2f start, float zoom) {
 		
 		Vec2f fp;
 		
-		fp.x = start.x + ((npc->pos.x - 100 + of.x - of2.x) * ( 1.0f / 100 ) * cas.x
+		fp.x = start.x + ((npc->pos().x - 100 + of.x - of2.x) * ( 1.0f / 100 ) * cas.x
 		+ of.x * ratio * m_mod.x) / m_mod.x;
 		fp.y = start.y + ((m_mapMaxY[showLevel] - of.y - of2.y) * ( 1.0f / 100 ) * cas.y
-		- (npc->pos.z + 200 + of.y - of2.y) * ( 1.0f / 100 ) * cas.y + of.y * ratio * m_mod.y) / m_mod.y;
+		- (npc->pos().z + 200 + of.y - of2.y) * ( 1.0f / 100 ) * cas.y + of.y * ratio * m_mod.y) / m_mod.y;
 		
-		float d = fdist(Vec2f(m_player->pos.x, m_player->pos.z), Vec2f(npc->pos.x, npc->pos.z));
-		if(d > 800 || glm::abs(ents.player()->pos.y - npc->pos.y) > 250.f) {
+		float d = fdist(Vec2f(m_player->pos.x, m_player->pos.z), Vec2f(npc->pos().x, npc->pos().z));
+		if(d > 800 || glm::abs(ents.player()->pos().y - npc->pos().y) > 250.f) {
 			continue; // the NPC is too far away to be detected
 		}
 		
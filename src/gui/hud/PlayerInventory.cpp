@@ -418,7 +418,7 @@ Entity * PlayerInventoryHud::getObj(const Vec2s & pos) {
 			if((tx >= 0) && ((size_t)tx < INVENTORY_X) && (ty >= 0) && ((size_t)ty < INVENTORY_Y)) {
 				Entity *result = inventory[g_currentInventoryBag][tx][ty].io;
 
-				if(result && (result->gameFlags & GFLAG_INTERACTIVITY)) {
+				if(result && (result->gameFlags() & GFLAG_INTERACTIVITY)) {
 					HERO_OR_SECONDARY = 1;
 					return result;
 				}
@@ -442,7 +442,7 @@ Entity * PlayerInventoryHud::getObj(const Vec2s & pos) {
 			if(tx >= 0 && (size_t)tx < INVENTORY_X && ty >= 0 && (size_t)ty < INVENTORY_Y) {
 				Entity *result = inventory[bag][tx][ty].io;
 
-				if(result && (result->gameFlags & GFLAG_INTERACTIVITY)) {
+				if(result && (result->gameFlags() & GFLAG_INTERACTIVITY)) {
 					HERO_OR_SECONDARY = 1;
 					return result;
 				}
@@ -575,7 +575,7 @@ void PlayerInventoryHud::dropEntity() {
 	
 	ARX_INVENTORY_Declare_InventoryIn(DRAGINTER);
 	ARX_SOUND_PlayInterface(SND_INVSTD);
-	DRAGINTER->show = SHOW_FLAG_IN_INVENTORY;
+	DRAGINTER->show() = SHOW_FLAG_IN_INVENTORY;
 	Set_DragInter(NULL);
 }
 
@@ -594,7 +594,7 @@ void PlayerInventoryHud::dragEntity(Entity * io, const Vec2s &pos) {
 				if(io->_itemdata->count - 1 > 0) {
 					
 					Entity * ioo = AddItem(io->classPath());
-					ioo->show = SHOW_FLAG_NOT_DRAWN;
+					ioo->show() = SHOW_FLAG_NOT_DRAWN;
 					ioo->_itemdata->count = 1;
 					io->_itemdata->count--;
 					ioo->scriptload = 1;
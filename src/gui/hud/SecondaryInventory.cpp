@@ -143,7 +143,7 @@ static Entity * getSecondaryOrStealInvEntity() {
 void SecondaryInventoryHud::update() {
 	Entity * io = getSecondaryOrStealInvEntity();
 	if(io) {
-		float dist = fdist(io->pos, player.pos + (Vec3f_Y_AXIS * 80.f));
+		float dist = fdist(io->pos(), player.pos + (Vec3f_Y_AXIS * 80.f));
 		
 		float maxDist = player.m_telekinesis ? 900.f : 350.f;
 		
@@ -341,7 +341,7 @@ Entity * SecondaryInventoryHud::getObj(const Vec2s & pos) {
 
 				Entity * io = SecondaryInventory->slot[tx][ty].io;
 
-				if(!(io->gameFlags & GFLAG_INTERACTIVITY))
+				if(!(io->gameFlags() & GFLAG_INTERACTIVITY))
 					return NULL;
 
 				HERO_OR_SECONDARY = 2;
@@ -417,7 +417,7 @@ void SecondaryInventoryHud::dropEntity() {
 				if(!ioo)
 					continue;
 				
-				DRAGINTER->show = SHOW_FLAG_IN_INVENTORY;
+				DRAGINTER->show() = SHOW_FLAG_IN_INVENTORY;
 				
 				if(   ioo->_itemdata->playerstacksize > 1
 				   && IsSameObject(DRAGINTER, ioo)
@@ -471,7 +471,7 @@ void SecondaryInventoryHud::dropEntity() {
 			}
 
 			SecondaryInventory->slot[t.x][t.y].show = true;
-			DRAGINTER->show = SHOW_FLAG_IN_INVENTORY;
+			DRAGINTER->show() = SHOW_FLAG_IN_INVENTORY;
 			ARX_SOUND_PlayInterface(SND_INVSTD);
 			Set_DragInter(NULL);
 			return;
@@ -504,7 +504,7 @@ bool SecondaryInventoryHud::dragEntity(Entity * io, const Vec2s & pos) {
 				
 				if(io->_itemdata->count > 1) {
 					Entity * ioo = CloneIOItem(io);
-					ioo->show = SHOW_FLAG_NOT_DRAWN;
+					ioo->show() = SHOW_FLAG_NOT_DRAWN;
 					ioo->scriptload = 1;
 					ioo->_itemdata->count = 1;
 					io->_itemdata->count--;
@@ -516,7 +516,7 @@ bool SecondaryInventoryHud::dragEntity(Entity * io, const Vec2s & pos) {
 				
 				if(!GInput->actionPressed(CONTROLS_CUST_STEALTHMODE)) {
 					Entity * ioo = CloneIOItem(io);
-					ioo->show = SHOW_FLAG_NOT_DRAWN;
+					ioo->show() = SHOW_FLAG_NOT_DRAWN;
 					ioo->scriptload = 1;
 					ioo->_itemdata->count = 1;
 					io->_itemdata->count--;
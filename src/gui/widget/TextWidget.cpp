@@ -313,7 +313,6 @@ void TextWidget::Render() {
 }
 
 extern MenuCursor * pMenuCursor;
-extern TextureContainer *pTextureLoad;
 extern TextureContainer *pTextureLoadRender;
 
 void TextWidget::RenderMouseOver() {
@@ -336,14 +335,10 @@ void TextWidget::RenderMouseOver() {
 				break;
 			}
 			
-			const res::path & image = savegames[m_savegame.handleData()].thumbnail;
-			if(!image.empty()) {
-				TextureContainer * t = TextureContainer::LoadUI(image, TextureContainer::NoColorKey);
-				if(t != pTextureLoad) {
-					delete pTextureLoad;
-					pTextureLoad = t;
-				}
-				pTextureLoadRender = pTextureLoad;
+			// The thumbnail is decoded in the background and only shown once available
+			TextureContainer * thumbnail = savegames.getThumbnail(m_savegame);
+			if(thumbnail) {
+				pTextureLoadRender = thumbnail;
 			}
 			
 			break;
@@ -35,14 +35,20 @@
  *    00 04 82 24 25 8f 80 7f
  *
  * which decompresses to "AIAIAIAIAIAIA" (without the quotes).
+ *
+ * Modified for Arx Libertatis: bits are buffered in a 32-bit word, codes are
+ * decoded with lookup tables and memory-to-memory decompression writes directly
+ * to the output buffer instead of going through a separate window.
  */
 
 #include "io/Blast.h"
 
 #include <cstring>
 #include <cstdlib>
+#include <algorithm>
 
 #include "io/log/Logger.h"
+#include "platform/Platform.h"
 
 #define MAXBITS 13              /* maximum code length */
 #define MAXWIN 4096             /* maximum window size */
@@ -51,31 +57,20 @@ namespace {
 
 struct blast_truncated_error { };
 
-} // anonymous namespace
-
-/* input and output state */
+/* input state */
 struct state {
-	
-	/* input state */
-	blast_in infun;             /* input function provided by user */
+	blast_in infun;             /* input function provided by user or NULL */
 	void * inhow;               /* opaque information passed to infun() */
 	const unsigned char * in;   /* next input location */
-	unsigned left;              /* available input at in */
-	int bitbuf;                 /* bit buffer */
-	int bitcnt;                 /* number of bits in bit buffer */
-	
-	/* output state */
-	blast_out outfun;           /* output function provided by user */
-	void * outhow;              /* opaque information passed to outfun() */
-	unsigned next;              /* index of next write location in out[] */
-	int first;                  /* true to check distances (for first 4K) */
-	unsigned char out[MAXWIN];  /* output buffer and sliding window */
-	
+	size_t left;                /* available input at in */
+	u32 bitbuf;                 /* bit buffer */
+	unsigned bitcnt;            /* number of bits in bit buffer */
 };
 
 /*
- * Return need bits from the input stream.  This always leaves less than
- * eight bits in the buffer.  bits() works properly for need == 0.
+ * Load as many whole bytes into the bit buffer as fit.  This leaves at least
+ * 25 bits in the buffer unless the input has ended.  The input function is not
+ * called again once it has returned zero.
  *
  * Format notes:
  *
@@ -84,106 +79,71 @@ struct state {
  *   buffer, using shift right, and new bytes are appended to the top of the
  *   bit buffer, using shift left.
  */
-static int bits(state * s, int need) {
-	
-	int val;            /* bit accumulator */
-	
-	/* load at least need bits into val */
-	val = s->bitbuf;
-	while(s->bitcnt < need) {
+inline void refill(state * s) {
+	while(s->bitcnt <= 24) {
 		if(s->left == 0) {
-			s->left = s->infun(s->inhow, &(s->in));
-			if (s->left == 0) throw blast_truncated_error(); /* out of input */
+			if(!s->infun || (s->left = s->infun(s->inhow, &s->in)) == 0) {
+				s->infun = NULL;
+				return;
+			}
 		}
-		val |= (int)(*(s->in)++) << s->bitcnt;          /* load eight bits */
+		s->bitbuf |= u32(*s->in++) << s->bitcnt;
 		s->left--;
 		s->bitcnt += 8;
 	}
+}
+
+/*
+ * Return need bits from the input stream.  bits() works properly for
+ * need == 0.
+ */
+inline int bits(state * s, unsigned need) {
 	
-	/* drop need bits and update buffer, always zero to seven bits left */
-	s->bitbuf = val >> need;
+	if(s->bitcnt < need) {
+		refill(s);
+		if(s->bitcnt < need) {
+			throw blast_truncated_error(); /* out of input */
+		}
+	}
+	
+	int val = int(s->bitbuf & ((u32(1) << need) - 1));
+	s->bitbuf >>= need;
 	s->bitcnt -= need;
 	
-	/* return need bits, zeroing the bits above that */
-	return val & ((1 << need) - 1);
+	return val;
 }
 
 /*
- * Huffman code decoding tables.  count[1..MAXBITS] is the number of symbols of
- * each length, which for a canonical code are stepped through in order.
- * symbol[] are the symbol values in canonical order, where the number of
- * entries is the sum of the counts in count[].  The decoding process can be
- * seen in the function decode() below.
+ * Huffman code decoding tables.  entry[] is indexed by the next bits bits in
+ * the stream and stores the decoded symbol in the upper bits and the length of
+ * its code in the lower four bits.  All codes used by the format are complete
+ * so that every entry is valid.
  */
 struct huffman {
-	short * count;       /* number of symbols of each length */
-	short * symbol;      /* canonically ordered symbols */
+	unsigned bits;               /* number of bits used to index entry[] */
+	u16 entry[1 << MAXBITS];     /* symbol << 4 | code length */
 };
 
 /*
- * Decode a code from the stream s using huffman table h.  Return the symbol or
- * a negative value if there is an error.  If all of the lengths are zero, i.e.
- * an empty code, or if the code is incomplete and an invalid code is received,
- * then -9 is returned after reading MAXBITS bits.
- *
- * Format notes:
- *
- * - The codes as stored in the compressed data are bit-reversed relative to
- *   a simple integer ordering of codes of the same lengths.  Hence below the
- *   bits are pulled from the compressed data one at a time and used to
- *   build the code value reversed from what is in the stream in order to
- *   permit simple integer comparisons for decoding.
- *
- * - The first code for the shortest length is all ones.  Subsequent codes of
- *   the same length are simply integer decrements of the previous code.  When
- *   moving up a length, a one bit is appended to the code.  For a complete
- *   code, the last code of the longest length will be all zeros.  To support
- *   this ordering, the bits pulled during decoding are inverted to apply the
- *   more "natural" ordering starting with all zeros and incrementing.
+ * Decode a code from the stream s using huffman table h.  Codes at the end of
+ * the input may be shorter than the table index - they are padded with zeros.
  */
-static int decode(state * s, huffman * h) {
-	
-	int len;            /* current number of bits in code */
-	int code;           /* len bits being decoded */
-	int first;          /* first code of length len */
-	int count;          /* number of codes of length len */
-	int index;          /* index of first code of length len in symbol table */
-	int bitbuf;         /* bits from stream */
-	int left;           /* bits left in next or left to process */
-	short * next;        /* next number of codes */
-	
-	bitbuf = s->bitbuf;
-	left = s->bitcnt;
-	code = first = index = 0;
-	len = 1;
-	next = h->count + 1;
-	while(1) {
-		while(left--) {
-			code |= (bitbuf & 1) ^ 1;   /* invert code */
-			bitbuf >>= 1;
-			count = *next++;
-			if(code < first + count) { /* if length len, return symbol */
-				s->bitbuf = bitbuf;
-				s->bitcnt = (s->bitcnt - len) & 7;
-				return h->symbol[index + (code - first)];
-			}
-			index += count;             /* else update for next length */
-			first += count;
-			first <<= 1;
-			code <<= 1;
-			len++;
-		}
-		left = (MAXBITS+1) - len;
-		if(left == 0) break;
-		if(s->left == 0) {
-			s->left = s->infun(s->inhow, &(s->in));
-			if (s->left == 0) throw blast_truncated_error(); /* out of input */
-		}
-		bitbuf = *(s->in)++;
-		s->left--;
-		if (left > 8) left = 8;
+inline int decode(state * s, const huffman * h) {
+	
+	if(s->bitcnt < h->bits) {
+		refill(s);
+	}
+	
+	unsigned entry = h->entry[s->bitbuf & ((u32(1) << h->bits) - 1)];
+	unsigned len = entry & 15;
+	if(len > s->bitcnt) {
+		throw blast_truncated_error(); /* out of input */
 	}
-	return -9;                          /* ran out of codes */
+	
+	s->bitbuf >>= len;
+	s->bitcnt -= len;
+	
+	return int(entry >> 4);
 }
 
 /*
@@ -191,24 +151,26 @@ static int decode(state * s, huffman * h) {
  * count (high four bits + 1) and a code length (low four bits), generate the
  * list of code lengths.  This compaction reduces the size of the object code.
  * Then given the list of code lengths length[0..n-1] representing a canonical
- * Huffman code for n symbols, construct the tables required to decode those
- * codes.  Those tables are the number of codes of each length, and the symbols
- * sorted by length, retaining their original order within each length.  The
- * return value is zero for a complete code set, negative for an over-
- * subscribed code set, and positive for an incomplete code set.  The tables
- * can be used if the return value is zero or positive, but they cannot be used
- * if the return value is negative.  If the return value is zero, it is not
- * possible for decode() using that table to return an error--any stream of
- * enough bits will resolve to a symbol.  If the return value is positive, then
- * it is possible for decode() using that table to return an error for received
- * codes past the end of the incomplete lengths.
+ * Huffman code for n symbols, construct the lookup table for that code.
+ *
+ * Format notes:
+ *
+ * - The codes as stored in the compressed data are bit-reversed relative to
+ *   a simple integer ordering of codes of the same lengths.  Hence the table
+ *   entries for a code are found by reversing its bits.
+ *
+ * - The first code for the shortest length is all ones.  Subsequent codes of
+ *   the same length are simply integer decrements of the previous code.  When
+ *   moving up a length, a one bit is appended to the code.  For a complete
+ *   code, the last code of the longest length will be all zeros.  To support
+ *   this ordering, the codes are assigned in the more "natural" ordering
+ *   starting with all zeros and incrementing and inverted afterwards.
  */
-static int construct(huffman * h, const unsigned char * rep, int n) {
+void construct(huffman * h, const unsigned char * rep, int n) {
 	
 	int symbol;         /* current symbol when stepping through length[] */
-	int len;            /* current length when stepping through h->count[] */
-	int left;           /* number of possible codes left of current length */
-	short offs[MAXBITS+1];      /* offsets in symbol table for each length */
+	int len;            /* current length */
+	int left;           /* number of symbols left with the current length */
 	short length[256];  /* code lengths */
 	
 	/* convert compact repeat counts into symbol bit length list */
@@ -223,39 +185,223 @@ static int construct(huffman * h, const unsigned char * rep, int n) {
 	} while (--n);
 	n = symbol;
 	
-	/* count number of codes of each length */
-	for(len = 0; len <= MAXBITS; len++)
-		h->count[len] = 0;
-	for(symbol = 0; symbol < n; symbol++)
-		(h->count[length[symbol]])++;   /* assumes lengths are within bounds */
-	if(h->count[0] == n)               /* no codes! */
-		return 0;                       /* complete, but decode() will fail */
-	
-	/* check for an over-subscribed or incomplete set of lengths */
-	left = 1;                           /* one possible code of zero length */
-	for(len = 1; len <= MAXBITS; len++) {
-		left <<= 1;                     /* one more bit, double codes left */
-		left -= h->count[len];          /* deduct count from possible codes */
-		if(left < 0) return left;      /* over-subscribed--return negative */
-	}                                   /* left > 0 means incomplete */
-	
-	/* generate offsets into symbol table for each length for sorting */
-	offs[1] = 0;
-	for(len = 1; len < MAXBITS; len++)
-		offs[len + 1] = offs[len] + h->count[len];
-	
-	/*
-	 * put symbols in table sorted by length, by symbol order within each
-	 * length
-	 */
-	for(symbol = 0; symbol < n; symbol++)
-		if(length[symbol] != 0)
-			h->symbol[offs[length[symbol]]++] = symbol;
-	
-	/* return zero for complete set, positive for incomplete set */
-	return left;
+	h->bits = 0;
+	for(symbol = 0; symbol < n; symbol++) {
+		h->bits = std::max(h->bits, unsigned(length[symbol]));
+	}
+	arx_assert(h->bits <= MAXBITS);
+	
+	std::fill(h->entry, h->entry + (1 << h->bits), u16(0));
+	
+	/* assign codes by length, by symbol order within each length */
+	unsigned code = 0;
+	for(len = 1; len <= int(h->bits); len++) {
+		for(symbol = 0; symbol < n; symbol++) {
+			
+			if(length[symbol] != len) {
+				continue;
+			}
+			
+			/* the inverted code is stored starting with the most significant bit */
+			unsigned reversed = 0;
+			for(int i = 0; i < len; i++) {
+				reversed |= ((~code >> (len - 1 - i)) & 1) << i;
+			}
+			
+			/* fill all entries whose lower len bits match the code */
+			for(unsigned i = reversed; i < (1u << h->bits); i += (1u << len)) {
+				h->entry[i] = u16(symbol << 4 | len);
+			}
+			
+			code++;
+		}
+		code <<= 1;
+	}
+	
+	/* there are no unused entries for a complete code */
+	arx_assert(code == (1u << (h->bits + 1)));
 }
 
+/* bit lengths of literal codes */
+const unsigned char litlen[] = {
+	11, 124, 8, 7, 28, 7, 188, 13, 76, 4, 10, 8, 12, 10, 12, 10, 8, 23, 8,
+	9, 7, 6, 7, 8, 7, 6, 55, 8, 23, 24, 12, 11, 7, 9, 11, 12, 6, 7, 22, 5,
+	7, 24, 6, 11, 9, 6, 7, 22, 7, 11, 38, 7, 9, 8, 25, 11, 8, 11, 9, 12,
+	8, 12, 5, 38, 5, 38, 5, 11, 7, 5, 6, 21, 6, 10, 53, 8, 7, 24, 10, 27,
+	44, 253, 253, 253, 252, 252, 252, 13, 12, 45, 12, 45, 12, 61, 12, 45,
+	44, 173
+};
+/* bit lengths of length codes 0..15 */
+const unsigned char lenlen[] = {2, 35, 36, 53, 38, 23};
+/* bit lengths of distance codes 0..63 */
+const unsigned char distlen[] = {2, 20, 53, 230, 247, 151, 248};
+const short base[16] = {     /* base for length codes */
+	3, 2, 4, 5, 6, 7, 8, 9, 10, 12, 16, 24, 40, 72, 136, 264
+};
+const char extra[16] = {     /* extra bits for length codes */
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8
+};
+
+struct tables {
+	
+	huffman litcode;   /* literal code */
+	huffman lencode;   /* length code */
+	huffman distcode;  /* distance code */
+	
+	tables() {
+		construct(&litcode, litlen, sizeof(litlen));
+		construct(&lencode, lenlen, sizeof(lenlen));
+		construct(&distcode, distlen, sizeof(distlen));
+	}
+	
+};
+
+/* set up decoding tables during static initialization so that blast() is thread-safe */
+const tables g_tables;
+
+/*
+ * Output to a sliding window that is passed to the user's output function
+ * whenever it is full.
+ */
+class window_output {
+	
+	blast_out outfun;           /* output function provided by user */
+	void * outhow;              /* opaque information passed to outfun() */
+	unsigned next;              /* index of next write location in out[] */
+	bool first;                 /* true to check distances (for first 4K) */
+	unsigned char out[MAXWIN];  /* output buffer and sliding window */
+	
+	BlastResult wrap() {
+		if(next == MAXWIN) {
+			if(outfun(outhow, out, next)) return BLAST_OUTPUT_ERROR;
+			next = 0;
+			first = false;
+		}
+		return BLAST_SUCCESS;
+	}
+	
+public:
+	
+	window_output(blast_out _outfun, void * _outhow)
+		: outfun(_outfun), outhow(_outhow), next(0), first(true) { }
+	
+	BlastResult literal(int symbol) {
+		out[next++] = (unsigned char)symbol;
+		return wrap();
+	}
+	
+	BlastResult copy(unsigned dist, unsigned len) {
+		
+		if(first && dist > next) {
+			return BLAST_INVALID_OFFSET;
+		}
+		
+		/* copy length bytes from distance bytes back */
+		do {
+			unsigned char * to = out + next;
+			unsigned char * from = to - dist;
+			unsigned copy = MAXWIN;
+			if(next < dist) {
+				from += copy;
+				copy = dist;
+			}
+			copy -= next;
+			if(copy > len) copy = len;
+			len -= copy;
+			next += copy;
+			do {
+				*to++ = *from++;
+			} while(--copy);
+			if(BlastResult err = wrap()) return err;
+		} while(len != 0);
+		
+		return BLAST_SUCCESS;
+	}
+	
+	/* write any leftover output */
+	BlastResult finish() {
+		if(next && outfun(outhow, out, next)) return BLAST_OUTPUT_ERROR;
+		next = 0;
+		return BLAST_SUCCESS;
+	}
+	
+};
+
+/*
+ * Output directly to a memory buffer which also serves as the window.
+ * If grow is true, the buffer is resized with realloc() as needed.
+ */
+class memory_output {
+	
+	char * buf;
+	size_t fill;
+	size_t capacity;
+	bool grow;
+	
+	bool reserve(size_t n) {
+		
+		if(!grow) {
+			return false;
+		}
+		
+		size_t newCapacity = std::max(std::max(capacity * 2, fill + n), size_t(MAXWIN));
+		char * newBuf = (char *)realloc(buf, newCapacity);
+		if(!newBuf) {
+			return false;
+		}
+		
+		buf = newBuf;
+		capacity = newCapacity;
+		return true;
+	}
+	
+public:
+	
+	memory_output(char * _buf, size_t _capacity, bool _grow)
+		: buf(_buf), fill(0), capacity(_capacity), grow(_grow) { }
+	
+	char * data() const { return buf; }
+	size_t size() const { return fill; }
+	
+	BlastResult literal(int symbol) {
+		if(fill == capacity && !reserve(1)) return BLAST_OUTPUT_ERROR;
+		buf[fill++] = char(symbol);
+		return BLAST_SUCCESS;
+	}
+	
+	BlastResult copy(unsigned dist, unsigned len) {
+		
+		if(dist > fill) {
+			return BLAST_INVALID_OFFSET;
+		}
+		
+		if(len > capacity - fill && !reserve(len)) {
+			/* copy what fits, like the window output */
+			len = unsigned(capacity - fill);
+			if(len == 0) return BLAST_OUTPUT_ERROR;
+			copy(dist, len);
+			return BLAST_OUTPUT_ERROR;
+		}
+		
+		char * to = buf + fill;
+		const char * from = to - dist;
+		fill += len;
+		if(dist >= len) {
+			memcpy(to, from, len);
+		} else {
+			/* overlapped copies repeat the last dist bytes */
+			do {
+				*to++ = *from++;
+			} while(--len);
+		}
+		
+		return BLAST_SUCCESS;
+	}
+	
+};
+
+} // anonymous namespace
+
 /*
  * Decode PKWare Compression Library stream.
  *
@@ -294,49 +440,14 @@ static int construct(huffman * h, const unsigned char * rep, int n) {
  *   ignoring whether the length is greater than the distance or not implements
  *   this correctly.
  */
-static BlastResult blastDecompress(state * s) {
+template <typename Output>
+static BlastResult blastDecompress(state * s, Output & out) {
 	
 	int lit;            /* true if literals are coded */
 	int dict;           /* log2(dictionary size) - 6 */
 	int symbol;         /* decoded symbol, extra bits for distance */
 	int len;            /* length for copy */
 	int dist;           /* distance for copy */
-	int copy;           /* copy counter */
-	unsigned char * from, *to;   /* copy pointers */
-	static int virgin = 1;                              /* build tables once */
-	static short litcnt[MAXBITS+1], litsym[256];        /* litcode memory */
-	static short lencnt[MAXBITS+1], lensym[16];         /* lencode memory */
-	static short distcnt[MAXBITS+1], distsym[64];       /* distcode memory */
-	static huffman litcode = {litcnt, litsym};   /* length code */
-	static huffman lencode = {lencnt, lensym};   /* length code */
-	static huffman distcode = {distcnt, distsym};/* distance code */
-	/* bit lengths of literal codes */
-	static const unsigned char litlen[] = {
-		11, 124, 8, 7, 28, 7, 188, 13, 76, 4, 10, 8, 12, 10, 12, 10, 8, 23, 8,
-		9, 7, 6, 7, 8, 7, 6, 55, 8, 23, 24, 12, 11, 7, 9, 11, 12, 6, 7, 22, 5,
-		7, 24, 6, 11, 9, 6, 7, 22, 7, 11, 38, 7, 9, 8, 25, 11, 8, 11, 9, 12,
-		8, 12, 5, 38, 5, 38, 5, 11, 7, 5, 6, 21, 6, 10, 53, 8, 7, 24, 10, 27,
-		44, 253, 253, 253, 252, 252, 252, 13, 12, 45, 12, 45, 12, 61, 12, 45,
-		44, 173
-	};
-	/* bit lengths of length codes 0..15 */
-	static const unsigned char lenlen[] = {2, 35, 36, 53, 38, 23};
-	/* bit lengths of distance codes 0..63 */
-	static const unsigned char distlen[] = {2, 20, 53, 230, 247, 151, 248};
-	static const short base[16] = {     /* base for length codes */
-		3, 2, 4, 5, 6, 7, 8, 9, 10, 12, 16, 24, 40, 72, 136, 264
-	};
-	static const char extra[16] = {     /* extra bits for length codes */
-		0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8
-	};
-	
-	/* set up decoding tables (once--might not be thread-safe) */
-	if(virgin) {
-		construct(&litcode, litlen, sizeof(litlen));
-		construct(&lencode, lenlen, sizeof(lenlen));
-		construct(&distcode, distlen, sizeof(distlen));
-		virgin = 0;
-	}
 	
 	/* read header */
 	lit = bits(s, 8);
@@ -346,53 +457,27 @@ static BlastResult blastDecompress(state * s) {
 	
 	/* decode literals and length/distance pairs */
 	do {
+		BlastResult err;
 		if(bits(s, 1)) {
 			/* get length */
-			symbol = decode(s, &lencode);
+			symbol = decode(s, &g_tables.lencode);
 			len = base[symbol] + bits(s, extra[symbol]);
 			if (len == 519) break;              /* end code */
 			
 			/* get distance */
 			symbol = len == 2 ? 2 : dict;
-			dist = decode(s, &distcode) << symbol;
+			dist = decode(s, &g_tables.distcode) << symbol;
 			dist += bits(s, symbol);
 			dist++;
-			if (s->first && dist > (int)s->next)
-				return BLAST_INVALID_OFFSET;
 			
-			/* copy length bytes from distance bytes back */
-			do {
-				to = s->out + s->next;
-				from = to - dist;
-				copy = MAXWIN;
-				if ((int)s->next < dist) {
-					from += copy;
-					copy = dist;
-				}
-				copy -= s->next;
-				if (copy > len) copy = len;
-				len -= copy;
-				s->next += copy;
-				do {
-					*to++ = *from++;
-				} while(--copy);
-				if(s->next == MAXWIN) {
-					if(s->outfun(s->outhow, s->out, s->next)) return BLAST_OUTPUT_ERROR;
-					s->next = 0;
-					s->first = 0;
-				}
-			} while(len != 0);
+			err = out.copy(dist, len);
 			
 		} else {
 			/* get literal and write it */
-			symbol = lit ? decode(s, &litcode) : bits(s, 8);
-			s->out[s->next++] = symbol;
-			if(s->next == MAXWIN) {
-				if(s->outfun(s->outhow, s->out, s->next)) return BLAST_OUTPUT_ERROR;
-				s->next = 0;
-				s->first = 0;
-			}
+			symbol = lit ? decode(s, &g_tables.litcode) : bits(s, 8);
+			err = out.literal(symbol);
 		}
+		if(err) return err;
 	} while(1);
 	
 	return BLAST_SUCCESS;
@@ -400,36 +485,50 @@ static BlastResult blastDecompress(state * s) {
 
 BlastResult blast(blast_in infun, void *inhow, blast_out outfun, void *outhow) {
 	
-	state s;
-	
 	// initialize input state
+	state s;
 	s.infun = infun;
 	s.inhow = inhow;
+	s.in = NULL;
 	s.left = 0;
 	s.bitbuf = 0;
 	s.bitcnt = 0;
 	
-	// initialize output state
-	s.outfun = outfun;
-	s.outhow = outhow;
-	s.next = 0;
-	s.first = 1;
+	window_output out(outfun, outhow);
 	
 	BlastResult err;
 	try {
-		err = blastDecompress(&s);
+		err = blastDecompress(&s, out);
 	} catch(const blast_truncated_error &) {
 		err = BLAST_TRUNCATED_INPUT;
 	}
 	
 	// write any leftover output and update the error code if needed
-	if(err != 1 && s.next && s.outfun(s.outhow, s.out, s.next) && err == 0) {
+	if(err != BLAST_OUTPUT_ERROR && out.finish() && err == BLAST_SUCCESS) {
 		err = BLAST_OUTPUT_ERROR;
 	}
 	
 	return err;
 }
 
+static BlastResult blastMemory(const char * from, size_t fromSize, memory_output & out) {
+	
+	// The whole input is available up front
+	state s;
+	s.infun = NULL;
+	s.inhow = NULL;
+	s.in = reinterpret_cast<const unsigned char *>(from);
+	s.left = fromSize;
+	s.bitbuf = 0;
+	s.bitcnt = 0;
+	
+	try {
+		return blastDecompress(&s, out);
+	} catch(const blast_truncated_error &) {
+		return BLAST_TRUNCATED_INPUT;
+	}
+}
+
 // Additional functions.
 
 int blastOutMem(void * Param, unsigned char * buf, size_t len) {
@@ -486,33 +585,32 @@ int blastOutMemRealloc(void * Param, unsigned char * buf, size_t len) {
 
 char * blastMemAlloc(const char * from, size_t fromSize, size_t & toSize) {
 	
-	BlastMemInBuffer in(from, fromSize);
-	BlastMemOutBufferRealloc out;
+	// Most files compress to between a third and a quarter of their size
+	size_t capacity = fromSize * 3;
+	memory_output out((char *)malloc(capacity), capacity, true);
 	
-	BlastResult error = blast(blastInMem, &in, blastOutMemRealloc, &out);
+	BlastResult error = blastMemory(from, fromSize, out);
 	if(error) {
 		LogError << "blastMemAlloc error " << error << " for " << fromSize;
+		free(out.data());
 		toSize = 0;
 		return NULL;
 	}
 	
-	// TODO realloc to fit fill size?
-	
-	toSize = out.fillSize;
-	return out.buf;
+	toSize = out.size();
+	return out.data();
 }
 
 
 size_t blastMem(const char * from, size_t fromSize, char * to, size_t toSize) {
 	
-	BlastMemInBuffer in(from, fromSize);
-	BlastMemOutBuffer out(to, toSize);
+	memory_output out(to, toSize, false);
 	
-	BlastResult error = blast(blastInMem, &in, blastOutMem, &out);
+	BlastResult error = blastMemory(from, fromSize, out);
 	if(error) {
 		LogError << "blastMem error " << error << " for " << fromSize << "/" << toSize;
 		return 0;
 	}
 	
-	return toSize - out.size;
+	return out.size();
 }
@@ -43,7 +43,9 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 
 #include "io/SaveBlock.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 
 #include <boost/algorithm/string/case_conv.hpp>
 
@@ -54,6 +56,7 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include "io/Blast.h"
 
 #include "platform/Platform.h"
+#include "platform/ThreadPool.h"
 
 static const u32 SAV_VERSION_OLD = (1<<16) | 0;
 static const u32 SAV_VERSION_RELEASE = (1<<16) | 1;
@@ -183,6 +186,15 @@ char * SaveBlock::File::loadData(std::istream & handle, size_t & size, const std
 		return NULL;
 	}
 	
+	return decompressData(readData(handle), size, name);
+}
+
+char * SaveBlock::File::readData(std::istream & handle) const {
+	
+	if(storedSize == 0) {
+		return NULL;
+	}
+	
 	char * buf = (char*)malloc(storedSize);
 	char * p = buf;
 	
@@ -195,6 +207,16 @@ char * SaveBlock::File::loadData(std::istream & handle, size_t & size, const std
 	
 	arx_assert(p == buf + storedSize);
 	
+	return buf;
+}
+
+char * SaveBlock::File::decompressData(char * buf, size_t & size, const std::string & name) const {
+	
+	if(!buf) {
+		size = 0;
+		return NULL;
+	}
+	
 	switch(comp) {
 		
 		case File::None: {
@@ -249,7 +271,9 @@ char * SaveBlock::File::loadData(std::istream & handle, size_t & size, const std
 	}
 }
 
-SaveBlock::SaveBlock(const fs::path & _savefile) : savefile(_savefile), totalSize(0), usedSize(0), chunkCount(0) { }
+SaveBlock::SaveBlock(const fs::path & _savefile)
+	: savefile(_savefile), totalSize(0), usedSize(0), chunkCount(0), deferWrites(false)
+	, shared(false) { }
 
 SaveBlock::~SaveBlock() { }
 
@@ -329,11 +353,10 @@ bool SaveBlock::loadFileTable() {
 	return true;
 }
 
-void SaveBlock::writeFileTable(const std::string & important) {
+void SaveBlock::writeFileTable(std::ostream & handle, const Files & files, size_t _fatOffset,
+                               const std::string & important) {
 	
-	LogDebug("writeFileTable " << savefile);
-	
-	u32 fatOffset = totalSize;
+	u32 fatOffset = _fatOffset;
 	handle.seekp(fatOffset + 4);
 	
 	fs::write(handle, SAV_VERSION_NOEXT);
@@ -385,6 +408,9 @@ bool SaveBlock::open(bool writable) {
 		return false;
 	}
 	
+	// Files cloned by flush() may be hard links that must not be modified in place
+	shared = writable && fs::hard_link_count(savefile) > 1;
+	
 	return true;
 }
 
@@ -393,17 +419,158 @@ bool SaveBlock::flush(const std::string & important) {
 	arx_assert(important.find_first_of(BADSAVCHAR) == std::string::npos,
 	           "bad save filename: \"%s\"", important.c_str());
 	
+	if(!writeDeferred(deferred.size())) {
+		return false;
+	}
+	
 	if((usedSize * 2 < totalSize || chunkCount > (files.size() * 4 / 3))) {
 		defragment();
 	}
 	
-	writeFileTable(important);
+	if(!unshare()) {
+		return false;
+	}
+	
+	LogDebug("writeFileTable " << savefile);
+	
+	writeFileTable(handle, files, totalSize, important);
 	
 	handle.flush();
 	
 	return handle.good();
 }
 
+bool SaveBlock::flush(const std::string & important, const fs::path & destination,
+                      ThreadPool * pool) {
+	
+	arx_assert(important.find_first_of(BADSAVCHAR) == std::string::npos,
+	           "bad save filename: \"%s\"", important.c_str());
+	
+	compressDeferred(deferred.size(), pool);
+	
+	LogDebug("writing " << files.size() << " files to " << destination);
+	
+	fs::path tempFile = destination;
+	tempFile.append(".tmp");
+	
+	fs::ofstream out(tempFile, fs::fstream::out | fs::fstream::binary | fs::fstream::trunc);
+	if(!out.is_open()) {
+		LogError << "Could not open " << tempFile << " for writing";
+		flush(important);
+		return false;
+	}
+	
+	Files table;
+	size_t offset = 0;
+	out.seekp(4);
+	
+	for(Files::const_iterator file = files.begin(); file != files.end(); ++file) {
+		
+		if(deferred.find(file->first) != deferred.end()) {
+			continue;
+		}
+		
+		File & entry = table[file->first];
+		entry = file->second;
+		entry.chunks.clear();
+		
+		if(entry.storedSize != 0) {
+			char * buf = file->second.readData(handle);
+			out.write(buf, entry.storedSize);
+			free(buf);
+			entry.chunks.push_back(File::Chunk(entry.storedSize, offset));
+			offset += entry.storedSize;
+		}
+	}
+	
+	for(DeferredFiles::const_iterator file = deferred.begin(); file != deferred.end(); ++file) {
+		
+		File & entry = table[file->first];
+		entry.comp = (file->second.comp == File::Deflate) ? File::Deflate : File::None;
+		entry.uncompressedSize = file->second.size;
+		entry.storedSize = file->second.data.size();
+		
+		if(entry.storedSize != 0) {
+			out.write(&file->second.data[0], entry.storedSize);
+			entry.chunks.push_back(File::Chunk(entry.storedSize, offset));
+			offset += entry.storedSize;
+		}
+	}
+	
+	writeFileTable(out, table, offset, important);
+	
+	out.flush();
+	bool written = !out.fail() && !handle.fail();
+	out.close();
+	
+	// Our file may be a hard link to the destination, which cannot be replaced on Windows
+	// while we still have it open
+	handle.close();
+	
+	if(!written || !fs::rename(tempFile, destination, true)) {
+		LogError << "Could not write " << destination;
+		fs::remove(tempFile);
+		handle.clear();
+		handle.open(savefile, fs::fstream::in | fs::fstream::out | fs::fstream::binary);
+		flush(important);
+		return false;
+	}
+	
+	// Replace our own file with the destination instead of writing the same data again
+	
+	fs::path workingFile = savefile;
+	workingFile.append(".tmp");
+	fs::remove(workingFile);
+	if((!fs::clone_file(destination, workingFile)
+	    && !fs::copy_file(destination, workingFile, true))
+	   || !fs::rename(workingFile, savefile, true)) {
+		LogWarning << "Could not replace " << savefile << " with " << destination;
+		fs::remove(workingFile);
+		handle.clear();
+		handle.open(savefile, fs::fstream::in | fs::fstream::out | fs::fstream::binary);
+		return flush(important);
+	}
+	
+	files.swap(table);
+	deferred.clear();
+	totalSize = usedSize = offset, chunkCount = 0;
+	for(Files::const_iterator file = files.begin(); file != files.end(); ++file) {
+		chunkCount += file->second.chunks.size();
+	}
+	
+	handle.clear();
+	handle.open(savefile, fs::fstream::in | fs::fstream::out | fs::fstream::binary);
+	shared = fs::hard_link_count(savefile) > 1;
+	
+	return handle.is_open();
+}
+
+bool SaveBlock::unshare() {
+	
+	if(!shared) {
+		return true;
+	}
+	
+	LogDebug("copying shared save file " << savefile << " before modifying it");
+	
+	handle.close();
+	
+	fs::path tempFile = savefile;
+	tempFile.append(".tmp");
+	bool copied = fs::copy_file(savefile, tempFile, true) && fs::rename(tempFile, savefile, true);
+	if(!copied) {
+		LogError << "Could not copy shared save file " << savefile;
+		fs::remove(tempFile);
+	}
+	
+	handle.clear();
+	handle.open(savefile, fs::fstream::in | fs::fstream::out | fs::fstream::binary);
+	
+	shared = !copied;
+	
+	return copied && handle.is_open();
+}
+
 bool SaveBlock::defragment() {
 	
 	LogDebug("defragmenting " << savefile << " save: using " << usedSize << " / " << totalSize
@@ -472,6 +639,7 @@ bool SaveBlock::defragment() {
 	}
 	
 	handle.open(savefile, fs::fstream::in | fs::fstream::out | fs::fstream::binary);
+	shared = false;
 	return handle.is_open();
 }
 
@@ -484,6 +652,217 @@ bool SaveBlock::save(const std::string & name, const char * data, size_t size) {
 	arx_assert(name.find_first_of(BADSAVCHAR) == std::string::npos,
 	           "bad save filename: \"%s\"", name.c_str());
 	
+	if(deferWrites) {
+		DeferredFile & file = deferred[name];
+		file.data.assign(data, data + size);
+		file.size = size;
+		file.comp = File::Unknown;
+		return true;
+	}
+	
+	return write(name, data, size);
+}
+
+bool SaveBlock::save(const EntryList & entries, ThreadPool * pool) {
+	
+	if(!handle) {
+		return false;
+	}
+	
+	if(deferWrites) {
+		for(EntryList::const_iterator entry = entries.begin(); entry != entries.end(); ++entry) {
+			if(!save(entry->name, entry->data, entry->size)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	
+	for(EntryList::const_iterator entry = entries.begin(); entry != entries.end(); ++entry) {
+		arx_assert(entry->name.find_first_of(BADSAVCHAR) == std::string::npos,
+		           "bad save filename: \"%s\"", entry->name.c_str());
+	}
+	
+	return write(entries, pool);
+}
+
+void SaveBlock::setDeferWrites(bool enable) {
+	arx_assert(enable || deferred.empty());
+	deferWrites = enable;
+}
+
+//! Compress a file, \return a new[]-allocated buffer or NULL if the data should be stored as-is
+static char * compressData(const char * data, size_t size, size_t & compressedSize) {
+	
+	if(size <= 1) {
+		return NULL;
+	}
+	
+	uLongf destSize = size - 1;
+	char * compressed = new char[destSize];
+	if(compress2((Bytef*)compressed, &destSize, (const Bytef*)data, size, 1) != Z_OK) {
+		delete[] compressed;
+		return NULL;
+	}
+	
+	compressedSize = destSize;
+	return compressed;
+}
+
+namespace {
+
+class CompressTask : public ThreadPool::Task {
+	
+	const SaveBlock::EntryList & m_files;
+	std::vector<char *> & m_compressed;
+	std::vector<size_t> & m_sizes;
+	
+public:
+	
+	CompressTask(const SaveBlock::EntryList & files, std::vector<char *> & compressed,
+	             std::vector<size_t> & sizes)
+		: m_files(files), m_compressed(compressed), m_sizes(sizes) { }
+	
+	void run(size_t index) {
+		const SaveBlock::Entry & file = m_files[index];
+		m_compressed[index] = compressData(file.data, file.size, m_sizes[index]);
+	}
+	
+};
+
+} // anonymous namespace
+
+void SaveBlock::compress(const std::vector<DeferredFile *> & pending, ThreadPool * pool) {
+	
+	EntryList entries;
+	entries.reserve(pending.size());
+	for(std::vector<DeferredFile *>::const_iterator file = pending.begin(); file != pending.end(); ++file) {
+		std::vector<char> & data = (*file)->data;
+		entries.push_back(Entry(std::string(), data.empty() ? NULL : &data[0], data.size()));
+	}
+	
+	std::vector<char *> compressed(entries.size(), NULL);
+	std::vector<size_t> compressedSizes(entries.size(), 0);
+	
+	CompressTask task(entries, compressed, compressedSizes);
+	ThreadPool::run(pool, task, entries.size());
+	
+	for(size_t i = 0; i < pending.size(); i++) {
+		DeferredFile & file = *pending[i];
+		if(compressed[i]) {
+			file.data.assign(compressed[i], compressed[i] + compressedSizes[i]);
+			file.comp = File::Deflate;
+			delete[] compressed[i];
+		} else {
+			file.comp = File::None;
+		}
+	}
+}
+
+size_t SaveBlock::compressDeferred(size_t count, ThreadPool * pool) {
+	
+	std::vector<DeferredFile *> pending;
+	size_t remaining = 0;
+	for(DeferredFiles::iterator file = deferred.begin(); file != deferred.end(); ++file) {
+		if(file->second.comp == File::Unknown) {
+			if(pending.size() < count) {
+				pending.push_back(&file->second);
+			} else {
+				remaining++;
+			}
+		}
+	}
+	
+	compress(pending, pool);
+	
+	return remaining;
+}
+
+bool SaveBlock::writeDeferred(size_t count, ThreadPool * pool) {
+	
+	count = std::min(count, deferred.size());
+	if(count == 0) {
+		return true;
+	}
+	
+	std::vector<std::string> names;
+	names.reserve(count);
+	std::vector<DeferredFile *> pending;
+	DeferredFiles::iterator it = deferred.begin();
+	for(size_t i = 0; i < count; i++, ++it) {
+		names.push_back(it->first);
+		if(it->second.comp == File::Unknown) {
+			pending.push_back(&it->second);
+		}
+	}
+	
+	compress(pending, pool);
+	
+	bool ret = true;
+	for(std::vector<std::string>::const_iterator name = names.begin(); name != names.end(); ++name) {
+		DeferredFiles::iterator file = deferred.find(*name);
+		if(ret) {
+			ret = write(*name, file->second);
+		}
+		deferred.erase(file);
+	}
+	
+	return ret;
+}
+
+bool SaveBlock::write(const std::string & name, const DeferredFile & file) {
+	
+	const char * data = file.data.empty() ? NULL : &file.data[0];
+	
+	if(file.comp == File::Deflate) {
+		return write(name, NULL, file.size, data, file.data.size());
+	}
+	
+	arx_assert(file.data.size() == file.size);
+	
+	return write(name, data, file.size, NULL, 0);
+}
+
+bool SaveBlock::write(const EntryList & entries, ThreadPool * pool) {
+	
+	std::vector<char *> compressed(entries.size(), NULL);
+	std::vector<size_t> compressedSizes(entries.size(), 0);
+	
+	CompressTask task(entries, compressed, compressedSizes);
+	ThreadPool::run(pool, task, entries.size());
+	
+	// Writing needs to be sequential but can reuse the old chunks of each file
+	bool ret = true;
+	for(size_t i = 0; i < entries.size(); i++) {
+		const Entry & entry = entries[i];
+		if(ret) {
+			ret = write(entry.name, entry.data, entry.size, compressed[i], compressedSizes[i]);
+		}
+		delete[] compressed[i];
+	}
+	
+	return ret;
+}
+
+bool SaveBlock::write(const std::string & name, const char * data, size_t size) {
+	
+	size_t compressedSize = 0;
+	char * compressed = compressData(data, size, compressedSize);
+	
+	bool ret = write(name, data, size, compressed, compressedSize);
+	
+	delete[] compressed;
+	
+	return ret;
+}
+
+bool SaveBlock::write(const std::string & name, const char * data, size_t size,
+                      const char * compressed, size_t compressedSize) {
+	
+	if(!unshare()) {
+		return false;
+	}
+	
 	File * file = &files[name];
 	
 	file->uncompressedSize = size;
@@ -494,10 +873,8 @@ bool SaveBlock::save(const std::string & name, const char * data, size_t size) {
 		return true;
 	}
 	
-	uLongf compressedSize = size - 1;
-	char * compressed = new char[compressedSize];
 	const char * p;
-	if(compress2((Bytef*)compressed, &compressedSize, (const Bytef*)data, size, 1) == Z_OK) {
+	if(compressed) {
 		file->comp = File::Deflate;
 		file->storedSize = compressedSize;
 		p = compressed;
@@ -527,7 +904,6 @@ bool SaveBlock::save(const std::string & name, const char * data, size_t size) {
 		
 		if(remaining == 0) {
 			file->chunks.erase(++chunk, file->chunks.end());
-			delete[] compressed;
 			return true;
 		}
 	}
@@ -537,13 +913,12 @@ bool SaveBlock::save(const std::string & name, const char * data, size_t size) {
 	handle.write(p, remaining);
 	totalSize += remaining, usedSize += remaining, chunkCount++;
 	
-	delete[] compressed;
-	
 	return !handle.fail();
 }
 
 void SaveBlock::remove(const std::string & name) {
 	files.erase(name);
+	deferred.erase(name);
 }
 
 char * SaveBlock::load(const std::string & name, size_t & size) {
@@ -551,15 +926,96 @@ char * SaveBlock::load(const std::string & name, size_t & size) {
 	arx_assert(name.find_first_of(BADSAVCHAR) == std::string::npos,
 	           "bad save filename: \"%s\"", name.c_str());
 	
+	DeferredFiles::const_iterator pending = deferred.find(name);
+	if(pending != deferred.end()) {
+		const std::vector<char> & data = pending->second.data;
+		if(data.empty()) {
+			size = 0;
+			return NULL;
+		}
+		char * buf = (char*)malloc(data.size());
+		memcpy(buf, &data[0], data.size());
+		if(pending->second.comp != File::Deflate) {
+			size = data.size();
+			return buf;
+		}
+		File file;
+		file.comp = File::Deflate;
+		file.storedSize = data.size();
+		file.uncompressedSize = pending->second.size;
+		return file.decompressData(buf, size, name);
+	}
+	
 	Files::const_iterator file = files.find(name);
 	
 	return (file == files.end()) ? NULL : file->second.loadData(handle, size, name);
 }
 
+class SaveBlock::DecompressTask : public ThreadPool::Task {
+	
+	EntryList & m_files;
+	const std::vector<const File *> & m_stored;
+	
+public:
+	
+	DecompressTask(EntryList & files, const std::vector<const File *> & stored)
+		: m_files(files), m_stored(stored) { }
+	
+	void run(size_t index) {
+		Entry & file = m_files[index];
+		if(m_stored[index]) {
+			file.data = m_stored[index]->decompressData(file.data, file.size, file.name);
+		}
+	}
+	
+};
+
+bool SaveBlock::load(EntryList & entries, ThreadPool * pool) {
+	
+	std::vector<const File *> stored(entries.size(), NULL);
+	
+	// Read all stored data first - the file handle cannot be shared between threads
+	for(size_t i = 0; i < entries.size(); i++) {
+		
+		Entry & entry = entries[i];
+		
+		arx_assert(entry.name.find_first_of(BADSAVCHAR) == std::string::npos,
+		           "bad save filename: \"%s\"", entry.name.c_str());
+		
+		DeferredFiles::const_iterator pending = deferred.find(entry.name);
+		if(pending != deferred.end()) {
+			entry.data = load(entry.name, entry.size);
+			continue;
+		}
+		
+		Files::const_iterator file = files.find(entry.name);
+		if(file == files.end()) {
+			entry.data = NULL, entry.size = 0;
+			continue;
+		}
+		
+		entry.data = file->second.readData(handle);
+		entry.size = 0;
+		stored[i] = &file->second;
+	}
+	
+	DecompressTask task(entries, stored);
+	ThreadPool::run(pool, task, entries.size());
+	
+	bool ret = true;
+	for(size_t i = 0; i < entries.size(); i++) {
+		if(!entries[i].data && (stored[i] ? stored[i]->storedSize != 0 : !hasFile(entries[i].name))) {
+			ret = false;
+		}
+	}
+	
+	return ret;
+}
+
 bool SaveBlock::hasFile(const std::string & name) const {
 	arx_assert(name.find_first_of(BADSAVCHAR) == std::string::npos,
 	           "bad save filename: \"%s\"", name.c_str());
-	return (files.find(name) != files.end());
+	return (files.find(name) != files.end() || deferred.find(name) != deferred.end());
 }
 
 std::vector<std::string> SaveBlock::getFiles() const {
@@ -570,6 +1026,12 @@ std::vector<std::string> SaveBlock::getFiles() const {
 		result.push_back(file->first);
 	}
 	
+	for(DeferredFiles::const_iterator file = deferred.begin(); file != deferred.end(); ++file) {
+		if(files.find(file->first) == files.end()) {
+			result.push_back(file->first);
+		}
+	}
+	
 	return result;
 }
 
@@ -54,11 +54,30 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include "io/fs/FilePath.h"
 #include "io/fs/FileStream.h"
 
+class ThreadPool;
+
 /*!
  * Interface to read and write save block files. (used for savegames)
  */
 class SaveBlock {
 	
+public:
+	
+	//! A file passed to or returned from the batch versions of save() and load()
+	struct Entry {
+		
+		std::string name;
+		char * data;
+		size_t size;
+		
+		Entry() : data(NULL), size(0) { }
+		explicit Entry(const std::string & _name, char * _data = NULL, size_t _size = 0)
+			: name(_name), data(_data), size(_size) { }
+		
+	};
+	
+	typedef std::vector<Entry> EntryList;
+	
 private:
 	
 	struct File {
@@ -95,9 +114,33 @@ private:
 		
 		char * loadData(std::istream & handle, size_t & size, const std::string & name) const;
 		
+		//! Read the stored data for this file into a new, malloc-allocated buffer
+		char * readData(std::istream & handle) const;
+		
+		/*!
+		 * Decompress the data returned by readData().
+		 * This does not access the save block and can be called from any thread.
+		 * Takes ownership of the stored data.
+		 */
+		char * decompressData(char * buf, size_t & size, const std::string & name) const;
+		
 	};
 	
+	//! A file buffered in memory while deferring writes
+	struct DeferredFile {
+		
+		std::vector<char> data; //!< The raw data or the stored data once compressed
+		size_t size; //!< Uncompressed size
+		File::Compression comp; //!< Unknown until the data has been compressed
+		
+		DeferredFile() : size(0), comp(File::Unknown) { }
+		
+	};
+	
+	class DecompressTask;
+	
 	typedef boost::unordered_map<std::string, File> Files;
+	typedef boost::unordered_map<std::string, DeferredFile> DeferredFiles;
 	
 	fs::path savefile;
 	fs::fstream handle;
@@ -105,10 +148,21 @@ private:
 	size_t usedSize;
 	size_t chunkCount;
 	Files files;
+	bool deferWrites;
+	DeferredFiles deferred;
+	bool shared;
 	
+	bool write(const std::string & name, const char * data, size_t size);
+	bool write(const std::string & name, const char * data, size_t size,
+	           const char * compressed, size_t compressedSize);
+	bool write(const EntryList & entries, ThreadPool * pool);
+	bool write(const std::string & name, const DeferredFile & file);
+	void compress(const std::vector<DeferredFile *> & files, ThreadPool * pool);
+	bool unshare();
 	bool defragment();
 	bool loadFileTable();
-	void writeFileTable(const std::string & important);
+	static void writeFileTable(std::ostream & handle, const Files & files, size_t fatOffset,
+	                           const std::string & important);
 	
 public:
 	
@@ -132,6 +186,23 @@ public:
 	 */
 	bool flush(const std::string & important);
 	
+	/*!
+	 * Finalize the save block by writing a defragmented copy to another file.
+	 * 
+	 * The copy is written to a temporary file next to the destination which then replaces
+	 * it. The replacement is atomic where the filesystem supports it (rename() on POSIX). Files buffered since setDeferWrites(true) are only written to the copy.
+	 * Afterwards, this save block's own file is replaced with a clone of the destination
+	 * where the filesystem allows it, or with a copy otherwise.
+	 * 
+	 * If the destination cannot be written, pending files are written to this save block
+	 * as in flush().
+	 * 
+	 * \param pool the thread pool to compress remaining buffered files on, or NULL
+	 * \return false if the destination could not be written
+	 */
+	bool flush(const std::string & important, const fs::path & destination,
+	           ThreadPool * pool = NULL);
+	
 	/*!
 	 * Save a file to the save block.
 	 * This only writes the file data and does not add the file to the file table.
@@ -140,12 +211,64 @@ public:
 	 */
 	bool save(const std::string & name, const char * data, size_t size);
 	
+	/*!
+	 * Save multiple files to the save block, compressing them concurrently.
+	 * 
+	 * The resulting save block is the same as if save() had been called for each file.
+	 * 
+	 * \param pool the thread pool to compress the files on, or NULL to compress them
+	 *             on the calling thread
+	 */
+	bool save(const EntryList & files, ThreadPool * pool);
+	
 	/*!
 	 * Remove a file from the save block.
 	 */
 	void remove(const std::string & name);
 	
+	/*!
+	 * Buffer files passed to save() in memory instead of compressing and writing them.
+	 * 
+	 * This allows to take a snapshot quickly and write it later, possibly from another
+	 * thread, using writeDeferred() or compressDeferred() and flush().
+	 * Deferred writes can only be disabled once all buffered files have been written.
+	 */
+	void setDeferWrites(bool enable);
+	
+	//! \return the number of buffered files that still need to be written
+	size_t getDeferredCount() const { return deferred.size(); }
+	
+	/*!
+	 * Compress and write some of the files buffered since setDeferWrites(true).
+	 * \param count the maximum number of files to write
+	 * \param pool the thread pool to compress the files on, or NULL
+	 * \return false if the files could not be written
+	 */
+	bool writeDeferred(size_t count = 1, ThreadPool * pool = NULL);
+	
+	/*!
+	 * Compress some of the files buffered since setDeferWrites(true) but keep them in memory.
+	 * \param count the maximum number of files to compress
+	 * \param pool the thread pool to compress the files on, or NULL
+	 * \return the number of buffered files that still need to be compressed
+	 */
+	size_t compressDeferred(size_t count, ThreadPool * pool = NULL);
+	
 	char * load(const std::string & name, size_t & size);
+	
+	/*!
+	 * Load multiple files from the save block, decompressing them concurrently.
+	 * 
+	 * The stored data is read sequentially on the calling thread.
+	 * 
+	 * \param files the files to load - for each entry, data will be set to a new,
+	 *              malloc-allocated buffer or NULL if the file could not be loaded
+	 * \param pool the thread pool to decompress the files on, or NULL to decompress
+	 *             them on the calling thread
+	 * \return false if any of the files could not be loaded
+	 */
+	bool load(EntryList & files, ThreadPool * pool);
+	
 	bool hasFile(const std::string & name) const;
 	
 	std::vector<std::string> getFiles() const;
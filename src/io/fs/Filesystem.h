@@ -108,6 +108,30 @@ bool create_directories(const path & p);
  */
 bool copy_file(const path & from_p, const path & to_p, bool overwrite = false);
 
+/*!
+ * \brief Create a copy of a regular file without duplicating its data
+ *
+ * This uses a copy-on-write clone if the filesystem supports it and a hard link otherwise.
+ * For hard links, writes to either file will also change the other one - use
+ * \ref hard_link_count() to detect this before modifying a file in place.
+ *
+ * from_p must exist and be a regular file.
+ * to_p.parent() must exist and be a directory.
+ * to_p must not exist.
+ *
+ * \return true if the file was cloned or linked or false if neither is supported or
+ *         there was an error. Nothing is copied in that case.
+ */
+bool clone_file(const path & from_p, const path & to_p);
+
+/*!
+ * \brief Get the number of hard links to a file
+ *
+ * \return the number of names referring to the file or 0 if there was an error
+ *         (file doesn't exist, ...).
+ */
+u64 hard_link_count(const path & p);
+
 /*!
  * \brief Move a regular file or directory
  *
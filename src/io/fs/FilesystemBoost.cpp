@@ -101,6 +101,18 @@ bool copy_file(const path & from_p, const path & to_p, bool overwrite) {
 	return !ec;
 }
 
+bool clone_file(const path & from_p, const path & to_p) {
+	error_code ec;
+	fs_boost::create_hard_link(from_p.string(), to_p.string(), ec);
+	return !ec;
+}
+
+u64 hard_link_count(const path & p) {
+	error_code ec;
+	uintmax_t count = fs_boost::hard_link_count(p.string(), ec);
+	return ec ? 0 : (u64)count;
+}
+
 bool rename(const path & old_p, const path & new_p, bool overwrite) {
 	if(!overwrite && exists(new_p)) {
 		return false;
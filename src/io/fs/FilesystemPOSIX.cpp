@@ -31,6 +31,14 @@
 #include <dirent.h>
 #include <unistd.h>
 
+#if ARX_HAVE_CLONEFILE
+#include <sys/clonefile.h>
+#elif ARX_HAVE_FICLONE
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#endif
+
 #include <boost/algorithm/string/case_conv.hpp>
 
 #include "io/fs/FilePath.h"
@@ -146,6 +154,41 @@ bool copy_file(const path & from_p, const path & to_p, bool overwrite) {
 	return true;
 }
 
+bool clone_file(const path & from_p, const path & to_p) {
+	
+#if ARX_HAVE_CLONEFILE
+	if(!clonefile(from_p.string().c_str(), to_p.string().c_str(), 0)) {
+		return true;
+	}
+#elif ARX_HAVE_FICLONE
+	int in = open(from_p.string().c_str(), O_RDONLY);
+	if(in >= 0) {
+		int out = open(to_p.string().c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
+		if(out >= 0) {
+			bool cloned = !ioctl(out, FICLONE, in);
+			close(out);
+			if(cloned) {
+				close(in);
+				return true;
+			}
+			::remove(to_p.string().c_str());
+		}
+		close(in);
+	}
+#endif
+	
+#if ARX_HAVE_LINK
+	return !link(from_p.string().c_str(), to_p.string().c_str());
+#else
+	return false;
+#endif
+}
+
+u64 hard_link_count(const path & p) {
+	struct stat buf;
+	return stat(p.string().c_str(), &buf) ? 0 : (u64)buf.st_nlink;
+}
+
 bool rename(const path & old_p, const path & new_p, bool overwrite) {
 	
 	if(!overwrite && exists(new_p)) {
@@ -224,6 +224,32 @@ bool copy_file(const path & from_p, const path & to_p, bool overwrite) {
 	return ret;
 }
 
+bool clone_file(const path & from_p, const path & to_p) {
+	// Block cloning is only available on ReFS - use hard links instead
+	return CreateHardLinkW(platform::WideString(to_p.string()),
+	                       platform::WideString(from_p.string()), NULL) == TRUE;
+}
+
+u64 hard_link_count(const path & p) {
+	
+	HANDLE hFile = CreateFileW(platform::WideString(p.string()), 0,
+	                           FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+	                           NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(hFile == INVALID_HANDLE_VALUE) {
+		return 0;
+	}
+	
+	u64 count = 0;
+	BY_HANDLE_FILE_INFORMATION info;
+	if(GetFileInformationByHandle(hFile, &info)) {
+		count = info.nNumberOfLinks;
+	}
+	
+	::CloseHandle(hFile);
+	
+	return count;
+}
+
 bool rename(const path & old_p, const path & new_p, bool overwrite) {
 	
 	DWORD flags = overwrite ? MOVEFILE_REPLACE_EXISTING : 0;
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2016 Arx Libertatis Team (see the AUTHORS file)
+ *
+ * This file is part of Arx Libertatis.
+ *
+ * Arx Libertatis is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Arx Libertatis is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Arx Libertatis.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ARX_IO_RESOURCE_ARCHIVEFORMAT_H
+#define ARX_IO_RESOURCE_ARCHIVEFORMAT_H
+
+#include <string>
+
+#include "platform/Platform.h"
+
+/*
+ * Repacked archives are created from the original .pak files by arxrepack and are
+ * mounted on top of them to reduce load times.
+ *
+ * Layout:
+ *  - ArchiveHeader, padded to ARCHIVE_ALIGNMENT
+ *  - File data, each file starting at a multiple of ARCHIVE_ALIGNMENT
+ *  - Table of contents at ArchiveHeader::tocOffset:
+ *    ArchiveEntry[fileCount] sorted by name, followed by the names of all files
+ */
+
+#pragma pack(push,1)
+
+const u32 ARCHIVE_MAGIC = 0x41585241; // "ARXA"
+const u32 ARCHIVE_VERSION = 1;
+
+//! File data is aligned to this many bytes
+const size_t ARCHIVE_ALIGNMENT = 4096;
+
+//! Compressed files are split into blocks of this size that can be decompressed independently
+const size_t ARCHIVE_BLOCK_SIZE = 64 * 1024;
+
+enum ArchiveCompression {
+	
+	//! The file data is stored as is
+	ArchiveStored = 0,
+	
+	/*!
+	 * A u32 table with the stored size of each block followed by the blocks.
+	 * Blocks are compressed with zlib unless the stored size equals the block size.
+	 */
+	ArchiveDeflate = 1
+	
+};
+
+struct ArchiveHeader {
+	u32 magic;
+	u32 version;
+	u64 sourceSize; //!< Size of the .pak file this archive was created from
+	u64 tocOffset;
+	u32 tocSize;
+	u32 tocChecksum; //!< crc32 of the table of contents
+	u32 fileCount;
+	u32 blockSize;
+};
+
+ARX_STATIC_ASSERT(sizeof(ArchiveHeader) == 40, "Header size mismatch");
+
+struct ArchiveEntry {
+	u64 hash; //!< archivePathHash() of the file name, checked when the archive is mounted
+	u64 offset;
+	u32 size; //!< Uncompressed size
+	u32 storedSize;
+	u32 checksum; //!< crc32 of the uncompressed data
+	u32 nameOffset; //!< Offset of the name relative to the end of the entry table
+	u16 nameSize;
+	u16 compression; //!< One of the ArchiveCompression values
+};
+
+ARX_STATIC_ASSERT(sizeof(ArchiveEntry) == 36, "Entry size mismatch");
+
+#pragma pack(pop)
+
+//! FNV-1a hash of a lowercase resource path used to detect corrupt archive entry names
+inline u64 archivePathHash(const std::string & name) {
+	const u64 prime = (u64(0x100) << 32) | 0x1b3;
+	u64 hash = (u64(0xcbf29ce4) << 32) | 0x84222325;
+	for(std::string::const_iterator i = name.begin(); i != name.end(); ++i) {
+		hash = (hash ^ u8(*i)) * prime;
+	}
+	return hash;
+}
+
+#endif // ARX_IO_RESOURCE_ARCHIVEFORMAT_H
@@ -25,6 +25,7 @@
 #include "io/log/Logger.h"
 #include "io/resource/ResourcePath.h"
 #include "platform/Platform.h"
+#include "platform/ThreadPool.h"
 
 PakFile::~PakFile() {
 	delete _alternative;
@@ -39,6 +40,41 @@ char * PakFile::readAlloc() const {
 	return buffer;
 }
 
+namespace {
+
+class ReadTask : public ThreadPool::Task {
+	
+	const std::vector<const PakFile *> & m_files;
+	std::vector<char *> & m_data;
+	std::vector<char> & m_success;
+	
+public:
+	
+	ReadTask(const std::vector<const PakFile *> & files, std::vector<char *> & data,
+	         std::vector<char> & success)
+		: m_files(files), m_data(data), m_success(success) { }
+	
+	void run(size_t index) {
+		m_data[index] = (char *)malloc(m_files[index]->size());
+		m_success[index] = m_files[index]->read(m_data[index]);
+	}
+	
+};
+
+} // anonymous namespace
+
+bool PakFile::readAlloc(const std::vector<const PakFile *> & files, std::vector<char *> & data,
+                        std::vector<char> & success, ThreadPool * pool) {
+	
+	data.assign(files.size(), NULL);
+	success.assign(files.size(), false);
+	
+	ReadTask task(files, data, success);
+	ThreadPool::run(pool, task, files.size());
+	
+	return std::find(success.begin(), success.end(), false) == success.end();
+}
+
 PakDirectory::PakDirectory() { }
 
 PakDirectory::~PakDirectory() {
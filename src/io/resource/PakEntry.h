@@ -22,12 +22,14 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include <boost/noncopyable.hpp>
 
 namespace res { class path; }
 
 class PakFileHandle;
+class ThreadPool;
 
 class PakFile : private boost::noncopyable {
 	
@@ -51,9 +53,24 @@ public:
 	size_t size() const { return _size; }
 	PakFile * alternative() const { return _alternative; }
 	
-	virtual void read(void * buf) const = 0;
+	//! \return false if the file could not be read completely or is corrupt
+	virtual bool read(void * buf) const = 0;
 	char * readAlloc() const;
 	
+	/*!
+	 * Read multiple files into new, malloc-allocated buffers.
+	 *
+	 * Reads from the same archive are serialized, but compressed files are decompressed
+	 * in parallel if a thread pool is given.
+	 *
+	 * \param data is resized to match files and receives the buffer for each file
+	 * \param success is resized to match files and receives the result of read() for each file
+	 *
+	 * \return true if all files were read successfully
+	 */
+	static bool readAlloc(const std::vector<const PakFile *> & files, std::vector<char *> & data,
+	                      std::vector<char> & success, ThreadPool * pool = NULL);
+	
 	virtual PakFileHandle * open() const = 0;
 	
 };
@@ -26,16 +26,39 @@
 
 #include <boost/algorithm/string/case_conv.hpp>
 #include <boost/foreach.hpp>
+#include <boost/scoped_array.hpp>
+
+#include <zlib.h>
 
 #include "io/log/Logger.h"
 #include "io/Blast.h"
+#include "io/resource/ArchiveFormat.h"
 #include "io/resource/PakEntry.h"
 #include "io/fs/FilePath.h"
 #include "io/fs/Filesystem.h"
 #include "io/fs/FileStream.h"
 
+#include "platform/Lock.h"
+
 #include "util/String.h"
 
+/*!
+ * Stream for a .pak file or repacked archive that is shared by all files in the archive.
+ *
+ * Seeking and reading is serialized per archive so that files can be read from any thread
+ * as long as no files are added or removed.
+ */
+class ArchiveStream : public fs::ifstream {
+	
+public:
+	
+	Lock lock;
+	
+	explicit ArchiveStream(const fs::path & path)
+		: fs::ifstream(path, fs::fstream::in | fs::fstream::binary) { }
+	
+};
+
 namespace {
 
 const size_t PAK_READ_BUF_SIZE = 1024;
@@ -75,15 +98,15 @@ static void pakDecrypt(char * fat, size_t fat_size, PakReader::ReleaseType keyId
 /*! Uncompressed file in a .pak file archive. */
 class UncompressedFile : public PakFile {
 	
-	std::istream & archive;
+	ArchiveStream & archive;
 	size_t offset;
 	
 public:
 	
-	explicit UncompressedFile(std::istream * _archive, size_t _offset, size_t size)
+	explicit UncompressedFile(ArchiveStream * _archive, size_t _offset, size_t size)
 		: PakFile(size), archive(*_archive), offset(_offset) { }
 	
-	void read(void * buf) const;
+	bool read(void * buf) const;
 	
 	PakFileHandle * open() const;
 	
@@ -111,16 +134,19 @@ public:
 	
 };
 
-void UncompressedFile::read(void * buf) const {
+bool UncompressedFile::read(void * buf) const {
+	
+	Autolock lock(archive.lock);
 	
 	archive.seekg(offset);
 	
 	fs::read(archive, buf, size());
 	
-	arx_assert(!archive.fail());
-	arx_assert(size_t(archive.gcount()) == size());
+	bool success = !archive.fail() && size_t(archive.gcount()) == size();
 	
 	archive.clear();
+	
+	return success;
 }
 
 PakFileHandle * UncompressedFile::open() const {
@@ -133,6 +159,8 @@ size_t UncompressedFileHandle::read(void * buf, size_t size) {
 		return 0;
 	}
 	
+	Autolock lock(file.archive.lock);
+	
 	file.archive.seekg(file.offset + offset);
 	
 	if(file.size() < offset + size) {
@@ -175,17 +203,17 @@ size_t UncompressedFileHandle::tell() {
 /*! Compressed file in a .pak file archive. */
 class CompressedFile : public PakFile {
 	
-	fs::ifstream & archive;
+	ArchiveStream & archive;
 	size_t offset;
 	size_t storedSize;
 	
 public:
 	
-	explicit CompressedFile(fs::ifstream * _archive, size_t _offset, size_t size,
+	explicit CompressedFile(ArchiveStream * _archive, size_t _offset, size_t size,
 	                        size_t _storedSize)
 		: PakFile(size), archive(*_archive), offset(_offset), storedSize(_storedSize) { }
 	
-	void read(void * buf) const;
+	bool read(void * buf) const;
 	
 	PakFileHandle * open() const;
 	
@@ -237,23 +265,34 @@ size_t blastInFile(void * Param, const unsigned char ** buf) {
 	return fs::read(p->file, p->readbuf, count).gcount();
 }
 
-void CompressedFile::read(void * buf) const {
-	
-	archive.seekg(offset);
+bool CompressedFile::read(void * buf) const {
 	
-	BlastFileInBuffer in(&archive, storedSize);
-	BlastMemOutBuffer out(reinterpret_cast<char *>(buf), size());
-	
-	int r = blast(blastInFile, &in, blastOutMem, &out);
-	if(r) {
-		LogError << "Blast error " << r << " outSize=" << size();
+	// Only hold the archive lock while reading so that files can be decompressed in parallel
+	boost::scoped_array<char> compressed(new char[storedSize]);
+	{
+		Autolock lock(archive.lock);
+		
+		archive.seekg(offset);
+		
+		fs::read(archive, compressed.get(), storedSize);
+		
+		bool success = !archive.fail() && size_t(archive.gcount()) == storedSize;
+		
+		archive.clear();
+		
+		if(!success) {
+			LogError << "Error reading compressed file at " << offset;
+			return false;
+		}
 	}
 	
-	arx_assert(!archive.fail());
-	arx_assert(in.remaining == 0);
-	arx_assert(out.size == 0);
+	size_t outSize = blastMem(compressed.get(), storedSize, reinterpret_cast<char *>(buf), size());
+	if(outSize != size()) {
+		LogError << "Blast error: got " << outSize << " bytes, expected " << size();
+		return false;
+	}
 	
-	archive.clear();
+	return true;
 }
 
 PakFileHandle * CompressedFile::open() const {
@@ -312,6 +351,8 @@ size_t CompressedFileHandle::read(void * buf, size_t size) {
 		           << " offset=" << offset << " total=" << file.size();
 	}
 	
+	Autolock lock(file.archive.lock);
+	
 	file.archive.seekg(file.offset);
 	
 	BlastFileInBuffer in(&file.archive, file.storedSize);
@@ -374,7 +415,7 @@ public:
 	
 	PlainFile(const fs::path & _path, size_t size) : PakFile(size), path(_path) { }
 	
-	void read(void * buf) const;
+	bool read(void * buf) const;
 	
 	PakFileHandle * open() const;
 	
@@ -401,15 +442,16 @@ public:
 	
 };
 
-void PlainFile::read(void * buf) const {
+bool PlainFile::read(void * buf) const {
 	
 	fs::ifstream ifs(path, fs::fstream::in | fs::fstream::binary);
-	arx_assert(ifs.is_open());
+	if(!ifs.is_open()) {
+		return false;
+	}
 	
 	fs::read(ifs, buf, size());
 	
-	arx_assert(!ifs.fail());
-	arx_assert(size_t(ifs.gcount()) == size());
+	return !ifs.fail() && size_t(ifs.gcount()) == size();
 }
 
 PakFileHandle * PlainFile::open() const {
@@ -434,6 +476,227 @@ size_t PlainFileHandle::tell() {
 	return ifs.tellg();
 }
 
+/*! File in a repacked archive created by arxrepack. */
+class ArchiveFile : public PakFile {
+	
+	ArchiveStream & archive;
+	u64 offset;
+	size_t storedSize;
+	u32 checksum;
+	u16 compression;
+	
+public:
+	
+	ArchiveFile(ArchiveStream * _archive, const ArchiveEntry & entry)
+		: PakFile(entry.size), archive(*_archive), offset(entry.offset),
+		  storedSize(entry.storedSize), checksum(entry.checksum),
+		  compression(entry.compression) { }
+	
+	bool read(void * buf) const;
+	
+	PakFileHandle * open() const;
+	
+	size_t getBlockCount() const {
+		return (size() + ARCHIVE_BLOCK_SIZE - 1) / ARCHIVE_BLOCK_SIZE;
+	}
+	
+	size_t getBlockSize(size_t block) const {
+		return std::min(ARCHIVE_BLOCK_SIZE, size() - block * ARCHIVE_BLOCK_SIZE);
+	}
+	
+	//! Read stored data relative to the start of this file
+	bool readStored(size_t pos, void * buf, size_t count) const;
+	
+	friend class ArchiveFileHandle;
+	
+};
+
+class ArchiveFileHandle : public PakFileHandle {
+	
+	const ArchiveFile & file;
+	size_t offset;
+	
+	std::vector<size_t> blockOffsets; //!< Start of the stored data for each block
+	std::vector<char> stored;
+	std::vector<char> block;
+	size_t cachedBlock;
+	
+public:
+	
+	explicit ArchiveFileHandle(const ArchiveFile * _file)
+		: file(*_file), offset(0), cachedBlock(size_t(-1)) { }
+	
+	size_t read(void * buf, size_t size);
+	
+	int seek(Whence whence, int offset);
+	
+	size_t tell();
+	
+	~ArchiveFileHandle() { }
+	
+};
+
+bool decompressBlock(const char * in, size_t inSize, char * out, size_t outSize) {
+	
+	if(inSize == outSize) {
+		memcpy(out, in, outSize);
+		return true;
+	}
+	
+	uLongf size = uLongf(outSize);
+	int ret = uncompress(reinterpret_cast<Bytef *>(out), &size,
+	                     reinterpret_cast<const Bytef *>(in), uLong(inSize));
+	
+	return ret == Z_OK && size == outSize;
+}
+
+bool ArchiveFile::readStored(size_t pos, void * buf, size_t count) const {
+	
+	Autolock lock(archive.lock);
+	
+	archive.seekg(offset + pos);
+	
+	fs::read(archive, buf, count);
+	
+	bool success = !archive.fail() && size_t(archive.gcount()) == count;
+	
+	archive.clear();
+	
+	return success;
+}
+
+bool ArchiveFile::read(void * buf) const {
+	
+	char * out = reinterpret_cast<char *>(buf);
+	
+	if(compression == ArchiveStored) {
+		if(!readStored(0, out, size())) {
+			LogError << "Error reading archive file at " << offset;
+			return false;
+		}
+	} else {
+		
+		// Only hold the archive lock while reading so that files can be decompressed in parallel
+		boost::scoped_array<char> data(new char[storedSize]);
+		if(!readStored(0, data.get(), storedSize)) {
+			LogError << "Error reading archive file at " << offset;
+			return false;
+		}
+		
+		size_t count = getBlockCount();
+		size_t pos = sizeof(u32) * count;
+		for(size_t i = 0; i < count; i++) {
+			u32 blockStored;
+			memcpy(&blockStored, data.get() + sizeof(u32) * i, sizeof(u32));
+			size_t blockSize = getBlockSize(i);
+			if(pos + blockStored > storedSize
+			   || !decompressBlock(data.get() + pos, blockStored, out, blockSize)) {
+				LogError << "Corrupt archive file at " << offset;
+				return false;
+			}
+			pos += blockStored, out += blockSize;
+		}
+		
+	}
+	
+	u32 crc = crc32(crc32(0, Z_NULL, 0), reinterpret_cast<const Bytef *>(buf), uInt(size()));
+	if(crc != checksum) {
+		LogError << "Checksum mismatch for archive file at " << offset;
+		return false;
+	}
+	
+	return true;
+}
+
+PakFileHandle * ArchiveFile::open() const {
+	return new ArchiveFileHandle(this);
+}
+
+size_t ArchiveFileHandle::read(void * buf, size_t size) {
+	
+	if(offset >= file.size()) {
+		return 0;
+	}
+	
+	size = std::min(size, file.size() - offset);
+	
+	if(file.compression == ArchiveStored) {
+		if(!file.readStored(offset, buf, size)) {
+			return 0;
+		}
+		offset += size;
+		return size;
+	}
+	
+	// Only the blocks that are actually needed are read and decompressed
+	
+	if(blockOffsets.empty()) {
+		size_t count = file.getBlockCount();
+		std::vector<u32> table(count);
+		if(!file.readStored(0, &table[0], sizeof(u32) * count)) {
+			return 0;
+		}
+		blockOffsets.resize(count + 1);
+		blockOffsets[0] = sizeof(u32) * count;
+		for(size_t i = 0; i < count; i++) {
+			blockOffsets[i + 1] = blockOffsets[i] + table[i];
+		}
+	}
+	
+	char * out = reinterpret_cast<char *>(buf);
+	size_t nread = 0;
+	while(nread < size) {
+		
+		size_t index = offset / ARCHIVE_BLOCK_SIZE;
+		size_t blockSize = file.getBlockSize(index);
+		
+		if(index != cachedBlock) {
+			size_t storedBlockSize = blockOffsets[index + 1] - blockOffsets[index];
+			stored.resize(storedBlockSize);
+			block.resize(ARCHIVE_BLOCK_SIZE);
+			if(storedBlockSize == 0
+			   || !file.readStored(blockOffsets[index], &stored[0], storedBlockSize)
+			   || !decompressBlock(&stored[0], storedBlockSize, &block[0], blockSize)) {
+				LogError << "Corrupt archive file at " << file.offset;
+				cachedBlock = size_t(-1);
+				break;
+			}
+			cachedBlock = index;
+		}
+		
+		size_t start = offset - index * ARCHIVE_BLOCK_SIZE;
+		size_t count = std::min(size - nread, blockSize - start);
+		memcpy(out + nread, &block[start], count);
+		nread += count;
+		offset += count;
+	}
+	
+	return nread;
+}
+
+int ArchiveFileHandle::seek(Whence whence, int _offset) {
+	
+	size_t base;
+	switch(whence) {
+		case SeekSet: base = 0; break;
+		case SeekEnd: base = file.size(); break;
+		case SeekCur: base = offset; break;
+		default: return -1;
+	}
+	
+	if((int)base + _offset < 0) {
+		return -1;
+	}
+	
+	offset = (int)base + _offset;
+	
+	return offset;
+}
+
+size_t ArchiveFileHandle::tell() {
+	return offset;
+}
+
 } // anonymous namespace
 
 PakReader::~PakReader() {
@@ -442,7 +705,7 @@ PakReader::~PakReader() {
 
 bool PakReader::addArchive(const fs::path & pakfile) {
 	
-	fs::ifstream * ifs = new fs::ifstream(pakfile, fs::fstream::in | fs::fstream::binary);
+	ArchiveStream * ifs = new ArchiveStream(pakfile);
 	
 	if(!ifs->is_open()) {
 		delete ifs;
@@ -458,6 +721,10 @@ bool PakReader::addArchive(const fs::path & pakfile) {
 		delete ifs;
 		return false;
 	}
+	
+	if(fat_offset == ARCHIVE_MAGIC) {
+		return addArchiveTable(ifs, pakfile);
+	}
 	if(ifs->seekg(fat_offset).fail()) {
 		LogError << pakfile << ": error seeking to FAT offset " << fat_offset;
 		delete ifs;
@@ -557,6 +824,105 @@ error:
 	return false;
 }
 
+bool PakReader::addArchiveTable(ArchiveStream * ifs, const fs::path & file) {
+	
+	ArchiveHeader header;
+	ifs->seekg(0);
+	if(fs::read(*ifs, header).fail() || header.version != ARCHIVE_VERSION
+	   || header.blockSize != ARCHIVE_BLOCK_SIZE) {
+		LogError << file << ": unsupported archive version";
+		delete ifs;
+		return false;
+	}
+	
+	// Read the whole table of contents at once
+	std::vector<char> toc(header.tocSize);
+	if(header.tocSize < sizeof(ArchiveEntry) * header.fileCount
+	   || ifs->seekg(header.tocOffset).fail()
+	   || (!toc.empty() && fs::read(*ifs, &toc[0], toc.size()).fail())) {
+		LogError << file << ": error reading table of contents";
+		delete ifs;
+		return false;
+	}
+	
+	const Bytef * tocData = toc.empty() ? Z_NULL : reinterpret_cast<const Bytef *>(&toc[0]);
+	if(crc32(crc32(0, Z_NULL, 0), tocData, uInt(toc.size())) != header.tocChecksum) {
+		LogError << file << ": corrupt table of contents";
+		delete ifs;
+		return false;
+	}
+	
+	const char * names = toc.empty() ? NULL : &toc[0] + sizeof(ArchiveEntry) * header.fileCount;
+	size_t namesSize = toc.size() - sizeof(ArchiveEntry) * header.fileCount;
+	
+	// Validate all entries before mounting anything so that a corrupt archive is not half-loaded
+	std::vector<ArchiveEntry> entries(header.fileCount);
+	for(size_t i = 0; i < entries.size(); i++) {
+		
+		ArchiveEntry & entry = entries[i];
+		memcpy(&entry, &toc[0] + sizeof(ArchiveEntry) * i, sizeof(ArchiveEntry));
+		
+		size_t blockTableSize = sizeof(u32) * ((size_t(entry.size) + ARCHIVE_BLOCK_SIZE - 1)
+		                                       / ARCHIVE_BLOCK_SIZE);
+		
+		bool valid = size_t(entry.nameOffset) + entry.nameSize <= namesSize;
+		if(valid) {
+			std::string name(names + entry.nameOffset, entry.nameSize);
+			valid = (entry.hash == archivePathHash(name));
+		}
+		if(entry.compression == ArchiveStored) {
+			valid = valid && entry.storedSize == entry.size;
+		} else if(entry.compression == ArchiveDeflate) {
+			valid = valid && entry.storedSize >= blockTableSize;
+		} else {
+			valid = false;
+		}
+		
+		if(!valid) {
+			LogError << file << ": invalid entry " << i << " in table of contents";
+			delete ifs;
+			return false;
+		}
+	}
+	
+	paks.push_back(ifs);
+	
+	for(size_t i = 0; i < entries.size(); i++) {
+		
+		const ArchiveEntry & entry = entries[i];
+		
+		res::path path = res::path::load(std::string(names + entry.nameOffset, entry.nameSize));
+		
+		addDirectory(path.parent())->addFile(path.filename(), new ArchiveFile(ifs, entry));
+	}
+	
+	LogInfo << "Loaded archive " << file;
+	return true;
+}
+
+fs::path PakReader::getRepackedPath(const fs::path & pakfile) {
+	return fs::path(pakfile).set_ext("arxpak");
+}
+
+bool PakReader::addRepackedArchive(const fs::path & pakfile) {
+	
+	fs::path file = getRepackedPath(pakfile);
+	if(!fs::is_regular_file(file)) {
+		return false;
+	}
+	
+	fs::ifstream ifs(file, fs::fstream::in | fs::fstream::binary);
+	
+	ArchiveHeader header;
+	if(fs::read(ifs, header).fail() || header.magic != ARCHIVE_MAGIC
+	   || header.sourceSize != fs::file_size(pakfile)) {
+		LogWarning << "Ignoring outdated archive " << file << ", run arxrepack to update it";
+		return false;
+	}
+	
+	return addArchive(file);
+}
+
 void PakReader::clear() {
 	
 	release = 0;
@@ -564,7 +930,7 @@ void PakReader::clear() {
 	files.clear();
 	dirs.clear();
 	
-	BOOST_FOREACH(std::istream * is, paks) {
+	BOOST_FOREACH(ArchiveStream * is, paks) {
 		delete is;
 	}
 }
@@ -576,9 +942,7 @@ bool PakReader::read(const res::path & name, void * buf) {
 		return false;
 	}
 	
-	f->read(buf);
-	
-	return true;
+	return f->read(buf);
 }
 
 char * PakReader::readAlloc(const res::path & name, size_t & sizeRead) {
@@ -29,7 +29,9 @@
 #include "io/resource/ResourcePath.h"
 #include "util/Flags.h"
 
-namespace fs { class path; }
+namespace fs { class path; class ifstream; }
+
+class ArchiveStream;
 
 enum Whence {
 	SeekSet,
@@ -87,7 +89,23 @@ public:
 	 */
 	bool addFiles(const fs::path & path, const res::path & mount = res::path());
 	
+	/*!
+	 * Add the files from an original .pak file or from an archive created by arxrepack.
+	 */
 	bool addArchive(const fs::path & pakfile);
+	
+	/*!
+	 * Add the archive created by arxrepack from a .pak file on top of that file.
+	 *
+	 * The repacked archive contains the same files but loads much faster.
+	 *
+	 * \return false if there is no up to date repacked archive for the .pak file.
+	 */
+	bool addRepackedArchive(const fs::path & pakfile);
+	
+	//! \return the file name of the repacked archive for a .pak file
+	static fs::path getRepackedPath(const fs::path & pakfile);
+	
 	void clear();
 	
 	bool read(const res::path & name, void * buf);
@@ -100,8 +118,9 @@ public:
 private:
 	
 	ReleaseFlags release;
-	std::vector<std::istream *> paks;
+	std::vector<ArchiveStream *> paks;
 	
+	bool addArchiveTable(ArchiveStream * ifs, const fs::path & file);
 	bool addFiles(PakDirectory * dir, const fs::path & path);
 	bool addFile(PakDirectory * dir, const fs::path & path, const std::string & name);
 	
@@ -19,15 +19,27 @@
 
 #include "lib/ArxIO.h"
 
+#include <algorithm>
 #include <deque>
 #include <string>
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <vector>
 
+#include <boost/scoped_ptr.hpp>
+
+#include "graphics/data/FastSceneFormat.h"
+#include "graphics/data/FTLFormat.h"
 #include "io/Blast.h"
+#include "io/fs/FilePath.h"
 #include "io/log/Logger.h"
 #include "io/log/ConsoleLogger.h"
+#include "io/resource/PakReader.h"
+#include "platform/Lock.h"
+#include "platform/ThreadPool.h"
+#include "scene/LevelFormat.h"
+#include "util/String.h"
 
 namespace {
 
@@ -39,6 +51,8 @@ public:
 		ARX_UNUSED(file);
 		ARX_UNUSED(line);
 
+		Autolock lock(m_lock);
+
 		if(level == Logger::Error) {
 			m_lastError = str;
 		}
@@ -58,6 +72,7 @@ public:
 
 	void flush() {}
 
+	Lock m_lock;
 	std::string m_lastError;
 	std::deque<std::string> m_Lines;
 };
@@ -74,6 +89,7 @@ void ArxIO_init() {
 }
 
 void ArxIO_getError(char * outMessage, int size) {
+	Autolock lock(memLogger.m_lock);
 	if(!memLogger.m_lastError.empty()) {
 		memLogger.m_lastError.copy(outMessage, size);
 		memLogger.m_lastError.clear();
@@ -81,6 +97,7 @@ void ArxIO_getError(char * outMessage, int size) {
 }
 
 int ArxIO_getLogLine(char * outMessage, int size) {
+	Autolock lock(memLogger.m_lock);
 	if(memLogger.m_Lines.empty()) {
 		return 0;
 	}
@@ -98,3 +115,324 @@ void ArxIO_unpack_alloc(const char * in, const size_t inSize, char ** out, size_
 void ArxIO_unpack_free(char * buffer) {
 	free(buffer);
 }
+
+struct ArxIO_Context {
+	
+	struct File {
+		
+		std::string name;
+		const PakFile * file;
+		
+		File(const std::string & _name, const PakFile * _file) : name(_name), file(_file) { }
+		
+		bool operator<(const File & other) const { return name < other.name; }
+		
+	};
+	
+	std::string error;
+	
+	size_t threads;
+	boost::scoped_ptr<ThreadPool> pool;
+	
+	PakReader pak;
+	std::vector<File> files;
+	
+	explicit ArxIO_Context(size_t _threads) : threads(_threads) { }
+	
+	int fail(const std::string & message) {
+		error = message;
+		return 0;
+	}
+	
+	//! \return the thread pool for batch functions or NULL to process batches serially
+	ThreadPool * getPool() {
+		if(!pool && threads != 1) {
+			pool.reset(new ThreadPool(threads == 0 ? 0 : threads - 1));
+		}
+		return pool.get();
+	}
+	
+	void collectFiles(PakDirectory & dir, const std::string & prefix) {
+		
+		for(PakDirectory::files_iterator i = dir.files_begin(); i != dir.files_end(); ++i) {
+			files.push_back(File(prefix + i->first, i->second));
+		}
+		
+		for(PakDirectory::dirs_iterator i = dir.dirs_begin(); i != dir.dirs_end(); ++i) {
+			collectFiles(i->second, prefix + i->first + '/');
+		}
+	}
+	
+};
+
+ArxIO_Context * ArxIO_context_new(int threads) {
+	return new ArxIO_Context(size_t(std::max(threads, 0)));
+}
+
+void ArxIO_context_free(ArxIO_Context * ctx) {
+	delete ctx;
+}
+
+const char * ArxIO_context_error(const ArxIO_Context * ctx) {
+	return ctx->error.c_str();
+}
+
+int ArxIO_pak_mount(ArxIO_Context * ctx, const char * pakfile) {
+	
+	if(!ctx->pak.addArchive(fs::path(pakfile))) {
+		return ctx->fail(std::string("Could not load PAK file ") + pakfile);
+	}
+	
+	// Files from later archives replace earlier ones
+	ctx->files.clear();
+	ctx->collectFiles(ctx->pak, std::string());
+	std::sort(ctx->files.begin(), ctx->files.end());
+	
+	return 1;
+}
+
+size_t ArxIO_pak_count(const ArxIO_Context * ctx) {
+	return ctx->files.size();
+}
+
+const char * ArxIO_pak_name(const ArxIO_Context * ctx, size_t index) {
+	return (index < ctx->files.size()) ? ctx->files[index].name.c_str() : NULL;
+}
+
+size_t ArxIO_pak_size(const ArxIO_Context * ctx, size_t index) {
+	return (index < ctx->files.size()) ? ctx->files[index].file->size() : 0;
+}
+
+int ArxIO_pak_find(ArxIO_Context * ctx, const char * name, size_t * index) {
+	
+	ArxIO_Context::File key(name, NULL);
+	std::transform(key.name.begin(), key.name.end(), key.name.begin(), ::tolower);
+	
+	std::vector<ArxIO_Context::File>::const_iterator file;
+	file = std::lower_bound(ctx->files.begin(), ctx->files.end(), key);
+	if(file == ctx->files.end() || file->name != key.name) {
+		return ctx->fail(std::string("File not found: ") + name);
+	}
+	
+	*index = size_t(file - ctx->files.begin());
+	return 1;
+}
+
+int ArxIO_pak_read(ArxIO_Context * ctx, size_t index, char ** out, size_t * outSize) {
+	return ArxIO_pak_read_batch(ctx, &index, 1, out, outSize);
+}
+
+int ArxIO_pak_read_batch(ArxIO_Context * ctx, const size_t * indices, size_t count,
+                         char ** out, size_t * outSizes) {
+	
+	std::vector<const PakFile *> files(count);
+	for(size_t i = 0; i < count; i++) {
+		if(indices[i] >= ctx->files.size()) {
+			return ctx->fail("File index out of range");
+		}
+		files[i] = ctx->files[indices[i]].file;
+	}
+	
+	std::vector<char *> data;
+	std::vector<char> success;
+	if(!PakFile::readAlloc(files, data, success, ctx->getPool())) {
+		size_t failed = size_t(std::find(success.begin(), success.end(), false) - success.begin());
+		for(size_t i = 0; i < count; i++) {
+			free(data[i]), out[i] = NULL, outSizes[i] = 0;
+		}
+		return ctx->fail("Could not read " + ctx->files[indices[failed]].name);
+	}
+	
+	for(size_t i = 0; i < count; i++) {
+		out[i] = data[i];
+		outSizes[i] = files[i]->size();
+	}
+	
+	return 1;
+}
+
+namespace {
+
+class UnpackTask : public ThreadPool::Task {
+	
+	const char * const * m_in;
+	const size_t * m_inSizes;
+	char ** m_out;
+	size_t * m_outSizes;
+	
+public:
+	
+	UnpackTask(const char * const * in, const size_t * inSizes, char ** out, size_t * outSizes)
+		: m_in(in), m_inSizes(inSizes), m_out(out), m_outSizes(outSizes) { }
+	
+	void run(size_t index) {
+		m_out[index] = blastMemAlloc(m_in[index], m_inSizes[index], m_outSizes[index]);
+	}
+	
+};
+
+} // anonymous namespace
+
+int ArxIO_unpack_batch(ArxIO_Context * ctx, const char * const * in, const size_t * inSizes,
+                       size_t count, char ** out, size_t * outSizes) {
+	
+	UnpackTask task(in, inSizes, out, outSizes);
+	ThreadPool::run(ctx->getPool(), task, count);
+	
+	for(size_t i = 0; i < count; i++) {
+		if(!out[i]) {
+			for(size_t j = 0; j < count; j++) {
+				free(out[j]), out[j] = NULL, outSizes[j] = 0;
+			}
+			return ctx->fail("Could not decompress buffer");
+		}
+	}
+	
+	return 1;
+}
+
+static void setOutput(char * data, size_t size, char ** out, size_t * outSize) {
+	if(out && outSize) {
+		*out = data;
+		*outSize = size;
+	} else {
+		free(data);
+	}
+}
+
+int ArxIO_ftl_parse(ArxIO_Context * ctx, const char * in, size_t inSize,
+                    ArxIO_FtlInfo * info, char ** out, size_t * outSize) {
+	
+	// Models may be stored uncompressed
+	size_t size = inSize;
+	char * data;
+	if(inSize >= 3 && !memcmp(in, "FTL", 3)) {
+		data = (char *)malloc(inSize);
+		memcpy(data, in, inSize);
+	} else {
+		data = blastMemAlloc(in, inSize, size);
+		if(!data) {
+			return ctx->fail("Could not decompress FTL data");
+		}
+	}
+	
+	size_t pos = sizeof(ARX_FTL_PRIMARY_HEADER) + sizeof(ARX_FTL_SECONDARY_HEADER);
+	if(size < pos || memcmp(data, "FTL", 3)) {
+		free(data);
+		return ctx->fail("Invalid FTL header");
+	}
+	
+	const ARX_FTL_PRIMARY_HEADER * afph = reinterpret_cast<const ARX_FTL_PRIMARY_HEADER *>(data);
+	const ARX_FTL_SECONDARY_HEADER * afsh;
+	afsh = reinterpret_cast<const ARX_FTL_SECONDARY_HEADER *>(data + sizeof(ARX_FTL_PRIMARY_HEADER));
+	
+	memset(info, 0, sizeof(*info));
+	info->version = afph->version;
+	
+	if(afsh->offset_3Ddata >= 0) {
+		
+		if(size_t(afsh->offset_3Ddata) + sizeof(ARX_FTL_3D_DATA_HEADER) > size) {
+			free(data);
+			return ctx->fail("Truncated FTL data");
+		}
+		
+		const ARX_FTL_3D_DATA_HEADER * af3Ddh;
+		af3Ddh = reinterpret_cast<const ARX_FTL_3D_DATA_HEADER *>(data + afsh->offset_3Ddata);
+		info->vertexCount = af3Ddh->nb_vertex;
+		info->faceCount = af3Ddh->nb_faces;
+		info->textureCount = af3Ddh->nb_maps;
+		info->groupCount = af3Ddh->nb_groups;
+		info->actionCount = af3Ddh->nb_action;
+		info->selectionCount = af3Ddh->nb_selections;
+		info->origin = af3Ddh->origin;
+		util::storeStringTerminated(info->name, util::loadString(af3Ddh->name));
+	}
+	
+	setOutput(data, size, out, outSize);
+	return 1;
+}
+
+int ArxIO_fts_parse(ArxIO_Context * ctx, const char * in, size_t inSize,
+                    ArxIO_FtsInfo * info, char ** out, size_t * outSize) {
+	
+	if(inSize < sizeof(UNIQUE_HEADER)) {
+		return ctx->fail("Truncated FTS header");
+	}
+	
+	const UNIQUE_HEADER * uh = reinterpret_cast<const UNIQUE_HEADER *>(in);
+	size_t pos = sizeof(UNIQUE_HEADER) + sizeof(UNIQUE_HEADER3) * size_t(std::max(uh->count, 0));
+	if(pos > inSize || uh->uncompressedsize < s32(sizeof(FAST_SCENE_HEADER))) {
+		return ctx->fail("Invalid FTS header");
+	}
+	
+	size_t size = size_t(uh->uncompressedsize);
+	char * data = (char *)malloc(size);
+	if(blastMem(in + pos, inSize - pos, data, size) != size) {
+		free(data);
+		return ctx->fail("Could not decompress FTS data");
+	}
+	
+	const FAST_SCENE_HEADER * fsh = reinterpret_cast<const FAST_SCENE_HEADER *>(data);
+	info->version = fsh->version;
+	info->sizeX = fsh->sizex;
+	info->sizeZ = fsh->sizez;
+	info->textureCount = fsh->nb_textures;
+	info->polygonCount = fsh->nb_polys;
+	info->anchorCount = fsh->nb_anchors;
+	info->portalCount = fsh->nb_portals;
+	info->roomCount = fsh->nb_rooms;
+	info->playerPosition[0] = fsh->playerpos.x;
+	info->playerPosition[1] = fsh->playerpos.y;
+	info->playerPosition[2] = fsh->playerpos.z;
+	info->scenePosition[0] = fsh->Mscenepos.x;
+	info->scenePosition[1] = fsh->Mscenepos.y;
+	info->scenePosition[2] = fsh->Mscenepos.z;
+	
+	setOutput(data, size, out, outSize);
+	return 1;
+}
+
+int ArxIO_dlf_parse(ArxIO_Context * ctx, const char * in, size_t inSize,
+                    ArxIO_DlfInfo * info, char ** out, size_t * outSize) {
+	
+	if(inSize < sizeof(DANAE_LS_HEADER)) {
+		return ctx->fail("Truncated DLF header");
+	}
+	
+	const DANAE_LS_HEADER * dlh = reinterpret_cast<const DANAE_LS_HEADER *>(in);
+	info->version = dlh->version;
+	info->sceneCount = dlh->nb_scn;
+	info->entityCount = dlh->nb_inter;
+	info->nodeCount = dlh->nb_nodes;
+	info->nodeLinkCount = dlh->nb_nodeslinks;
+	info->zoneCount = dlh->nb_zones;
+	info->lightCount = dlh->nb_lights;
+	info->fogCount = dlh->nb_fogs;
+	info->pathCount = dlh->nb_paths;
+	info->offset[0] = dlh->offset.x;
+	info->offset[1] = dlh->offset.y;
+	info->offset[2] = dlh->offset.z;
+	
+	if(!out || !outSize) {
+		return 1;
+	}
+	
+	const char * body = in + sizeof(DANAE_LS_HEADER);
+	size_t bodySize = inSize - sizeof(DANAE_LS_HEADER);
+	
+	// Levels before version 1.44 are not compressed
+	size_t size = bodySize;
+	char * data;
+	if(dlh->version >= 1.44f) {
+		data = blastMemAlloc(body, bodySize, size);
+		if(!data) {
+			return ctx->fail("Could not decompress DLF data");
+		}
+	} else {
+		data = (char *)malloc(bodySize);
+		memcpy(data, body, bodySize);
+	}
+	
+	setOutput(data, size, out, outSize);
+	return 1;
+}
@@ -46,6 +46,105 @@ ARX_LIB_PUBLIC int  ArxIO_getLogLine(char * outMessage, int size);
 ARX_LIB_PUBLIC void ArxIO_unpack_alloc(const char * in, const size_t inSize, char ** out, size_t * outSize);
 ARX_LIB_PUBLIC void ArxIO_unpack_free(char * buffer);
 
+/*
+ * Contexts hold mounted .pak files, worker threads and the last error message.
+ *
+ * The functions below are reentrant: different threads can use different contexts
+ * at the same time, but a single context must not be used concurrently.
+ * Functions returning int return 1 on success and 0 on failure, in which case
+ * ArxIO_context_error() describes the problem.
+ * Buffers returned by these functions must be freed with ArxIO_unpack_free().
+ */
+typedef struct ArxIO_Context ArxIO_Context;
+
+/*!
+ * Create a new context.
+ * \param threads number of threads to use for batch functions, including the calling
+ *                thread, or 0 to use one thread per processor
+ */
+ARX_LIB_PUBLIC ArxIO_Context * ArxIO_context_new(int threads);
+ARX_LIB_PUBLIC void ArxIO_context_free(ArxIO_Context * ctx);
+
+//! \return the message for the last error in this context or an empty string
+ARX_LIB_PUBLIC const char * ArxIO_context_error(const ArxIO_Context * ctx);
+
+//! Add the files from a .pak file - files in later .pak files replace earlier ones
+ARX_LIB_PUBLIC int ArxIO_pak_mount(ArxIO_Context * ctx, const char * pakfile);
+
+//! \return the number of files in all mounted .pak files
+ARX_LIB_PUBLIC size_t ArxIO_pak_count(const ArxIO_Context * ctx);
+
+//! \return the full lowercase path of a file or NULL if index is out of range - files are sorted by path
+ARX_LIB_PUBLIC const char * ArxIO_pak_name(const ArxIO_Context * ctx, size_t index);
+
+//! \return the uncompressed size of a file
+ARX_LIB_PUBLIC size_t ArxIO_pak_size(const ArxIO_Context * ctx, size_t index);
+
+ARX_LIB_PUBLIC int ArxIO_pak_find(ArxIO_Context * ctx, const char * name, size_t * index);
+
+ARX_LIB_PUBLIC int ArxIO_pak_read(ArxIO_Context * ctx, size_t index, char ** out, size_t * outSize);
+
+//! Read multiple files, decompressing them in parallel - fails if any of the files could not be read
+ARX_LIB_PUBLIC int ArxIO_pak_read_batch(ArxIO_Context * ctx, const size_t * indices, size_t count,
+                                        char ** out, size_t * outSizes);
+
+//! Decompress multiple independent buffers in parallel
+ARX_LIB_PUBLIC int ArxIO_unpack_batch(ArxIO_Context * ctx, const char * const * in,
+                                      const size_t * inSizes, size_t count,
+                                      char ** out, size_t * outSizes);
+
+typedef struct {
+	float version;
+	int vertexCount;
+	int faceCount;
+	int textureCount;
+	int groupCount;
+	int actionCount;
+	int selectionCount;
+	int origin;
+	char name[256];
+} ArxIO_FtlInfo;
+
+typedef struct {
+	float version;
+	int sizeX;
+	int sizeZ;
+	int textureCount;
+	int polygonCount;
+	int anchorCount;
+	int portalCount;
+	int roomCount;
+	float playerPosition[3];
+	float scenePosition[3];
+} ArxIO_FtsInfo;
+
+typedef struct {
+	float version;
+	int sceneCount;
+	int entityCount;
+	int nodeCount;
+	int nodeLinkCount;
+	int zoneCount;
+	int lightCount;
+	int fogCount;
+	int pathCount;
+	float offset[3];
+} ArxIO_DlfInfo;
+
+/*
+ * Parse the headers of level and model files and decompress their contents.
+ *
+ * out is set to the uncompressed file data following the headers that are only
+ * stored uncompressed - for .ftl files this is the whole file.
+ * out and outSize may be NULL if only the header is needed.
+ */
+ARX_LIB_PUBLIC int ArxIO_ftl_parse(ArxIO_Context * ctx, const char * in, size_t inSize,
+                                   ArxIO_FtlInfo * info, char ** out, size_t * outSize);
+ARX_LIB_PUBLIC int ArxIO_fts_parse(ArxIO_Context * ctx, const char * in, size_t inSize,
+                                   ArxIO_FtsInfo * info, char ** out, size_t * outSize);
+ARX_LIB_PUBLIC int ArxIO_dlf_parse(ArxIO_Context * ctx, const char * in, size_t inSize,
+                                   ArxIO_DlfInfo * info, char ** out, size_t * outSize);
+
 #ifdef __cplusplus
 }
 #endif
@@ -120,21 +120,21 @@ void ARX_SPECIAL_ATTRACTORS_ComputeForIO(const Entity & ioo, Vec3f & force) {
 		
 		const Entity & io = *entities[attractors[i].ionum];
 		
-		if(io.show != SHOW_FLAG_IN_SCENE || (io.ioflags & IO_NO_COLLISIONS)
-			 || !(io.gameFlags & GFLAG_ISINTREATZONE)) {
+		if(io.show() != SHOW_FLAG_IN_SCENE || (io.ioflags & IO_NO_COLLISIONS)
+			 || !(io.gameFlags() & GFLAG_ISINTREATZONE)) {
 			continue;
 		}
 		
 		float power = attractors[i].power;
-		float dist = fdist(ioo.pos, io.pos);
+		float dist = fdist(ioo.pos(), io.pos());
 		
-		if(dist > (ioo.physics.cyl.radius + io.physics.cyl.radius + 10.f) || power < 0.f) {
+		if(dist > (ioo.physics().cyl.radius + io.physics().cyl.radius + 10.f) || power < 0.f) {
 			
 			float max_radius = attractors[i].radius; 
 			
 			if(dist < max_radius) {
 				float ratio_dist = 1.f - (dist / max_radius);
-				Vec3f vect = io.pos - ioo.pos;
+				Vec3f vect = io.pos() - ioo.pos();
 				vect = glm::normalize(vect);
 				power *= ratio_dist * 0.01f;
 				force = vect * power;
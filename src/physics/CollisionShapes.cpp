@@ -64,29 +64,29 @@ void EERIE_COLLISION_Cylinder_Create(Entity * io)
 		return;
 
 	if(obj->vertexlist.empty()) {
-		io->physics.cyl.height = 0.f;
+		io->physics().cyl.height = 0.f;
 		return;
 	}
 	
-	io->physics.cyl.origin = obj->vertexlist[obj->origin].v;
+	io->physics().cyl.origin = obj->vertexlist[obj->origin].v;
 	
 	float d = 0.f;
 	float height = 0.f;
 	for(size_t i = 0; i < obj->vertexlist.size(); i++) {
-		if(i != obj->origin && glm::abs(io->physics.cyl.origin.y - obj->vertexlist[i].v.y) < 20.f) {
-			d = std::max(d, glm::distance(io->physics.cyl.origin, obj->vertexlist[i].v));
+		if(i != obj->origin && glm::abs(io->physics().cyl.origin.y - obj->vertexlist[i].v.y) < 20.f) {
+			d = std::max(d, glm::distance(io->physics().cyl.origin, obj->vertexlist[i].v));
 		}
-		height = std::max(height, io->physics.cyl.origin.y - obj->vertexlist[i].v.y);
+		height = std::max(height, io->physics().cyl.origin.y - obj->vertexlist[i].v.y);
 	}
 
 	if(d == 0.f || height == 0.f) {
-		io->physics.cyl.height = 0.f;
+		io->physics().cyl.height = 0.f;
 		return;
 	}
 	
 	io->original_radius = d * 1.2f;
 	io->original_height = -height;
-	io->physics.cyl.origin = io->pos;
+	io->physics().cyl.origin = io->pos();
 	
 	if(io->original_height > -40) {
 		float v = (-io->original_height) * ( 1.0f / 40 );
@@ -98,8 +98,8 @@ void EERIE_COLLISION_Cylinder_Create(Entity * io)
 	if(io->original_radius > 40.f)
 		io->original_radius = 40.f;
 
-	io->physics.cyl.radius = io->original_radius * io->scale;
-	io->physics.cyl.height = io->original_height * io->scale;
+	io->physics().cyl.radius = io->original_radius * io->scale;
+	io->physics().cyl.height = io->original_height * io->scale;
 }
 
 void EERIE_COLLISION_SPHERES_Release(EERIE_3DOBJ * obj) {
@@ -275,11 +275,11 @@ bool IsCollidingIO(Entity * io,Entity * ioo) {
 	if(ioo != NULL
 	   && io != ioo
 	   && !(ioo->ioflags & IO_NO_COLLISIONS)
-	   && ioo->show == SHOW_FLAG_IN_SCENE
+	   && ioo->show() == SHOW_FLAG_IN_SCENE
 	   && ioo->obj
 	) {
 		if(ioo->ioflags & IO_NPC) {
-			Cylinder cyl = ioo->physics.cyl;
+			Cylinder cyl = ioo->physics().cyl;
 			cyl.radius += 25.f;
 			
 			for(size_t j = 0; j < io->obj->vertexlist3.size(); j++) {
@@ -303,11 +303,11 @@ void PushIO_ON_Top(Entity * ioo, float ydec) {
 		if(io
 		   && io != ioo
 		   && !(io->ioflags & IO_NO_COLLISIONS)
-		   && io->show == SHOW_FLAG_IN_SCENE
+		   && io->show() == SHOW_FLAG_IN_SCENE
 		   && io->obj
 		   && !(io->ioflags & (IO_FIX | IO_CAMERA | IO_MARKER))
 		) {
-			if(closerThan(Vec2f(io->pos.x, io->pos.z), Vec2f(ioo->pos.x, ioo->pos.z), 450.f)) {
+			if(closerThan(Vec2f(io->pos().x, io->pos().z), Vec2f(ioo->pos().x, ioo->pos().z), 450.f)) {
 				EERIEPOLY ep;
 				ep.type = 0;
 				float miny = 9999999.f;
@@ -318,7 +318,7 @@ void PushIO_ON_Top(Entity * ioo, float ydec) {
 					maxy = std::max(maxy, ioo->obj->vertexlist3[ii].v.y);
 				}
 
-				float posy = (io == entities.player()) ? player.basePosition().y : io->pos.y;
+				float posy = (io == entities.player()) ? player.basePosition().y : io->pos().y;
 				float modd = (ydec > 0) ? -20.f : 0;
 
 				if(posy <= maxy && posy >= miny + modd) {
@@ -343,7 +343,7 @@ void PushIO_ON_Top(Entity * ioo, float ydec) {
 								ep.v[kk].p.z = (ep.v[kk].p.z - cz) * tval + cz; 
 						}
 						
-						if(PointIn2DPolyXZ(&ep, io->pos.x, io->pos.z)) {
+						if(PointIn2DPolyXZ(&ep, io->pos().x, io->pos().z)) {
 							if(io == entities.player()) {
 								if(ydec <= 0) {
 									player.pos.y += ydec;
@@ -364,12 +364,12 @@ void PushIO_ON_Top(Entity * ioo, float ydec) {
 								}
 							} else {
 								if(ydec <= 0) {
-									io->pos.y += ydec;
+									io->pos().y += ydec;
 								} else {
 									Cylinder cyl = GetIOCyl(io);
 									cyl.origin.y += ydec;
 									if(CheckAnythingInCylinder(cyl, io ,0) >= 0) {
-										io->pos.y += ydec;
+										io->pos().y += ydec;
 									}
 								}
 							}
@@ -392,7 +392,7 @@ bool IsAnyNPCInPlatform(Entity * pfrm) {
 		   && io != pfrm
 		   && (io->ioflags & IO_NPC)
 		   && !(io->ioflags & IO_NO_COLLISIONS)
-		   && io->show == SHOW_FLAG_IN_SCENE
+		   && io->show() == SHOW_FLAG_IN_SCENE
 		) {
 			Cylinder cyl = GetIOCyl(io);
 
@@ -434,8 +434,8 @@ static bool CollidedFromBack(Entity * io,Entity * ioo) {
 	   && (ioo->ioflags & IO_NPC)
 	) {
 
-	ep.v[0].p.x=io->pos.x;
-	ep.v[0].p.z=io->pos.z;
+	ep.v[0].p.x=io->pos().x;
+	ep.v[0].p.z=io->pos().z;
 
 	float ft = glm::radians(135.f + 90.f);
 	ep.v[1].p.x =  std::sin(ft) * 180.f;
@@ -457,7 +457,7 @@ static bool CollidedFromBack(Entity * io,Entity * ioo) {
 	ep.v[2].p.z=ep.tv[2].p.z+ep.v[0].p.z;
 
 	// To keep if we need some visual debug
-	if(PointIn2DPolyXZ(&ep, ioo->pos.x, ioo->pos.z))
+	if(PointIn2DPolyXZ(&ep, ioo->pos().x, ioo->pos().z))
 		return true;
 
 	}
@@ -562,21 +562,21 @@ float CheckAnythingInCylinder(const Cylinder & cyl, Entity * ioo, long flags) {
 			if(!io
 				|| io == ioo
 				|| !io->obj
-				||	(	(io->show!=SHOW_FLAG_IN_SCENE)
+				||	(	(io->show()!=SHOW_FLAG_IN_SCENE)
 					||	((io->ioflags & IO_NO_COLLISIONS)  && !(flags & CFLAG_COLLIDE_NOCOL))
 					) 
-				|| fartherThan(io->pos, cyl.origin, 1000.f)) continue;
+				|| fartherThan(io->pos(), cyl.origin, 1000.f)) continue;
 	
 			{
-				Cylinder & io_cyl = io->physics.cyl;
+				Cylinder & io_cyl = io->physics().cyl;
 				io_cyl = GetIOCyl(io);
 				float dealt = 0;
 
-				if (	(io->gameFlags & GFLAG_PLATFORM)
+				if (	(io->gameFlags() & GFLAG_PLATFORM)
 					||	((flags & CFLAG_COLLIDE_NOCOL) && (io->ioflags & IO_NPC) &&  (io->ioflags & IO_NO_COLLISIONS))
 					)
 				{
-					if(closerThan(Vec2f(io->pos.x, io->pos.z), Vec2f(cyl.origin.x, cyl.origin.z), 440.f + cyl.radius))
+					if(closerThan(Vec2f(io->pos().x, io->pos().z), Vec2f(cyl.origin.x, cyl.origin.z), 440.f + cyl.radius))
 					if(In3DBBoxTolerance(cyl.origin, io->bbox3D, cyl.radius+80))
 					{
 						if(io->ioflags & IO_FIELD) {
@@ -656,10 +656,10 @@ float CheckAnythingInCylinder(const Cylinder & cyl, Entity * ioo, long flags) {
 							if(!dealt && (ioo->damager_damages > 0 || io->damager_damages > 0)) {
 
 								if(ioo->damager_damages > 0)
-									ARX_DAMAGES_DealDamages(EntityHandle(i), ioo->damager_damages, ioo->index(), ioo->damager_type, &io->pos);
+									ARX_DAMAGES_DealDamages(EntityHandle(i), ioo->damager_damages, ioo->index(), ioo->damager_type, &io->pos());
 
 								if(io->damager_damages > 0)
-									ARX_DAMAGES_DealDamages(ioo->index(), io->damager_damages, io->index(), io->damager_type, &ioo->pos);
+									ARX_DAMAGES_DealDamages(ioo->index(), io->damager_damages, io->index(), io->damager_type, &ioo->pos());
 							}
 							
 							if(io->targetinfo == handle) {
@@ -710,7 +710,7 @@ float CheckAnythingInCylinder(const Cylinder & cyl, Entity * ioo, long flags) {
 
 								if(SphereInCylinder(cyl, sp)) {
 									if(!(flags & CFLAG_JUST_TEST) && ioo) {
-										if(io->gameFlags & GFLAG_DOOR) {
+										if(io->gameFlags() & GFLAG_DOOR) {
 											float elapsed = arxtime.now_f() - io->collide_door_time;
 											if(elapsed > 500) {
 												EVENT_SENDER = ioo;
@@ -733,10 +733,10 @@ float CheckAnythingInCylinder(const Cylinder & cyl, Entity * ioo, long flags) {
 											dealt = 1;
 
 											if(ioo->damager_damages > 0)
-												ARX_DAMAGES_DealDamages(EntityHandle(i), ioo->damager_damages, ioo->index(), ioo->damager_type, &io->pos);
+												ARX_DAMAGES_DealDamages(EntityHandle(i), ioo->damager_damages, ioo->index(), ioo->damager_type, &io->pos());
 
 											if(io->damager_damages > 0)
-												ARX_DAMAGES_DealDamages(ioo->index(), io->damager_damages, io->index(), io->damager_type, &ioo->pos);
+												ARX_DAMAGES_DealDamages(ioo->index(), io->damager_damages, io->index(), io->damager_type, &ioo->pos());
 										}
 									}
 
@@ -770,7 +770,7 @@ float CheckAnythingInCylinder(const Cylinder & cyl, Entity * ioo, long flags) {
 									
 									if(SphereInCylinder(cyl, sp)) {
 										if(!(flags & CFLAG_JUST_TEST) && ioo) {
-											if(io->gameFlags & GFLAG_DOOR) {
+											if(io->gameFlags() & GFLAG_DOOR) {
 												float elapsed = arxtime.now_f() - io->collide_door_time;
 												if(elapsed > 500) {
 													EVENT_SENDER = ioo;
@@ -793,10 +793,10 @@ float CheckAnythingInCylinder(const Cylinder & cyl, Entity * ioo, long flags) {
 											dealt = 1;
 											
 											if(ioo->damager_damages > 0)
-												ARX_DAMAGES_DealDamages(EntityHandle(i), ioo->damager_damages, ioo->index(), ioo->damager_type, &io->pos);
+												ARX_DAMAGES_DealDamages(EntityHandle(i), ioo->damager_damages, ioo->index(), ioo->damager_type, &io->pos());
 									
 											if(io->damager_damages > 0)
-												ARX_DAMAGES_DealDamages(ioo->index(), io->damager_damages, io->index(), io->damager_type, &ioo->pos);
+												ARX_DAMAGES_DealDamages(ioo->index(), io->damager_damages, io->index(), io->damager_type, &ioo->pos());
 										}
 										}
 										anything = std::min(anything, std::min(sp.origin.y - sp.radius, io->bbox3D.min.y));
@@ -850,8 +850,8 @@ bool CheckEverythingInSphere(const Sphere & sphere, EntityHandle source, EntityH
 			if(!io
 			   || InExceptionList(targ)
 			   || targ == source
-			   || io->show != SHOW_FLAG_IN_SCENE
-			   || !(io->gameFlags & GFLAG_ISINTREATZONE)
+			   || io->show() != SHOW_FLAG_IN_SCENE
+			   || !(io->gameFlags() & GFLAG_ISINTREATZONE)
 			   || !(io->obj)
 			) {
 				return false;
@@ -877,14 +877,14 @@ bool CheckEverythingInSphere(const Sphere & sphere, EntityHandle source, EntityH
 		if(!io->obj)
 			continue;
 
-		if(io->gameFlags & GFLAG_PLATFORM) {
+		if(io->gameFlags() & GFLAG_PLATFORM) {
 			float miny = io->bbox3D.min.y;
 			float maxy = io->bbox3D.max.y;
 
 			if(maxy <= sphere.origin.y + sphere.radius || miny >= sphere.origin.y)
 			if(In3DBBoxTolerance(sphere.origin, io->bbox3D, sphere.radius))
 			{
-				if(closerThan(Vec2f(io->pos.x, io->pos.z), Vec2f(sphere.origin.x, sphere.origin.z), 440.f + sphere.radius)) {
+				if(closerThan(Vec2f(io->pos().x, io->pos().z), Vec2f(sphere.origin.x, sphere.origin.z), 440.f + sphere.radius)) {
 
 					EERIEPOLY ep;
 					ep.type = 0;
@@ -919,7 +919,7 @@ bool CheckEverythingInSphere(const Sphere & sphere, EntityHandle source, EntityH
 			}
 		}
 
-		if(closerThan(io->pos, sphere.origin, sr180)) {
+		if(closerThan(io->pos(), sphere.origin, sr180)) {
 
 			long amount = 1;
 			std::vector<EERIE_VERTEX> & vlist = io->obj->vertexlist3;
@@ -1072,14 +1072,14 @@ bool CheckAnythingInSphere(const Sphere & sphere, EntityHandle source, CASFlags
 		if(treatio[i].io->index() != PlayerEntityHandle && source != PlayerEntityHandle && validsource && HaveCommonGroup(io,entities[source]))
 			continue;
 
-		if(io->gameFlags & GFLAG_PLATFORM) {
+		if(io->gameFlags() & GFLAG_PLATFORM) {
 			float miny = io->bbox3D.min.y;
 			float maxy = io->bbox3D.max.y;
 
 			if(maxy > sphere.origin.y - sphere.radius || miny < sphere.origin.y + sphere.radius)
 			if(In3DBBoxTolerance(sphere.origin, io->bbox3D, sphere.radius))
 			{
-				if(closerThan(Vec2f(io->pos.x, io->pos.z), Vec2f(sphere.origin.x, sphere.origin.z), 440.f + sphere.radius)) {
+				if(closerThan(Vec2f(io->pos().x, io->pos().z), Vec2f(sphere.origin.x, sphere.origin.z), 440.f + sphere.radius)) {
 
 					EERIEPOLY ep;
 					ep.type = 0;
@@ -1114,7 +1114,7 @@ bool CheckAnythingInSphere(const Sphere & sphere, EntityHandle source, CASFlags
 			}
 		}
 
-		if(closerThan(io->pos, sphere.origin, sr180)) {
+		if(closerThan(io->pos(), sphere.origin, sr180)) {
 			long amount = 1;
 			std::vector<EERIE_VERTEX> & vlist = io->obj->vertexlist3;
 
@@ -1160,11 +1160,11 @@ bool CheckIOInSphere(const Sphere & sphere, const Entity & entity, bool ignoreNo
 	float sr180 = sphere.radius + 500.f;
 
 	if((ignoreNoCollisionFlag || !(entity.ioflags & IO_NO_COLLISIONS))
-	   && (entity.show == SHOW_FLAG_IN_SCENE)
-	   && (entity.gameFlags & GFLAG_ISINTREATZONE)
+	   && (entity.show() == SHOW_FLAG_IN_SCENE)
+	   && (entity.gameFlags() & GFLAG_ISINTREATZONE)
 	   && (entity.obj)
 	) {
-		if(closerThan(entity.pos, sphere.origin, sr180)) {
+		if(closerThan(entity.pos(), sphere.origin, sr180)) {
 			std::vector<EERIE_VERTEX> & vlist = entity.obj->vertexlist3;
 
 			if(entity.obj->grouplist.size()>10) {
@@ -1632,7 +1632,7 @@ bool IO_Visible(const Vec3f & orgn, const Vec3f & dest, Vec3f * hit)
 			const EntityHandle handle = EntityHandle(num);
 			Entity * io = entities[handle];
 
-			if(io && (io->gameFlags & GFLAG_VIEW_BLOCKER)) {
+			if(io && (io->gameFlags() & GFLAG_VIEW_BLOCKER)) {
 				if(CheckIOInSphere(sphere, *io)) {
 					float dd = fdist(orgn, sphere.origin);
 
@@ -1700,10 +1700,10 @@ void ANCHOR_BLOCK_By_IO(Entity * io, long status) {
 	for(long k = 0; k < eb->nbanchors; k++) {
 		ANCHOR_DATA & ad = eb->anchors[k];
 
-		if(fartherThan(ad.pos, io->pos, 600.f))
+		if(fartherThan(ad.pos, io->pos(), 600.f))
 			continue;
 
-		if(closerThan(Vec2f(io->pos.x, io->pos.z), Vec2f(ad.pos.x, ad.pos.z), 440.f)) {
+		if(closerThan(Vec2f(io->pos().x, io->pos().z), Vec2f(ad.pos.x, ad.pos.z), 440.f)) {
 			
 			EERIEPOLY ep;
 			ep.type = 0;
@@ -1713,7 +1713,7 @@ void ANCHOR_BLOCK_By_IO(Entity * io, long status) {
 				float cz = 0;
 
 				for(long kk = 0; kk < 3; kk++) {
-					ep.v[kk].p = io->obj->vertexlist[io->obj->facelist[ii].vid[kk]].v + io->pos;
+					ep.v[kk].p = io->obj->vertexlist[io->obj->facelist[ii].vid[kk]].v + io->pos();
 
 					cx += ep.v[kk].p.x;
 					cz += ep.v[kk].p.z;
@@ -349,7 +349,7 @@ static void ARX_TEMPORARY_TrySound(Entity * source, Material collisionMaterial,
 		
 		if(source->soundcount < 5) {
 			long material;
-			if(EEIsUnderWater(source->pos))
+			if(EEIsUnderWater(source->pos()))
 				material = MATERIAL_WATER;
 			else if(source->material)
 				material = source->material;
@@ -359,7 +359,7 @@ static void ARX_TEMPORARY_TrySound(Entity * source, Material collisionMaterial,
 			if(volume > 1.f)
 				volume = 1.f;
 			
-			long soundLength = ARX_SOUND_PlayCollision(material, collisionMaterial, volume, 1.f, source->pos, source);
+			long soundLength = ARX_SOUND_PlayCollision(material, collisionMaterial, volume, 1.f, source->pos(), source);
 			
 			source->soundtime = now + (soundLength >> 4) + 50;
 		}
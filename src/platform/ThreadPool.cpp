@@ -0,0 +1,265 @@
+/*
+ * Copyright 2016 Arx Libertatis Team (see the AUTHORS file)
+ *
+ * This file is part of Arx Libertatis.
+ *
+ * Arx Libertatis is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Arx Libertatis is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Arx Libertatis.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "platform/ThreadPool.h"
+
+#include <algorithm>
+
+#if ARX_HAVE_PTHREADS
+#include <unistd.h>
+#else
+#include <climits>
+#endif
+
+#include "io/log/Logger.h"
+
+namespace {
+
+ThreadPool::WorkerHook g_workerStart = NULL;
+ThreadPool::WorkerHook g_workerStop = NULL;
+
+} // anonymous namespace
+
+ThreadPool::ThreadPool(size_t threads)
+	: quit(false)
+	, workerStart(g_workerStart)
+	, workerStop(g_workerStop)
+	, task(NULL)
+	, count(0)
+	, next(0)
+{
+	
+	if(threads == 0) {
+		threads = getProcessorCount() - 1;
+	}
+	
+	workers.reserve(threads);
+	for(size_t i = 0; i < threads; i++) {
+#if ARX_HAVE_PTHREADS
+		Worker worker;
+		if(pthread_create(&worker, NULL, entryPoint, this) != 0) {
+			LogWarning << "Could not start thread pool worker " << i;
+			break;
+		}
+#elif ARX_PLATFORM == ARX_PLATFORM_WIN32
+		Worker worker = CreateThread(NULL, 0, entryPoint, this, 0, NULL);
+		if(!worker) {
+			LogWarning << "Could not start thread pool worker " << i;
+			break;
+		}
+#endif
+		workers.push_back(worker);
+	}
+	
+}
+
+ThreadPool::~ThreadPool() {
+	
+	quit = true;
+	for(size_t i = 0; i < workers.size(); i++) {
+		work.post();
+	}
+	
+	for(std::vector<Worker>::const_iterator i = workers.begin(); i != workers.end(); ++i) {
+#if ARX_HAVE_PTHREADS
+		pthread_join(*i, NULL);
+#elif ARX_PLATFORM == ARX_PLATFORM_WIN32
+		WaitForSingleObject(*i, INFINITE);
+		CloseHandle(*i);
+#endif
+	}
+	
+}
+
+void ThreadPool::run(Task & _task, size_t _count) {
+	
+	if(_count == 0) {
+		return;
+	}
+	
+	Autolock lock(batchLock);
+	
+	// The semaphores order these writes before any worker accesses them
+	task = &_task, count = _count, next = 0;
+	
+	size_t helpers = std::min(workers.size(), count - 1);
+	for(size_t i = 0; i < helpers; i++) {
+		work.post();
+	}
+	
+	process();
+	
+	for(size_t i = 0; i < helpers; i++) {
+		done.wait();
+	}
+	
+	task = NULL;
+}
+
+void ThreadPool::setWorkerHooks(WorkerHook start, WorkerHook stop) {
+	g_workerStart = start;
+	g_workerStop = stop;
+}
+
+void ThreadPool::run(ThreadPool * pool, Task & task, size_t count) {
+	
+	if(pool) {
+		pool->run(task, count);
+		return;
+	}
+	
+	for(size_t i = 0; i < count; i++) {
+		task.run(i);
+	}
+}
+
+void ThreadPool::process() {
+	
+	for(;;) {
+		
+		size_t index;
+		{
+			Autolock lock(itemLock);
+			if(next >= count) {
+				return;
+			}
+			index = next++;
+		}
+		
+		task->run(index);
+	}
+}
+
+#if ARX_HAVE_PTHREADS
+
+void * ThreadPool::entryPoint(void * param) {
+	
+	ThreadPool & pool = *static_cast<ThreadPool *>(param);
+	
+	if(pool.workerStart) {
+		pool.workerStart();
+	}
+	
+	for(;;) {
+		pool.work.wait();
+		if(pool.quit) {
+			break;
+		}
+		pool.process();
+		pool.done.post();
+	}
+	
+	if(pool.workerStop) {
+		pool.workerStop();
+	}
+	
+	return NULL;
+}
+
+size_t ThreadPool::getProcessorCount() {
+#ifdef _SC_NPROCESSORS_ONLN
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return (count > 0) ? size_t(count) : 1;
+#else
+	return 1;
+#endif
+}
+
+ThreadPool::Semaphore::Semaphore() : count(0) {
+	pthread_mutex_init(&mutex, NULL);
+	pthread_cond_init(&cond, NULL);
+}
+
+ThreadPool::Semaphore::~Semaphore() {
+	pthread_cond_destroy(&cond);
+	pthread_mutex_destroy(&mutex);
+}
+
+void ThreadPool::Semaphore::post() {
+	pthread_mutex_lock(&mutex);
+	count++;
+	pthread_cond_signal(&cond);
+	pthread_mutex_unlock(&mutex);
+}
+
+void ThreadPool::Semaphore::wait() {
+	
+	pthread_mutex_lock(&mutex);
+	
+	while(count == 0) {
+		int rc = pthread_cond_wait(&cond, &mutex);
+		arx_assert(rc == 0);
+		ARX_UNUSED(rc);
+	}
+	
+	count--;
+	pthread_mutex_unlock(&mutex);
+}
+
+#elif ARX_PLATFORM == ARX_PLATFORM_WIN32
+
+DWORD WINAPI ThreadPool::entryPoint(LPVOID param) {
+	
+	ThreadPool & pool = *static_cast<ThreadPool *>(param);
+	
+	if(pool.workerStart) {
+		pool.workerStart();
+	}
+	
+	for(;;) {
+		pool.work.wait();
+		if(pool.quit) {
+			break;
+		}
+		pool.process();
+		pool.done.post();
+	}
+	
+	if(pool.workerStop) {
+		pool.workerStop();
+	}
+	
+	return 0;
+}
+
+size_t ThreadPool::getProcessorCount() {
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (info.dwNumberOfProcessors > 0) ? size_t(info.dwNumberOfProcessors) : 1;
+}
+
+ThreadPool::Semaphore::Semaphore() {
+	semaphore = CreateSemaphore(NULL, 0, LONG_MAX, NULL);
+}
+
+ThreadPool::Semaphore::~Semaphore() {
+	CloseHandle(semaphore);
+}
+
+void ThreadPool::Semaphore::post() {
+	ReleaseSemaphore(semaphore, 1, NULL);
+}
+
+void ThreadPool::Semaphore::wait() {
+	DWORD rc = WaitForSingleObject(semaphore, INFINITE);
+	arx_assert(rc == WAIT_OBJECT_0);
+	ARX_UNUSED(rc);
+}
+
+#endif
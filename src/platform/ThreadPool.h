@@ -0,0 +1,153 @@
+/*
+ * Copyright 2016 Arx Libertatis Team (see the AUTHORS file)
+ *
+ * This file is part of Arx Libertatis.
+ *
+ * Arx Libertatis is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Arx Libertatis is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Arx Libertatis.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARX_PLATFORM_THREADPOOL_H
+#define ARX_PLATFORM_THREADPOOL_H
+
+#include <stddef.h>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "Configure.h"
+#include "platform/Lock.h"
+#include "platform/Platform.h"
+
+#if ARX_HAVE_PTHREADS
+#include <pthread.h>
+#elif ARX_PLATFORM == ARX_PLATFORM_WIN32
+#include <windows.h>
+#else
+#error "Thread pools not supported: need ARX_HAVE_PTHREADS on non-Windows systems"
+#endif
+
+/*!
+ * A fixed set of worker threads to process batches of independent work items.
+ *
+ * Unlike \ref Thread, the workers do not register with the crash handler or profiler
+ * themselves so that the pool can also be used by the tools and the IO library.
+ * The game installs hooks for this using \ref setWorkerHooks().
+ */
+class ThreadPool : private boost::noncopyable {
+	
+public:
+	
+	//! A batch of independent work items
+	class Task {
+		
+	public:
+		
+		virtual ~Task() { }
+		
+		/*!
+		 * Process a single work item.
+		 *
+		 * This may be called concurrently for different indices and must not call
+		 * \ref ThreadPool::run() on the same pool.
+		 */
+		virtual void run(size_t index) = 0;
+		
+	};
+	
+	/*!
+	 * Start the worker threads.
+	 * \param threads number of worker threads or 0 to use one less than the number
+	 *                of available processors - the thread calling run() also helps
+	 *                to process items
+	 */
+	explicit ThreadPool(size_t threads = 0);
+	
+	//! Stop and join all worker threads
+	~ThreadPool();
+	
+	/*!
+	 * Call task.run(i) for every i in [0, count) and wait until all items are done.
+	 *
+	 * Batches from different threads are processed one after the other.
+	 */
+	void run(Task & task, size_t count);
+	
+	/*!
+	 * Run a batch on a pool or on the calling thread if there is no pool.
+	 */
+	static void run(ThreadPool * pool, Task & task, size_t count);
+	
+	//! \return the number of worker threads, not including the calling thread
+	size_t getThreadCount() const { return workers.size(); }
+	
+	//! \return the number of processors available to this process
+	static size_t getProcessorCount();
+	
+	typedef void (*WorkerHook)();
+	
+	/*!
+	 * Set functions to call on each worker thread when it starts and before it exits.
+	 *
+	 * Only affects pools created after this call.
+	 */
+	static void setWorkerHooks(WorkerHook start, WorkerHook stop);
+	
+private:
+	
+	class Semaphore {
+		
+#if ARX_HAVE_PTHREADS
+		pthread_mutex_t mutex;
+		pthread_cond_t cond;
+		size_t count;
+#elif ARX_PLATFORM == ARX_PLATFORM_WIN32
+		HANDLE semaphore;
+#endif
+		
+	public:
+		
+		Semaphore();
+		~Semaphore();
+		
+		void post();
+		void wait();
+		
+	};
+	
+#if ARX_HAVE_PTHREADS
+	typedef pthread_t Worker;
+	static void * entryPoint(void * param);
+#elif ARX_PLATFORM == ARX_PLATFORM_WIN32
+	typedef HANDLE Worker;
+	static DWORD WINAPI entryPoint(LPVOID param);
+#endif
+	
+	void process();
+	
+	std::vector<Worker> workers;
+	Semaphore work;
+	Semaphore done;
+	bool quit;
+	WorkerHook workerStart;
+	WorkerHook workerStop;
+	
+	Lock batchLock;
+	Lock itemLock;
+	Task * task;
+	size_t count;
+	size_t next;
+	
+};
+
+#endif // ARX_PLATFORM_THREADPOOL_H
@@ -290,6 +290,10 @@ void profiler::unregisterThread() {
 	g_profiler.unregisterThread();
 }
 
+void profiler::addSample(const char * tag, u64 startTime, u64 endTime) {
+	g_profiler.addProfilePoint(tag, Thread::getCurrentThreadId(), startTime, endTime);
+}
+
 
 profiler::Scope::Scope(const char * tag)
 	: m_tag(tag)
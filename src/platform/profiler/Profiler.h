@@ -36,6 +36,10 @@ namespace profiler {
 	void unregisterThread();
 	
 #if BUILD_PROFILER_INSTRUMENT
+	
+	//! Add a sample for a tag that must remain valid until the next flush()
+	void addSample(const char * tag, u64 startTime, u64 endTime);
+	
 	class Scope {
 		const char* m_tag;
 		u64         m_startTime;
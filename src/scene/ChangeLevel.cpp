@@ -46,6 +46,7 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 
 #include "scene/ChangeLevel.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include <cstdio>
@@ -85,10 +86,14 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include "io/SaveBlock.h"
 #include "io/log/Logger.h"
 
+#include "platform/Lock.h"
 #include "platform/Platform.h"
+#include "platform/Thread.h"
+#include "platform/ThreadPool.h"
 
 #include "scene/Interactive.h"
 #include "scene/GameSound.h"
+#include "scene/LevelLoader.h"
 #include "scene/LoadLevel.h"
 #include "scene/SaveFormat.h"
 #include "scene/Light.h"
@@ -130,6 +135,114 @@ static long CONVERT_CREATED = 0;
 long DONT_WANT_PLAYER_INZONE = 0;
 static SaveBlock * g_currentSavedGame = NULL;
 
+/*!
+ * Compresses a snapshot of the current game taken by ARX_CHANGELEVEL_Save()
+ * and writes it directly to the savegame destination.
+ * 
+ * The main thread must not access g_currentSavedGame until the writer has completed.
+ */
+class SaveGameWriter : public Thread {
+	
+public:
+	
+	SaveGameWriter(SaveBlock & save, const fs::path & destination)
+		: m_save(save)
+		, m_destination(destination)
+		, m_total(save.getDeferredCount() + 1)
+		, m_written(0)
+		, m_finished(false)
+		, m_success(false)
+	{
+		setThreadName("Savegame Writer");
+	}
+	
+	bool isFinished() {
+		Autolock lock(m_lock);
+		return m_finished;
+	}
+	
+	bool succeeded() {
+		Autolock lock(m_lock);
+		return m_success;
+	}
+	
+	float getProgress() {
+		Autolock lock(m_lock);
+		return float(m_written) / float(m_total);
+	}
+	
+private:
+	
+	void run() {
+		
+		// Compress a few files per worker at a time so that progress can still be reported
+		ThreadPool pool;
+		size_t batchSize = (pool.getThreadCount() + 1) * 4;
+		
+		size_t remaining = m_total - 1;
+		while(remaining != 0) {
+			remaining = m_save.compressDeferred(batchSize, &pool);
+			Autolock lock(m_lock);
+			m_written = m_total - 1 - remaining;
+		}
+		
+		// Write the savegame directly to its destination - the current game file is
+		// replaced with a clone instead of copying it
+		bool success = m_save.flush("pld", m_destination);
+		if(!success) {
+			LogError << "Could not complete the save";
+		}
+		m_save.setDeferWrites(false);
+		
+		Autolock lock(m_lock);
+		m_written = m_total;
+		m_success = success;
+		m_finished = true;
+	}
+	
+	SaveBlock & m_save;
+	fs::path m_destination;
+	
+	Lock m_lock;
+	size_t m_total; //!< Number of deferred files plus one for writing the destination
+	size_t m_written;
+	bool m_finished;
+	bool m_success;
+	
+};
+
+static SaveGameWriter * g_saveGameWriter = NULL;
+static SaveWriteStatus g_saveGameWriteResult = SaveWriteIdle;
+
+bool ARX_CHANGELEVEL_FinishSave() {
+	
+	if(g_saveGameWriter) {
+		g_saveGameWriter->waitForCompletion();
+		g_saveGameWriteResult = g_saveGameWriter->succeeded() ? SaveWriteDone : SaveWriteFailed;
+		delete g_saveGameWriter, g_saveGameWriter = NULL;
+	}
+	
+	return g_saveGameWriteResult != SaveWriteFailed;
+}
+
+SaveWriteStatus ARX_CHANGELEVEL_PollSave(float * progress) {
+	
+	if(g_saveGameWriter) {
+		if(!g_saveGameWriter->isFinished()) {
+			if(progress) {
+				*progress = g_saveGameWriter->getProgress();
+			}
+			return SaveWriteInProgress;
+		}
+		ARX_CHANGELEVEL_FinishSave();
+	}
+	
+	SaveWriteStatus status = g_saveGameWriteResult;
+	g_saveGameWriteResult = SaveWriteIdle;
+	
+	return status;
+}
+
 static ARX_CHANGELEVEL_IO_INDEX * idx_io = NULL;
 static ARX_CHANGELEVEL_INVENTORY_DATA_SAVE ** Gaids = NULL;
 
@@ -206,6 +319,8 @@ static long GetIOAnimIdx2(const Entity * io, ANIM_HANDLE * anim) {
 
 bool ARX_Changelevel_CurGame_Clear() {
 	
+	ARX_CHANGELEVEL_FinishSave();
+	
 	if(g_currentSavedGame) {
 		delete g_currentSavedGame, g_currentSavedGame = NULL;
 	}
@@ -229,6 +344,8 @@ static bool openCurrentSavedGameFile() {
 	
 	arx_assert(!CURRENT_GAME_FILE.empty());
 	
+	ARX_CHANGELEVEL_FinishSave();
+	
 	if(g_currentSavedGame) {
 		// Already open...
 		return true;
@@ -258,6 +375,7 @@ bool ARX_CHANGELEVEL_StartNew() {
 }
 
 bool currentSavedGameHasEntity(const std::string & idString) {
+	ARX_CHANGELEVEL_FinishSave();
 	if(g_currentSavedGame) {
 		return g_currentSavedGame->hasFile(idString);
 	} else {
@@ -268,6 +386,8 @@ bool currentSavedGameHasEntity(const std::string & idString) {
 
 void currentSavedGameStoreEntityDeletion(const std::string & idString) {
 	
+	ARX_CHANGELEVEL_FinishSave();
+	
 	if(!g_currentSavedGame) {
 		ARX_DEAD_CODE();
 		return;
@@ -285,6 +405,7 @@ void currentSavedGameStoreEntityDeletion(const std::string & idString) {
 }
 
 void currentSavedGameRemoveEntity(const std::string & idString) {
+	ARX_CHANGELEVEL_FinishSave();
 	if(g_currentSavedGame) {
 		g_currentSavedGame->remove(idString);
 	}
@@ -292,6 +413,22 @@ void currentSavedGameRemoveEntity(const std::string & idString) {
 
 extern long JUST_RELOADED;
 
+static std::string getLevelFile(long num) {
+	char levelId[256];
+	GetLevelNameByNum(num, levelId);
+	return std::string("graph/levels/level") + levelId + "/level" + levelId + ".dlf";
+}
+
+void ARX_CHANGELEVEL_Prefetch(const std::string & level) {
+	
+	long num = GetLevelNumByName("level" + level);
+	if(num == -1 || num == CURRENTLEVEL) {
+		return;
+	}
+	
+	LevelLoader::prefetch(getLevelFile(num));
+}
+
 void ARX_CHANGELEVEL_Change(const std::string & level, const std::string & target, long angle) {
 	
 	LogDebug("ARX_CHANGELEVEL_Change " << level << " " << target << " " << angle);
@@ -877,8 +1014,8 @@ static long ARX_CHANGELEVEL_Push_IO(const Entity * io, long level) {
 		return -1;
 	}
 	
-	arx_assert(io->show != SHOW_FLAG_DESTROYED);
-	arx_assert(io->show != SHOW_FLAG_KILLED);
+	arx_assert(io->show() != SHOW_FLAG_DESTROYED);
+	arx_assert(io->show() != SHOW_FLAG_KILLED);
 	
 	// Sets Savefile Name
 	std::string savefile = io->idString();
@@ -922,7 +1059,7 @@ static long ARX_CHANGELEVEL_Push_IO(const Entity * io, long level) {
 		ais.ioflags &= ~IO_FREEZESCRIPT;
 	}
 
-	ais.pos = io->pos;
+	ais.pos = io->pos();
 
 	if(io->obj && io->obj->pbox && io->obj->pbox->active) {
 		ais.pos.y -= io->obj->pbox->vert[0].initpos.y;
@@ -931,13 +1068,13 @@ static long ARX_CHANGELEVEL_Push_IO(const Entity * io, long level) {
 	ais.lastpos = io->lastpos;
 	ais.initpos = io->initpos;
 	ais.initangle = io->initangle;
-	ais.move = io->move;
+	ais.move = io->move();
 	ais.lastmove = io->lastmove;
 	ais.angle = io->angle;
 	ais.scale = io->scale;
 	ais.weight = io->weight;
 	util::storeString(ais.locname, io->locname.c_str());
-	ais.gameFlags = io->gameFlags;
+	ais.gameFlags = io->gameFlags();
 
 	if(io == entities.player())
 		ais.gameFlags &= ~GFLAG_INVISIBILITY;
@@ -945,7 +1082,7 @@ static long ARX_CHANGELEVEL_Push_IO(const Entity * io, long level) {
 	ais.material = io->material;
 	ais.level = ais.truelevel = level;
 	ais.scriptload = io->scriptload;
-	ais.show = io->show;
+	ais.show = io->show();
 	ais.collision = io->collision;
 	util::storeString(ais.mainevent, io->mainevent.c_str());
 	ais.velocity = io->velocity;
@@ -1057,7 +1194,7 @@ static long ARX_CHANGELEVEL_Push_IO(const Entity * io, long level) {
 	if (io->usepath)
 		ais.system_flags |= SYSTEM_FLAG_USEPATH;
 
-	ais.physics = io->physics;
+	ais.physics = io->physics();
 	ais.spellcast_data = io->spellcast_data;
 	assert(SAVED_MAX_ANIM_LAYERS == MAX_ANIM_LAYERS);
 	std::copy(io->animlayer, io->animlayer + SAVED_MAX_ANIM_LAYERS, ais.animlayer);
@@ -1083,7 +1220,7 @@ static long ARX_CHANGELEVEL_Push_IO(const Entity * io, long level) {
 	{
 		if (scr_timer[i].exist)
 		{
-			if (scr_timer[i].io == io)
+			if(entities.get(scr_timer[i].io) == io)
 			{
 				count++;
 			}
@@ -1119,7 +1256,7 @@ static long ARX_CHANGELEVEL_Push_IO(const Entity * io, long level) {
 	for(int i = 0; i < MAX_TIMER_SCRIPT; i++) {
 		SCR_TIMER & timer = scr_timer[i];
 		if(timer.exist) {
-			if(timer.io == io) {
+			if(entities.get(timer.io) == io) {
 				ARX_CHANGELEVEL_TIMERS_SAVE * ats = (ARX_CHANGELEVEL_TIMERS_SAVE *)(dat + pos);
 				memset(ats, 0, sizeof(ARX_CHANGELEVEL_TIMERS_SAVE));
 				ats->longinfo = timer.longinfo;
@@ -1568,9 +1705,7 @@ static long ARX_CHANGELEVEL_Pop_Zones_n_Lights(ARX_CHANGELEVEL_INDEX * asi, long
 static long ARX_CHANGELEVEL_Pop_Level(ARX_CHANGELEVEL_INDEX * asi, long num,
                                       bool firstTime) {
 	
-	char levelId[256];
-	GetLevelNameByNum(num, levelId);
-	std::string levelFile = std::string("graph/levels/level") + levelId + "/level" + levelId + ".dlf";
+	std::string levelFile = getLevelFile(num);
 	
 	LOAD_N_ERASE = false;
 	
@@ -1732,7 +1867,7 @@ static long ARX_CHANGELEVEL_Pop_Player() {
 		sp_wep = 0;
 	}
 	
-	entities.player()->pos = player.basePosition();
+	entities.player()->pos() = player.basePosition();
 	
 	WILL_RESTORE_PLAYER_POSITION = asp->pos.toVec3();
 	WILL_RESTORE_PLAYER_POSITION_FLAG = true;
@@ -1987,9 +2122,9 @@ static Entity * ARX_CHANGELEVEL_Pop_IO(const std::string & idString, EntityInsta
 		io->ioflags = EntityFlags::load(ais->ioflags); // TODO save/load flags
 		
 		io->ioflags &= ~IO_FREEZESCRIPT;
-		io->pos = ais->pos.toVec3();
+		io->pos() = ais->pos.toVec3();
 		io->lastpos = ais->lastpos.toVec3();
-		io->move = ais->move.toVec3();
+		io->move() = ais->move.toVec3();
 		io->lastmove = ais->lastmove.toVec3();
 		io->initpos = ais->initpos.toVec3();
 		io->initangle = ais->initangle;
@@ -1997,12 +2132,12 @@ static Entity * ARX_CHANGELEVEL_Pop_IO(const std::string & idString, EntityInsta
 		io->scale = ais->scale;
 		io->weight = ais->weight;
 		io->locname = script::loadUnlocalized(boost::to_lower_copy(util::loadString(ais->locname)));
-		io->gameFlags = GameFlags::load(ais->gameFlags); // TODO save/load flags
+		io->gameFlags() = GameFlags::load(ais->gameFlags); // TODO save/load flags
 		io->material = (Material)ais->material; // TODO save/load enum
 		
 		// Script data
 		io->scriptload = ais->scriptload;
-		io->show = EntityVisilibity(ais->show); // TODO save/load enum
+		io->show() = EntityVisilibity(ais->show); // TODO save/load enum
 		io->collision = IOCollisionFlags::load(ais->collision); // TODO save/load flags
 		io->mainevent = boost::to_lower_copy(util::loadString(ais->mainevent));
 		
@@ -2080,7 +2215,7 @@ static Entity * ARX_CHANGELEVEL_Pop_IO(const std::string & idString, EntityInsta
 		}
 		
 		io->spellcast_data = ais->spellcast_data;
-		io->physics = ais->physics;
+		io->physics() = ais->physics;
 		assert(SAVED_MAX_ANIM_LAYERS == MAX_ANIM_LAYERS);
 		std::copy(ais->animlayer, ais->animlayer + SAVED_MAX_ANIM_LAYERS, io->animlayer);
 		
@@ -2128,8 +2263,6 @@ static Entity * ARX_CHANGELEVEL_Pop_IO(const std::string & idString, EntityInsta
 				continue;
 			}
 			
-			ActiveTimers++;
-			
 			if(ats->script) {
 				scr_timer[num].es = &io->over_script;
 			} else {
@@ -2137,8 +2270,7 @@ static Entity * ARX_CHANGELEVEL_Pop_IO(const std::string & idString, EntityInsta
 			}
 			
 			scr_timer[num].flags = sFlags;
-			scr_timer[num].exist = 1;
-			scr_timer[num].io = io;
+			scr_timer[num].io = entities.ref(io);
 			scr_timer[num].msecs = ats->msecs;
 			scr_timer[num].name = boost::to_lower_copy(util::loadString(ats->name));
 			scr_timer[num].pos = ats->pos;
@@ -2149,6 +2281,8 @@ static Entity * ARX_CHANGELEVEL_Pop_IO(const std::string & idString, EntityInsta
 			scr_timer[num].tim = tt;
 			
 			scr_timer[num].times = ats->times;
+			
+			ARX_SCRIPT_Timer_Start(num);
 		}
 		
 		if(!loadScriptData(io->script, dat, pos) || !loadScriptData(io->over_script, dat, pos)) {
@@ -2490,7 +2624,7 @@ static void ARX_CHANGELEVEL_PopAllIO_FINISH(bool reloadflag, bool firstTime) {
 			
 			if(e && (e->ioflags & IO_NPC) && ValidIONum(e->targetinfo)) {
 				if(e->_npcdata->behavior != BEHAVIOUR_NONE) {
-					e->physics.cyl = GetIOCyl(e);
+					e->physics().cyl = GetIOCyl(e);
 					GetTargetPos(e);
 					ARX_NPC_LaunchPathfind(e, e->targetinfo);
 				}
@@ -2536,7 +2670,7 @@ static void ARX_CHANGELEVEL_PopAllIO_FINISH(bool reloadflag, bool firstTime) {
 			
 			if(e && (e->ioflags & IO_NPC) && ValidIONum(e->targetinfo)) {
 				if(e->_npcdata->behavior != BEHAVIOUR_NONE) {
-					e->physics.cyl = GetIOCyl(e);
+					e->physics().cyl = GetIOCyl(e);
 					GetTargetPos(e);
 					ARX_NPC_LaunchPathfind(e, e->targetinfo);
 				}
@@ -2692,6 +2826,7 @@ static bool ARX_CHANGELEVEL_PopLevel(long instance, bool reloadflag) {
 				scr_timer[i].tim = ulDTime;
 			}
 		}
+		ARX_SCRIPT_Timer_Reschedule();
 	} else {
 		LogDebug("Before ARX_CHANGELEVEL_PopAllIO");
 		ARX_CHANGELEVEL_PopAllIO(&asi);
@@ -2789,10 +2924,18 @@ bool ARX_CHANGELEVEL_Save(const std::string & name, const fs::path & savefile) {
 		return false;
 	}
 	
+	// Only take a snapshot of the serialized game state here - compressing and writing
+	// it is left to the SaveGameWriter thread
+	g_currentSavedGame->setDeferWrites(true);
+	
 	// Save the current level
 	
 	if(!ARX_CHANGELEVEL_PushLevel(CURRENTLEVEL, CURRENTLEVEL)) {
 		LogWarning << "Could not save the level";
+		while(g_currentSavedGame->getDeferredCount() != 0) {
+			g_currentSavedGame->writeDeferred();
+		}
+		g_currentSavedGame->setDeferWrites(false);
 		return false;
 	}
 	
@@ -2809,20 +2952,11 @@ bool ARX_CHANGELEVEL_Save(const std::string & name, const fs::path & savefile) {
 	const char * dat = reinterpret_cast<const char *>(&pld);
 	g_currentSavedGame->save("pld", dat, sizeof(ARX_CHANGELEVEL_PLAYER_LEVEL_DATA));
 	
-	// Close the savegame file
-	
-	if(!g_currentSavedGame->flush("pld")) {
-		LogError << "Could not complete the save";
-		return false;
-	}
-	
 	arxtime.resume();
 	
-	// Copy the savegame and screenshot to the final destination, overwriting previous files
-	if(!fs::copy_file(CURRENT_GAME_FILE, savefile, true)) {
-		LogWarning << "Failed to copy save " << CURRENT_GAME_FILE <<" to " << savefile;
-		return false;
-	}
+	// Compress the savegame and write it to the final destination, overwriting previous files
+	g_saveGameWriter = new SaveGameWriter(*g_currentSavedGame, savefile);
+	g_saveGameWriter->start();
 	
 	return true;
 }
@@ -2875,8 +3009,8 @@ long ARX_CHANGELEVEL_Load(const fs::path & savefile) {
 	
 	assert(!CURRENT_GAME_FILE.empty());
 	
-	// Copy SavePath to Current Game
-	if(!fs::copy_file(savefile, CURRENT_GAME_FILE)) {
+	// Copy SavePath to Current Game - the SaveBlock will only copy the data once it is modified
+	if(!fs::clone_file(savefile, CURRENT_GAME_FILE) && !fs::copy_file(savefile, CURRENT_GAME_FILE)) {
 		LogWarning << "Failed to create copy savegame " << savefile << " to " << CURRENT_GAME_FILE;
 		return -1;
 	}
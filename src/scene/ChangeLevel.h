@@ -53,6 +53,12 @@ namespace fs { class path; }
 
 void ARX_CHANGELEVEL_Change(const std::string & level, const std::string & target, long angle);
 
+/*!
+ * Start loading the files of a level in the background.
+ * Call this when a level change to that level becomes likely.
+ */
+void ARX_CHANGELEVEL_Prefetch(const std::string & level);
+
 long ARX_CHANGELEVEL_GetInfo(const fs::path & savefile, std::string & name, float & version, long & level, unsigned long & time);
 
 bool ARX_CHANGELEVEL_StartNew();
@@ -62,8 +68,41 @@ bool ARX_CHANGELEVEL_StartNew();
  */
 long ARX_CHANGELEVEL_Load(const fs::path & savefile);
 
+/*!
+ * Save the current game.
+ * 
+ * The game state is captured before this returns, but compressing and writing the save
+ * file to its destination happens in a background thread.
+ * Use \ref ARX_CHANGELEVEL_PollSave() to check for completion.
+ * 
+ * \return true if the game state was captured and the write has been started
+ */
 bool ARX_CHANGELEVEL_Save(const std::string & name, const fs::path & savefile);
 
+//! Status of the savegame being written by \ref ARX_CHANGELEVEL_Save()
+enum SaveWriteStatus {
+	SaveWriteIdle,       //!< No savegame is being written
+	SaveWriteInProgress, //!< A savegame is being written in the background
+	SaveWriteDone,       //!< The savegame has been written - only reported once
+	SaveWriteFailed      //!< The savegame could not be written - only reported once
+};
+
+/*!
+ * Check the status of the savegame being written in the background.
+ * 
+ * \param progress if not NULL, receives the fraction [0, 1] of the save that has been written
+ *                 while the status is \ref SaveWriteInProgress
+ */
+SaveWriteStatus ARX_CHANGELEVEL_PollSave(float * progress = NULL);
+
+/*!
+ * Wait until the savegame being written in the background is complete.
+ * The result is still reported by the next call to \ref ARX_CHANGELEVEL_PollSave().
+ * 
+ * \return false if the last savegame could not be written
+ */
+bool ARX_CHANGELEVEL_FinishSave();
+
 bool ARX_Changelevel_CurGame_Clear();
 
 /*!
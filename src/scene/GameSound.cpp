@@ -562,7 +562,7 @@ static void ARX_SOUND_IOFrontPos(const Entity * io, Vec3f & pos) {
 	if(io == entities.player()) {
 		pos = ARX_PLAYER_FrontPos();
 	} else if(io) {
-		pos = io->pos;
+		pos = io->pos();
 		pos += angleToVectorXZ(io->angle.getPitch()) * 100.f;
 		pos += Vec3f(0.f, -100.f, 0.f);
 	} else if(ACTIVECAM) {
@@ -600,9 +600,9 @@ long ARX_SOUND_PlaySpeech(const res::path & name, const Entity * io)
 		if((io == entities.player() && !EXTERNALVIEW))
 			ARX_SOUND_IOFrontPos(io, channel.position);
 		else
-			channel.position = io->pos;
+			channel.position = io->pos();
 
-		if(ACTIVECAM && fartherThan(ACTIVECAM->orgTrans.pos, io->pos, ARX_SOUND_REFUSE_DISTANCE)) {
+		if(ACTIVECAM && fartherThan(ACTIVECAM->orgTrans.pos, io->pos(), ARX_SOUND_REFUSE_DISTANCE)) {
 			return ARX_SOUND_TOO_FAR; // TODO sample is never freed!
 		}
 
@@ -866,7 +866,7 @@ void ARX_SOUND_RefreshSpeechPosition(SourceId & sample_id, const Entity * io) {
 	if((io == entities.player() && !EXTERNALVIEW)) {
 		ARX_SOUND_IOFrontPos(io, position);
 	} else {
-		position = io->pos;
+		position = io->pos();
 	}
 	
 	audio::setSamplePosition(sample_id, position);
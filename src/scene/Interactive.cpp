@@ -146,20 +146,7 @@ bool ValidIONum(EntityHandle num) {
 }
 
 bool ValidIOAddress(const Entity * io) {
-	
-	if(!io)
-		return false;
-	
-	for(size_t i = 0; i < entities.size(); i++) {
-		const EntityHandle handle = EntityHandle(i);
-		Entity * e = entities[handle];
-		
-		if(e == io) {
-			return true;
-		}
-	}
-	
-	return false;
+	return entities.contains(io);
 }
 
 static float ARX_INTERACTIVE_fGetPrice(Entity * io, Entity * shop) {
@@ -247,7 +234,7 @@ bool ARX_INTERACTIVE_Attach(EntityHandle n_source, EntityHandle n_target, const
 	if(!ValidIONum(n_source) || !ValidIONum(n_target))
 		return false;
 
-	entities[n_source]->show = SHOW_FLAG_LINKED;
+	entities[n_source]->show() = SHOW_FLAG_LINKED;
 	EERIE_LINKEDOBJ_UnLinkObjectFromObject(entities[n_target]->obj, entities[n_source]->obj);
 	return EERIE_LINKEDOBJ_LinkObjectToObject(entities[n_target]->obj,
 	        entities[n_source]->obj, ap_target, ap_source, entities[n_source]);
@@ -258,7 +245,7 @@ void ARX_INTERACTIVE_Detach(EntityHandle n_source, EntityHandle n_target)
 	if(!ValidIONum(n_source) || !ValidIONum(n_target))
 		return;
 
-	entities[n_source]->show = SHOW_FLAG_IN_SCENE;
+	entities[n_source]->show() = SHOW_FLAG_IN_SCENE;
 	EERIE_LINKEDOBJ_UnLinkObjectFromObject(entities[n_target]->obj, entities[n_source]->obj);
 }
 
@@ -350,10 +337,10 @@ void ARX_INTERACTIVE_HideGore(Entity * io, long flag)
 bool ForceNPC_Above_Ground(Entity * io) {
 	
 	if(io && (io->ioflags & IO_NPC) && !(io->ioflags & IO_PHYSICAL_OFF)) {
-		io->physics.cyl.origin = io->pos;
-		AttemptValidCylinderPos(io->physics.cyl, io, CFLAG_NO_INTERCOL);
-		if(glm::abs(io->pos.y - io->physics.cyl.origin.y) < 45.f) {
-			io->pos.y = io->physics.cyl.origin.y;
+		io->physics().cyl.origin = io->pos();
+		AttemptValidCylinderPos(io->physics().cyl, io, CFLAG_NO_INTERCOL);
+		if(glm::abs(io->pos().y - io->physics().cyl.origin.y) < 45.f) {
+			io->pos().y = io->physics().cyl.origin.y;
 			return true;
 		}
 	}
@@ -388,8 +375,8 @@ void IO_UnlinkAllLinkedObjects(Entity * io) {
 		linked->angle = Anglef(Random::getf(340.f, 380.f), Random::getf(0.f, 360.f), 0.f);
 		linked->soundtime = 0;
 		linked->soundcount = 0;
-		linked->gameFlags |= GFLAG_NO_PHYS_IO_COL;
-		linked->show = SHOW_FLAG_IN_SCENE;
+		linked->gameFlags() |= GFLAG_NO_PHYS_IO_COL;
+		linked->show() = SHOW_FLAG_IN_SCENE;
 		linked->no_collide = io->index();
 		
 		Vec3f pos = actionPointPosition(io->obj, io->obj->linked[k].lidx);
@@ -410,6 +397,25 @@ TREATZONE_IO * treatio = NULL;
 long TREATZONE_CUR = 0;
 static long TREATZONE_MAX = 0;
 
+//! Slot in treatio for each entity index - only valid if treatio[slot].io matches
+static std::vector<long> g_treatZoneSlots;
+
+//! Find the treatio slot of an entity or return -1 if it is not in the treat zone
+static long TREATZONE_Find(Entity * io) {
+	
+	size_t index = size_t(io->index().handleData());
+	if(index >= g_treatZoneSlots.size()) {
+		return -1;
+	}
+	
+	long slot = g_treatZoneSlots[index];
+	if(slot < 0 || slot >= TREATZONE_CUR || treatio[slot].io != io) {
+		return -1;
+	}
+	
+	return slot;
+}
+
 void TREATZONE_Clear() {
 	TREATZONE_CUR = 0;
 }
@@ -419,40 +425,43 @@ void TREATZONE_Release() {
 	treatio = NULL;
 	TREATZONE_MAX = 0;
 	TREATZONE_CUR = 0;
+	g_treatZoneSlots.clear();
 }
 
 void TREATZONE_RemoveIO(Entity * io)
 {
-	if(treatio) {
-		for(long i = 0; i < TREATZONE_CUR; i++) {
-			if(treatio[i].io == io) {
-				treatio[i].io = NULL;
-				treatio[i].ioflags = 0;
-				treatio[i].show = 0;
-			}
-		}
+	long slot = TREATZONE_Find(io);
+	if(slot >= 0) {
+		treatio[slot].io = NULL;
+		treatio[slot].ioflags = 0;
+		treatio[slot].show = 0;
 	}
 }
 
 void TREATZONE_AddIO(Entity * io, bool justCollide)
 {
+	if(TREATZONE_Find(io) >= 0)
+		return;
+
 	if(TREATZONE_MAX == TREATZONE_CUR) {
-		TREATZONE_MAX++;
+		TREATZONE_MAX = std::max(TREATZONE_MAX * 2, 64l);
 		treatio = (TREATZONE_IO *)realloc(treatio, sizeof(TREATZONE_IO) * TREATZONE_MAX);
 	}
 
-	for(long i = 0; i < TREATZONE_CUR; i++) {
-		if(treatio[i].io == io)
-			return;
+	size_t index = size_t(io->index().handleData());
+	if(index >= g_treatZoneSlots.size()) {
+		g_treatZoneSlots.resize(index + 1, -1);
 	}
+	g_treatZoneSlots[index] = TREATZONE_CUR;
 
 	treatio[TREATZONE_CUR].io = io;
+	treatio[TREATZONE_CUR].handle = io->index();
 	treatio[TREATZONE_CUR].ioflags = io->ioflags;
 
 	if(justCollide)
 		treatio[TREATZONE_CUR].ioflags |= IO_JUST_COLLIDE;
 
-	treatio[TREATZONE_CUR].show = io->show;
+	treatio[TREATZONE_CUR].show = io->show();
 	TREATZONE_CUR++;
 }
 
@@ -461,8 +470,8 @@ void CheckSetAnimOutOfTreatZone(Entity * io, AnimLayer & layer) {
 	arx_assert(io);
 	
 	if( layer.cur_anim &&
-		!(io->gameFlags & GFLAG_ISINTREATZONE) &&
-		fartherThan(io->pos, ACTIVECAM->orgTrans.pos, 2500.f))
+		!(io->gameFlags() & GFLAG_ISINTREATZONE) &&
+		fartherThan(io->pos(), ACTIVECAM->orgTrans.pos, 2500.f))
 	{
 
 		layer.ctime = layer.cur_anim->anims[layer.altidx_cur]->anim_time - 1;
@@ -534,14 +543,18 @@ void PrepareIOTreatZone(long flag) {
 	
 	for(size_t i = 1; i < entities.size(); i++) {
 		const EntityHandle handle = EntityHandle(i);
+		
+		// Filter on the hot data first so that hidden entities and unused slots are
+		// skipped without touching the Entity objects
+		const EntityVisilibity show = entities.hotData(handle).show;
+		if(show != SHOW_FLAG_IN_SCENE && show != SHOW_FLAG_TELEPORTING
+		   && show != SHOW_FLAG_ON_PLAYER && show != SHOW_FLAG_HIDDEN) {
+			continue;
+		}
+		
 		Entity * io = entities[handle];
 
-		if ((io)
-		        &&	((io->show == SHOW_FLAG_IN_SCENE)
-		             ||	(io->show == SHOW_FLAG_TELEPORTING)
-		             ||	(io->show == SHOW_FLAG_ON_PLAYER)
-		             ||	(io->show == SHOW_FLAG_HIDDEN)))   
-		{
+		if(io) {
 			bool treat;
 
 			if (io->ioflags & IO_CAMERA) {
@@ -554,22 +567,22 @@ void PrepareIOTreatZone(long flag) {
 				float dists;
 
 				if(Cam_Room >= 0) {
-					if(io->show == SHOW_FLAG_TELEPORTING) {
+					if(io->show() == SHOW_FLAG_TELEPORTING) {
 						Vec3f pos = GetItemWorldPosition(io);
 						dists = glm::distance2(cameraPos, pos);
 					} else {
 						if(io->requestRoomUpdate)
 							UpdateIORoom(io);
 
-						dists = square(SP_GetRoomDist(io->pos, cameraPos, io->room, Cam_Room));
+						dists = square(SP_GetRoomDist(io->pos(), cameraPos, io->room, Cam_Room));
 					}
 				} else {
-					if(io->show == SHOW_FLAG_TELEPORTING) {
+					if(io->show() == SHOW_FLAG_TELEPORTING) {
 						Vec3f pos = GetItemWorldPosition(io);
 						dists = glm::distance2(cameraPos, pos); //&io->pos,&pos);
 					}
 					else
-						dists = glm::distance2(io->pos, cameraPos);
+						dists = glm::distance2(io->pos(), cameraPos);
 				}
 		
 				if(dists < square(TREATZONE_LIMIT))
@@ -583,14 +596,14 @@ void PrepareIOTreatZone(long flag) {
 					treat = true;
 			}
 			
-			if(io->gameFlags & GFLAG_ISINTREATZONE) {
-				io->gameFlags |= GFLAG_WASINTREATZONE;
+			if(io->gameFlags() & GFLAG_ISINTREATZONE) {
+				io->gameFlags() |= GFLAG_WASINTREATZONE;
 			} else {
-				io->gameFlags &= ~GFLAG_WASINTREATZONE;
+				io->gameFlags() &= ~GFLAG_WASINTREATZONE;
 			}
 			
 			if(treat) {
-				io->gameFlags |= GFLAG_ISINTREATZONE;
+				io->gameFlags() |= GFLAG_ISINTREATZONE;
 				TREATZONE_AddIO(io);
 				if((io->ioflags & IO_NPC) && io->_npcdata->weapon) {
 					Entity * iooo = io->_npcdata->weapon;
@@ -598,66 +611,67 @@ void PrepareIOTreatZone(long flag) {
 					iooo->requestRoomUpdate = io->requestRoomUpdate;
 				}
 			} else {
-				io->gameFlags &= ~GFLAG_ISINTREATZONE;
+				io->gameFlags() &= ~GFLAG_ISINTREATZONE;
 			}
 			
 			EVENT_SENDER = NULL;
 
-			if ((io->gameFlags & GFLAG_ISINTREATZONE)
-			        && (!(io->gameFlags & GFLAG_WASINTREATZONE)))
+			if ((io->gameFlags() & GFLAG_ISINTREATZONE)
+			        && (!(io->gameFlags() & GFLAG_WASINTREATZONE)))
 			{
 				//coming back; doesn't really matter right now
 				//	SendIOScriptEvent(entities[i],SM_TREATIN);
 
 			}
-			else if ((!(io->gameFlags & GFLAG_ISINTREATZONE))
-			         &&	(io->gameFlags & GFLAG_WASINTREATZONE))
+			else if ((!(io->gameFlags() & GFLAG_ISINTREATZONE))
+			         &&	(io->gameFlags() & GFLAG_WASINTREATZONE))
 			{
 				//going away;
-				io->gameFlags |= GFLAG_ISINTREATZONE;
+				io->gameFlags() |= GFLAG_ISINTREATZONE;
 
 				if(SendIOScriptEvent(io, SM_TREATOUT) != REFUSE) {
 					if(io->ioflags & IO_NPC)
 						io->_npcdata->pathfind.flags &= ~PATHFIND_ALWAYS;
 
-					io->gameFlags &= ~GFLAG_ISINTREATZONE;
+					io->gameFlags() &= ~GFLAG_ISINTREATZONE;
 				}
 			}
 		}
 	}
 
-	long M_TREAT = TREATZONE_CUR;
+	// Gather the positions once so the proximity test below is a linear sweep
+	// instead of dereferencing every treated entity for every candidate
+	static std::vector<Vec3f> treatPositions;
+	treatPositions.clear();
+	for(long ii = 1; ii < TREATZONE_CUR; ii++) {
+		if(treatio[ii].io) {
+			treatPositions.push_back(treatio[ii].io->pos());
+		}
+	}
 
 	for(size_t i = 1; i < entities.size(); i++) {
 		const EntityHandle handle = EntityHandle(i);
-		Entity * io = entities[handle];
-
-		if(io && !(io->gameFlags & GFLAG_ISINTREATZONE)
-		        && ((io->show == SHOW_FLAG_IN_SCENE)
-		            ||	(io->show == SHOW_FLAG_TELEPORTING)
-		            ||	(io->show == SHOW_FLAG_ON_PLAYER)
-		            ||	(io->show == SHOW_FLAG_HIDDEN)))   // show 5 = ininventory; 15 = destroyed
-		{
-			if(io->ioflags & (IO_CAMERA | IO_ITEM | IO_MARKER))
-				continue;
-
-			bool toadd = false;
-
-			for(long ii = 1; ii < M_TREAT; ii++) {
-				Entity * ioo = treatio[ii].io;
-
-				if(ioo) {
-					if(closerThan(io->pos, ioo->pos, 300.f)) {
-						toadd = true;
-						break;
-					}
-				}
-			}
-
-			if(toadd) {
-				TREATZONE_AddIO(io, true);
+		
+		const EntityHotData & hot = entities.hotData(handle);
+		if((hot.gameFlags & GFLAG_ISINTREATZONE)
+		   || (hot.show != SHOW_FLAG_IN_SCENE && hot.show != SHOW_FLAG_TELEPORTING
+		       && hot.show != SHOW_FLAG_ON_PLAYER && hot.show != SHOW_FLAG_HIDDEN)) {
+			continue;
+		}
+		
+		bool toadd = false;
+		for(size_t ii = 0; ii < treatPositions.size(); ii++) {
+			if(closerThan(hot.pos, treatPositions[ii], 300.f)) {
+				toadd = true;
+				break;
 			}
 		}
+		
+		Entity * io = entities[handle];
+		
+		if(toadd && io && !(io->ioflags & (IO_CAMERA | IO_ITEM | IO_MARKER))) {
+			TREATZONE_AddIO(io, true);
+		}
 	}
 }
 
@@ -674,7 +688,7 @@ void CleanScriptLoadedIO() {
 				delete io;
 			} else {
 				// TODO why not jus leave it as is?
-				io->show = SHOW_FLAG_IN_SCENE;
+				io->show() = SHOW_FLAG_IN_SCENE;
 			}
 		}
 	}
@@ -827,7 +841,7 @@ static void ARX_INTERACTIVE_ClearIODynData_II(Entity * io) {
 	}
 	
 	io->inventory = NULL;
-	io->gameFlags |= GFLAG_INTERACTIVITY;
+	io->gameFlags() |= GFLAG_INTERACTIVITY;
 	
 	if(io->tweaky) {
 		delete io->obj;
@@ -853,8 +867,8 @@ static void RestoreIOInitPos(Entity * io) {
 
 	{
 		ARX_INTERACTIVE_Teleport(io, io->initpos);
-		io->pos = io->lastpos = io->initpos;
-		io->move = Vec3f_ZERO;
+		io->pos() = io->lastpos = io->initpos;
+		io->move() = Vec3f_ZERO;
 		io->lastmove = Vec3f_ZERO;
 		io->angle = io->initangle;
 	}
@@ -900,21 +914,21 @@ void RestoreInitialIOStatusOfIO(Entity * io)
 		io->frameloss = 0.f;
 		io->sfx_flag = 0;
 		io->max_durability = io->durability = 100;
-		io->gameFlags &= ~GFLAG_INVISIBILITY;
-		io->gameFlags &= ~GFLAG_MEGAHIDE;
-		io->gameFlags &= ~GFLAG_NOGORE;
-		io->gameFlags &= ~GFLAG_ISINTREATZONE;
-		io->gameFlags &= ~GFLAG_PLATFORM;
-		io->gameFlags &= ~GFLAG_ELEVATOR;
-		io->gameFlags &= ~GFLAG_HIDEWEAPON;
-		io->gameFlags &= ~GFLAG_NOCOMPUTATION;
-		io->gameFlags &= ~GFLAG_INTERACTIVITYHIDE;
-		io->gameFlags &= ~GFLAG_DOOR;
-		io->gameFlags &= ~GFLAG_GOREEXPLODE;
+		io->gameFlags() &= ~GFLAG_INVISIBILITY;
+		io->gameFlags() &= ~GFLAG_MEGAHIDE;
+		io->gameFlags() &= ~GFLAG_NOGORE;
+		io->gameFlags() &= ~GFLAG_ISINTREATZONE;
+		io->gameFlags() &= ~GFLAG_PLATFORM;
+		io->gameFlags() &= ~GFLAG_ELEVATOR;
+		io->gameFlags() &= ~GFLAG_HIDEWEAPON;
+		io->gameFlags() &= ~GFLAG_NOCOMPUTATION;
+		io->gameFlags() &= ~GFLAG_INTERACTIVITYHIDE;
+		io->gameFlags() &= ~GFLAG_DOOR;
+		io->gameFlags() &= ~GFLAG_GOREEXPLODE;
 		io->invisibility = 0.f;
 		io->rubber = BASE_RUBBER;
 		io->scale = 1.f;
-		io->move = Vec3f_ZERO;
+		io->move() = Vec3f_ZERO;
 		io->type_flags = 0;
 		io->sound = -1;
 		io->soundtime = 0;
@@ -948,11 +962,11 @@ void RestoreInitialIOStatusOfIO(Entity * io)
 			io->obj->pbox->storedtiming = 0;
 		}
 		
-		io->physics.cyl.origin = io->pos;
-		io->physics.cyl.radius = io->original_radius;
-		io->physics.cyl.height = io->original_height;
+		io->physics().cyl.origin = io->pos();
+		io->physics().cyl.radius = io->original_radius;
+		io->physics().cyl.height = io->original_height;
 		io->fall = 0;
-		io->show = SHOW_FLAG_IN_SCENE;
+		io->show() = SHOW_FLAG_IN_SCENE;
 		io->targetinfo = EntityHandle(TARGET_NONE);
 		io->spellcast_data.castingspell = SPELL_NONE;
 		io->summoner = EntityHandle();
@@ -1146,27 +1160,26 @@ void ARX_INTERACTIVE_TeleportBehindTarget(Entity * io)
 
 		if(num != -1) {
 			EntityHandle t = io->index();
-			ActiveTimers++;
 			scr_timer[num].es = NULL;
-			scr_timer[num].exist = 1;
-			scr_timer[num].io = io;
+			scr_timer[num].io = entities.ref(io);
 			scr_timer[num].msecs = Random::get(3000, 6000);
 			scr_timer[num].name = "_r_a_t_";
 			scr_timer[num].pos = -1; 
 			scr_timer[num].tim = arxtime.now_ul();
 			scr_timer[num].times = 1;
-			entities[t]->show = SHOW_FLAG_TELEPORTING;
+			ARX_SCRIPT_Timer_Start(num);
+			entities[t]->show() = SHOW_FLAG_TELEPORTING;
 			AddRandomSmoke(io, 10);
-			ARX_PARTICLES_Add_Smoke(io->pos, 3, 20);
+			ARX_PARTICLES_Add_Smoke(io->pos(), 3, 20);
 			Vec3f pos;
-			pos.x = entities[t]->pos.x;
-			pos.y = entities[t]->pos.y + entities[t]->physics.cyl.height * ( 1.0f / 2 );
-			pos.z = entities[t]->pos.z;
+			pos.x = entities[t]->pos().x;
+			pos.y = entities[t]->pos().y + entities[t]->physics().cyl.height * ( 1.0f / 2 );
+			pos.z = entities[t]->pos().z;
 			io->requestRoomUpdate = true;
 			io->room = -1;
 			ARX_PARTICLES_Add_Smoke(pos, 3, 20);
-			MakeCoolFx(io->pos);
-			io->gameFlags |= GFLAG_INVISIBILITY;
+			MakeCoolFx(io->pos());
+			io->gameFlags() |= GFLAG_INVISIBILITY;
 		}
 	}
 }
@@ -1174,7 +1187,7 @@ void ARX_INTERACTIVE_TeleportBehindTarget(Entity * io)
 void ResetVVPos(Entity * io)
 {
 	if(io && (io->ioflags & IO_NPC))
-		io->_npcdata->vvpos = io->pos.y;
+		io->_npcdata->vvpos = io->pos().y;
 }
 
 void ComputeVVPos(Entity * io)
@@ -1182,12 +1195,12 @@ void ComputeVVPos(Entity * io)
 	if(io->ioflags & IO_NPC) {
 		float vvp = io->_npcdata->vvpos;
 
-		if(vvp == -99999.f || vvp == io->pos.y) {
-			io->_npcdata->vvpos = io->pos.y;
+		if(vvp == -99999.f || vvp == io->pos().y) {
+			io->_npcdata->vvpos = io->pos().y;
 			return;
 		}
 
-		float diff = io->pos.y - vvp;
+		float diff = io->pos().y - vvp;
 		float fdiff = glm::abs(diff);
 		float eediff = fdiff;
 
@@ -1219,9 +1232,9 @@ void ComputeVVPos(Entity * io)
 			fdiff = 0.f;
 
 		if(diff < 0.f)
-			io->_npcdata->vvpos = io->pos.y + fdiff;
+			io->_npcdata->vvpos = io->pos().y + fdiff;
 		else
-			io->_npcdata->vvpos = io->pos.y - fdiff;
+			io->_npcdata->vvpos = io->pos().y - fdiff;
 	}
 }
 
@@ -1230,7 +1243,7 @@ void ARX_INTERACTIVE_Teleport(Entity * io, const Vec3f & target, bool flag) {
 	if(!io)
 		return;
 	
-	io->gameFlags &= ~GFLAG_NOCOMPUTATION;
+	io->gameFlags() &= ~GFLAG_NOCOMPUTATION;
 	io->requestRoomUpdate = true;
 	io->room = -1;
 	
@@ -1244,11 +1257,11 @@ void ARX_INTERACTIVE_Teleport(Entity * io, const Vec3f & target, bool flag) {
 	}
 	
 	if(io->ioflags & IO_NPC) {
-		io->_npcdata->vvpos = io->pos.y;
+		io->_npcdata->vvpos = io->pos().y;
 	}
 	
-	Vec3f translate = target - io->pos;
-	io->lastpos = io->physics.cyl.origin = io->pos = target;
+	Vec3f translate = target - io->pos();
+	io->lastpos = io->physics().cyl.origin = io->pos() = target;
 	
 	if(io->obj) {
 		if(io->obj->pbox) {
@@ -1315,7 +1328,7 @@ void SetWeapon_Back(Entity * io) {
 	if(ioo && ioo->obj) {
 		EERIE_LINKEDOBJ_UnLinkObjectFromObject(io->obj, ioo->obj);
 
-		if(io->gameFlags & GFLAG_HIDEWEAPON)
+		if(io->gameFlags() & GFLAG_HIDEWEAPON)
 			return;
 
 		ActionPoint ni = io->obj->fastaccess.weapon_attach;
@@ -1349,7 +1362,7 @@ void Prepare_SetWeapon(Entity * io, const res::path & temp) {
 		SendIOScriptEvent(ioo, SM_INIT);
 		SendIOScriptEvent(ioo, SM_INITEND);
 		io->_npcdata->weapontype = ioo->type_flags;
-		ioo->show = SHOW_FLAG_LINKED;
+		ioo->show() = SHOW_FLAG_LINKED;
 		ioo->scriptload = 2;
 		
 		SetWeapon_Back(io);
@@ -1369,7 +1382,7 @@ void LinkObjToMe(Entity * io, Entity * io2, const std::string & attach) {
 		return;
 	
 	RemoveFromAllInventories(io2);
-	io2->show = SHOW_FLAG_LINKED;
+	io2->show() = SHOW_FLAG_LINKED;
 	EERIE_LINKEDOBJ_LinkObjectToObject(io->obj, io2->obj, attach, attach, io2);
 }
 
@@ -1434,23 +1447,23 @@ Entity * AddFix(const res::path & classPath, EntityInstance instance, AddInterac
 	
 	io->spellcast_data.castingspell = SPELL_NONE;
 	
-	io->pos = player.pos;
-	io->pos += angleToVectorXZ(player.angle.getPitch()) * 140.f;
+	io->pos() = player.pos;
+	io->pos() += angleToVectorXZ(player.angle.getPitch()) * 140.f;
 	
-	io->lastpos = io->initpos = io->pos;
+	io->lastpos = io->initpos = io->pos();
 	io->lastpos.x = io->initpos.x = glm::abs(io->initpos.x / 20) * 20.f;
 	io->lastpos.z = io->initpos.z = glm::abs(io->initpos.z / 20) * 20.f;
 	
 	float tempo;
-	EERIEPOLY * ep = CheckInPoly(io->pos + Vec3f(0.f, player.baseHeight(), 0.f));
-	if(ep && GetTruePolyY(ep, io->pos, &tempo)) {
-		io->lastpos.y = io->initpos.y = io->pos.y = tempo;
+	EERIEPOLY * ep = CheckInPoly(io->pos() + Vec3f(0.f, player.baseHeight(), 0.f));
+	if(ep && GetTruePolyY(ep, io->pos(), &tempo)) {
+		io->lastpos.y = io->initpos.y = io->pos().y = tempo;
 	}
 	
-	ep = CheckInPoly(io->pos);
+	ep = CheckInPoly(io->pos());
 	if(ep) {
-		io->pos.y = std::min(ep->v[0].p.y, ep->v[1].p.y);
-		io->lastpos.y = io->initpos.y = io->pos.y = std::min(io->pos.y, ep->v[2].p.y);
+		io->pos().y = std::min(ep->v[0].p.y, ep->v[1].p.y);
+		io->lastpos.y = io->initpos.y = io->pos().y = std::min(io->pos().y, ep->v[2].p.y);
 	}
 	
 	if(!io->obj && !(flags & NO_MESH)) {
@@ -1490,27 +1503,27 @@ static Entity * AddCamera(const res::path & classPath, EntityInstance instance)
 	
 	GetIOScript(io, script);
 	
-	io->pos = player.pos;
-	io->pos += angleToVectorXZ(player.angle.getPitch()) * 140.f;
+	io->pos() = player.pos;
+	io->pos() += angleToVectorXZ(player.angle.getPitch()) * 140.f;
 	
-	io->lastpos = io->initpos = io->pos;
+	io->lastpos = io->initpos = io->pos();
 	io->lastpos.x = io->initpos.x = glm::abs(io->initpos.x / 20) * 20.f;
 	io->lastpos.z = io->initpos.z = glm::abs(io->initpos.z / 20) * 20.f;
 	
 	float tempo;
 	EERIEPOLY * ep;
-	ep = CheckInPoly(io->pos + Vec3f(0.f, player.baseHeight(), 0.f), &tempo);
+	ep = CheckInPoly(io->pos() + Vec3f(0.f, player.baseHeight(), 0.f), &tempo);
 	if(ep) {
-		io->lastpos.y = io->initpos.y = io->pos.y = tempo;
+		io->lastpos.y = io->initpos.y = io->pos().y = tempo;
 	}
 	
-	ep = CheckInPoly(io->pos);
+	ep = CheckInPoly(io->pos());
 	if(ep) {
-		io->pos.y = std::min(ep->v[0].p.y, ep->v[1].p.y);
-		io->lastpos.y = io->initpos.y = io->pos.y = std::min(io->pos.y, ep->v[2].p.y);
+		io->pos().y = std::min(ep->v[0].p.y, ep->v[1].p.y);
+		io->lastpos.y = io->initpos.y = io->pos().y = std::min(io->pos().y, ep->v[2].p.y);
 	}
 	
-	io->lastpos.y = io->initpos.y = io->pos.y += player.baseHeight();
+	io->lastpos.y = io->initpos.y = io->pos().y += player.baseHeight();
 	
 	io->obj = cameraobj;
 	
@@ -1542,27 +1555,27 @@ static Entity * AddMarker(const res::path & classPath, EntityInstance instance)
 	
 	GetIOScript(io, script);
 	
-	io->pos = player.pos;
-	io->pos += angleToVectorXZ(player.angle.getPitch()) * 140.f;
+	io->pos() = player.pos;
+	io->pos() += angleToVectorXZ(player.angle.getPitch()) * 140.f;
 	
-	io->lastpos = io->initpos = io->pos;
+	io->lastpos = io->initpos = io->pos();
 	io->lastpos.x = io->initpos.x = glm::abs(io->initpos.x / 20) * 20.f;
 	io->lastpos.z = io->initpos.z = glm::abs(io->initpos.z / 20) * 20.f;
 	
 	float tempo;
 	EERIEPOLY * ep;
-	ep = CheckInPoly(io->pos + Vec3f(0.f, player.baseHeight(), 0.f));
-	if(ep && GetTruePolyY(ep, io->pos, &tempo)) {
-		io->lastpos.y = io->initpos.y = io->pos.y = tempo;
+	ep = CheckInPoly(io->pos() + Vec3f(0.f, player.baseHeight(), 0.f));
+	if(ep && GetTruePolyY(ep, io->pos(), &tempo)) {
+		io->lastpos.y = io->initpos.y = io->pos().y = tempo;
 	}
 	
-	ep = CheckInPoly(io->pos);
+	ep = CheckInPoly(io->pos());
 	if(ep) {
-		io->pos.y = std::min(ep->v[0].p.y, ep->v[1].p.y);
-		io->lastpos.y = io->initpos.y = io->pos.y = std::min(io->pos.y, ep->v[2].p.y);
+		io->pos().y = std::min(ep->v[0].p.y, ep->v[1].p.y);
+		io->lastpos.y = io->initpos.y = io->pos().y = std::min(io->pos().y, ep->v[2].p.y);
 	}
 	
-	io->lastpos.y = io->initpos.y = io->pos.y += player.baseHeight();
+	io->lastpos.y = io->initpos.y = io->pos().y += player.baseHeight();
 	
 	io->obj = markerobj;
 	io->ioflags = IO_MARKER;
@@ -1675,23 +1688,23 @@ Entity * AddNPC(const res::path & classPath, EntityInstance instance, AddInterac
 		SendIOScriptEvent(io, SM_LOAD);
 	}
 	
-	io->pos = player.pos;
-	io->pos += angleToVectorXZ(player.angle.getPitch()) * 140.f;
+	io->pos() = player.pos;
+	io->pos() += angleToVectorXZ(player.angle.getPitch()) * 140.f;
 	
-	io->lastpos = io->initpos = io->pos;
+	io->lastpos = io->initpos = io->pos();
 	io->lastpos.x = io->initpos.x = glm::abs(io->initpos.x / 20) * 20.f;
 	io->lastpos.z = io->initpos.z = glm::abs(io->initpos.z / 20) * 20.f;
 	
 	float tempo;
-	EERIEPOLY * ep = CheckInPoly(io->pos + Vec3f(0.f, player.baseHeight(), 0.f));
-	if(ep && GetTruePolyY(ep, io->pos, &tempo)) {
-		io->lastpos.y = io->initpos.y = io->pos.y = tempo; 
+	EERIEPOLY * ep = CheckInPoly(io->pos() + Vec3f(0.f, player.baseHeight(), 0.f));
+	if(ep && GetTruePolyY(ep, io->pos(), &tempo)) {
+		io->lastpos.y = io->initpos.y = io->pos().y = tempo; 
 	}
 	
-	ep = CheckInPoly(io->pos);
+	ep = CheckInPoly(io->pos());
 	if(ep) {
-		io->pos.y = std::min(ep->v[0].p.y, ep->v[1].p.y);
-		io->lastpos.y = io->initpos.y = io->pos.y = std::min(io->pos.y, ep->v[2].p.y);
+		io->pos().y = std::min(ep->v[0].p.y, ep->v[1].p.y);
+		io->lastpos.y = io->initpos.y = io->pos().y = std::min(io->pos().y, ep->v[2].p.y);
 	}
 	
 	if(!io->obj && !(flags & NO_MESH)) {
@@ -1771,27 +1784,27 @@ Entity * AddItem(const res::path & classPath_, EntityInstance instance, AddInter
 	
 	io->spellcast_data.castingspell = SPELL_NONE;
 	
-	io->pos = player.pos;
-	io->pos += angleToVectorXZ(player.angle.getPitch()) * 140.f;
+	io->pos() = player.pos;
+	io->pos() += angleToVectorXZ(player.angle.getPitch()) * 140.f;
 	
-	io->lastpos.x = io->initpos.x = (float)((long)(io->pos.x / 20)) * 20.f;
-	io->lastpos.z = io->initpos.z = (float)((long)(io->pos.z / 20)) * 20.f;
+	io->lastpos.x = io->initpos.x = (float)((long)(io->pos().x / 20)) * 20.f;
+	io->lastpos.z = io->initpos.z = (float)((long)(io->pos().z / 20)) * 20.f;
 
 	EERIEPOLY * ep;
-	ep = CheckInPoly(io->pos + Vec3f(0.f, -60.f, 0.f));
+	ep = CheckInPoly(io->pos() + Vec3f(0.f, -60.f, 0.f));
 
 	if(ep) {
 		float tempo;
 
-		if(GetTruePolyY(ep, io->pos, &tempo))
-			io->lastpos.y = io->initpos.y = io->pos.y = tempo; 
+		if(GetTruePolyY(ep, io->pos(), &tempo))
+			io->lastpos.y = io->initpos.y = io->pos().y = tempo; 
 	}
 
-	ep = CheckInPoly(io->pos);
+	ep = CheckInPoly(io->pos());
 
 	if(ep) {
-		io->pos.y = std::min(ep->v[0].p.y, ep->v[1].p.y);
-		io->lastpos.y = io->initpos.y = io->pos.y = std::min(io->pos.y, ep->v[2].p.y);
+		io->pos().y = std::min(ep->v[0].p.y, ep->v[1].p.y);
+		io->lastpos.y = io->initpos.y = io->pos().y = std::min(io->pos().y, ep->v[2].p.y);
 	}
 
 	if(io->ioflags & IO_GOLD) {
@@ -1876,20 +1889,20 @@ Entity * GetFirstInterAtPos(const Vec2s & pos, long flag, Vec3f * _pRef, Entity
 		if((io->ioflags & IO_CAMERA) || (io->ioflags & IO_MARKER))
 			continue;
 
-		if(!(io->gameFlags & GFLAG_INTERACTIVITY))
+		if(!(io->gameFlags() & GFLAG_INTERACTIVITY))
 			continue;
 
 		// Is Object in TreatZone ??
 		bPlayerEquiped = IsEquipedByPlayer(io);
 
-		if( !((bPlayerEquiped  && (player.Interface & INTER_MAP)) || (io->gameFlags & GFLAG_ISINTREATZONE)) )
+		if( !((bPlayerEquiped  && (player.Interface & INTER_MAP)) || (io->gameFlags() & GFLAG_ISINTREATZONE)) )
 			continue;
 
 		// Is Object Displayed on screen ???
-		if( !((io->show == SHOW_FLAG_IN_SCENE) ||
+		if( !((io->show() == SHOW_FLAG_IN_SCENE) ||
 			  (bPlayerEquiped && flag) ||
 			  (bPlayerEquiped && (player.Interface & INTER_MAP) && (g_guiBookCurrentTopTab == BOOKMODE_STATS))) )
-			//((io->show==9) && (player.Interface & INTER_MAP)) )
+			//((io->show()==9) && (player.Interface & INTER_MAP)) )
 		{
 			continue;
 		}
@@ -1911,11 +1924,11 @@ Entity * GetFirstInterAtPos(const Vec2s & pos, long flag, Vec3f * _pRef, Entity
 
 		if(flag && _pRef) {
 			float flDistanceToRef = glm::distance2(ACTIVECAM->orgTrans.pos, *_pRef);
-			float flDistanceToIO = glm::distance2(ACTIVECAM->orgTrans.pos, io->pos);
+			float flDistanceToIO = glm::distance2(ACTIVECAM->orgTrans.pos, io->pos());
 			bPass = bPlayerEquiped || (flDistanceToIO < flDistanceToRef);
 		}
 
-		float fp = fdist(io->pos, player.pos);
+		float fp = fdist(io->pos(), player.pos);
 
 		if((!flag && fp <= fMaxDist) && (!foundBB || fp < fdistBB)) {
 			fdistBB = fp;
@@ -1926,7 +1939,7 @@ Entity * GetFirstInterAtPos(const Vec2s & pos, long flag, Vec3f * _pRef, Entity
 			if(bPlayerEquiped)
 				fp = 0.f;
 			else
-				fp = fdist(io->pos, player.pos);
+				fp = fdist(io->pos(), player.pos);
 
 			if(fp < fdistBB || !foundBB) {
 				fdistBB = fp;
@@ -1946,7 +1959,7 @@ Entity * GetFirstInterAtPos(const Vec2s & pos, long flag, Vec3f * _pRef, Entity
 					if(bPlayerEquiped)
 						fp = 0.f;
 					else
-						fp = fdist(io->pos, player.pos);
+						fp = fdist(io->pos(), player.pos);
 
 					if((bPass && fp <= fMaxDist) && (fp < _fdist || !foundPixel)) {
 
@@ -1970,7 +1983,7 @@ bool IsEquipedByPlayer(const Entity * io)
 	if(!io)
 		return false;
 
-	if((io->ioflags & IO_ICONIC) && (io->show == SHOW_FLAG_ON_PLAYER))
+	if((io->ioflags & IO_ICONIC) && (io->show() == SHOW_FLAG_ON_PLAYER))
 		return true;
 
 	EntityHandle num = io->index();
@@ -2001,12 +2014,12 @@ Entity * InterClick(const Vec2s & pos) {
 
 	if(io) {
 		if(io->ioflags & IO_NPC) {
-			if(closerThan(player.pos, io->pos, dist_Threshold)) {
+			if(closerThan(player.pos, io->pos(), dist_Threshold)) {
 				return io;
 			}
 		} else if(player.m_telekinesis) {
 			return io;
-		} else if(IsEquipedByPlayer(io) || closerThan(player.pos, io->pos, dist_Threshold)) {
+		} else if(IsEquipedByPlayer(io) || closerThan(player.pos, io->pos(), dist_Threshold)) {
 			return io;
 		}
 	}
@@ -2024,9 +2037,9 @@ EntityHandle IsCollidingAnyInter(const Vec3f & pos, const Vec3f & size) {
 		if(   io
 		   && !(io->ioflags & IO_NO_COLLISIONS)
 		   && (io->collision)
-		   && (io->gameFlags & GFLAG_ISINTREATZONE)
+		   && (io->gameFlags() & GFLAG_ISINTREATZONE)
 		   && ((io->ioflags & IO_NPC) || (io->ioflags & IO_FIX))
-		   && (io->show == SHOW_FLAG_IN_SCENE)
+		   && (io->show() == SHOW_FLAG_IN_SCENE)
 		   && !((io->ioflags & IO_NPC) && io->_npcdata->lifePool.current <= 0.f)
 		) {
 			Vec3f tempPos = pos;
@@ -2052,7 +2065,7 @@ static bool IsCollidingInter(Entity * io, const Vec3f & pos) {
 	if(!io || !io->obj)
 		return false;
 
-	if(closerThan(pos, io->pos, 190.f)) {
+	if(closerThan(pos, io->pos(), 190.f)) {
 		
 		std::vector<EERIE_VERTEX> & vlist = io->obj->vertexlist3;
 
@@ -2100,7 +2113,7 @@ bool ARX_INTERACTIVE_CheckFULLCollision(PHYSICS_BOX_DATA * pbox, Entity * source
 		   || (io->ioflags & (IO_CAMERA | IO_MARKER | IO_ITEM))
 		   || io->usepath
 		   || ((io->ioflags & IO_NPC) && source && (source->ioflags & IO_NO_NPC_COLLIDE))
-		   || !closerThan(io->pos, pbox->vert[0].pos, 600.f)
+		   || !closerThan(io->pos(), pbox->vert[0].pos, 600.f)
 		   || !In3DBBoxTolerance(pbox->vert[0].pos, io->bbox3D, pbox->radius)
 		) {
 			continue;
@@ -2108,7 +2121,7 @@ bool ARX_INTERACTIVE_CheckFULLCollision(PHYSICS_BOX_DATA * pbox, Entity * source
 
 		if((io->ioflags & IO_NPC) && io->_npcdata->lifePool.current > 0.f) {
 			for(long kk = 0; kk < pbox->nb_physvert; kk++)
-				if(PointInCylinder(io->physics.cyl, pbox->vert[kk].pos))
+				if(PointInCylinder(io->physics().cyl, pbox->vert[kk].pos))
 					return true;
 		} else if(io->ioflags & IO_FIX) {
 			size_t step;
@@ -2129,7 +2142,7 @@ bool ARX_INTERACTIVE_CheckFULLCollision(PHYSICS_BOX_DATA * pbox, Entity * source
 
 			std::vector<EERIE_VERTEX> & vlist = io->obj->vertexlist3;
 
-			if(io->gameFlags & GFLAG_PLATFORM) {
+			if(io->gameFlags() & GFLAG_PLATFORM) {
 				for(long kk = 0; kk < pbox->nb_physvert; kk++) {
 					Sphere sphere;
 					sphere.origin = pbox->vert[kk].pos;
@@ -2141,7 +2154,7 @@ bool ARX_INTERACTIVE_CheckFULLCollision(PHYSICS_BOX_DATA * pbox, Entity * source
 					if(maxy <= sphere.origin.y + sphere.radius || miny >= sphere.origin.y) {
 						if(In3DBBoxTolerance(sphere.origin, io->bbox3D, sphere.radius)) {
 							// TODO why ignore the z components?
-							if(closerThan(Vec2f(io->pos.x, io->pos.z), Vec2f(sphere.origin.x, sphere.origin.z), 440.f + sphere.radius)) {
+							if(closerThan(Vec2f(io->pos().x, io->pos().z), Vec2f(sphere.origin.x, sphere.origin.z), 440.f + sphere.radius)) {
 
 								EERIEPOLY ep;
 								ep.type = 0;
@@ -2181,7 +2194,7 @@ bool ARX_INTERACTIVE_CheckFULLCollision(PHYSICS_BOX_DATA * pbox, Entity * source
 
 					for(long kk = 0; kk < pbox->nb_physvert; kk++) {
 						if(sp.contains(pbox->vert[kk].pos)) {
-							if(source && (io->gameFlags & GFLAG_DOOR)) {
+							if(source && (io->gameFlags() & GFLAG_DOOR)) {
 								float elapsed = arxtime.now_f() - io->collide_door_time;
 								if(elapsed > 500) {
 									EVENT_SENDER = source;
@@ -2241,7 +2254,7 @@ void UpdateCameras() {
 				aup->_curtime += elapsed;
 			}
 
-			long last = ARX_PATHS_Interpolate(aup, &io->pos);
+			long last = ARX_PATHS_Interpolate(aup, &io->pos());
 
 			if(aup->lastWP != last) {
 				if(last == -2) {
@@ -2281,16 +2294,16 @@ void UpdateCameras() {
 				}
 			}
 
-			if(io->damager_damages > 0 && io->show == SHOW_FLAG_IN_SCENE) {
+			if(io->damager_damages > 0 && io->show() == SHOW_FLAG_IN_SCENE) {
 				for(size_t i2 = 0; i2 < entities.size(); i2++) {
 					const EntityHandle handle2 = EntityHandle(i2);
 					Entity * io2 = entities[handle2];
 
 					if(io2
 					   && handle2 != handle
-					   && io2->show == SHOW_FLAG_IN_SCENE
+					   && io2->show() == SHOW_FLAG_IN_SCENE
 					   && (io2->ioflags & IO_NPC)
-					   && closerThan(io->pos, io2->pos, 600.f)
+					   && closerThan(io->pos(), io2->pos(), 600.f)
 					) {
 						bool Touched = false;
 
@@ -2305,7 +2318,7 @@ void UpdateCameras() {
 						}
 
 						if(Touched)
-							ARX_DAMAGES_DealDamages(handle2, io->damager_damages, handle, io->damager_type, &io2->pos);
+							ARX_DAMAGES_DealDamages(handle2, io->damager_damages, handle, io->damager_type, &io2->pos());
 					}
 				}
 			}
@@ -2313,7 +2326,7 @@ void UpdateCameras() {
 
 		if(io->ioflags & IO_CAMERA) {
 
-			io->_camdata->cam.orgTrans.pos = io->pos;
+			io->_camdata->cam.orgTrans.pos = io->pos();
 
 			if(io->targetinfo != EntityHandle(TARGET_NONE)) {
 				// Follows target
@@ -2351,7 +2364,7 @@ void UpdateCameras() {
 				io->angle.setRoll(0.f);
 			} else {
 				// no target...
-				io->target = io->pos;
+				io->target = io->pos();
 				io->target += angleToVectorXZ(io->angle.getPitch() + 90) * 20.f;
 				
 				io->_camdata->cam.setTargetCamera(io->target);
@@ -2367,9 +2380,9 @@ void UpdateCameras() {
 void UpdateIOInvisibility(Entity * io)
 {
 	if(io && io->invisibility <= 1.f) {
-		if((io->gameFlags & GFLAG_INVISIBILITY) && io->invisibility < 1.f) {
+		if((io->gameFlags() & GFLAG_INVISIBILITY) && io->invisibility < 1.f) {
 			io->invisibility += g_framedelay * ( 1.0f / 1000 );
-		} else if(!(io->gameFlags & GFLAG_INVISIBILITY) && io->invisibility != 0.f) {
+		} else if(!(io->gameFlags() & GFLAG_INVISIBILITY) && io->invisibility != 0.f) {
 			io->invisibility -= g_framedelay * ( 1.0f / 1000 );
 		}
 		
@@ -2402,8 +2415,8 @@ void UpdateInter() {
 
 		if(   !io
 		   || io == DRAGINTER
-		   || !(io->gameFlags & GFLAG_ISINTREATZONE)
-		   || io->show != SHOW_FLAG_IN_SCENE
+		   || !(io->gameFlags() & GFLAG_ISINTREATZONE)
+		   || io->show() != SHOW_FLAG_IN_SCENE
 		   || (io->ioflags & IO_CAMERA)
 		   || (io->ioflags & IO_MARKER)
 		) {
@@ -2431,7 +2444,7 @@ void UpdateInter() {
 			else
 				diff = static_cast<long>(g_framedelay);
 
-			Vec3f pos = io->pos;
+			Vec3f pos = io->pos();
 
 			if(io->ioflags & IO_NPC) {
 				ComputeVVPos(io);
@@ -2457,8 +2470,8 @@ void RenderInter() {
 
 		if(   !io
 		   || io == DRAGINTER
-		   || !(io->gameFlags & GFLAG_ISINTREATZONE)
-		   || io->show != SHOW_FLAG_IN_SCENE
+		   || !(io->gameFlags() & GFLAG_ISINTREATZONE)
+		   || io->show() != SHOW_FLAG_IN_SCENE
 		   || (io->ioflags & IO_CAMERA)
 		   || (io->ioflags & IO_MARKER)
 		) {
@@ -2475,7 +2488,7 @@ void RenderInter() {
 
 		if(io->animlayer[0].cur_anim) {
 
-			Vec3f pos = io->pos;
+			Vec3f pos = io->pos();
 
 			if(io->ioflags & IO_NPC) {
 				pos.y = io->_npcdata->vvpos;
@@ -2499,7 +2512,7 @@ void RenderInter() {
 						glm::mat4x4 mat = convertToMatrixForDrawEERIEInter(*io->obj->pbox);
 						glm::quat rotation = glm::toQuat(mat);
 						
-						TransformInfo t(io->pos, rotation, io->scale, io->obj->pbox->vert[0].initpos);
+						TransformInfo t(io->pos(), rotation, io->scale, io->obj->pbox->vert[0].initpos);
 
 						float invisibility = Cedric_GetInvisibility(io);
 
@@ -2507,7 +2520,7 @@ void RenderInter() {
 					} else {
 						glm::quat rotation = glm::toQuat(toRotationMatrix(temp));
 						
-						TransformInfo t(io->pos, rotation, io->scale);
+						TransformInfo t(io->pos(), rotation, io->scale);
 
 						float invisibility = Cedric_GetInvisibility(io);
 
@@ -2623,13 +2636,13 @@ void ARX_INTERACTIVE_ActivatePhysics(EntityHandle t)
 	if(ValidIONum(t)) {
 		Entity * io = entities[t];
 
-		if(io == DRAGINTER || (io->show != SHOW_FLAG_IN_SCENE))
+		if(io == DRAGINTER || (io->show() != SHOW_FLAG_IN_SCENE))
 			return;
 
 		float yy;
-		EERIEPOLY * ep = CheckInPoly(io->pos, &yy);
+		EERIEPOLY * ep = CheckInPoly(io->pos(), &yy);
 
-		if(ep && (yy - io->pos.y < 10.f))
+		if(ep && (yy - io->pos().y < 10.f))
 			return;
 
 		io->obj->pbox->active = 1;
@@ -2637,10 +2650,10 @@ void ARX_INTERACTIVE_ActivatePhysics(EntityHandle t)
 		io->velocity = Vec3f_ZERO;
 		io->stopped = 1;
 		Vec3f fallvector = Vec3f(0.0f, 0.000001f, 0.f);
-		io->show = SHOW_FLAG_IN_SCENE;
+		io->show() = SHOW_FLAG_IN_SCENE;
 		io->soundtime = 0;
 		io->soundcount = 0;
-		EERIE_PHYSICS_BOX_Launch(io->obj, io->pos, io->angle, fallvector);
+		EERIE_PHYSICS_BOX_Launch(io->obj, io->pos(), io->angle, fallvector);
 	}
 }
 
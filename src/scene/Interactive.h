@@ -109,7 +109,7 @@ void ARX_INTERACTIVE_DestroyIOdelayedExecute();
  * ValidIONum and ValidIOAddress are fundamentally flawed and vulnerable to
  * index / address aliasing as both indices and memory addresses can be reused.
  *
- * We should instead use a proper weak pointer!
+ * New code should store an EntityRef and resolve it with EntityManager::get() instead.
  */
 bool ValidIONum(EntityHandle num);
 bool ValidIOAddress(const Entity * io);
@@ -159,6 +159,7 @@ void IO_UnlinkAllLinkedObjects(Entity * io);
 
 struct TREATZONE_IO {
 	Entity * io;
+	EntityHandle handle; //!< Index of the entity's hot data in the EntityManager
 	EntityFlags ioflags;
 	long show;
 };
@@ -0,0 +1,267 @@
+/*
+ * Copyright 2016 Arx Libertatis Team (see the AUTHORS file)
+ *
+ * This file is part of Arx Libertatis.
+ *
+ * Arx Libertatis is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Arx Libertatis is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Arx Libertatis.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "scene/LevelLoader.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "graphics/data/Mesh.h"
+#include "gui/LoadLevelScreen.h"
+#include "io/Blast.h"
+#include "io/log/Logger.h"
+#include "io/resource/PakReader.h"
+#include "util/String.h"
+
+namespace {
+
+//! Maximum amount of decompressed level data to keep for a prefetched level
+static const size_t LEVEL_PREFETCH_BUDGET = 128 * 1024 * 1024;
+
+static LevelLoader * g_prefetchedLevel = NULL;
+
+//! Decompress a level or lighting file body
+static bool decompress(const char * data, size_t size, std::vector<char> & buffer) {
+	
+	size_t outSize = 0;
+	char * out = blastMemAlloc(data, size, outSize);
+	if(!out) {
+		return false;
+	}
+	
+	buffer.assign(out, out + outSize);
+	free(out);
+	
+	return true;
+}
+	
+} // anonymous namespace
+
+LevelLoader::LevelLoader(const res::path & file)
+	: m_file(file)
+	, m_hasHeader(false)
+	, m_stage(LoadLevelFile)
+	, m_prefetch(false)
+	, m_discarded(false)
+{
+	memset(&m_header, 0, sizeof(DANAE_LS_HEADER));
+	setThreadName("Level Loader");
+}
+
+LevelLoader::~LevelLoader() {
+	waitForCompletion();
+}
+
+bool LevelLoader::isDone(Stage stage) {
+	Autolock lock(m_lock);
+	return m_stage > stage;
+}
+
+void LevelLoader::waitFor(Stage stage) {
+	while(!isDone(stage)) {
+		LoadLevelScreen();
+		Thread::sleep(1);
+	}
+}
+
+void LevelLoader::finish(Stage stage) {
+	Autolock lock(m_lock);
+	m_stage = Stage(stage + 1);
+}
+
+void LevelLoader::run() {
+	
+	loadLevel();
+	if(!checkBudget()) {
+		return;
+	}
+	finish(LoadLevelFile);
+	
+	loadScene();
+	if(!checkBudget()) {
+		return;
+	}
+	finish(LoadSceneFile);
+	
+	loadLighting();
+	if(!checkBudget()) {
+		return;
+	}
+	finish(LoadLightingFile);
+}
+
+bool LevelLoader::checkBudget() {
+	
+	Autolock lock(m_lock);
+	
+	if(!m_prefetch || (!m_discarded && getMemoryUsage() <= LEVEL_PREFETCH_BUDGET)) {
+		return true;
+	}
+	
+	LogDebug("discarding prefetched level " << m_file);
+	
+	std::vector<char>().swap(m_level);
+	std::vector<char>().swap(m_sceneData);
+	std::vector<char>().swap(m_lighting);
+	
+	m_discarded = true;
+	m_stage = LoadDone;
+	
+	return false;
+}
+
+size_t LevelLoader::getMemoryUsage() const {
+	return m_level.size() + m_sceneData.size() + m_lighting.size();
+}
+
+void LevelLoader::prefetch(const res::path & file) {
+	
+	if(g_prefetchedLevel && g_prefetchedLevel->getFile() == file) {
+		return;
+	}
+	
+	clearPrefetch();
+	
+	LogDebug("prefetching level " << file);
+	
+	g_prefetchedLevel = new LevelLoader(file);
+	g_prefetchedLevel->m_prefetch = true;
+	g_prefetchedLevel->setPriority(Low);
+	g_prefetchedLevel->start();
+}
+
+LevelLoader * LevelLoader::acquire(const res::path & file) {
+	
+	if(g_prefetchedLevel && g_prefetchedLevel->getFile() == file) {
+		
+		LevelLoader * loader = g_prefetchedLevel;
+		g_prefetchedLevel = NULL;
+		
+		bool discarded;
+		{
+			Autolock lock(loader->m_lock);
+			loader->m_prefetch = false;
+			discarded = loader->m_discarded;
+		}
+		
+		if(!discarded) {
+			LogDebug("using prefetched level " << file);
+			loader->setPriority(Normal);
+			return loader;
+		}
+		
+		delete loader;
+	}
+	
+	LevelLoader * loader = new LevelLoader(file);
+	loader->start();
+	
+	return loader;
+}
+
+void LevelLoader::clearPrefetch() {
+	
+	if(!g_prefetchedLevel) {
+		return;
+	}
+	
+	// Skip any remaining files
+	{
+		Autolock lock(g_prefetchedLevel->m_lock);
+		g_prefetchedLevel->m_discarded = true;
+	}
+	
+	delete g_prefetchedLevel, g_prefetchedLevel = NULL;
+}
+
+void LevelLoader::loadLevel() {
+	
+	size_t size = 0;
+	char * dat = resources->readAlloc(m_file, size);
+	if(!dat) {
+		return;
+	}
+	
+	if(size < sizeof(DANAE_LS_HEADER)) {
+		LogError << "Truncated level file " << m_file;
+		free(dat);
+		return;
+	}
+	
+	memcpy(&m_header, dat, sizeof(DANAE_LS_HEADER));
+	m_hasHeader = true;
+	
+	const char * body = dat + sizeof(DANAE_LS_HEADER);
+	size_t bodySize = size - sizeof(DANAE_LS_HEADER);
+	
+	if(m_header.version > DLH_CURRENT_VERSION) {
+		// Reported by DanaeLoadLevel()
+	} else if(m_header.version >= 1.44f) {
+		// using compression
+		if(!decompress(body, bodySize, m_level)) {
+			m_level.clear();
+		}
+	} else {
+		m_level.assign(body, body + bodySize);
+	}
+	
+	free(dat);
+}
+
+void LevelLoader::loadScene() {
+	
+	if(m_level.size() < sizeof(DANAE_LS_SCENE) || m_header.nb_scn <= 0) {
+		return;
+	}
+	
+	const DANAE_LS_SCENE * dls = reinterpret_cast<const DANAE_LS_SCENE *>(&m_level[0]);
+	m_scene = res::path::load(util::loadString(dls->name));
+	
+	if(!FastSceneRead(m_scene, m_sceneData)) {
+		m_sceneData.clear();
+	}
+}
+
+void LevelLoader::loadLighting() {
+	
+	if(m_level.empty()) {
+		return;
+	}
+	
+	PakFile * lightingFile = resources->getFile(res::path(m_file).set_ext("llf"));
+	if(!lightingFile) {
+		return;
+	}
+	
+	char * dat = lightingFile->readAlloc();
+	if(!dat) {
+		return;
+	}
+	
+	if(m_header.version >= 1.44f) {
+		// using compression
+		if(!decompress(dat, lightingFile->size(), m_lighting)) {
+			m_lighting.clear();
+		}
+	} else {
+		m_lighting.assign(dat, dat + lightingFile->size());
+	}
+	
+	free(dat);
+}
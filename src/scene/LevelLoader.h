@@ -0,0 +1,138 @@
+/*
+ * Copyright 2016 Arx Libertatis Team (see the AUTHORS file)
+ *
+ * This file is part of Arx Libertatis.
+ *
+ * Arx Libertatis is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Arx Libertatis is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Arx Libertatis.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARX_SCENE_LEVELLOADER_H
+#define ARX_SCENE_LEVELLOADER_H
+
+#include <vector>
+
+#include "io/resource/ResourcePath.h"
+#include "platform/Lock.h"
+#include "platform/Thread.h"
+#include "scene/LevelFormat.h"
+
+/*!
+ * Reads and decompresses the files of a level in a background thread.
+ *
+ * The level (.dlf), scene (.fts) and lighting (.llf) files are loaded one after the other
+ * so that the main thread can already process each file while the next one is still
+ * being read and decompressed.
+ *
+ * Data for a stage must not be accessed before \ref isDone() returns true for that stage.
+ *
+ * Levels can also be prefetched during play so that a following level change does not
+ * need to wait for the files.
+ */
+class LevelLoader : public Thread {
+	
+public:
+	
+	enum Stage {
+		LoadLevelFile,
+		LoadSceneFile,
+		LoadLightingFile,
+		LoadDone
+	};
+	
+	//! The loader must be started with \ref start()
+	explicit LevelLoader(const res::path & file);
+	
+	//! Wait for the background thread to finish
+	~LevelLoader();
+	
+	const res::path & getFile() const { return m_file; }
+	
+	//! \return true if the given stage and all stages before it have completed
+	bool isDone(Stage stage);
+	
+	/*!
+	 * Wait until the given stage and all stages before it have completed.
+	 * The load screen is kept updated while waiting.
+	 */
+	void waitFor(Stage stage);
+	
+	//! \return true if the level file header could be read
+	bool hasHeader() const { return m_hasHeader; }
+	const DANAE_LS_HEADER & getHeader() const { return m_header; }
+	
+	//! Decompressed level data following the header or empty on error
+	const std::vector<char> & getLevelData() const { return m_level; }
+	
+	//! Scene directory referenced by the level or empty if there is none
+	const res::path & getScene() const { return m_scene; }
+	
+	//! Decompressed scene data or empty on error
+	const std::vector<char> & getSceneData() const { return m_sceneData; }
+	
+	//! Decompressed lighting data or empty if there is none
+	const std::vector<char> & getLightingData() const { return m_lighting; }
+	
+	/*!
+	 * Start loading a level in the background before it is needed.
+	 *
+	 * Only one level is prefetched at a time - prefetching a different level discards
+	 * the previous one. Prefetched data that does not fit into the prefetch memory
+	 * budget is discarded.
+	 */
+	static void prefetch(const res::path & file);
+	
+	/*!
+	 * Get a started loader for a level.
+	 * This takes over the prefetched loader if there is one for the same level.
+	 * \return a loader to be deleted by the caller
+	 */
+	static LevelLoader * acquire(const res::path & file);
+	
+	//! Discard any prefetched level
+	static void clearPrefetch();
+	
+private:
+	
+	void run();
+	
+	//! \return false if the loader is prefetching and its data has been discarded
+	bool checkBudget();
+	
+	size_t getMemoryUsage() const;
+	
+	void loadLevel();
+	void loadScene();
+	void loadLighting();
+	
+	void finish(Stage stage);
+	
+	res::path m_file;
+	
+	bool m_hasHeader;
+	DANAE_LS_HEADER m_header;
+	std::vector<char> m_level;
+	
+	res::path m_scene;
+	std::vector<char> m_sceneData;
+	
+	std::vector<char> m_lighting;
+	
+	Lock m_lock;
+	Stage m_stage; //!< First stage that has not completed yet
+	bool m_prefetch; //!< The level has not been requested yet
+	bool m_discarded; //!< The prefetched data is no longer needed or exceeded the budget
+	
+};
+
+#endif // ARX_SCENE_LEVELLOADER_H
@@ -52,6 +52,7 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include <sstream>
 
 #include <boost/algorithm/string/case_conv.hpp>
+#include <boost/smart_ptr/scoped_ptr.hpp>
 
 #include "ai/PathFinderManager.h"
 #include "ai/Paths.h"
@@ -92,6 +93,7 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include "scene/GameSound.h"
 #include "scene/Interactive.h"
 #include "scene/LevelFormat.h"
+#include "scene/LevelLoader.h"
 #include "scene/Light.h"
 
 #include "util/String.h"
@@ -451,8 +453,8 @@ Entity * LoadInter_Ex(const res::path & classPath, EntityInstance instance,
 	RestoreInitialIOStatusOfIO(io);
 	ARX_INTERACTIVE_HideGore(io);
 	
-	io->lastpos = io->initpos = io->pos = pos + trans;
-	io->move = Vec3f_ZERO;
+	io->lastpos = io->initpos = io->pos() = pos + trans;
+	io->move() = Vec3f_ZERO;
 	io->initangle = io->angle = angle;
 	
 	res::path tmp = io->instancePath(); // Get the directory name to check for
@@ -496,46 +498,39 @@ bool DanaeLoadLevel(const res::path & file, bool loadEntities) {
 
 	LogDebug("fic2 " << lightingFileName);
 	LogDebug("fileDlf " << file);
-
-	size_t FileSize = 0;
-	char * dat = resources->readAlloc(file, FileSize);
-	if(!dat) {
+	
+	// Read and decompress the level files in the background while this thread
+	// processes the parts that have already been loaded - unless they were prefetched
+	boost::scoped_ptr<LevelLoader> loader(LevelLoader::acquire(file));
+	
+	PakFile * lightingFile = resources->getFile(lightingFileName);
+	
+	loader->waitFor(LevelLoader::LoadLevelFile);
+	if(!loader->hasHeader()) {
 		LogError << "Unable to find " << file;
 		return false;
 	}
 	
-	PakFile * lightingFile = resources->getFile(lightingFileName);
-	
 	progressBarAdvance();
 	LoadLevelScreen();
 	
-	size_t pos = 0;
-	
-	DANAE_LS_HEADER dlh;
-	memcpy(&dlh, dat + pos, sizeof(DANAE_LS_HEADER));
-	pos += sizeof(DANAE_LS_HEADER);
+	const DANAE_LS_HEADER & dlh = loader->getHeader();
 	
 	LogDebug("dlh.version " << dlh.version << " header size " << sizeof(DANAE_LS_HEADER));
 	
 	if(dlh.version > DLH_CURRENT_VERSION) {
 		LogError << "Unexpected level file version: " << dlh.version << " for " << file;
-		free(dat);
-		dat = NULL;
 		return false;
 	}
 	
-	// using compression
-	if(dlh.version >= 1.44f) {
-		char * torelease = dat;
-		dat = blastMemAlloc(dat + pos, FileSize - pos, FileSize);
-		free(torelease);
-		pos = 0;
-		if(!dat) {
-			LogError << "Could not decompress level file " << file;
-			return false;
-		}
+	if(loader->getLevelData().empty()) {
+		LogError << "Could not decompress level file " << file;
+		return false;
 	}
 	
+	const char * dat = &loader->getLevelData()[0];
+	size_t pos = 0;
+	
 	g_loddpos = dlh.pos_edit.toVec3();
 	player.desiredangle = player.angle = dlh.angle_edit;
 	
@@ -552,12 +547,15 @@ bool DanaeLoadLevel(const res::path & file, bool loadEntities) {
 	// Loading Scene
 	if(dlh.nb_scn > 0) {
 		
-		const DANAE_LS_SCENE * dls = reinterpret_cast<const DANAE_LS_SCENE *>(dat + pos);
 		pos += sizeof(DANAE_LS_SCENE);
 		
-		res::path scene = res::path::load(util::loadString(dls->name));
+		loader->waitFor(LevelLoader::LoadSceneFile);
+		progressBarAdvance(4.f);
+		LoadLevelScreen();
+		
+		const res::path & scene = loader->getScene();
 		
-		if(FastSceneLoad(scene)) {
+		if(!loader->getSceneData().empty() && FastSceneLoad(scene, loader->getSceneData())) {
 			LogDebug("done loading scene");
 			FASTmse = true;
 		} else {
@@ -570,9 +568,9 @@ bool DanaeLoadLevel(const res::path & file, bool loadEntities) {
 #else
 			LogError << "Fast loading scene failed";
 #endif
+			EERIEPOLY_Compute_PolyIn();
 		}
 		
-		EERIEPOLY_Compute_PolyIn();
 		LastLoadedScene = scene;
 	}
 	
@@ -816,22 +814,18 @@ bool DanaeLoadLevel(const res::path & file, bool loadEntities) {
 	
 	//Now LOAD Separate LLF Lighting File
 	
-	free(dat);
 	pos = 0;
 	dat = NULL;
+	size_t FileSize = 0;
 	
 	if(lightingFile) {
 		
 		LogDebug("Loading LLF Info");
 		
-		// using compression
-		if(dlh.version >= 1.44f) {
-			char * compressed = lightingFile->readAlloc();
-			dat = (char*)blastMemAlloc(compressed, lightingFile->size(), FileSize);
-			free(compressed);
-		} else {
-			dat = lightingFile->readAlloc();
-			FileSize = lightingFile->size();
+		loader->waitFor(LevelLoader::LoadLightingFile);
+		if(!loader->getLightingData().empty()) {
+			dat = &loader->getLightingData()[0];
+			FileSize = loader->getLightingData().size();
 		}
 	}
 	// TODO size ignored
@@ -844,7 +838,7 @@ bool DanaeLoadLevel(const res::path & file, bool loadEntities) {
 		return true;
 	}
 	
-	const DANAE_LLF_HEADER * llh = reinterpret_cast<DANAE_LLF_HEADER *>(dat + pos);
+	const DANAE_LLF_HEADER * llh = reinterpret_cast<const DANAE_LLF_HEADER *>(dat + pos);
 	pos += sizeof(DANAE_LLF_HEADER);
 	
 	progressBarAdvance(4.f);
@@ -930,8 +924,6 @@ bool DanaeLoadLevel(const res::path & file, bool loadEntities) {
 	ARX_UNUSED(pos), ARX_UNUSED(FileSize);
 	arx_assert(pos <= FileSize);
 	
-	free(dat);
-	
 	progressBarAdvance();
 	LoadLevelScreen();
 	
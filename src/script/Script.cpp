@@ -51,10 +51,12 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include <sstream>
 #include <cstdio>
 #include <algorithm>
+#include <functional>
 #include <limits>
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/foreach.hpp>
+#include <boost/unordered_map.hpp>
 
 #include "ai/Paths.h"
 
@@ -79,12 +81,14 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #include "io/resource/PakReader.h"
 #include "io/log/Logger.h"
 
+#include "platform/Time.h"
 #include "platform/profiler/Profiler.h"
 
 #include "scene/Scene.h"
 #include "scene/Interactive.h"
 
 #include "script/ScriptEvent.h"
+#include "script/ScriptProfiler.h"
 
 
 #define MAX_SSEPARAMS 5
@@ -103,35 +107,104 @@ long ActiveTimers = 0;
 
 long FindScriptPos(const EERIE_SCRIPT * es, const std::string & str) {
 	
-	// TODO(script-parser) remove, respect quoted strings
+	EERIE_SCRIPT::Positions::const_iterator it = es->positions.find(str);
 	
-	const char * start = es->data;
-	const char * end = es->data + es->size;
+	return (it != es->positions.end()) ? it->second : -1;
+}
+
+static bool isScriptWhitespace(char c) {
+	return (unsigned char)c <= 32;
+}
+
+static bool isScriptComment(const char * data, size_t size, size_t pos) {
+	return pos + 1 < size && data[pos] == '/' && data[pos + 1] == '/';
+}
+
+//! Record the positions of all event handlers and labels, ignoring comments and quoted strings
+static void ARX_SCRIPT_ComputePositions(EERIE_SCRIPT & es) {
+	
+	es.positions.clear();
 	
-	while(true) {
+	const char * data = es.data;
+	size_t size = es.size;
+	
+	size_t pos = 0;
+	while(pos < size) {
 		
-		const char * dat = std::search(start, end, str.begin(), str.end());
-		if(dat + str.length() >= end) {
-			return -1;
+		if(isScriptWhitespace(data[pos])) {
+			pos++;
+			continue;
 		}
 		
-		start = dat + 1;
-		if(((unsigned char)dat[str.length()]) > 32) {
+		if(isScriptComment(data, size, pos)) {
+			while(pos < size && data[pos] != '\n') {
+				pos++;
+			}
 			continue;
 		}
 		
-		// Check if the line is commented out!
-		for(const char * search = dat; search[0] != '/' || search[1] != '/'; search--) {
-			if(*search == '\n' || search == es->data) {
-				return dat - es->data;
+		// Find the end of the current word
+		size_t start = pos;
+		while(pos < size && !isScriptWhitespace(data[pos]) && !isScriptComment(data, size, pos)) {
+			if(data[pos] == '"') {
+				// Quoted strings end at the closing quote or at the end of the line
+				do {
+					pos++;
+				} while(pos < size && data[pos] != '"' && data[pos] != '\n');
+				if(pos < size && data[pos] == '"') {
+					pos++;
+				}
+			} else {
+				pos++;
 			}
 		}
 		
+		// Earlier definitions take precedence over later ones
+		if(pos - start > 2 && data[start] == '>' && data[start + 1] == '>') {
+			std::string label(data + start, pos - start);
+			es.positions.insert(EERIE_SCRIPT::Positions::value_type(label, long(start)));
+		} else if(pos - start == 2 && data[start] == 'o' && data[start + 1] == 'n'
+		          && pos + 1 < size && data[pos] == ' ' && !isScriptWhitespace(data[pos + 1])) {
+			size_t end = pos + 1;
+			while(end < size && !isScriptWhitespace(data[end])) {
+				end++;
+			}
+			std::string event(data + start, end - start);
+			es.positions.insert(EERIE_SCRIPT::Positions::value_type(event, long(start)));
+		}
+		
 	}
 	
-	return -1;
 }
 
+namespace {
+
+bool hasEventHandler(const EERIE_SCRIPT & es, ScriptMessage msg) {
+	if(!es.data) {
+		return false;
+	}
+	if(size_t(msg) < MAX_SHORTCUT) {
+		return es.shortcut[msg] >= 0;
+	}
+	return true;
+}
+
+//! Same as SendIOScriptEvent() for an entity without a handler for the message
+ScriptResult SendUnhandledIOScriptEvent(Entity * io, ScriptMessage msg) {
+	
+	if(!io->over_script.data) {
+		return ScriptEvent::sendUnhandled(&io->script, msg, io);
+	}
+	
+	if(ScriptEvent::sendUnhandled(&io->over_script, msg, io) == REFUSE) {
+		return REFUSE;
+	}
+	
+	return ScriptEvent::sendUnhandled(&io->script, msg, io);
+}
+
+} // anonymous namespace
+
 ScriptResult SendMsgToAllIO(ScriptMessage msg, const std::string & params) {
 	
 	ScriptResult ret = ACCEPT;
@@ -141,7 +214,17 @@ ScriptResult SendMsgToAllIO(ScriptMessage msg, const std::string & params) {
 		Entity * e = entities[handle];
 		
 		if(e) {
-			if(SendIOScriptEvent(e, msg, params) == REFUSE) {
+			
+			// Only run scripts that actually handle the message - the others can still refuse it
+			ScriptResult res;
+			if(msg == SM_INIT || msg == SM_INITEND
+			   || hasEventHandler(e->script, msg) || hasEventHandler(e->over_script, msg)) {
+				res = SendIOScriptEvent(e, msg, params);
+			} else {
+				res = SendUnhandledIOScriptEvent(e, msg);
+			}
+			
+			if(res == REFUSE) {
 				ret = REFUSE;
 			}
 		}
@@ -197,7 +280,7 @@ void ARX_SCRIPT_ResetObject(Entity * io, bool init) {
 	}
 	
 	if(entities[num])
-		entities[num]->gameFlags &= ~GFLAG_NEEDINIT;
+		entities[num]->gameFlags() &= ~GFLAG_NEEDINIT;
 	
 }
 
@@ -248,7 +331,7 @@ void ARX_SCRIPT_AllowInterScriptExec() {
 			return;
 		}
 		
-		if(entities[i] == NULL || !(entities[i]->gameFlags & GFLAG_ISINTREATZONE)) {
+		if(entities[i] == NULL || !(entities[i]->gameFlags() & GFLAG_ISINTREATZONE)) {
 			continue;
 		}
 		
@@ -288,10 +371,13 @@ void ReleaseScript(EERIE_SCRIPT * es) {
 	
 	es->lvar.clear();
 	
+	script::forgetProfileSites(es->data);
 	free(es->data);
 	es->data = NULL;
 	
 	ARX_SCRIPT_ReleaseLabels(es);
+	es->positions.clear();
+	es->tokens.clear();
 	memset(es->shortcut, 0, sizeof(long) * MAX_SHORTCUT);
 }
 
@@ -350,7 +436,7 @@ ValueType getSystemVar(const EERIE_SCRIPT * es, Entity * entity, const std::stri
 			
 			if(name == "^&playerdist") {
 				if(entity) {
-					*fcontent = fdist(player.pos, entity->pos);
+					*fcontent = fdist(player.pos, entity->pos());
 					return TYPE_FLOAT;
 				}
 			}
@@ -362,7 +448,7 @@ ValueType getSystemVar(const EERIE_SCRIPT * es, Entity * entity, const std::stri
 			
 			if(name == "^#playerdist") {
 				if(entity) {
-					*lcontent = (long)fdist(player.pos, entity->pos);
+					*lcontent = (long)fdist(player.pos, entity->pos());
 					return TYPE_LONG;
 				}
 			}
@@ -520,16 +606,16 @@ ValueType getSystemVar(const EERIE_SCRIPT * es, Entity * entity, const std::stri
 							UpdateIORoom(entity);
 						}
 						long Player_Room = ARX_PORTALS_GetRoomNumForPosition(player.pos, 1);
-						*fcontent = SP_GetRoomDist(entity->pos, player.pos, entity->room, Player_Room);
+						*fcontent = SP_GetRoomDist(entity->pos(), player.pos, entity->room, Player_Room);
 						return TYPE_FLOAT;
 					}
 					
 					EntityHandle t = entities.getById(obj);
 					if(ValidIONum(t)) {
-						if((entity->show == SHOW_FLAG_IN_SCENE
-						    || entity->show == SHOW_FLAG_IN_INVENTORY)
-						   && (entities[t]->show == SHOW_FLAG_IN_SCENE
-						       || entities[t]->show == SHOW_FLAG_IN_INVENTORY)) {
+						if((entity->show() == SHOW_FLAG_IN_SCENE
+						    || entity->show() == SHOW_FLAG_IN_INVENTORY)
+						   && (entities[t]->show() == SHOW_FLAG_IN_SCENE
+						       || entities[t]->show() == SHOW_FLAG_IN_INVENTORY)) {
 							
 							Vec3f pos  = GetItemWorldPosition(entity);
 							Vec3f pos2 = GetItemWorldPosition(entities[t]);
@@ -636,7 +722,7 @@ ValueType getSystemVar(const EERIE_SCRIPT * es, Entity * entity, const std::stri
 				ARX_PATH * ap = ARX_PATH_GetAddressByName(zone);
 				*lcontent = 0;
 				if(entity && ap) {
-					if(ARX_PATH_IsPosInZone(ap, entity->pos)) {
+					if(ARX_PATH_IsPosInZone(ap, entity->pos())) {
 						*lcontent = 1;
 					}
 				}
@@ -834,16 +920,16 @@ ValueType getSystemVar(const EERIE_SCRIPT * es, Entity * entity, const std::stri
 					const char * obj = name.c_str() + 6;
 					
 					if(!strcmp(obj, "player")) {
-						*fcontent = fdist(player.pos, entity->pos);
+						*fcontent = fdist(player.pos, entity->pos());
 						return TYPE_FLOAT;
 					}
 					
 					EntityHandle t = entities.getById(obj);
 					if(ValidIONum(t)) {
-						if((entity->show == SHOW_FLAG_IN_SCENE
-						    || entity->show == SHOW_FLAG_IN_INVENTORY)
-						   && (entities[t]->show == SHOW_FLAG_IN_SCENE
-						       || entities[t]->show == SHOW_FLAG_IN_INVENTORY)) {
+						if((entity->show() == SHOW_FLAG_IN_SCENE
+						    || entity->show() == SHOW_FLAG_IN_INVENTORY)
+						   && (entities[t]->show() == SHOW_FLAG_IN_SCENE
+						       || entities[t]->show() == SHOW_FLAG_IN_INVENTORY)) {
 							Vec3f pos  = GetItemWorldPosition(entity);
 							Vec3f pos2 = GetItemWorldPosition(entities[t]);
 							*fcontent = fdist(pos, pos2);
@@ -1120,37 +1206,68 @@ void CloneLocalVars(Entity * ioo, Entity * io) {
 	ioo->script.lvar = io->script.lvar;
 }
 
-static SCRIPT_VAR * GetFreeVarSlot(SCRIPT_VARIABLES& _svff) {
-	_svff.resize(_svff.size() + 1);
-	SCRIPT_VAR * v = &_svff.back();
-	return v;
+void SCRIPT_VARIABLES::updateIndex() const {
+	
+	if(!m_indexDirty) {
+		return;
+	}
+	
+	m_index.clear();
+	for(size_t i = 0; i < m_variables.size(); i++) {
+		// Prefer the first typed variable, same as a linear search would
+		std::pair<Index::iterator, bool> entry = m_index.insert(Index::value_type(m_variables[i].name, i));
+		if(!entry.second && m_variables[entry.first->second].type == TYPE_UNKNOWN) {
+			entry.first->second = i;
+		}
+	}
+	
+	m_indexDirty = false;
 }
 
-static SCRIPT_VAR * GetVarAddress(SCRIPT_VARIABLES & svf, const std::string & name) {
+const SCRIPT_VAR * SCRIPT_VARIABLES::find(const std::string & name) const {
 	
-	for(SCRIPT_VARIABLES::iterator it = svf.begin(); it != svf.end(); ++it) {
-		if(it->type != TYPE_UNKNOWN) {
-			if(name == it->name) {
-				return &(*it);
-			}
-		}
+	updateIndex();
+	
+	Index::const_iterator it = m_index.find(name);
+	if(it == m_index.end()) {
+		return NULL;
+	}
+	
+	const SCRIPT_VAR & var = m_variables[it->second];
+	if(var.type == TYPE_UNKNOWN) {
+		return NULL;
 	}
+	
+	return &var;
+}
 
-	return NULL;
+SCRIPT_VAR * SCRIPT_VARIABLES::find(const std::string & name) {
+	return const_cast<SCRIPT_VAR *>(static_cast<const SCRIPT_VARIABLES *>(this)->find(name));
 }
 
-static const SCRIPT_VAR * GetVarAddress(const SCRIPT_VARIABLES & svf,
-                                        const std::string & name) {
+SCRIPT_VAR * SCRIPT_VARIABLES::add(const std::string & name) {
 	
-	for(SCRIPT_VARIABLES::const_iterator it = svf.begin(); it != svf.end(); ++it) {
-		if(it->type != TYPE_UNKNOWN) {
-			if(name == it->name) {
-				return &(*it);
-			}
-		}
+	updateIndex();
+	
+	size_t index = m_variables.size();
+	m_variables.resize(index + 1);
+	m_variables[index].name = name;
+	
+	std::pair<Index::iterator, bool> entry = m_index.insert(Index::value_type(name, index));
+	if(!entry.second && m_variables[entry.first->second].type == TYPE_UNKNOWN) {
+		entry.first->second = index;
 	}
+	
+	return &m_variables[index];
+}
 
-	return NULL;
+static SCRIPT_VAR * GetVarAddress(SCRIPT_VARIABLES & svf, const std::string & name) {
+	return svf.find(name);
+}
+
+static const SCRIPT_VAR * GetVarAddress(const SCRIPT_VARIABLES & svf,
+                                        const std::string & name) {
+	return svf.find(name);
 }
 
 long GETVarValueLong(const SCRIPT_VARIABLES& svf, const std::string & name) {
@@ -1282,14 +1399,8 @@ SCRIPT_VAR* SETVarValueLong(SCRIPT_VARIABLES& svf, const std::string& name, long
 {
 	SCRIPT_VAR* tsv = GetVarAddress(svf, name);
 
-	if (!tsv)
-	{
-		tsv = GetFreeVarSlot(svf);
-
-		if (!tsv)
-			return NULL;
-
-		tsv->name = name;
+	if(!tsv) {
+		tsv = svf.add(name);
 	}
 
 	tsv->ival = val;
@@ -1300,14 +1411,8 @@ SCRIPT_VAR* SETVarValueFloat(SCRIPT_VARIABLES& svf, const std::string& name, flo
 {
 	SCRIPT_VAR* tsv = GetVarAddress(svf, name);
 
-	if (!tsv)
-	{
-		tsv = GetFreeVarSlot(svf);
-
-		if (!tsv)
-			return NULL;
-
-		tsv->name = name;
+	if(!tsv) {
+		tsv = svf.add(name);
 	}
 
 	tsv->fval = val;
@@ -1318,14 +1423,8 @@ SCRIPT_VAR* SETVarValueText(SCRIPT_VARIABLES& svf, const std::string& name, cons
 {
 	SCRIPT_VAR* tsv = GetVarAddress(svf, name);
 
-	if (!tsv)
-	{
-		tsv = GetFreeVarSlot(svf);
-
-		if (!tsv)
-			return NULL;
-
-		tsv->name = name.c_str();
+	if(!tsv) {
+		tsv = svf.add(name);
 	}
 	
 	tsv->text = val;
@@ -1456,16 +1555,17 @@ void MakeSSEPARAMS(const char * params)
 struct QueuedEvent {
 	
 	bool          exists;
-	Entity *      sender;
-	Entity *      entity;
+	EntityRef     sender;
+	EntityRef     entity;
 	ScriptMessage msg;
 	std::string   params;
 	std::string   eventname;
+	size_t        next; //!< Sequence number of the next queued event for the same entity
 	
 	void clear() {
 		exists = false;
-		sender = NULL;
-		entity = NULL;
+		sender = EntityRef();
+		entity = EntityRef();
 		msg = SM_NULL;
 		params.clear();
 		eventname.clear();
@@ -1473,57 +1573,166 @@ struct QueuedEvent {
 	
 };
 
-// TODO use a queue
-static QueuedEvent g_eventQueue[800];
+namespace {
+
+const size_t NoEvent = size_t(-1);
+const size_t InitialEventQueueSize = 1024;
+const size_t MaxEventQueueSize = 65536;
+
+//! Queued events for one entity index, linked through QueuedEvent::next
+struct QueuedEventList {
+	
+	size_t first;
+	size_t last;
+	
+	QueuedEventList() : first(NoEvent), last(NoEvent) { }
+	
+};
+
+/*!
+ * FIFO ring buffer of events - the size is always a power of two.
+ *
+ * Events are identified by a sequence number that is incremented for every queued
+ * event and stays valid when the buffer grows.
+ */
+std::vector<QueuedEvent> g_eventQueue;
+size_t g_eventQueueBegin = 0; //!< Sequence number of the oldest queued event
+size_t g_eventQueueEnd = 0; //!< Sequence number for the next queued event
+
+//! Indexed by entity index
+std::vector<QueuedEventList> g_entityEvents;
+
+ScriptEventQueueStats g_eventQueueStats;
+
+QueuedEvent & getQueuedEvent(size_t sequence) {
+	return g_eventQueue[sequence & (g_eventQueue.size() - 1)];
+}
+
+bool growEventQueue() {
+	
+	size_t size = std::max(g_eventQueue.size() * 2, InitialEventQueueSize);
+	if(size > MaxEventQueueSize) {
+		return false;
+	}
+	
+	std::vector<QueuedEvent> queue(size);
+	for(size_t i = g_eventQueueBegin; i != g_eventQueueEnd; i++) {
+		QueuedEvent & event = queue[i & (size - 1)];
+		event = getQueuedEvent(i);
+	}
+	g_eventQueue.swap(queue);
+	
+	return true;
+}
+
+QueuedEventList * getEventList(EntityRef entity) {
+	
+	if(entity.index() < 0) {
+		return NULL;
+	}
+	
+	size_t index = size_t(entity.index());
+	if(index >= g_entityEvents.size()) {
+		g_entityEvents.resize(index + 1);
+	}
+	
+	return &g_entityEvents[index];
+}
+
+} // anonymous namespace
 
 void ARX_SCRIPT_EventStackInit() {
-	ARX_SCRIPT_EventStackClear(false); // Clear everything in the stack
+	ARX_SCRIPT_EventStackClear(); // Clear everything in the stack
+	g_eventQueueStats = ScriptEventQueueStats();
 }
 
-void ARX_SCRIPT_EventStackClear(bool check_exist) {
+void ARX_SCRIPT_EventStackClear() {
 	LogDebug("clearing event queue");
-	BOOST_FOREACH(QueuedEvent & event, g_eventQueue) {
-		if(!check_exist || event.exists) {
-			event.clear();
-		}
+	for(size_t i = g_eventQueueBegin; i != g_eventQueueEnd; i++) {
+		getQueuedEvent(i).clear();
 	}
+	g_eventQueueBegin = g_eventQueueEnd;
+	g_entityEvents.clear();
+	g_eventQueueStats.depth = 0;
 }
 
 void ARX_SCRIPT_EventStackClearForIo(Entity * io) {
-	BOOST_FOREACH(QueuedEvent & event, g_eventQueue) {
-		if(event.exists && event.entity == io) {
+	
+	QueuedEventList * list = getEventList(entities.ref(io));
+	if(!list) {
+		return;
+	}
+	
+	// Events for older entities with the same index are also cleared as they are no longer valid
+	for(size_t i = list->first; i != NoEvent; ) {
+		QueuedEvent & event = getQueuedEvent(i);
+		i = event.next;
+		if(event.exists) {
 			LogDebug("clearing queued " << ScriptEvent::getName(event.msg, event.eventname)
 			         << " for " << io->idString());
 			event.clear();
+			g_eventQueueStats.depth--;
 		}
 	}
+	
+	*list = QueuedEventList();
 }
 
-void ARX_SCRIPT_EventStackExecute(size_t limit) {
+void ARX_SCRIPT_EventStackExecute(u64 budget) {
 	
 	ARX_PROFILE_FUNC();
 	
-	size_t count = 0;
+	const u64 start = platform::getTimeUs();
+	
+	// Don't run events queued by the events we execute here until the next call
+	const size_t end = g_eventQueueEnd;
 	
-	BOOST_FOREACH(QueuedEvent & event, g_eventQueue) {
+	QueuedEvent event;
+	
+	while(g_eventQueueBegin < end) {
 		
-		if(!event.exists) {
+		QueuedEvent & queued = getQueuedEvent(g_eventQueueBegin);
+		if(!queued.exists) {
+			g_eventQueueBegin++;
 			continue;
 		}
 		
-		if(ValidIOAddress(event.entity)) {
-			EVENT_SENDER = ValidIOAddress(event.sender) ? event.sender : NULL;
+		QueuedEventList * list = getEventList(queued.entity);
+		if(list) {
+			arx_assert(list->first == g_eventQueueBegin);
+			list->first = queued.next;
+			if(list->first == NoEvent) {
+				list->last = NoEvent;
+			}
+		}
+		
+		// Move the event out of the queue as running it may queue or clear other events
+		event.exists = true;
+		event.sender = queued.sender;
+		event.entity = queued.entity;
+		event.msg = queued.msg;
+		event.params.swap(queued.params);
+		event.eventname.swap(queued.eventname);
+		queued.clear();
+		g_eventQueueBegin++;
+		g_eventQueueStats.depth--;
+		
+		Entity * entity = entities.get(event.entity);
+		if(entity) {
+			EVENT_SENDER = entities.get(event.sender);
 			LogDebug("running queued " << ScriptEvent::getName(event.msg, event.eventname)
-			         << " for " << event.entity->idString());
-			SendIOScriptEvent(event.entity, event.msg, event.params, event.eventname);
+			         << " for " << entity->idString());
+			SendIOScriptEvent(entity, event.msg, event.params, event.eventname);
+			if(size_t(event.msg) < size_t(SM_MAXCMD)) {
+				g_eventQueueStats.executed[event.msg]++;
+			}
 		} else {
 			LogDebug("could not run queued " << ScriptEvent::getName(event.msg, event.eventname)
 			         << " params=\"" << event.params << "\" - entity vanished");
 		}
-		event.clear();
 		
-		// Abort if the event limit was reached
-		if(++count >= limit) {
+		// Abort if the time budget is used up
+		if(platform::getElapsedUs(start) >= budget) {
 			return;
 		}
 		
@@ -1532,22 +1741,46 @@ void ARX_SCRIPT_EventStackExecute(size_t limit) {
 }
 
 void ARX_SCRIPT_EventStackExecuteAll() {
-	ARX_SCRIPT_EventStackExecute(std::numeric_limits<size_t>::max());
+	ARX_SCRIPT_EventStackExecute(std::numeric_limits<u64>::max());
+}
+
+const ScriptEventQueueStats & ARX_SCRIPT_EventStackGetStats() {
+	return g_eventQueueStats;
 }
 
 void Stack_SendIOScriptEvent(Entity * io, ScriptMessage msg, const std::string & params,
                              const std::string & eventname) {
-	BOOST_FOREACH(QueuedEvent & event, g_eventQueue) {
-		if(!event.exists) {
-			event.sender = EVENT_SENDER;
-			event.entity = io;
-			event.msg = msg;
-			event.params = params;
-			event.eventname = eventname;
-			event.exists = true;
-			return;
+	
+	if(g_eventQueueEnd - g_eventQueueBegin == g_eventQueue.size() && !growEventQueue()) {
+		if(g_eventQueueStats.dropped++ == 0) {
+			LogWarning << "Script event queue is full, dropping events";
 		}
+		return;
 	}
+	
+	size_t sequence = g_eventQueueEnd++;
+	
+	QueuedEvent & event = getQueuedEvent(sequence);
+	event.sender = entities.ref(ValidIOAddress(EVENT_SENDER) ? EVENT_SENDER : NULL);
+	event.entity = entities.ref(io);
+	event.msg = msg;
+	event.params = params;
+	event.eventname = eventname;
+	event.exists = true;
+	event.next = NoEvent;
+	
+	QueuedEventList * list = getEventList(event.entity);
+	if(list) {
+		if(list->last != NoEvent) {
+			getQueuedEvent(list->last).next = sequence;
+		} else {
+			list->first = sequence;
+		}
+		list->last = sequence;
+	}
+	
+	g_eventQueueStats.depth++;
+	g_eventQueueStats.maxDepth = std::max(g_eventQueueStats.maxDepth, g_eventQueueStats.depth);
 }
 
 static ScriptResult SendIOScriptEventReverse(Entity * io, ScriptMessage msg, const std::string& params, const std::string& eventname)
@@ -1659,18 +1892,95 @@ ScriptResult SendInitScriptEvent(Entity * io) {
 	return ACCEPT;
 }
 
-//! Checks if timer named texx exists.
-static bool ARX_SCRIPT_Timer_Exist(const std::string & texx) {
+namespace {
+
+//! Scheduling state for a script timer slot
+struct TimerLinks {
 	
-	for(long i = 0; i < MAX_TIMER_SCRIPT; i++) {
-		if(scr_timer[i].exist) {
-			if(scr_timer[i].name == texx) {
-				return true;
-			}
+	//! Incremented whenever the slot is started or cleared to invalidate old queue entries
+	unsigned long serial;
+	
+	//! Neighbours in the list of timers for the same entity
+	long prev;
+	long next;
+	
+	TimerLinks() : serial(0), prev(-1), next(-1) { }
+	
+};
+
+struct QueuedTimer {
+	
+	unsigned long time;
+	long index;
+	unsigned long serial;
+	
+	QueuedTimer(unsigned long _time, long _index, unsigned long _serial)
+		: time(_time), index(_index), serial(_serial) { }
+	
+	//! Timers due at the same time run in slot order, like the old linear scan
+	bool operator>(const QueuedTimer & other) const {
+		if(time != other.time) {
+			return time > other.time;
 		}
+		if(index != other.index) {
+			return index > other.index;
+		}
+		return serial > other.serial;
 	}
 	
-	return false;
+};
+
+typedef std::vector<QueuedTimer> TimerQueue;
+typedef boost::unordered_map<std::string, long> TimerNameCounts;
+
+std::vector<TimerLinks> g_timerLinks;
+
+//! Min-heap of timer fire times - may contain stale entries for cleared or restarted timers
+TimerQueue g_timerQueue;
+
+//! Timers rescheduled while running ARX_SCRIPT_Timer_Check()
+TimerQueue g_timerQueuePending;
+bool g_timerCheckRunning = false;
+
+//! First timer of each entity, indexed by entity index + 1
+std::vector<long> g_entityTimers;
+
+TimerNameCounts g_timerNames;
+
+//! First unused timer slot
+long g_timerMinFree = 0;
+
+long getTimerListKey(const EntityRef & ref) {
+	return ref.index() + 1;
+}
+
+long getTimerListKey(const Entity * io) {
+	return io ? io->index().handleData() + 1 : 0;
+}
+
+long getFirstTimer(const Entity * io) {
+	size_t key = size_t(getTimerListKey(io));
+	return (key < g_entityTimers.size()) ? g_entityTimers[key] : -1;
+}
+
+void scheduleTimer(long num) {
+	
+	const SCR_TIMER & timer = scr_timer[num];
+	QueuedTimer entry(timer.tim + timer.msecs, num, g_timerLinks[num].serial);
+	
+	// Don't run timers more than once per ARX_SCRIPT_Timer_Check() call
+	TimerQueue & queue = g_timerCheckRunning ? g_timerQueuePending : g_timerQueue;
+	queue.push_back(entry);
+	if(&queue == &g_timerQueue) {
+		std::push_heap(queue.begin(), queue.end(), std::greater<QueuedTimer>());
+	}
+}
+
+} // anonymous namespace
+
+//! Checks if timer named texx exists.
+static bool ARX_SCRIPT_Timer_Exist(const std::string & texx) {
+	return g_timerNames.find(texx) != g_timerNames.end();
 }
 
 std::string ARX_SCRIPT_Timer_GetDefaultName() {
@@ -1691,14 +2001,60 @@ std::string ARX_SCRIPT_Timer_GetDefaultName() {
 //*************************************************************************************
 long ARX_SCRIPT_Timer_GetFree() {
 	
-	for(long i = 0; i < MAX_TIMER_SCRIPT; i++) {
-		if(!(scr_timer[i].exist))
+	for(long i = g_timerMinFree; i < MAX_TIMER_SCRIPT; i++) {
+		if(!(scr_timer[i].exist)) {
+			g_timerMinFree = i;
 			return i;
+		}
 	}
 	
+	g_timerMinFree = MAX_TIMER_SCRIPT;
 	return -1;
 }
 
+void ARX_SCRIPT_Timer_Start(long num) {
+	
+	SCR_TIMER & timer = scr_timer[num];
+	arx_assert(!timer.exist);
+	
+	timer.exist = 1;
+	ActiveTimers++;
+	
+	if(num == g_timerMinFree) {
+		g_timerMinFree++;
+	}
+	
+	g_timerNames[timer.name]++;
+	
+	TimerLinks & links = g_timerLinks[num];
+	links.serial++;
+	
+	size_t key = size_t(getTimerListKey(timer.io));
+	if(key >= g_entityTimers.size()) {
+		g_entityTimers.resize(key + 1, -1);
+	}
+	links.prev = -1;
+	links.next = g_entityTimers[key];
+	if(links.next >= 0) {
+		g_timerLinks[links.next].prev = num;
+	}
+	g_entityTimers[key] = num;
+	
+	scheduleTimer(num);
+}
+
+void ARX_SCRIPT_Timer_Reschedule() {
+	
+	g_timerQueue.clear();
+	g_timerQueuePending.clear();
+	
+	for(long i = 0; i < MAX_TIMER_SCRIPT; i++) {
+		if(scr_timer[i].exist) {
+			scheduleTimer(i);
+		}
+	}
+}
+
 //*************************************************************************************
 // Count the number of active script timers...
 //*************************************************************************************
@@ -1708,34 +2064,60 @@ long ARX_SCRIPT_CountTimers() {
 
 //*************************************************************************************
 // ARX_SCRIPT_Timer_ClearByNum
-// Clears a timer by its Index (long timer_idx) on the timers list
 //*************************************************************************************
 void ARX_SCRIPT_Timer_ClearByNum(long timer_idx) {
-	if(scr_timer[timer_idx].exist) {
-		LogDebug("clearing timer " << scr_timer[timer_idx].name);
-		scr_timer[timer_idx].name.clear();
-		ActiveTimers--;
-		scr_timer[timer_idx].exist = 0;
+	
+	SCR_TIMER & timer = scr_timer[timer_idx];
+	if(!timer.exist) {
+		return;
+	}
+	
+	LogDebug("clearing timer " << timer.name);
+	
+	TimerNameCounts::iterator name = g_timerNames.find(timer.name);
+	arx_assert(name != g_timerNames.end());
+	if(--name->second == 0) {
+		g_timerNames.erase(name);
+	}
+	
+	TimerLinks & links = g_timerLinks[timer_idx];
+	links.serial++;
+	if(links.prev >= 0) {
+		g_timerLinks[links.prev].next = links.next;
+	} else {
+		g_entityTimers[size_t(getTimerListKey(timer.io))] = links.next;
+	}
+	if(links.next >= 0) {
+		g_timerLinks[links.next].prev = links.prev;
+	}
+	links.prev = links.next = -1;
+	
+	timer.name.clear();
+	ActiveTimers--;
+	timer.exist = 0;
+	
+	if(timer_idx < g_timerMinFree) {
+		g_timerMinFree = timer_idx;
 	}
 }
 
 void ARX_SCRIPT_Timer_Clear_By_Name_And_IO(const std::string & timername, Entity * io) {
-	for(long i = 0; i < MAX_TIMER_SCRIPT; i++) {
-		if(scr_timer[i].exist && scr_timer[i].io == io && scr_timer[i].name == timername) {
+	for(long i = getFirstTimer(io); i >= 0; ) {
+		long next = g_timerLinks[i].next;
+		if(entities.get(scr_timer[i].io) == io && scr_timer[i].name == timername) {
 			ARX_SCRIPT_Timer_ClearByNum(i);
 		}
+		i = next;
 	}
 }
 
-void ARX_SCRIPT_Timer_Clear_All_Locals_For_IO(Entity * io)
-{
-	for (long i = 0; i < MAX_TIMER_SCRIPT; i++)
-	{
-		if (scr_timer[i].exist)
-		{
-			if ((scr_timer[i].io == io) && (scr_timer[i].es == &io->over_script))
-				ARX_SCRIPT_Timer_ClearByNum(i);
+void ARX_SCRIPT_Timer_Clear_All_Locals_For_IO(Entity * io) {
+	for(long i = getFirstTimer(io); i >= 0; ) {
+		long next = g_timerLinks[i].next;
+		if(entities.get(scr_timer[i].io) == io && scr_timer[i].es == &io->over_script) {
+			ARX_SCRIPT_Timer_ClearByNum(i);
 		}
+		i = next;
 	}
 }
 
@@ -1752,6 +2134,13 @@ void ARX_SCRIPT_Timer_FirstInit(long number)
 	delete[] scr_timer;
 	scr_timer = new SCR_TIMER[MAX_TIMER_SCRIPT];
 	ActiveTimers = 0;
+	
+	g_timerLinks.assign(size_t(MAX_TIMER_SCRIPT), TimerLinks());
+	g_timerQueue.clear();
+	g_timerQueuePending.clear();
+	g_entityTimers.clear();
+	g_timerNames.clear();
+	g_timerMinFree = 0;
 }
 
 void ARX_SCRIPT_Timer_ClearAll()
@@ -1761,53 +2150,55 @@ void ARX_SCRIPT_Timer_ClearAll()
 			ARX_SCRIPT_Timer_ClearByNum(i);
 
 	ActiveTimers = 0;
+	
+	g_timerQueue.clear();
+	g_timerQueuePending.clear();
 }
 
 void ARX_SCRIPT_Timer_Clear_For_IO(Entity * io) {
-	for(long i = 0; i < MAX_TIMER_SCRIPT; i++) {
-		if(scr_timer[i].exist && scr_timer[i].io == io) {
+	for(long i = getFirstTimer(io); i >= 0; ) {
+		long next = g_timerLinks[i].next;
+		if(entities.get(scr_timer[i].io) == io) {
 			ARX_SCRIPT_Timer_ClearByNum(i);
 		}
+		i = next;
 	}
 }
 
 long ARX_SCRIPT_GetSystemIOScript(Entity * io, const std::string & name) {
 	
-	if(ActiveTimers) {
-		for(long i = 0; i < MAX_TIMER_SCRIPT; i++) {
-			if(scr_timer[i].exist && scr_timer[i].io == io && scr_timer[i].name == name) {
-				return i;
-			}
+	for(long i = getFirstTimer(io); i >= 0; i = g_timerLinks[i].next) {
+		if(entities.get(scr_timer[i].io) == io && scr_timer[i].name == name) {
+			return i;
 		}
 	}
 	
 	return -1;
 }
 
-static bool Manage_Specific_RAT_Timer(SCR_TIMER * st) {
+static bool Manage_Specific_RAT_Timer(SCR_TIMER * st, Entity * io) {
 	
-	Entity * io = st->io;
 	GetTargetPos(io);
-	Vec3f target = io->target - io->pos;
+	Vec3f target = io->target - io->pos();
 	target = glm::normalize(target);
 	Vec3f targ = VRotateY(target, Random::getf(-30.f, 30.f));
 	target = io->target + targ * 100.f;
 	
 	if(ARX_INTERACTIVE_ConvertToValidPosForIO(io, &target)) {
 		ARX_INTERACTIVE_Teleport(io, target);
-		Vec3f pos = io->pos;
-		pos.y += io->physics.cyl.height * ( 1.0f / 2 );
+		Vec3f pos = io->pos();
+		pos.y += io->physics().cyl.height * ( 1.0f / 2 );
 		
 		ARX_PARTICLES_Add_Smoke(pos, 3, 20);
 		AddRandomSmoke(io, 20);
-		MakeCoolFx(io->pos);
-		io->show = SHOW_FLAG_IN_SCENE;
+		MakeCoolFx(io->pos());
+		io->show() = SHOW_FLAG_IN_SCENE;
 		
 		for(long kl = 0; kl < 10; kl++) {
 			FaceTarget2(io);
 		}
 		
-		io->gameFlags &= ~GFLAG_INVISIBILITY;
+		io->gameFlags() &= ~GFLAG_INVISIBILITY;
 		st->times = 1;
 	} else {
 		st->times++;
@@ -1826,38 +2217,52 @@ void ARX_SCRIPT_Timer_Check() {
 	ARX_PROFILE_FUNC();
 	
 	if(!ActiveTimers) {
+		g_timerQueue.clear();
 		return;
 	}
 	
-	for(long i = 0; i < MAX_TIMER_SCRIPT; i++) {
+	g_timerCheckRunning = true;
+	
+	const unsigned long now = arxtime.now_ul();
+	
+	while(!g_timerQueue.empty() && g_timerQueue.front().time <= now) {
 		
+		QueuedTimer entry = g_timerQueue.front();
+		std::pop_heap(g_timerQueue.begin(), g_timerQueue.end(), std::greater<QueuedTimer>());
+		g_timerQueue.pop_back();
+		
+		long i = entry.index;
 		SCR_TIMER * st = &scr_timer[i];
-		if(!st->exist) {
+		if(!st->exist || g_timerLinks[i].serial != entry.serial) {
+			// Timer was cleared or restarted after being queued
 			continue;
 		}
 		
-		unsigned long now = arxtime.now_ul();
 		unsigned long fire_time = st->tim + st->msecs;
 		if(fire_time > now) {
 			// Timer not ready to fire yet
+			scheduleTimer(i);
 			continue;
 		}
 		
+		Entity * io = entities.get(st->io);
+		
 		// Skip heartbeat timer events for far away objects
-		if((st->flags & 1) && !(st->io->gameFlags & GFLAG_ISINTREATZONE)) {
+		if((st->flags & 1) && io && !(io->gameFlags() & GFLAG_ISINTREATZONE)) {
 			long increment = (now - st->tim) / st->msecs;
 			st->tim += st->msecs * increment;
 			arx_assert(st->tim <= now && st->tim + st->msecs > now,
 			           "start=%lu wait=%ld now=%lu", st->tim, st->msecs, now);
+			scheduleTimer(i);
 			continue;
 		}
 		
 		EERIE_SCRIPT * es = st->es;
-		Entity * io = st->io;
 		long pos = st->pos;
 		
-		if(!es && st->name == "_r_a_t_") {
-			if(Manage_Specific_RAT_Timer(st)) {
+		if(!es && io && st->name == "_r_a_t_") {
+			if(Manage_Specific_RAT_Timer(st, io)) {
+				scheduleTimer(i);
 				continue;
 			}
 		}
@@ -1873,9 +2278,10 @@ void ARX_SCRIPT_Timer_Check() {
 				st->times--;
 			}
 			st->tim += st->msecs;
+			scheduleTimer(i);
 		}
 		
-		if(es && ValidIOAddress(io)) {
+		if(es && io) {
 			LogDebug("running timer \"" << name << "\" for entity " << io->idString());
 			ScriptEvent::send(es, SM_EXECUTELINE, "", io, "", pos);
 		} else {
@@ -1883,6 +2289,20 @@ void ARX_SCRIPT_Timer_Check() {
 		}
 		
 	}
+	
+	g_timerCheckRunning = false;
+	
+	BOOST_FOREACH(const QueuedTimer & entry, g_timerQueuePending) {
+		g_timerQueue.push_back(entry);
+		std::push_heap(g_timerQueue.begin(), g_timerQueue.end(), std::greater<QueuedTimer>());
+	}
+	g_timerQueuePending.clear();
+	
+	// Drop stale entries for timers that were cleared before they could fire
+	if(g_timerQueue.size() > size_t(ActiveTimers) * 2 + 64) {
+		ARX_SCRIPT_Timer_Reschedule();
+	}
+	
 }
 
 void ARX_SCRIPT_Init_Event_Stats() {
@@ -2016,6 +2436,7 @@ void loadScript(EERIE_SCRIPT & script, PakFile * file) {
 		return;
 	}
 	
+	script::forgetProfileSites(script.data);
 	free(script.data);
 	
 	script.data = file->readAlloc();
@@ -2029,10 +2450,13 @@ void loadScript(EERIE_SCRIPT & script, PakFile * file) {
 	
 	script.master = NULL;
 	
+	script.tokens.clear();
+	
 	for(size_t j = 0; j < MAX_SCRIPTTIMERS; j++) {
 		script.timers[j] = 0;
 	}
 	
+	ARX_SCRIPT_ComputePositions(script);
 	ARX_SCRIPT_ComputeShortcuts(script);
 	
 }
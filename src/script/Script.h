@@ -48,14 +48,20 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 #define ARX_SCRIPT_SCRIPT_H
 
 #include <stddef.h>
+#include <algorithm>
 #include <cstring>
 #include <string>
 #include <vector>
 
+#include <boost/unordered_map.hpp>
+
+#include "game/GameTypes.h"
+#include "platform/Platform.h"
 #include "util/Flags.h"
 
 class PakFile;
 class Entity;
+namespace script { class Command; }
 
 const size_t MAX_SHORTCUT = 80;
 const size_t MAX_SCRIPTTIMERS = 5;
@@ -108,7 +114,66 @@ enum DisabledEvent {
 DECLARE_FLAGS(DisabledEvent, DisabledEvents)
 DECLARE_FLAGS_OPERATORS(DisabledEvents)
 
-typedef std::vector<SCRIPT_VAR> SCRIPT_VARIABLES;
+/*!
+ * List of script variables with a hash index for lookups by name.
+ *
+ * Variables are kept in insertion order so that save games store them unchanged.
+ * Any non-const access may rename variables, so the index is rebuilt lazily
+ * by the next lookup.
+ */
+class SCRIPT_VARIABLES {
+	
+	typedef std::vector<SCRIPT_VAR> Variables;
+	typedef boost::unordered_map<std::string, size_t> Index;
+	
+	Variables m_variables;
+	mutable Index m_index;
+	mutable bool m_indexDirty;
+	
+	void updateIndex() const;
+	
+public:
+	
+	typedef Variables::iterator iterator;
+	typedef Variables::const_iterator const_iterator;
+	
+	SCRIPT_VARIABLES() : m_indexDirty(false) { }
+	
+	size_t size() const { return m_variables.size(); }
+	bool empty() const { return m_variables.empty(); }
+	
+	SCRIPT_VAR & operator[](size_t i) { m_indexDirty = true; return m_variables[i]; }
+	const SCRIPT_VAR & operator[](size_t i) const { return m_variables[i]; }
+	
+	iterator begin() { m_indexDirty = true; return m_variables.begin(); }
+	iterator end() { return m_variables.end(); }
+	const_iterator begin() const { return m_variables.begin(); }
+	const_iterator end() const { return m_variables.end(); }
+	
+	void clear() {
+		m_variables.clear();
+		m_index.clear();
+		m_indexDirty = false;
+	}
+	
+	void resize(size_t count) {
+		m_variables.resize(count);
+		m_indexDirty = true;
+	}
+	
+	iterator erase(iterator it) {
+		m_indexDirty = true;
+		return m_variables.erase(it);
+	}
+	
+	//! \return the variable with the given name or NULL if it does not exist
+	SCRIPT_VAR * find(const std::string & name);
+	const SCRIPT_VAR * find(const std::string & name) const;
+	
+	//! Append a new variable without a type
+	SCRIPT_VAR * add(const std::string & name);
+	
+};
 
 struct EERIE_SCRIPT {
 	size_t size;
@@ -121,7 +186,26 @@ struct EERIE_SCRIPT {
 	long shortcut[MAX_SHORTCUT];
 	long nb_labels;
 	LABEL_INFO * labels;
-
+	
+	//! Positions of all event handlers ("on event") and labels (">>label") in data
+	typedef boost::unordered_map<std::string, long> Positions;
+	Positions positions;
+	
+	//! A literal token parsed from data that does not need to be parsed again
+	struct Token {
+		size_t end; //!< Position after the token
+		std::string word; //!< Token text (without underscores for commands)
+		script::Command * command; //!< Resolved command or NULL
+	};
+	enum TokenType {
+		CommandToken,
+		LineCommandToken, //!< Command that may not span multiple lines
+		FlagsToken
+	};
+	//! Tokens keyed by their start position * 4 + TokenType, filled in as they are executed
+	typedef boost::unordered_map<size_t, Token> Tokens;
+	Tokens tokens;
+	
 	EERIE_SCRIPT() : size(), data(), lastcall(), allowevents(), master(), nb_labels(), labels() {
 		memset(&timers, 0, sizeof(timers));
 		memset(&shortcut, 0, sizeof(shortcut));
@@ -138,7 +222,7 @@ struct SCR_TIMER {
 	long pos;
 	long longinfo;
 	unsigned long tim;
-	Entity * io;
+	EntityRef io;
 	EERIE_SCRIPT * es;
 	
 	SCR_TIMER()
@@ -150,7 +234,7 @@ struct SCR_TIMER {
 		, pos(0)
 		, longinfo(0)
 		, tim(0)
-		, io(NULL)
+		, io()
 		, es(NULL)
 	{ }
 	
@@ -163,7 +247,7 @@ struct SCR_TIMER {
 		pos = 0;
 		longinfo = 0;
 		tim = 0;
-		io = NULL;
+		io = EntityRef();
 		es = NULL;
 	}
 	
@@ -426,6 +510,20 @@ enum ScriptMessage {
 	SM_DUMMY = 256
 };
 
+//! Statistics for the queue of delayed script events
+struct ScriptEventQueueStats {
+	
+	size_t depth; //!< Number of events currently queued
+	size_t maxDepth; //!< Largest number of events queued at the same time
+	size_t dropped; //!< Number of events dropped because the queue was full
+	size_t executed[SM_MAXCMD]; //!< Number of executed events for each message
+	
+	ScriptEventQueueStats() : depth(0), maxDepth(0), dropped(0) {
+		std::fill(executed, executed + size_t(SM_MAXCMD), 0);
+	}
+	
+};
+
 extern SCRIPT_VARIABLES svar;
 extern Entity * EVENT_SENDER;
 extern SCR_TIMER * scr_timer;
@@ -438,12 +536,28 @@ void ARX_SCRIPT_Timer_FirstInit(long number);
 void ARX_SCRIPT_Timer_ClearAll();
 void ARX_SCRIPT_Timer_Clear_For_IO(Entity * io);
 long ARX_SCRIPT_Timer_GetFree();
+
+/*!
+ * Activate a timer slot returned by ARX_SCRIPT_Timer_GetFree().
+ *
+ * All fields except exist must already be set and may not be changed afterwards,
+ * except by calling ARX_SCRIPT_Timer_Reschedule().
+ */
+void ARX_SCRIPT_Timer_Start(long num);
+
+//! Update the timer queue after changing the start time of running timers
+void ARX_SCRIPT_Timer_Reschedule();
  
 void ARX_SCRIPT_SetMainEvent(Entity * io, const std::string & newevent);
-void ARX_SCRIPT_EventStackExecute(size_t limit = 20);
+/*!
+ * Run queued script events.
+ *
+ * \param budget time in microseconds after which no further events are started
+ */
+void ARX_SCRIPT_EventStackExecute(u64 budget = 2000);
 void ARX_SCRIPT_EventStackExecuteAll();
 void ARX_SCRIPT_EventStackInit();
-void ARX_SCRIPT_EventStackClear(bool check_exist = true);
+void ARX_SCRIPT_EventStackClear();
 void ARX_SCRIPT_ResetObject(Entity * io, bool init);
 void ARX_SCRIPT_Reset(Entity * io, bool init);
 long ARX_SCRIPT_GetSystemIOScript(Entity * io, const std::string & name);
@@ -453,6 +567,7 @@ long ARX_SCRIPT_CountTimers();
 void ARX_SCRIPT_Timer_ClearByNum(long num);
 void ARX_SCRIPT_ResetAll(bool init);
 void ARX_SCRIPT_EventStackClearForIo(Entity * io);
+const ScriptEventQueueStats & ARX_SCRIPT_EventStackGetStats();
 Entity * ARX_SCRIPT_Get_IO_Max_Events();
 Entity * ARX_SCRIPT_Get_IO_Max_Events_Sent();
 
@@ -490,10 +605,11 @@ ScriptResult SendMsgToAllIO(ScriptMessage msg, const std::string & params = "");
 void Stack_SendIOScriptEvent(Entity * io, ScriptMessage msg, const std::string & params = "", const std::string & eventname = "");
 
 /*!
- * Finds the first occurence of str in the script that is followed
- * by a separator (a character of value less then or equal 32)
- * 
- * \return The position of str in the script or -1 if str was not found.
+ * Find the position of an event handler or label in a script.
+ *
+ * \param str the event handler ("on event") or label (">>label") to search for
+ *
+ * \return the position of str in the script data or -1 if it was not found
  */
 long FindScriptPos(const EERIE_SCRIPT * es, const std::string & str);
 
@@ -53,6 +53,7 @@ ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
 
 #include "io/log/Logger.h"
 
+#include "script/ScriptProfiler.h"
 #include "script/ScriptUtils.h"
 #include "script/ScriptedAnimation.h"
 #include "script/ScriptedCamera.h"
@@ -168,16 +169,64 @@ ScriptEvent::~ScriptEvent() {
 	// TODO Auto-generated destructor stub
 }
 
+//! Check if a message has been disabled for a script by setevent or is otherwise refused
+static bool isEventDisabled(const EERIE_SCRIPT * esss, ScriptMessage msg) {
+	
+	switch(msg) {
+		case SM_COLLIDE_NPC:
+			if (esss->allowevents & DISABLE_COLLIDE_NPC) return true;
+			break;
+		case SM_CHAT:
+			if (esss->allowevents & DISABLE_CHAT) return true;
+			break;
+		case SM_HIT:
+			if (esss->allowevents & DISABLE_HIT) return true;
+			break;
+		case SM_INVENTORY2_OPEN:
+			if (esss->allowevents & DISABLE_INVENTORY2_OPEN) return true;
+			break;
+		case SM_HEAR:
+			if (esss->allowevents & DISABLE_HEAR) return true;
+			break;
+		case SM_UNDETECTPLAYER:
+		case SM_DETECTPLAYER:
+			if (esss->allowevents & DISABLE_DETECT) return true;
+			break;
+		case SM_AGGRESSION:
+			if (esss->allowevents & DISABLE_AGGRESSION) return true;
+			break;
+		case SM_MAIN:
+			if (esss->allowevents & DISABLE_MAIN) return true;
+			break;
+		case SM_CURSORMODE:
+			if (esss->allowevents & DISABLE_CURSORMODE) return true;
+			break;
+		case SM_EXPLORATIONMODE:
+			if (esss->allowevents & DISABLE_EXPLORATIONMODE) return true;
+			break;
+		case SM_KEY_PRESSED: {
+			if(cinematicBorder.elapsedTime() < 3000) {
+				LogDebug("refusing SM_KEY_PRESSED");
+				return true;
+			}
+			break;
+		}
+		default: break;
+	}
+	
+	return false;
+}
+
 static bool checkInteractiveObject(Entity * io, ScriptMessage msg, ScriptResult & ret) {
 	
 	io->stat_count++;
 	
-	if((io->gameFlags & GFLAG_MEGAHIDE) && msg != SM_RELOAD) {
+	if((io->gameFlags() & GFLAG_MEGAHIDE) && msg != SM_RELOAD) {
 		ret = ACCEPT;
 		return true;
 	}
 	
-	arx_assert(io->show != SHOW_FLAG_DESTROYED);
+	arx_assert(io->show() != SHOW_FLAG_DESTROYED);
 	
 	if(io->ioflags & IO_FREEZESCRIPT) {
 		ret = (msg == SM_LOAD) ? ACCEPT : REFUSE;
@@ -281,46 +330,8 @@ ScriptResult ScriptEvent::send(EERIE_SCRIPT * es, ScriptMessage msg, const std::
 		if (msg == SM_EXECUTELINE) {
 			pos = info;
 		} else {
-			switch(msg) {
-				case SM_COLLIDE_NPC:
-					if (esss->allowevents & DISABLE_COLLIDE_NPC) return REFUSE;
-					break;
-				case SM_CHAT:
-					if (esss->allowevents & DISABLE_CHAT) return REFUSE;
-					break;
-				case SM_HIT:
-					if (esss->allowevents & DISABLE_HIT) return REFUSE;
-					break;
-				case SM_INVENTORY2_OPEN:
-					if (esss->allowevents & DISABLE_INVENTORY2_OPEN) return REFUSE;
-					break;
-				case SM_HEAR:
-					if (esss->allowevents & DISABLE_HEAR) return REFUSE;
-					break;
-				case SM_UNDETECTPLAYER:
-				case SM_DETECTPLAYER:
-					if (esss->allowevents & DISABLE_DETECT) return REFUSE;
-					break;
-				case SM_AGGRESSION:
-					if (esss->allowevents & DISABLE_AGGRESSION) return REFUSE;
-					break;
-				case SM_MAIN:
-					if (esss->allowevents & DISABLE_MAIN) return REFUSE;
-					break;
-				case SM_CURSORMODE:
-					if (esss->allowevents & DISABLE_CURSORMODE) return REFUSE;
-					break;
-				case SM_EXPLORATIONMODE:
-					if (esss->allowevents & DISABLE_EXPLORATIONMODE) return REFUSE;
-					break;
-				case SM_KEY_PRESSED: {
-					if(cinematicBorder.elapsedTime() < 3000) {
-						LogDebug("refusing SM_KEY_PRESSED");
-						return REFUSE;
-					}
-					break;
-				}
-				default: break;
+			if(isEventDisabled(esss, msg)) {
+				return REFUSE;
 			}
 
 			if(msg < (long)MAX_SHORTCUT) {
@@ -363,6 +374,8 @@ ScriptResult ScriptEvent::send(EERIE_SCRIPT * es, ScriptMessage msg, const std::
 		}
 	}
 	
+	script::ProfileScope profileEvent(es, io, msg, evname, size_t(pos));
+	
 	script::Context context(es, pos, io, msg);
 	
 	if(msg != SM_EXECUTELINE) {
@@ -377,7 +390,8 @@ ScriptResult ScriptEvent::send(EERIE_SCRIPT * es, ScriptMessage msg, const std::
 	
 	for(;;) {
 		
-		std::string word = context.getCommand(msg != SM_EXECUTELINE);
+		const EERIE_SCRIPT::Token & token = getCommand(context, msg != SM_EXECUTELINE);
+		const std::string & word = token.word;
 		if(word.empty()) {
 			if(msg == SM_EXECUTELINE && context.pos != es->size) {
 				arx_assert(es->data[context.pos] == '\n');
@@ -388,14 +402,10 @@ ScriptResult ScriptEvent::send(EERIE_SCRIPT * es, ScriptMessage msg, const std::
 			return ACCEPT;
 		}
 		
-		// Remove all underscores from the command.
-		word.resize(std::remove(word.begin(), word.end(), '_') - word.begin());
-		
-		Commands::const_iterator it = commands.find(word);
-		
-		if(it != commands.end()) {
+		if(token.command) {
 			
-			script::Command & command = *(it->second);
+			// The token may be invalidated while the command is executed
+			script::Command & command = *token.command;
 			
 			script::Command::Result res;
 			if(command.getEntityFlags()
@@ -406,7 +416,9 @@ ScriptResult ScriptEvent::send(EERIE_SCRIPT * es, ScriptMessage msg, const std::
 				context.skipCommand();
 				res = script::Command::Failed;
 			} else {
-				res = it->second->execute(context);
+				script::ProfileScope profileCommand(es, io, size_t(pos), command.getName(),
+				                                    context.getPosition());
+				res = command.execute(context);
 			}
 			
 			if(res == script::Command::AbortAccept) {
@@ -463,6 +475,55 @@ ScriptResult ScriptEvent::send(EERIE_SCRIPT * es, ScriptMessage msg, const std::
 	return ret;
 }
 
+const EERIE_SCRIPT::Token & ScriptEvent::getCommand(script::Context & context,
+                                                     bool skipNewlines) {
+	
+	EERIE_SCRIPT * es = context.script;
+	
+	size_t type = skipNewlines ? EERIE_SCRIPT::CommandToken : EERIE_SCRIPT::LineCommandToken;
+	size_t key = context.pos * 4 + type;
+	
+	EERIE_SCRIPT::Tokens::const_iterator cached = es->tokens.find(key);
+	if(cached != es->tokens.end()) {
+		context.pos = cached->second.end;
+		return cached->second;
+	}
+	
+	EERIE_SCRIPT::Token token;
+	token.word = context.getCommand(skipNewlines);
+	token.end = context.pos;
+	
+	// Remove all underscores from the command.
+	token.word.resize(std::remove(token.word.begin(), token.word.end(), '_') - token.word.begin());
+	
+	Commands::const_iterator it = commands.find(token.word);
+	token.command = (it != commands.end()) ? it->second : NULL;
+	
+	return es->tokens.insert(EERIE_SCRIPT::Tokens::value_type(key, token)).first->second;
+}
+
+ScriptResult ScriptEvent::sendUnhandled(EERIE_SCRIPT * es, ScriptMessage msg, Entity * io) {
+	
+	ScriptResult ret = ACCEPT;
+	
+	totalCount++;
+	
+	if(io && checkInteractiveObject(io, msg, ret)) {
+		return ret;
+	}
+	
+	if(!es->data) {
+		return ACCEPT;
+	}
+	
+	EERIE_SCRIPT * esss = es->master ? es->master : es;
+	if(msg != SM_EXECUTELINE && isEventDisabled(esss, msg)) {
+		return REFUSE;
+	}
+	
+	return ACCEPT;
+}
+
 void ScriptEvent::registerCommand(script::Command * command) {
 	
 	typedef std::pair<Commands::iterator, bool> Res;
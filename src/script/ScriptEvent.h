@@ -20,7 +20,7 @@
 #ifndef ARX_SCRIPT_SCRIPTEVENT_H
 #define ARX_SCRIPT_SCRIPTEVENT_H
 
-#include <map>
+#include <boost/unordered_map.hpp>
 
 #include "script/Script.h"
 
@@ -35,6 +35,7 @@ namespace script {
 std::string loadUnlocalized(const std::string & str);
 
 class Command;
+class Context;
 
 } // namespace script
 
@@ -51,6 +52,12 @@ public:
 	
 	static ScriptResult send(EERIE_SCRIPT * es, ScriptMessage msg, const std::string & params, Entity * io, const std::string & eventname, long info = 0);
 	
+	/*!
+	 * Get the result of send() for a script that has no handler for a message.
+	 * Nothing is executed, but entities with frozen scripts or disabled events still refuse.
+	 */
+	static ScriptResult sendUnhandled(EERIE_SCRIPT * es, ScriptMessage msg, Entity * io);
+	
 	static void registerCommand(script::Command * command);
 	
 	static void init();
@@ -58,7 +65,13 @@ public:
 	
 private:
 	
-	typedef std::map<std::string, script::Command *> Commands;
+	/*!
+	 * Read the next command word and resolve it to a command implementation.
+	 * The result is cached in the script so that each line is only parsed once.
+	 */
+	static const EERIE_SCRIPT::Token & getCommand(script::Context & context, bool skipNewlines);
+	
+	typedef boost::unordered_map<std::string, script::Command *> Commands;
 	static Commands commands;
 	
 };
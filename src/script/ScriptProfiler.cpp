@@ -0,0 +1,200 @@
+/*
+ * Copyright 2016 Arx Libertatis Team (see the AUTHORS file)
+ *
+ * This file is part of Arx Libertatis.
+ *
+ * Arx Libertatis is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Arx Libertatis is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Arx Libertatis.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "script/ScriptProfiler.h"
+
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+
+#include "game/Entity.h"
+#include "io/log/Logger.h"
+#include "platform/ProgramOptions.h"
+#include "platform/Time.h"
+#include "platform/profiler/Profiler.h"
+#include "script/ScriptEvent.h"
+
+namespace script {
+
+bool ProfileScope::s_enabled = false;
+
+namespace {
+
+struct ProfileSite {
+	
+	//! Used as profiler tag - must not change once the site has been created
+	std::string name;
+	bool command;
+	
+	u64 calls;
+	u64 time;
+	
+	ProfileSite(const std::string & _name, bool _command)
+		: name(_name), command(_command), calls(0), time(0) { }
+	
+};
+
+//! Sites are never removed so that their names remain valid as profiler tags
+std::deque<ProfileSite> g_sites;
+boost::unordered_map<std::string, size_t> g_sitesByName;
+
+//! Maps (event position, command position) in each loaded script to a site
+typedef std::pair<size_t, size_t> SitePosition;
+typedef boost::unordered_map<SitePosition, size_t, boost::hash<SitePosition> > ScriptSites;
+boost::unordered_map<const char *, ScriptSites> g_scriptSites;
+
+size_t getLine(const EERIE_SCRIPT * es, size_t pos) {
+	pos = std::min(pos, es->size);
+	return size_t(std::count(es->data, es->data + pos, '\n')) + 1;
+}
+
+std::string getScriptName(const EERIE_SCRIPT * es, const Entity * io) {
+	if(!io) {
+		return "unknown";
+	}
+	return (es == &io->script) ? io->className() : io->idString();
+}
+
+size_t createSite(ScriptSites & sites, SitePosition position, const std::string & name,
+                  bool command) {
+	
+	// Aggregate all instances of the same class
+	size_t site;
+	boost::unordered_map<std::string, size_t>::const_iterator byName = g_sitesByName.find(name);
+	if(byName != g_sitesByName.end()) {
+		site = byName->second;
+	} else {
+		site = g_sites.size();
+		g_sites.push_back(ProfileSite(name, command));
+		g_sitesByName[name] = site;
+	}
+	
+	sites[position] = site;
+	
+	return site;
+}
+
+bool compareSiteTime(size_t a, size_t b) {
+	return g_sites[a].time > g_sites[b].time;
+}
+
+void logHottestSites(size_t count, bool command) {
+	
+	std::vector<size_t> sites;
+	for(size_t i = 0; i < g_sites.size(); i++) {
+		if(g_sites[i].command == command && g_sites[i].calls != 0) {
+			sites.push_back(i);
+		}
+	}
+	
+	count = std::min(count, sites.size());
+	std::partial_sort(sites.begin(), sites.begin() + count, sites.end(), compareSiteTime);
+	
+	LogInfo << "Hottest script " << (command ? "commands" : "events") << ':';
+	for(size_t i = 0; i < count; i++) {
+		const ProfileSite & site = g_sites[sites[i]];
+		std::ostringstream oss;
+		oss << std::fixed << std::setprecision(3) << std::setw(10) << (double(site.time) / 1000.0)
+		    << " ms " << std::setw(8) << site.calls << " calls " << std::setw(8)
+		    << (double(site.time) / double(site.calls)) << " us  " << site.name;
+		LogInfo << oss.str();
+	}
+	
+}
+
+void enableProfiling() {
+	ProfileScope::enable();
+}
+
+} // anonymous namespace
+
+void ProfileScope::beginEvent(const EERIE_SCRIPT * es, const Entity * io, ScriptMessage msg,
+                              const std::string & eventname, size_t pos) {
+	
+	SitePosition position(pos, size_t(-1));
+	ScriptSites & sites = g_scriptSites[es->data];
+	ScriptSites::const_iterator it = sites.find(position);
+	if(it != sites.end()) {
+		m_site = it->second;
+	} else {
+		std::ostringstream oss;
+		oss << getScriptName(es, io) << ':' << getLine(es, pos) << ' '
+		    << ScriptEvent::getName(msg, eventname);
+		m_site = createSite(sites, position, oss.str(), false);
+	}
+	
+	m_startTime = platform::getTimeUs();
+}
+
+void ProfileScope::beginCommand(const EERIE_SCRIPT * es, const Entity * io, size_t eventPos,
+                                const std::string & command, size_t pos) {
+	
+	SitePosition position(eventPos, pos);
+	ScriptSites & sites = g_scriptSites[es->data];
+	ScriptSites::const_iterator it = sites.find(position);
+	if(it != sites.end()) {
+		m_site = it->second;
+	} else {
+		std::ostringstream oss;
+		oss << getScriptName(es, io) << ':' << getLine(es, pos) << ' ' << command
+		    << " (handler at line " << getLine(es, eventPos) << ')';
+		m_site = createSite(sites, position, oss.str(), true);
+	}
+	
+	m_startTime = platform::getTimeUs();
+}
+
+void ProfileScope::end() {
+	
+	u64 endTime = platform::getTimeUs();
+	
+	ProfileSite & site = g_sites[m_site];
+	site.calls++;
+	site.time += platform::getElapsedUs(m_startTime, endTime);
+	
+	#if BUILD_PROFILER_INSTRUMENT
+	::profiler::addSample(site.name.c_str(), m_startTime, endTime);
+	#endif
+}
+
+void forgetProfileSites(const char * data) {
+	if(data && !g_scriptSites.empty()) {
+		g_scriptSites.erase(data);
+	}
+}
+
+void logHottestScripts(size_t count) {
+	
+	if(!ProfileScope::isEnabled()) {
+		return;
+	}
+	
+	logHottestSites(count, false);
+	logHottestSites(count, true);
+}
+
+ARX_PROGRAM_OPTION("profile-scripts", "", "Record script execution times", &enableProfiling);
+
+} // namespace script
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2016 Arx Libertatis Team (see the AUTHORS file)
+ *
+ * This file is part of Arx Libertatis.
+ *
+ * Arx Libertatis is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Arx Libertatis is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Arx Libertatis.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARX_SCRIPT_SCRIPTPROFILER_H
+#define ARX_SCRIPT_SCRIPTPROFILER_H
+
+#include <stddef.h>
+#include <string>
+
+#include "platform/Platform.h"
+#include "script/Script.h"
+
+class Entity;
+
+namespace script {
+
+/*!
+ * Records call counts and wall time for a script event handler or command while in scope.
+ *
+ * Statistics are aggregated by class, event, command and source line.
+ * Does nothing unless script profiling was enabled with --profile-scripts.
+ */
+class ProfileScope {
+	
+	size_t m_site;
+	u64 m_startTime;
+	
+	static bool s_enabled;
+	
+	void beginEvent(const EERIE_SCRIPT * es, const Entity * io, ScriptMessage msg,
+	                const std::string & eventname, size_t pos);
+	void beginCommand(const EERIE_SCRIPT * es, const Entity * io, size_t eventPos,
+	                  const std::string & command, size_t pos);
+	void end();
+	
+public:
+	
+	//! Profile the event handler starting at pos
+	ProfileScope(const EERIE_SCRIPT * es, const Entity * io, ScriptMessage msg,
+	             const std::string & eventname, size_t pos)
+		: m_site(size_t(-1)), m_startTime(0) {
+		if(s_enabled) {
+			beginEvent(es, io, msg, eventname, pos);
+		}
+	}
+	
+	//! Profile the command at pos in the event handler starting at eventPos
+	ProfileScope(const EERIE_SCRIPT * es, const Entity * io, size_t eventPos,
+	             const std::string & command, size_t pos)
+		: m_site(size_t(-1)), m_startTime(0) {
+		if(s_enabled) {
+			beginCommand(es, io, eventPos, command, pos);
+		}
+	}
+	
+	~ProfileScope() {
+		if(m_site != size_t(-1)) {
+			end();
+		}
+	}
+	
+	static bool isEnabled() { return s_enabled; }
+	static void enable() { s_enabled = true; }
+	
+};
+
+//! Forget source positions cached for script data that is about to be freed
+void forgetProfileSites(const char * data);
+
+//! Log the event handlers and commands with the highest total execution time
+void logHottestScripts(size_t count = 20);
+
+} // namespace script
+
+#endif // ARX_SCRIPT_SCRIPTPROFILER_H
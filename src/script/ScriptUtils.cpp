@@ -206,13 +206,31 @@ void Context::skipWhitespace(bool skipNewlines) {
 
 std::string Context::getFlags() {
 	
+	size_t key = pos * 4 + EERIE_SCRIPT::FlagsToken;
+	EERIE_SCRIPT::Tokens::const_iterator cached = script->tokens.find(key);
+	if(cached != script->tokens.end()) {
+		pos = cached->second.end;
+		return cached->second.word;
+	}
+	
 	skipWhitespace();
 	
+	size_t start = pos;
+	std::string flags;
 	if(pos < script->size && script->data[pos] == '-') {
-		return getWord();
+		flags = getWord();
+	}
+	
+	// Flags that contain variables must be evaluated every time
+	if(std::find(script->data + start, script->data + pos, '~') == script->data + pos) {
+		EERIE_SCRIPT::Token token;
+		token.end = pos;
+		token.word = flags;
+		token.command = NULL;
+		script->tokens.insert(EERIE_SCRIPT::Tokens::value_type(key, token));
 	}
 	
-	return std::string();
+	return flags;
 }
 
 float Context::getFloat() {
@@ -216,7 +216,7 @@ public:
 			execute = test_flag(flg, 'e');
 			if(flg & flag('p')) {
 				iot = entities.player();
-				iot->move = iot->lastmove = Vec3f_ZERO;
+				iot->move() = iot->lastmove = Vec3f_ZERO;
 			}
 		}
 		
@@ -275,10 +275,8 @@ public:
 			}
 			
 			scr_timer[num2].reset();
-			ActiveTimers++;
 			scr_timer[num2].es = context.getScript();
-			scr_timer[num2].exist = 1;
-			scr_timer[num2].io = context.getEntity();
+			scr_timer[num2].io = entities.ref(context.getEntity());
 			scr_timer[num2].msecs = 1000.f;
 			// Don't assume that we successfully set the animation - use the current animation
 			if(layer.cur_anim) {
@@ -292,6 +290,7 @@ public:
 			scr_timer[num2].tim = arxtime.now_ul();
 			scr_timer[num2].times = 1;
 			scr_timer[num2].longinfo = 0;
+			ARX_SCRIPT_Timer_Start(num2);
 			
 			DebugScript(": scheduled timer #" << num2 << ' ' << timername << " in "
 			            << scr_timer[num2].msecs << "ms");
@@ -379,7 +378,7 @@ public:
 		
 		DebugScript(' ' << dx << ' ' << dy << ' ' << dz);
 		
-		context.getEntity()->pos += Vec3f(dx, dy, dz);
+		context.getEntity()->pos() += Vec3f(dx, dy, dz);
 		
 		return Success;
 	}
@@ -265,9 +265,9 @@ public:
 		Entity & io = *context.getEntity();
 		if(group == "door") {
 			if(rem) {
-				io.gameFlags &= ~GFLAG_DOOR;
+				io.gameFlags() &= ~GFLAG_DOOR;
 			} else {
-				io.gameFlags |= GFLAG_DOOR;
+				io.gameFlags() |= GFLAG_DOOR;
 			}
 		}
 		
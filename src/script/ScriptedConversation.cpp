@@ -161,7 +161,7 @@ public:
 		DebugScript(' ' << sample);
 		
 		Entity * io = context.getEntity();
-		audio::SampleId num = ARX_SOUND_PlaySpeech(sample, io && io->show == 1 ? io : NULL);
+		audio::SampleId num = ARX_SOUND_PlaySpeech(sample, io && io->show() == 1 ? io : NULL);
 		
 		if(num == audio::INVALID_ID) {
 			ScriptWarning << "unable to load sound file " << sample;
@@ -234,7 +234,7 @@ class SpeakCommand : public Command {
 			if(id != ActionPoint()) {
 				acs.pos1 = actionPointPosition(io->obj, id);
 			} else {
-				acs.pos1 = io->pos + Vec3f(0.f, io->physics.cyl.height, 0.f);
+				acs.pos1 = io->pos() + Vec3f(0.f, io->physics().cyl.height, 0.f);
 			}
 		}
 		
@@ -244,7 +244,7 @@ class SpeakCommand : public Command {
 			if(id != ActionPoint()) {
 				acs.pos2 = actionPointPosition(ioo->obj, id);
 			} else {
-				acs.pos2 = ioo->pos + Vec3f(0.f, ioo->physics.cyl.height, 0.f);
+				acs.pos2 = ioo->pos() + Vec3f(0.f, ioo->physics().cyl.height, 0.f);
 			}
 		}
 	}
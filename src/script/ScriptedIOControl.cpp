@@ -98,10 +98,10 @@ public:
 		LASTSPAWNED = ioo;
 		ioo->scriptload = 1;
 		ioo->initpos = io->initpos;
-		ioo->pos = io->pos;
+		ioo->pos() = io->pos();
 		ioo->angle = io->angle;
-		ioo->move = io->move;
-		ioo->show = io->show;
+		ioo->move() = io->move();
+		ioo->show() = io->show();
 		
 		if(io == DRAGINTER) {
 			Set_DragInter(ioo);
@@ -163,7 +163,7 @@ public:
 			ARX_INTERACTIVE_DestroyIOdelayed(io);
 			
 			// Prevent further script events as the object has been destroyed!
-			io->show = SHOW_FLAG_MEGAHIDE;
+			io->show() = SHOW_FLAG_MEGAHIDE;
 			io->ioflags |= IO_FREEZESCRIPT;
 			return AbortRefuse;
 		}
@@ -263,15 +263,15 @@ public:
 				
 				LASTSPAWNED = ioo;
 				ioo->scriptload = 1;
-				ioo->pos = t->pos;
+				ioo->pos() = t->pos();
 				
 				ioo->angle = t->angle;
 				SendInitScriptEvent(ioo);
 				
 				if(t->ioflags & IO_NPC) {
-					float dist = t->physics.cyl.radius + ioo->physics.cyl.radius + 10;
+					float dist = t->physics().cyl.radius + ioo->physics().cyl.radius + 10;
 					
-					ioo->pos += angleToVectorXZ(t->angle.getPitch()) * dist;
+					ioo->pos() += angleToVectorXZ(t->angle.getPitch()) * dist;
 				}
 				
 				TREATZONE_AddIO(ioo);
@@ -288,7 +288,7 @@ public:
 				
 				LASTSPAWNED = ioo;
 				ioo->scriptload = 1;
-				ioo->pos = t->pos;
+				ioo->pos() = t->pos();
 				ioo->angle = t->angle;
 				SendInitScriptEvent(ioo);
 				
@@ -305,7 +305,7 @@ public:
 			}
 			
 			GetTargetPos(io);
-			Vec3f pos = io->pos;
+			Vec3f pos = io->pos();
 			
 			if(io->ioflags & IO_NPC) {
 				pos.y -= 80.f;
@@ -351,10 +351,10 @@ public:
 			
 			if(type == "height") {
 				io->original_height = glm::clamp(-fval, -165.f, -30.f);
-				io->physics.cyl.height = io->original_height * io->scale;
+				io->physics().cyl.height = io->original_height * io->scale;
 			} else if(type == "radius") {
 				io->original_radius = glm::clamp(fval, 10.f, 40.f);
-				io->physics.cyl.radius = io->original_radius * io->scale;
+				io->physics().cyl.radius = io->original_radius * io->scale;
 			} else {
 				ScriptWarning << "unknown command: " << type;
 				return Failed;
@@ -421,12 +421,12 @@ class IfVisibleCommand : public Command {
 	
 	static bool hasVisibility(Entity * io, Entity * ioo) {
 		
-		if(fartherThan(io->pos, ioo->pos, 20000)) {
+		if(fartherThan(io->pos(), ioo->pos(), 20000)) {
 			return false;
 		}
 		
 		float ab = MAKEANGLE(io->angle.getPitch());
-		float aa = getAngle(io->pos.x, io->pos.z, ioo->pos.x, ioo->pos.z);
+		float aa = getAngle(io->pos().x, io->pos().z, ioo->pos().x, ioo->pos().z);
 		aa = MAKEANGLE(glm::degrees(aa));
 		
 		if((aa < ab + 90.f) && (aa > ab - 90.f)) {
@@ -482,16 +482,16 @@ public:
 			return Failed;
 		}
 		
-		t->gameFlags &= ~GFLAG_MEGAHIDE;
+		t->gameFlags() &= ~GFLAG_MEGAHIDE;
 		if(hide) {
 			if(megahide) {
-				t->gameFlags |= GFLAG_MEGAHIDE;
-				t->show = SHOW_FLAG_MEGAHIDE;
+				t->gameFlags() |= GFLAG_MEGAHIDE;
+				t->show() = SHOW_FLAG_MEGAHIDE;
 			} else {
-				t->show = SHOW_FLAG_HIDDEN;
+				t->show() = SHOW_FLAG_HIDDEN;
 			}
-		} else if(t->show == SHOW_FLAG_MEGAHIDE || t->show == SHOW_FLAG_HIDDEN) {
-			t->show = SHOW_FLAG_IN_SCENE;
+		} else if(t->show() == SHOW_FLAG_MEGAHIDE || t->show() == SHOW_FLAG_HIDDEN) {
+			t->show() = SHOW_FLAG_IN_SCENE;
 			if((t->ioflags & IO_NPC) && t->_npcdata->lifePool.current <= 0.f) {
 				t->animlayer[0].cur_anim = t->anims[ANIM_DIE];
 				t->animlayer[1].cur_anim = NULL;
@@ -592,8 +592,8 @@ public:
 			}
 			
 			if(!(io->ioflags & IO_NPC) || io->_npcdata->lifePool.current > 0) {
-				if(io->show != SHOW_FLAG_HIDDEN && io->show != SHOW_FLAG_MEGAHIDE) {
-					io->show = SHOW_FLAG_IN_SCENE;
+				if(io->show() != SHOW_FLAG_HIDDEN && io->show() != SHOW_FLAG_MEGAHIDE) {
+					io->show() = SHOW_FLAG_IN_SCENE;
 				}
 				ARX_INTERACTIVE_Teleport(io, pos);
 			}
@@ -609,8 +609,8 @@ public:
 				Vec3f pos = GetItemWorldPosition(io);
 				ARX_INTERACTIVE_Teleport(entities.player(), pos);
 			} else if(!(io->ioflags & IO_NPC) || io->_npcdata->lifePool.current > 0) {
-				if(io->show != SHOW_FLAG_HIDDEN && io->show != SHOW_FLAG_MEGAHIDE) {
-					io->show = SHOW_FLAG_IN_SCENE;
+				if(io->show() != SHOW_FLAG_HIDDEN && io->show() != SHOW_FLAG_MEGAHIDE) {
+					io->show() = SHOW_FLAG_IN_SCENE;
 				}
 				ARX_INTERACTIVE_Teleport(io, io->initpos);
 			}
@@ -660,7 +660,7 @@ public:
 		ARX_INTERACTIVE_DestroyIOdelayed(entity);
 		
 		// Prevent further script events as the object has been destroyed!
-		entity->show = SHOW_FLAG_MEGAHIDE;
+		entity->show() = SHOW_FLAG_MEGAHIDE;
 		entity->ioflags |= IO_FREEZESCRIPT;
 		if(entity == context.getEntity()) {
 			return AbortAccept;
@@ -725,7 +725,7 @@ public:
 		}
 		
 		EntityHandle self = (context.getEntity() == NULL) ? EntityHandle() : context.getEntity()->index();
-		ARX_DAMAGES_DealDamages(t->index(), damage, self, type, &t->pos);
+		ARX_DAMAGES_DealDamages(t->index(), damage, self, type, &t->pos());
 		
 		return Success;
 	}
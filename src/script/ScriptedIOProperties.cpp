@@ -111,9 +111,9 @@ public:
 		Entity * io = context.getEntity();
 		
 		if(enable ^ inv) {
-			io->gameFlags |= flag;
+			io->gameFlags() |= flag;
 		} else {
-			io->gameFlags &= ~flag;
+			io->gameFlags() &= ~flag;
 		}
 		
 		return Success;
@@ -270,14 +270,14 @@ public:
 		
 		Entity * io = context.getEntity();
 		if(interactivity == "none") {
-			io->gameFlags &= ~GFLAG_INTERACTIVITY;
-			io->gameFlags &= ~GFLAG_INTERACTIVITYHIDE;
+			io->gameFlags() &= ~GFLAG_INTERACTIVITY;
+			io->gameFlags() &= ~GFLAG_INTERACTIVITYHIDE;
 		} else if(interactivity == "hide") {
-			io->gameFlags &= ~GFLAG_INTERACTIVITY;
-			io->gameFlags |= GFLAG_INTERACTIVITYHIDE;
+			io->gameFlags() &= ~GFLAG_INTERACTIVITY;
+			io->gameFlags() |= GFLAG_INTERACTIVITYHIDE;
 		} else {
-			io->gameFlags |= GFLAG_INTERACTIVITY;
-			io->gameFlags &= ~GFLAG_INTERACTIVITYHIDE;
+			io->gameFlags() |= GFLAG_INTERACTIVITY;
+			io->gameFlags() &= ~GFLAG_INTERACTIVITYHIDE;
 		}
 		
 		return Success;
@@ -117,7 +117,7 @@ class InventoryCommand : public Command {
 						}
 						ARX_INTERACTIVE_DestroyIOdelayed(item);
 						// Prevent further script events as the object has been destroyed!
-						item->show = SHOW_FLAG_MEGAHIDE;
+						item->show() = SHOW_FLAG_MEGAHIDE;
 						item->ioflags |= IO_FREEZESCRIPT;
 					}
 					id->slot[x][y].io = NULL;
@@ -288,7 +288,7 @@ class InventoryCommand : public Command {
 			}
 			
 			t->scriptload = 0;
-			t->show = SHOW_FLAG_IN_INVENTORY;
+			t->show() = SHOW_FLAG_IN_INVENTORY;
 			
 			if(!CanBePutInSecondaryInventory(context.getEntity()->inventory, t)) {
 				PutInFrontOfPlayer(t);
@@ -347,7 +347,7 @@ class InventoryCommand : public Command {
 			LASTSPAWNED = ioo;
 			ioo->scriptload = 1;
 			SendInitScriptEvent(ioo);
-			ioo->show = SHOW_FLAG_IN_INVENTORY;
+			ioo->show() = SHOW_FLAG_IN_INVENTORY;
 			
 			if(multi) {
 				if(ioo->ioflags & IO_GOLD) {
@@ -535,10 +535,10 @@ public:
 		
 		Entity * io = context.getEntity();
 		
-		io->gameFlags &= ~GFLAG_HIDEWEAPON;
+		io->gameFlags() &= ~GFLAG_HIDEWEAPON;
 		HandleFlags("h") {
 			if(flg & flag('h')) {
-				io->gameFlags |= GFLAG_HIDEWEAPON;
+				io->gameFlags() |= GFLAG_HIDEWEAPON;
 			}
 		}
 		
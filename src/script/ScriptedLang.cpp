@@ -892,10 +892,8 @@ void timerCommand(const std::string & timer, Context & context) {
 		return;
 	}
 	
-	ActiveTimers++;
 	scr_timer[num].es = context.getScript();
-	scr_timer[num].exist = 1;
-	scr_timer[num].io = io;
+	scr_timer[num].io = entities.ref(io);
 	scr_timer[num].msecs = millisecons;
 	scr_timer[num].name = timername;
 	scr_timer[num].pos = pos;
@@ -904,6 +902,8 @@ void timerCommand(const std::string & timer, Context & context) {
 	
 	scr_timer[num].flags = (idle && io) ? 1 : 0;
 	
+	ARX_SCRIPT_Timer_Start(num);
+	
 }
 
 void setupScriptedLang() {
@@ -449,7 +449,7 @@ public:
 			Entity * ioo = io;
 			if(io->_itemdata->count > 1) {
 				ioo = CloneIOItem(io);
-				ioo->show = SHOW_FLAG_IN_INVENTORY;
+				ioo->show() = SHOW_FLAG_IN_INVENTORY;
 				ioo->scriptload = 1;
 				ioo->_itemdata->count = 1;
 				io->_itemdata->count--;
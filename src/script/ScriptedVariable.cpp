@@ -272,17 +272,12 @@ class UnsetCommand : public Command {
 	// TODO move to variable context
 	static bool UNSETVar(SCRIPT_VARIABLES& svf, const std::string & name) {
 		
-		SCRIPT_VARIABLES::iterator it;
-		for(it = svf.begin(); it != svf.end(); ++it) {
-			if(it->type != 0 && name == it->name) {
-				break;
-			}
-		}
-		
-		if(it == svf.end())
+		const SCRIPT_VAR * var = static_cast<const SCRIPT_VARIABLES &>(svf).find(name);
+		if(!var) {
 			return false;
+		}
 		
-		svf.erase(it);
+		svf.erase(svf.begin() + (var - &svf[0]));
 		
 		return true;
 	}
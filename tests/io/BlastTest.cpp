@@ -0,0 +1,222 @@
+/*
+ * Copyright 2016 Arx Libertatis Team (see the AUTHORS file)
+ *
+ * This file is part of Arx Libertatis.
+ *
+ * Arx Libertatis is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Arx Libertatis is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Arx Libertatis.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests/io/BlastTest.h"
+
+#include <cstdlib>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "src/io/Blast.h"
+#include "src/io/Implode.h"
+#include "src/platform/Platform.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BlastTest);
+
+namespace {
+
+// Larger than the biggest dictionary and the 4096 byte output chunks of blast()
+const size_t sizes[] = { 1, 100, 5000, 20000 };
+
+const ImplodeLiteralSize literalModes[] = { IMPLODE_LITERAL_FIXED, IMPLODE_LITERAL_VARIABLE };
+
+// 1024, 2048 and 4096 byte dictionaries
+const unsigned char dictSizes[] = { 4, 5, 6 };
+
+//! Repetitive data with back-references at all distances
+std::string makeText(size_t size) {
+	
+	static const char * const words[] = {
+		"arx ", "fatalis ", "libertatis ", "akbaa ", "noden ", "arkaneum ", "\n"
+	};
+	
+	std::string data;
+	unsigned state = 1;
+	while(data.size() < size) {
+		state = state * 1103515245u + 12345u;
+		data += words[(state >> 16) % ARRAY_SIZE(words)];
+	}
+	data.resize(size);
+	
+	return data;
+}
+
+//! Data with few repetitions that is mostly stored as literals
+std::string makeNoise(size_t size) {
+	
+	std::string data(size, '\0');
+	unsigned state = 1;
+	for(size_t i = 0; i < size; i++) {
+		state = state * 1103515245u + 12345u;
+		data[i] = char(state >> 16);
+	}
+	
+	return data;
+}
+
+std::string compress(const std::string & data, ImplodeLiteralSize literals,
+                     unsigned char dictSize) {
+	
+	std::string compressed(data.size() * 2 + 16, '\0');
+	
+	pkstream strm;
+	strm.pInBuffer = reinterpret_cast<const unsigned char *>(data.data());
+	strm.nInSize = data.size();
+	strm.pOutBuffer = reinterpret_cast<unsigned char *>(&compressed[0]);
+	strm.nOutSize = compressed.size();
+	strm.nLitSize = literals;
+	strm.nDictSizeByte = dictSize;
+	
+	CPPUNIT_ASSERT_EQUAL(IMPLODE_SUCCESS, implode(&strm));
+	compressed.resize(strm.nOutSize);
+	
+	return compressed;
+}
+
+//! All combinations of input data, literal mode and dictionary size
+std::vector<std::string> makeInputs() {
+	
+	std::vector<std::string> inputs;
+	for(size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		inputs.push_back(makeText(sizes[i]));
+		inputs.push_back(makeNoise(sizes[i]));
+	}
+	
+	return inputs;
+}
+
+//! Provides the input in chunks of varying size to exercise refills in the middle of codes
+struct ChunkedInput {
+	
+	const std::string & data;
+	size_t pos;
+	size_t chunk;
+	
+	ChunkedInput(const std::string & d, size_t c) : data(d), pos(0), chunk(c) { }
+	
+};
+
+size_t chunkedIn(void * how, const unsigned char ** buf) {
+	
+	ChunkedInput * in = static_cast<ChunkedInput *>(how);
+	
+	size_t count = std::min(in->chunk, in->data.size() - in->pos);
+	*buf = reinterpret_cast<const unsigned char *>(in->data.data() + in->pos);
+	in->pos += count;
+	in->chunk = in->chunk % 7 + 1;
+	
+	return count;
+}
+
+int stringOut(void * how, unsigned char * buf, size_t len) {
+	static_cast<std::string *>(how)->append(reinterpret_cast<const char *>(buf), len);
+	return 0;
+}
+
+} // anonymous namespace
+
+void BlastTest::memTest() {
+	
+	std::vector<std::string> inputs = makeInputs();
+	for(size_t i = 0; i < inputs.size(); i++) {
+		for(size_t l = 0; l < ARRAY_SIZE(literalModes); l++) {
+			for(size_t d = 0; d < ARRAY_SIZE(dictSizes); d++) {
+				
+				const std::string & data = inputs[i];
+				std::string compressed = compress(data, literalModes[l], dictSizes[d]);
+				
+				std::string out(data.size(), '\0');
+				size_t size = blastMem(compressed.data(), compressed.size(), &out[0], out.size());
+				
+				CPPUNIT_ASSERT_EQUAL(data.size(), size);
+				CPPUNIT_ASSERT(out == data);
+			}
+		}
+	}
+}
+
+void BlastTest::memAllocTest() {
+	
+	std::vector<std::string> inputs = makeInputs();
+	for(size_t i = 0; i < inputs.size(); i++) {
+		for(size_t l = 0; l < ARRAY_SIZE(literalModes); l++) {
+			for(size_t d = 0; d < ARRAY_SIZE(dictSizes); d++) {
+				
+				const std::string & data = inputs[i];
+				std::string compressed = compress(data, literalModes[l], dictSizes[d]);
+				
+				size_t size = 0;
+				char * out = blastMemAlloc(compressed.data(), compressed.size(), size);
+				
+				CPPUNIT_ASSERT(out != NULL);
+				CPPUNIT_ASSERT_EQUAL(data.size(), size);
+				CPPUNIT_ASSERT(std::string(out, size) == data);
+				
+				free(out);
+			}
+		}
+	}
+}
+
+void BlastTest::chunkedTest() {
+	
+	std::vector<std::string> inputs = makeInputs();
+	for(size_t i = 0; i < inputs.size(); i++) {
+		for(size_t l = 0; l < ARRAY_SIZE(literalModes); l++) {
+			for(size_t d = 0; d < ARRAY_SIZE(dictSizes); d++) {
+				
+				const std::string & data = inputs[i];
+				std::string compressed = compress(data, literalModes[l], dictSizes[d]);
+				
+				ChunkedInput in(compressed, 1);
+				std::string out;
+				
+				CPPUNIT_ASSERT_EQUAL(BLAST_SUCCESS, blast(chunkedIn, &in, stringOut, &out));
+				CPPUNIT_ASSERT(out == data);
+			}
+		}
+	}
+}
+
+void BlastTest::errorTest() {
+	
+	std::string data = makeText(5000);
+	std::string compressed = compress(data, IMPLODE_LITERAL_VARIABLE, 6);
+	
+	std::string out;
+	
+	std::string truncated = compressed.substr(0, compressed.size() / 2);
+	ChunkedInput in(truncated, 3);
+	CPPUNIT_ASSERT_EQUAL(BLAST_TRUNCATED_INPUT, blast(chunkedIn, &in, stringOut, &out));
+	
+	std::string badLiteral = compressed;
+	badLiteral[0] = 2;
+	ChunkedInput in2(badLiteral, 3);
+	CPPUNIT_ASSERT_EQUAL(BLAST_INVALID_LITERAL_FLAG, blast(chunkedIn, &in2, stringOut, &out));
+	
+	std::string badDict = compressed;
+	badDict[1] = 7;
+	ChunkedInput in3(badDict, 3);
+	CPPUNIT_ASSERT_EQUAL(BLAST_INVALID_DIC_SIZE, blast(chunkedIn, &in3, stringOut, &out));
+	
+	std::string small(data.size() / 2, '\0');
+	CPPUNIT_ASSERT_EQUAL(size_t(0), blastMem(compressed.data(), compressed.size(),
+	                                        &small[0], small.size()));
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2016 Arx Libertatis Team (see the AUTHORS file)
+ *
+ * This file is part of Arx Libertatis.
+ *
+ * Arx Libertatis is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Arx Libertatis is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Arx Libertatis.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "io/fs/FilePath.h"
+#include "io/log/Logger.h"
+#include "io/resource/PakEntry.h"
+#include "io/resource/PakReader.h"
+#include "platform/ThreadPool.h"
+#include "platform/Time.h"
+#include "platform/WindowsMain.h"
+
+static void collectFiles(PakDirectory & dir, std::vector<const PakFile *> & files) {
+	
+	for(PakDirectory::files_iterator i = dir.files_begin(); i != dir.files_end(); ++i) {
+		if(i->second->size() > 0) {
+			files.push_back(i->second);
+		}
+	}
+	
+	for(PakDirectory::dirs_iterator i = dir.dirs_begin(); i != dir.dirs_end(); ++i) {
+		collectFiles(i->second, files);
+	}
+}
+
+static void freeData(std::vector<char *> & data) {
+	for(std::vector<char *>::iterator i = data.begin(); i != data.end(); ++i) {
+		free(*i), *i = NULL;
+	}
+}
+
+static void printResult(const char * what, u64 time, size_t iterations, size_t total) {
+	
+	u64 average = time / iterations;
+	
+	std::cout << what << ": " << (average / 1000) << " ms";
+	
+	if(average != 0) {
+		std::cout << " (" << (u64(total) / average) << " MB/s)";
+	}
+	
+	std::cout << std::endl;
+}
+
+static bool parseCount(const char * arg, size_t & count) {
+	std::istringstream iss(arg);
+	return bool(iss >> count);
+}
+
+static void printHelp() {
+	std::cout << "usage: arxblastbench [-i <iterations>] [-t <threads>] <pakfile> [<pakfile>...]"
+	          << std::endl;
+}
+
+int utf8_main(int argc, char ** argv) {
+	
+	ARX_UNUSED(resources);
+	
+	Logger::initialize();
+	
+	size_t iterations = 10;
+	size_t threads = 0;
+	
+	int i = 1;
+	for(; i + 1 < argc && argv[i][0] == '-'; i += 2) {
+		if(!strcmp(argv[i], "-i")) {
+			if(!parseCount(argv[i + 1], iterations) || iterations == 0) {
+				printHelp();
+				return 1;
+			}
+		} else if(!strcmp(argv[i], "-t")) {
+			if(!parseCount(argv[i + 1], threads)) {
+				printHelp();
+				return 1;
+			}
+		} else {
+			break;
+		}
+	}
+	
+	if(i >= argc) {
+		printHelp();
+		return 1;
+	}
+	
+	PakReader pak;
+	for(; i < argc; i++) {
+		if(!pak.addArchive(argv[i])) {
+			std::cerr << "error opening PAK file " << argv[i] << std::endl;
+			return 1;
+		}
+	}
+	
+	platform::initializeTime();
+	
+	ThreadPool pool(threads);
+	
+	std::vector<const PakFile *> files;
+	collectFiles(pak, files);
+	
+	size_t total = 0;
+	for(std::vector<const PakFile *>::const_iterator file = files.begin(); file != files.end(); ++file) {
+		total += (*file)->size();
+	}
+	
+	std::cout << "Benchmarking " << files.size() << " files (" << (total / 1024 / 1024)
+	          << " MiB) with " << (pool.getThreadCount() + 1) << " threads, " << iterations
+	          << " iterations" << std::endl;
+	
+	std::vector<char *> reference;
+	std::vector<char> success;
+	if(!PakFile::readAlloc(files, reference, success)) {
+		std::cerr << "error reading files" << std::endl;
+		freeData(reference);
+		return 1;
+	}
+	
+	int ret = 0;
+	
+	u64 serial = 0;
+	u64 parallel = 0;
+	
+	for(size_t iteration = 0; iteration < iterations; iteration++) {
+		
+		std::vector<char *> data;
+		
+		u64 start = platform::getTimeUs();
+		PakFile::readAlloc(files, data, success);
+		serial += platform::getElapsedUs(start);
+		freeData(data);
+		
+		start = platform::getTimeUs();
+		PakFile::readAlloc(files, data, success, &pool);
+		parallel += platform::getElapsedUs(start);
+		
+		for(size_t j = 0; j < files.size(); j++) {
+			if(memcmp(data[j], reference[j], files[j]->size())) {
+				std::cerr << "parallel read differs from serial read" << std::endl;
+				ret = 1;
+				break;
+			}
+		}
+		freeData(data);
+		
+	}
+	
+	printResult("serial", serial, iterations, total);
+	printResult("parallel", parallel, iterations, total);
+	
+	freeData(reference);
+	
+	return ret;
+}
@@ -0,0 +1,286 @@
+/*
+ * Copyright 2016 Arx Libertatis Team (see the AUTHORS file)
+ *
+ * This file is part of Arx Libertatis.
+ *
+ * Arx Libertatis is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Arx Libertatis is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Arx Libertatis.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include "io/fs/FilePath.h"
+#include "io/fs/FileStream.h"
+#include "io/fs/Filesystem.h"
+#include "io/log/Logger.h"
+#include "io/resource/ArchiveFormat.h"
+#include "io/resource/PakEntry.h"
+#include "io/resource/PakReader.h"
+#include "platform/ThreadPool.h"
+#include "platform/WindowsMain.h"
+
+namespace {
+
+//! Number of files to load into memory at once
+const size_t BATCH_SIZE = 256;
+
+struct RepackFile {
+	
+	std::string name;
+	const PakFile * file;
+	u64 hash;
+	
+	RepackFile(const std::string & _name, const PakFile * _file)
+		: name(_name), file(_file), hash(archivePathHash(_name)) { }
+	
+	bool operator<(const RepackFile & other) const {
+		return name < other.name;
+	}
+	
+};
+
+//! Compressed data for a file
+struct StoredFile {
+	std::vector<char> data;
+	u16 compression;
+	u32 checksum;
+};
+
+void collectFiles(PakDirectory & dir, const std::string & prefix, std::vector<RepackFile> & files) {
+	
+	for(PakDirectory::files_iterator i = dir.files_begin(); i != dir.files_end(); ++i) {
+		files.push_back(RepackFile(prefix + i->first, i->second));
+	}
+	
+	for(PakDirectory::dirs_iterator i = dir.dirs_begin(); i != dir.dirs_end(); ++i) {
+		collectFiles(i->second, prefix + i->first + '/', files);
+	}
+}
+
+void compressFile(const char * data, size_t size, StoredFile & result) {
+	
+	const Bytef * bytes = reinterpret_cast<const Bytef *>(data);
+	result.checksum = u32(crc32(crc32(0, Z_NULL, 0), size ? bytes : Z_NULL, uInt(size)));
+	
+	size_t count = (size + ARCHIVE_BLOCK_SIZE - 1) / ARCHIVE_BLOCK_SIZE;
+	
+	std::vector<char> & stored = result.data;
+	stored.assign(sizeof(u32) * count, 0);
+	
+	std::vector<Bytef> buffer(compressBound(ARCHIVE_BLOCK_SIZE));
+	for(size_t i = 0; i < count; i++) {
+		
+		const char * block = data + i * ARCHIVE_BLOCK_SIZE;
+		size_t blockSize = std::min(ARCHIVE_BLOCK_SIZE, size - i * ARCHIVE_BLOCK_SIZE);
+		
+		// Blocks that do not get smaller are stored as is
+		uLongf length = uLongf(buffer.size());
+		if(compress2(&buffer[0], &length, reinterpret_cast<const Bytef *>(block), uLong(blockSize),
+		             Z_BEST_COMPRESSION) == Z_OK && length < blockSize) {
+			stored.insert(stored.end(), &buffer[0], &buffer[0] + length);
+		} else {
+			stored.insert(stored.end(), block, block + blockSize);
+			length = uLongf(blockSize);
+		}
+		
+		u32 blockStored = u32(length);
+		memcpy(&stored[sizeof(u32) * i], &blockStored, sizeof(u32));
+	}
+	
+	if(stored.size() >= size) {
+		stored.assign(data, data + size);
+		result.compression = ArchiveStored;
+	} else {
+		result.compression = ArchiveDeflate;
+	}
+}
+
+class CompressTask : public ThreadPool::Task {
+	
+	const std::vector<const PakFile *> & m_files;
+	const std::vector<char *> & m_data;
+	std::vector<StoredFile> & m_stored;
+	
+public:
+	
+	CompressTask(const std::vector<const PakFile *> & files, const std::vector<char *> & data,
+	             std::vector<StoredFile> & stored)
+		: m_files(files), m_data(data), m_stored(stored) { }
+	
+	void run(size_t index) {
+		compressFile(m_data[index], m_files[index]->size(), m_stored[index]);
+	}
+	
+};
+
+bool writePadding(std::ostream & os) {
+	size_t pos = size_t(os.tellp());
+	size_t padding = (ARCHIVE_ALIGNMENT - pos % ARCHIVE_ALIGNMENT) % ARCHIVE_ALIGNMENT;
+	std::vector<char> zeros(padding, 0);
+	return padding == 0 || !fs::write(os, &zeros[0], padding).fail();
+}
+
+bool repack(const fs::path & pakfile, ThreadPool & pool) {
+	
+	PakReader pak;
+	if(!pak.addArchive(pakfile)) {
+		std::cerr << "error opening PAK file " << pakfile << std::endl;
+		return false;
+	}
+	
+	std::vector<RepackFile> files;
+	collectFiles(pak, std::string(), files);
+	std::sort(files.begin(), files.end());
+	
+	fs::path archive = PakReader::getRepackedPath(pakfile);
+	fs::path tempFile = archive;
+	tempFile.append(".tmp");
+	
+	fs::ofstream ofs(tempFile, fs::fstream::out | fs::fstream::binary | fs::fstream::trunc);
+	if(!ofs.is_open()) {
+		std::cerr << "error opening " << tempFile << " for writing" << std::endl;
+		return false;
+	}
+	
+	ArchiveHeader header;
+	memset(&header, 0, sizeof(header));
+	fs::write(ofs, header);
+	
+	std::vector<ArchiveEntry> entries(files.size());
+	std::string names;
+	
+	u64 total = 0;
+	u64 totalStored = 0;
+	
+	for(size_t start = 0; start < files.size(); start += BATCH_SIZE) {
+		
+		size_t count = std::min(BATCH_SIZE, files.size() - start);
+		
+		std::vector<const PakFile *> batch(count);
+		for(size_t i = 0; i < count; i++) {
+			batch[i] = files[start + i].file;
+		}
+		
+		std::vector<char *> data;
+		std::vector<char> success;
+		if(!PakFile::readAlloc(batch, data, success, &pool)) {
+			std::cerr << "error reading files from " << pakfile << std::endl;
+			for(size_t i = 0; i < count; i++) {
+				free(data[i]);
+			}
+			ofs.close();
+			fs::remove(tempFile);
+			return false;
+		}
+		
+		std::vector<StoredFile> stored(count);
+		CompressTask task(batch, data, stored);
+		pool.run(task, count);
+		
+		for(size_t i = 0; i < count; i++) {
+			
+			free(data[i]);
+			
+			if(!writePadding(ofs)) {
+				break;
+			}
+			
+			const RepackFile & file = files[start + i];
+			ArchiveEntry & entry = entries[start + i];
+			entry.hash = file.hash;
+			entry.offset = u64(ofs.tellp());
+			entry.size = u32(file.file->size());
+			entry.storedSize = u32(stored[i].data.size());
+			entry.checksum = stored[i].checksum;
+			entry.nameOffset = u32(names.size());
+			entry.nameSize = u16(file.name.size());
+			entry.compression = stored[i].compression;
+			names += file.name;
+			
+			if(!stored[i].data.empty()) {
+				fs::write(ofs, &stored[i].data[0], stored[i].data.size());
+			}
+			
+			total += entry.size;
+			totalStored += entry.storedSize;
+		}
+		
+	}
+	
+	std::string toc;
+	if(!entries.empty()) {
+		toc.assign(reinterpret_cast<const char *>(&entries[0]), sizeof(ArchiveEntry) * entries.size());
+	}
+	toc += names;
+	
+	header.magic = ARCHIVE_MAGIC;
+	header.version = ARCHIVE_VERSION;
+	header.sourceSize = fs::file_size(pakfile);
+	header.tocOffset = u64(ofs.tellp());
+	header.tocSize = u32(toc.size());
+	header.tocChecksum = u32(crc32(crc32(0, Z_NULL, 0), reinterpret_cast<const Bytef *>(toc.data()),
+	                               uInt(toc.size())));
+	header.fileCount = u32(entries.size());
+	header.blockSize = ARCHIVE_BLOCK_SIZE;
+	
+	fs::write(ofs, toc.data(), toc.size());
+	ofs.seekp(0);
+	fs::write(ofs, header);
+	ofs.flush();
+	
+	bool failed = ofs.fail();
+	ofs.close();
+	
+	if(failed || !fs::rename(tempFile, archive, true)) {
+		std::cerr << "error writing " << archive << std::endl;
+		fs::remove(tempFile);
+		return false;
+	}
+	
+	std::cout << archive << ": " << files.size() << " files, " << (total / 1024) << " KiB -> "
+	          << (totalStored / 1024) << " KiB" << std::endl;
+	
+	return true;
+}
+	
+} // anonymous namespace
+
+int utf8_main(int argc, char ** argv) {
+	
+	ARX_UNUSED(resources);
+	
+	Logger::initialize();
+	
+	if(argc < 2) {
+		std::cout << "usage: arxrepack <pakfile> [<pakfile>...]" << std::endl;
+		return 1;
+	}
+	
+	ThreadPool pool;
+	
+	for(int i = 1; i < argc; i++) {
+		if(!repack(argv[i], pool)) {
+			return 1;
+		}
+	}
+	
+	return 0;
+}
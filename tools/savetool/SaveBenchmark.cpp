@@ -0,0 +1,225 @@
+/*
+ * Copyright 2016 Arx Libertatis Team (see the AUTHORS file)
+ *
+ * This file is part of Arx Libertatis.
+ *
+ * Arx Libertatis is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Arx Libertatis is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Arx Libertatis.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "savetool/SaveBenchmark.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "io/SaveBlock.h"
+#include "io/fs/Filesystem.h"
+#include "platform/ThreadPool.h"
+#include "platform/Time.h"
+
+static void freeEntries(SaveBlock::EntryList & entries) {
+	for(SaveBlock::EntryList::iterator entry = entries.begin(); entry != entries.end(); ++entry) {
+		free(entry->data), entry->data = NULL, entry->size = 0;
+	}
+}
+
+static bool sameEntries(const SaveBlock::EntryList & a, const SaveBlock::EntryList & b) {
+	
+	if(a.size() != b.size()) {
+		return false;
+	}
+	
+	for(size_t i = 0; i < a.size(); i++) {
+		if(a[i].name != b[i].name || a[i].size != b[i].size
+		   || (a[i].size && memcmp(a[i].data, b[i].data, a[i].size))) {
+			std::cerr << "mismatch for " << a[i].name << std::endl;
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+static void printResult(const char * what, u64 serial, u64 parallel, size_t iterations) {
+	
+	std::cout << what << ": " << (serial / iterations / 1000) << " ms serial, "
+	          << (parallel / iterations / 1000) << " ms parallel";
+	
+	if(parallel != 0) {
+		std::cout << " (" << (float(serial) / float(parallel)) << "x)";
+	}
+	
+	std::cout << std::endl;
+}
+
+static bool saveSerial(const fs::path & file, const SaveBlock::EntryList & entries) {
+	
+	fs::remove(file);
+	
+	SaveBlock save(file);
+	if(!save.open(true)) {
+		return false;
+	}
+	
+	for(SaveBlock::EntryList::const_iterator entry = entries.begin(); entry != entries.end(); ++entry) {
+		if(!save.save(entry->name, entry->data, entry->size)) {
+			return false;
+		}
+	}
+	
+	return save.flush("pld");
+}
+
+static bool saveParallel(const fs::path & file, const SaveBlock::EntryList & entries,
+                         ThreadPool & pool) {
+	
+	fs::remove(file);
+	
+	SaveBlock save(file);
+	if(!save.open(true)) {
+		return false;
+	}
+	
+	return save.save(entries, &pool) && save.flush("pld");
+}
+
+int main_benchmark(SaveBlock & save, int argc, char ** argv) {
+	
+	if(argc > 2) {
+		return -1;
+	}
+	
+	size_t iterations = 10;
+	if(argc > 0) {
+		std::istringstream iss(argv[0]);
+		if(!(iss >> iterations) || iterations == 0) {
+			return -1;
+		}
+	}
+	
+	size_t threads = 0;
+	if(argc > 1) {
+		std::istringstream iss(argv[1]);
+		if(!(iss >> threads)) {
+			return -1;
+		}
+	}
+	
+	if(!save.open()) {
+		return 2;
+	}
+	
+	platform::initializeTime();
+	
+	ThreadPool pool(threads);
+	
+	std::vector<std::string> files = save.getFiles();
+	
+	SaveBlock::EntryList reference;
+	reference.reserve(files.size());
+	size_t total = 0;
+	for(std::vector<std::string>::const_iterator file = files.begin(); file != files.end(); ++file) {
+		reference.push_back(SaveBlock::Entry(*file));
+		reference.back().data = save.load(*file, reference.back().size);
+		total += reference.back().size;
+	}
+	
+	std::cout << "Benchmarking " << files.size() << " files (" << (total / 1024) << " KiB) with "
+	          << (pool.getThreadCount() + 1) << " threads, " << iterations << " iterations"
+	          << std::endl;
+	
+	int ret = 0;
+	
+	// Loading
+	{
+		u64 serial = 0;
+		u64 parallel = 0;
+		
+		for(size_t i = 0; i < iterations; i++) {
+			
+			SaveBlock::EntryList entries;
+			entries.reserve(files.size());
+			u64 start = platform::getTimeUs();
+			for(std::vector<std::string>::const_iterator file = files.begin(); file != files.end(); ++file) {
+				entries.push_back(SaveBlock::Entry(*file));
+				entries.back().data = save.load(*file, entries.back().size);
+			}
+			serial += platform::getElapsedUs(start);
+			freeEntries(entries);
+			
+			entries.clear();
+			for(std::vector<std::string>::const_iterator file = files.begin(); file != files.end(); ++file) {
+				entries.push_back(SaveBlock::Entry(*file));
+			}
+			start = platform::getTimeUs();
+			save.load(entries, &pool);
+			parallel += platform::getElapsedUs(start);
+			if(!sameEntries(reference, entries)) {
+				ret = 1;
+			}
+			freeEntries(entries);
+			
+		}
+		
+		printResult("load", serial, parallel, iterations);
+	}
+	
+	// Saving
+	{
+		// Written to the current directory, like extracted files
+		fs::path serialFile = "arxsavetool-serial.sav";
+		fs::path parallelFile = "arxsavetool-parallel.sav";
+		
+		u64 serial = 0;
+		u64 parallel = 0;
+		
+		for(size_t i = 0; i < iterations; i++) {
+			
+			u64 start = platform::getTimeUs();
+			if(!saveSerial(serialFile, reference)) {
+				std::cerr << "error writing " << serialFile << std::endl;
+				ret = 1;
+				break;
+			}
+			serial += platform::getElapsedUs(start);
+			
+			start = platform::getTimeUs();
+			if(!saveParallel(parallelFile, reference, pool)) {
+				std::cerr << "error writing " << parallelFile << std::endl;
+				ret = 1;
+				break;
+			}
+			parallel += platform::getElapsedUs(start);
+			
+		}
+		
+		if(ret == 0) {
+			printResult("save", serial, parallel, iterations);
+			if(fs::read(serialFile) != fs::read(parallelFile)) {
+				std::cerr << "parallel save differs from serial save" << std::endl;
+				ret = 1;
+			}
+		}
+		
+		fs::remove(serialFile);
+		fs::remove(parallelFile);
+	}
+	
+	freeEntries(reference);
+	
+	return ret;
+}
@@ -25,6 +25,7 @@
 
 #include "platform/WindowsMain.h"
 
+#include "savetool/SaveBenchmark.h"
 #include "savetool/SaveFix.h"
 #include "savetool/SaveRename.h"
 #include "savetool/SaveView.h"
@@ -43,6 +44,7 @@ static void print_help() {
 	cout << " - fix <savefile>" << endl;
 	cout << " - rename <savefile> <newname>" << endl;
 	cout << " - view <savefile> [<ident>]" << endl;
+	cout << " - benchmark <savefile> [<iterations> [<threads>]]" << endl;
 }
 
 static int main_extract(SaveBlock & save, int argc, char ** argv) {
@@ -153,6 +155,8 @@ int utf8_main(int argc, char ** argv) {
 		ret = main_rename(save, argc, argv);
 	} else if(command == "v" || command == "view") {
 		ret = main_view(save, argc, argv);
+	} else if(command == "b" || command == "benchmark") {
+		ret = main_benchmark(save, argc, argv);
 	}
 	
 	if(ret == -1) {